@@ -26,6 +26,7 @@
 * History : DD.MM.YYYY Version  Description
 *         : 26.10.2011 1.00     First Release
 *         : 12.02.2013 1.01     Bug fix: Wifi-CS is PJ_3 not PJ_2
+*         : 19.10.2026 1.10     Added hardware_setup_essential().
 ***********************************************************************************************************************/
 
 /***********************************************************************************************************************
@@ -63,6 +64,23 @@ void hardware_setup(void)
     peripheral_modules_enable();
 }
 
+/***********************************************************************************************************************
+* Function name: hardware_setup_essential
+* Description  : Sets the outputs that must not float while the MCU starts up to the safe levels output_ports_configure()
+*                gives them. This can be called out of reset before the clocks and RAM are set up, so it only writes 
+*                port registers. hardware_setup() sets the same levels again with the rest of the ports.
+* Arguments    : none
+* Return value : none
+***********************************************************************************************************************/
+void hardware_setup_essential(void)
+{
+	/* Tocha (P23) high and PWM Chp (P22) low */
+	PORT2.PODR.BIT.B3 = 1;
+	PORT2.PODR.BIT.B2 = 0;
+	PORT2.PDR.BIT.B3  = 1;
+	PORT2.PDR.BIT.B2  = 1;
+}
+
 /***********************************************************************************************************************
 * Function name: output_ports_configure
 * Description  : Configures the port and pin direction settings, and sets the pin outputs to a safe level.
@@ -23,6 +23,7 @@
 /***********************************************************************************************************************
 * History : DD.MM.YYYY Version  Description
 *         : 26.10.2011 1.00     First Release
+*         : 19.10.2026 1.10     Added hardware_setup_essential().
 ***********************************************************************************************************************/
 
 /***********************************************************************************************************************
@@ -38,5 +39,8 @@ Exported global functions (to be accessed by other files)
 /* Hardware setup funtion declaration */
 void hardware_setup(void);
 
+/* Sets outputs that must not float while the MCU starts up */
+void hardware_setup_essential(void);
+
 /* End of multiple inclusion prevention macro */
 #endif
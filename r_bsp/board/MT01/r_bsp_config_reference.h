@@ -36,6 +36,7 @@
 *         : 17.01.2013 1.60    Moved BSP_CFG_IO_LIB_ENABLE macro since it is now used in conjunction with 
 *                              BSP_CFG_HEAP_BYTES. Added comments for disabling heap above BSP_CFG_HEAP_BYTES. 
 *                              Added BSP_CFG_PARAM_CHECKING_ENABLE macro for configuring global parameter checking.
+*         : 19.10.2026 1.70    Added BSP_CFG_FAST_BOOT_CALLBACK.
 ***********************************************************************************************************************/
 #ifndef R_BSP_CONFIG_REF_HEADER_FILE
 #define R_BSP_CONFIG_REF_HEADER_FILE
@@ -286,6 +287,13 @@ Configuration Options
 /* Callback for Bus Error Interrupt. */
 //#define BSP_CFG_BUS_ERROR_ISR_CALLBACK                  bus_error_cb
 
+/* Callback made first thing out of reset, before the clocks, RAM sections, I/O library and hardware_setup() are set up.
+   The MCU is running from the LOCO and only the stacks and the outputs set by hardware_setup_essential() are set up, 
+   so the function must not use global or static variables. It can start another program, such as a Bootloader going 
+   straight to a known good User Application with fl_fast_boot(), or return to go on with the normal start up. If the 
+   user does not need it then they should comment out the macro. */
+//#define BSP_CFG_FAST_BOOT_CALLBACK                      fl_fast_boot
+
 /* The user has the option of separately choosing little or big endian for the User Application Area and the
    User Boot space (if used). */
 
@@ -36,6 +36,7 @@
 *                               The code now handles starting the clocks and the required software delays for the clocks
 *                               to stabilize. Created clock_source_select() function.
 *         : 19.11.2012 1.50     Updated code to use 'BSP_' and 'BSP_CFG_' prefix for macros.
+*         : 19.10.2026 1.60     Added BSP_CFG_FAST_BOOT_CALLBACK, called out of reset before anything else is set up.
 ***********************************************************************************************************************/
 
 /***********************************************************************************************************************
@@ -82,6 +83,11 @@ External function Prototypes
 extern void _INIT_IOLIB(void);
 extern void _CLOSEALL(void);
 
+#ifdef BSP_CFG_FAST_BOOT_CALLBACK
+/* Called out of reset before anything else is set up (see r_bsp_config.h) */
+void BSP_CFG_FAST_BOOT_CALLBACK(void);
+#endif
+
 /***********************************************************************************************************************
 Private global variables and functions
 ***********************************************************************************************************************/
@@ -125,6 +131,10 @@ static void clock_source_select(void);
 *                9. The bus error interrupt is enabled to catch any accesses to invalid or reserved areas of memory.
 *
 *                Once this initialization is complete, the user's main() function is called.  It should not return.
+*
+*                If BSP_CFG_FAST_BOOT_CALLBACK is defined in r_bsp_config.h then the outputs set by 
+*                hardware_setup_essential() are set and the callback is called before step 2. It may start another
+*                program instead of returning, which skips all of the steps above.
 * Arguments    : none
 * Return value : none
 ***********************************************************************************************************************/
@@ -132,6 +142,15 @@ void PowerON_Reset_PC(void)
 {
     /* Stack pointers are setup prior to calling this function - see comments above */    
     
+#ifdef BSP_CFG_FAST_BOOT_CALLBACK
+    /* Outputs that cannot wait for hardware_setup() */
+    hardware_setup_essential();
+
+    /* May start another program while the MCU is still as it was out of reset. Returns if the normal start up is 
+       needed. */
+    BSP_CFG_FAST_BOOT_CALLBACK();
+#endif
+
     /* Initialise the MCU processor word */
 #if __RENESAS_VERSION__ >= 0x01010000    
     set_intb((void *)__sectop("C$VECT"));
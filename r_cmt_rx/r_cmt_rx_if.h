@@ -28,6 +28,11 @@
 *                              API did have to change.
 *         : 07.11.2012 1.30    Updated to be compliant with FIT Module Spec v1.00. Added R_CMT_CreateOneShot() function.                               
 *         : 14.12.2012 1.40    Added support for RX111. Completed updates to FIT 1.0 spec to support hardware locking.
+*         : 19.10.2026 1.50    Added R_CMT_CreateFreeRunning() and CMT_RX_CMD_GET_COUNT command.
+*         : 19.10.2026 1.60    Added CMT_RX_CMD_GET_COUNT_ADDRESS command.
+*         : 19.10.2026 1.70    Added timer wheel (R_CMT_TimerInit(), R_CMT_TimerStart(), R_CMT_TimerCancel() and
+*                              R_CMT_TimerNow()).
+*         : 19.10.2026 1.80    Added microsecond clock (R_CMT_ClockInit(), R_CMT_ClockNowUs() and helpers).
 ***********************************************************************************************************************/
 
 /***********************************************************************************************************************
@@ -43,11 +48,14 @@ Macro definitions
 ***********************************************************************************************************************/
 /* Version Number of API. */
 #define CMT_RX_VERSION_MAJOR            (1)
-#define CMT_RX_VERSION_MINOR            (30)
+#define CMT_RX_VERSION_MINOR            (80)
 
 /* This define is used with the R_CMT_Control() function if not channel needs to input. */
 #define CMT_RX_NO_CHANNEL               (0xFFFFFFFF)
 
+/* PCLK divider used by channels created with R_CMT_CreateFreeRunning(). */
+#define CMT_RX_FREE_RUNNING_DIVIDER     (512)
+
 /***********************************************************************************************************************
 Typedef definitions
 ***********************************************************************************************************************/
@@ -55,9 +63,23 @@ Typedef definitions
 typedef enum
 {
     CMT_RX_CMD_IS_CHANNEL_COUNTING = 0,    //Used for determining if a particular CMT channel is currently being used
-    CMT_RX_CMD_GET_NUM_CHANNELS            //Used for getting number of CMT channels on this MCU
+    CMT_RX_CMD_GET_NUM_CHANNELS,           //Used for getting number of CMT channels on this MCU
+    CMT_RX_CMD_GET_COUNT,                  //Used for reading the counter of a channel (pdata is uint16_t *)
+    CMT_RX_CMD_GET_COUNT_ADDRESS           //Used for getting the address of the counter register (pdata is uint32_t *)
 } cmt_commands_t;
 
+/* A timer wheel timer. The memory is owned by the caller and must stay valid while the timer is pending. Members are
+   only used by the driver. Clear a timer (or give it static storage) before its first R_CMT_TimerStart(). */
+typedef struct cmt_timer_s
+{
+    struct cmt_timer_s  *  p_next;          //Next timer in the same slot
+    struct cmt_timer_s  ** pp_prev;         //Link that points to this timer, NULL when not pending
+    uint32_t               expires;         //Tick count that the timer is due at
+    uint32_t               period;          //Ticks between callbacks, 0 for a one shot timer
+    void                (* callback)(void * pdata);
+    void                *  pdata;           //Passed to callback
+} cmt_timer_t;
+
 /***********************************************************************************************************************
 Exported global variables
 ***********************************************************************************************************************/
@@ -67,7 +89,18 @@ Exported global functions (to be accessed by other files)
 ***********************************************************************************************************************/
 bool R_CMT_CreatePeriodic(uint32_t frequency_hz, void (* callback)(void * pdata), uint32_t * channel);
 bool R_CMT_CreateOneShot(uint32_t period_us, void (* callback)(void * pdata), uint32_t * channel);
+bool R_CMT_CreateFreeRunning(uint32_t * channel);
 bool R_CMT_Control(uint32_t channel, cmt_commands_t command, void * pdata);
 bool R_CMT_Stop(uint32_t channel);
+bool R_CMT_TimerInit(uint32_t tick_hz);
+bool R_CMT_TimerStart(cmt_timer_t * p_timer, uint32_t ticks, uint32_t period_ticks, void (* callback)(void * pdata),
+                      void * pdata);
+bool R_CMT_TimerCancel(cmt_timer_t * p_timer);
+uint32_t R_CMT_TimerNow(void);
+bool R_CMT_ClockInit(void);
+uint64_t R_CMT_ClockNowUs(void);
+uint64_t R_CMT_ClockElapsedUs(uint64_t start_us);
+uint64_t R_CMT_ClockDeadlineUs(uint32_t timeout_us);
+bool R_CMT_ClockExpired(uint64_t deadline_us);
 
 
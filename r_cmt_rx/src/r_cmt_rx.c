@@ -28,6 +28,11 @@
 *                              API did have to change.
 *         : 07.11.2012 1.30    Updated to be compliant with FIT Module Spec v1.00. Added R_CMT_CreateOneShot() function.
 *         : 14.12.2012 1.40    Added support for RX111. Completed updates to FIT 1.0 spec to support hardware locking.
+*         : 19.10.2026 1.50    Added R_CMT_CreateFreeRunning() and CMT_RX_CMD_GET_COUNT command.
+*         : 19.10.2026 1.60    Added CMT_RX_CMD_GET_COUNT_ADDRESS command.
+*         : 19.10.2026 1.70    Added timer wheel (R_CMT_TimerInit(), R_CMT_TimerStart(), R_CMT_TimerCancel() and
+*                              R_CMT_TimerNow()).
+*         : 19.10.2026 1.80    Added microsecond clock (R_CMT_ClockInit(), R_CMT_ClockNowUs() and helpers).
 ***********************************************************************************************************************/
 
 /***********************************************************************************************************************
@@ -71,6 +76,56 @@ Macro definitions
     #define CMT_PCLK_HZ                 (BSP_PCLK_HZ)
 #endif
 
+#if CMT_RX_CFG_TIMER_ENABLE == 1
+/* Number of slots in each level of the timer wheel. */
+#define CMT_TIMER_SLOTS                 (1UL << CMT_RX_CFG_TIMER_SLOT_BITS)
+#define CMT_TIMER_SLOT_MASK             (CMT_TIMER_SLOTS - 1)
+
+/* Timers further away than this are placed this far away and placed again when their slot comes round. */
+#define CMT_TIMER_MAX_DELTA             ((1UL << (CMT_RX_CFG_TIMER_SLOT_BITS * CMT_RX_CFG_TIMER_LEVELS)) - 1)
+
+/* Longest timer that can be started. Longer ones would look like they were already due. */
+#define CMT_TIMER_MAX_TICKS             (0x7FFFFFFF)
+
+/* Returned by cmt_timer_next_event() when no timers are pending. */
+#define CMT_TIMER_NO_EVENT              (0xFFFFFFFF)
+
+/* Time in PCLK cycles from reading the counter to writing a new compare match value. A compare match value closer to
+   the counter than this could be passed before it is written, and would then not match until the counter wrapped. */
+#define CMT_TIMER_MARGIN_PCLK           (256)
+
+#if (CMT_RX_CFG_TIMER_SLOT_BITS * CMT_RX_CFG_TIMER_LEVELS) > 30
+    #error "Error! CMT_RX_CFG_TIMER_SLOT_BITS x CMT_RX_CFG_TIMER_LEVELS must not be more than 30 in r_cmt_rx_config.h"
+#endif
+#endif
+
+#if CMT_RX_CFG_CLOCK_ENABLE == 1
+/* CKS[1:0] setting for CMT_RX_CFG_CLOCK_DIVIDER. See g_cmt_clock_dividers[]. */
+#if   CMT_RX_CFG_CLOCK_DIVIDER == 8
+    #define CMT_CLOCK_CKS               (0)
+#elif CMT_RX_CFG_CLOCK_DIVIDER == 32
+    #define CMT_CLOCK_CKS               (1)
+#elif CMT_RX_CFG_CLOCK_DIVIDER == 128
+    #define CMT_CLOCK_CKS               (2)
+#elif CMT_RX_CFG_CLOCK_DIVIDER == 512
+    #define CMT_CLOCK_CKS               (3)
+#else
+    #error "Error! CMT_RX_CFG_CLOCK_DIVIDER must be 8, 32, 128 or 512 in r_cmt_rx_config.h"
+#endif
+
+/* Microseconds per counter count, with 32 bits after the binary point. Counts are turned into microseconds with a
+   multiply and a shift instead of a 64-bit divide. */
+#define CMT_CLOCK_US_PER_COUNT          ((((uint64_t)CMT_RX_CFG_CLOCK_DIVIDER * 1000000) << 32) / CMT_PCLK_HZ)
+
+/* Microseconds from one counter wrap to the next, with 32 bits after the binary point. */
+#define CMT_CLOCK_US_PER_WRAP           ((uint64_t)CMT_RX_MAX_TIMER_TICKS * CMT_CLOCK_US_PER_COUNT)
+#endif
+
+#if ((CMT_RX_CFG_TIMER_ENABLE == 1) && (CMT_RX_CFG_TIMER_TICKLESS == 1)) || (CMT_RX_CFG_CLOCK_ENABLE == 1)
+/* The I flag in the PSW. */
+#define CMT_PSW_I                       (0x00010000)
+#endif
+
 /***********************************************************************************************************************
 Typedef definitions
 ***********************************************************************************************************************/
@@ -79,7 +134,8 @@ typedef enum
 {
     CMT_RX_MODE_DISABLED = 0,
     CMT_RX_MODE_PERIODIC,
-    CMT_RX_MODE_ONE_SHOT
+    CMT_RX_MODE_ONE_SHOT,
+    CMT_RX_MODE_FREE_RUNNING
 } cmt_modes_t;
 
 /***********************************************************************************************************************
@@ -124,6 +180,65 @@ static bool cmt_setup_channel(uint32_t channel, uint32_t frequency_hz);
 static void cmt_isr_common(uint32_t channel);
 static bool cmt_create(uint32_t frequency_hz, void (* callback)(void * pdata), cmt_modes_t mode, uint32_t * channel);
 
+#if CMT_RX_CFG_TIMER_ENABLE == 1
+/* Heads of the timer wheel slot lists. Level 0 holds timers due in the next CMT_TIMER_SLOTS ticks, one slot per tick.
+   Each level above covers CMT_TIMER_SLOTS times the time of the level below. */
+static cmt_timer_t * g_cmt_timer_slots[CMT_RX_CFG_TIMER_LEVELS][CMT_TIMER_SLOTS];
+
+/* Ticks the timer wheel has been moved on since R_CMT_TimerInit(). */
+static volatile uint32_t g_cmt_timer_now;
+
+/* Channel used by the timer wheel. */
+static uint32_t g_cmt_timer_channel;
+
+/* Set once R_CMT_TimerInit() has succeeded. */
+static bool g_cmt_timer_ready = false;
+
+/* Set while the interrupt moves the timer wheel on and calls callbacks. */
+static bool g_cmt_timer_running = false;
+
+#if CMT_RX_CFG_TIMER_TICKLESS == 1
+/* Counter counts in each tick. */
+static uint32_t g_cmt_timer_counts_per_tick;
+
+/* Counter value that g_cmt_timer_now was last moved on to. This is below 0 when part of a tick was counted before the
+   last compare match. */
+static int32_t g_cmt_timer_base;
+
+/* CMT_TIMER_MARGIN_PCLK in counter counts. */
+static uint32_t g_cmt_timer_margin;
+#endif
+
+static void cmt_timer_isr(void * pdata);
+static void cmt_timer_insert(cmt_timer_t * p_timer);
+static void cmt_timer_unlink(cmt_timer_t * p_timer);
+static void cmt_timer_run_tick(void);
+static uint32_t cmt_timer_elapsed(void);
+#if CMT_RX_CFG_TIMER_TICKLESS == 1
+static uint32_t cmt_timer_next_event(void);
+static void cmt_timer_wake(uint32_t ticks);
+static void cmt_timer_program(void);
+#endif
+#endif
+
+#if CMT_RX_CFG_CLOCK_ENABLE == 1
+/* Microseconds up to the last counter wrap. g_cmt_clock_us_fraction holds the part microsecond, in 1/2^32 units. */
+static uint64_t g_cmt_clock_us;
+static uint32_t g_cmt_clock_us_fraction;
+
+/* Channel used by the clock. */
+static uint32_t g_cmt_clock_channel;
+
+/* Set once R_CMT_ClockInit() has succeeded. */
+static bool g_cmt_clock_ready = false;
+
+static void cmt_clock_isr(void * pdata);
+#endif
+
+#if ((CMT_RX_CFG_TIMER_ENABLE == 1) && (CMT_RX_CFG_TIMER_TICKLESS == 1)) || (CMT_RX_CFG_CLOCK_ENABLE == 1)
+static bool cmt_match_pending(uint32_t channel);
+#endif
+
 /***********************************************************************************************************************
 * Function Name: R_CMT_CreatePeriodic
 * Description  : Sets up a CMT channel and calls a callback function at a set frequency.
@@ -164,6 +279,62 @@ bool R_CMT_CreateOneShot (uint32_t period_us, void (* callback)(void * pdata), u
     return cmt_create((1000000/period_us), callback, CMT_RX_MODE_ONE_SHOT, channel);
 }
 
+/***********************************************************************************************************************
+* Function Name: R_CMT_CreateFreeRunning
+* Description  : Sets up a CMT channel that counts PCLK/CMT_RX_FREE_RUNNING_DIVIDER from 0 to 0xFFFF and wraps. No 
+*                interrupt is used so the counter can be read with R_CMT_Control() and CMT_RX_CMD_GET_COUNT at any time,
+*                including while MCU flash is being programmed. With a 48MHz PCLK the counter wraps every 699ms.
+*                Code that cannot call into ROM can read the counter register at the address returned by
+*                CMT_RX_CMD_GET_COUNT_ADDRESS.
+* Arguments    : channel -
+*                    Pointer of where to store which channel was used.
+* Return Value : true - 
+*                    Channel initialized successfully.
+*                false -
+*                    No channel available.
+***********************************************************************************************************************/
+bool R_CMT_CreateFreeRunning (uint32_t * channel)
+{
+    /* Return value. */
+    bool ret = false;    
+
+    /* Grab state to make sure we do not interfere with another operation. */
+    if (cmt_lock_state() != true)
+    {
+        /* Another operation is already in progress. */
+        return false;
+    }
+
+    /* Was a channel found? */
+    if (true == cmt_find_channel(channel))
+    {
+        /* Enable peripheral channel. */
+        power_on(*channel);
+
+        /* Count the full range of the counter. */
+        (*g_cmt_channels[*channel]).CMCOR = (uint16_t)(CMT_RX_MAX_TIMER_TICKS - 1);
+
+        /* PCLK/512 is the last entry in g_cmt_clock_dividers[]. */
+        (*g_cmt_channels[*channel]).CMCR.BIT.CKS = 3;
+
+        /* Set mode of operation. */
+        g_cmt_modes[*channel] = CMT_RX_MODE_FREE_RUNNING;
+
+        /* No callback is used. */
+        g_cmt_callbacks[*channel] = NULL;
+
+        /* Start channel counting. */
+        cmt_counter_start(*channel);
+
+        ret = true;
+    }
+
+    /* Release state so other operations can be performed. */
+    cmt_unlock_state();
+
+    return ret;
+}
+
 /***********************************************************************************************************************
 * Function Name: R_CMT_Stop
 * Description  : Stop a counter and puts it in module stop state to conserve power.
@@ -243,6 +414,30 @@ bool R_CMT_Control (uint32_t channel, cmt_commands_t command, void * pdata)
             pdata = (void *)CMT_RX_NUM_CHANNELS;
         break;
 
+        case CMT_RX_CMD_GET_COUNT:
+            /* Check input channel. */
+            if ((channel < CMT_RX_NUM_CHANNELS) && (CMT_RX_MODE_DISABLED != g_cmt_modes[channel]))
+            {
+                *(uint16_t *)pdata = (*g_cmt_channels[channel]).CMCNT;
+            }
+            else
+            {
+                ret = false;
+            }
+        break;
+
+        case CMT_RX_CMD_GET_COUNT_ADDRESS:
+            /* Check input channel. */
+            if ((channel < CMT_RX_NUM_CHANNELS) && (CMT_RX_MODE_DISABLED != g_cmt_modes[channel]))
+            {
+                *(uint32_t *)pdata = (uint32_t)&(*g_cmt_channels[channel]).CMCNT;
+            }
+            else
+            {
+                ret = false;
+            }
+        break;
+
         default:
             ret = false;
         break;
@@ -251,6 +446,743 @@ bool R_CMT_Control (uint32_t channel, cmt_commands_t command, void * pdata)
     return ret;
 } 
 
+#if CMT_RX_CFG_TIMER_ENABLE == 1
+/***********************************************************************************************************************
+* Function Name: R_CMT_TimerInit
+* Description  : Sets up a CMT channel to drive the timer wheel. Any number of timers can then be run with
+*                R_CMT_TimerStart() without using more channels. With CMT_RX_CFG_TIMER_TICKLESS the channel uses the
+*                slowest PCLK divider that gives a whole number of counts per tick (PCLK/512 if none does, which makes
+*                ticks a little short) and only interrupts when a timer is due or the counter is about to wrap.
+* Arguments    : tick_hz -
+*                    Ticks per second. Timer lengths are given in ticks.
+* Return Value : true - 
+*                    Timer wheel is running.
+*                false -
+*                    Already set up, no channel available or tick_hz cannot be used.
+***********************************************************************************************************************/
+bool R_CMT_TimerInit (uint32_t tick_hz)
+{
+    bool     ret = false;
+#if CMT_RX_CFG_TIMER_TICKLESS == 1
+    uint32_t i;
+    uint32_t counts_hz;
+#endif
+
+    if ((true == g_cmt_timer_ready) || (0 == tick_hz))
+    {
+        return false;
+    }
+
+#if CMT_RX_CFG_TIMER_TICKLESS == 1
+    /* Look for the slowest divider that gives a whole number of counts per tick. Fall back to the slowest divider. */
+    i = (sizeof(g_cmt_clock_dividers)/sizeof(g_cmt_clock_dividers[0])) - 1;
+
+    while ((i > 0) && ((((uint32_t)CMT_PCLK_HZ / g_cmt_clock_dividers[i]) % tick_hz) != 0))
+    {
+        i--;
+    }
+
+    if ((((uint32_t)CMT_PCLK_HZ / g_cmt_clock_dividers[i]) % tick_hz) != 0)
+    {
+        i = (sizeof(g_cmt_clock_dividers)/sizeof(g_cmt_clock_dividers[0])) - 1;
+    }
+
+    counts_hz = (uint32_t)CMT_PCLK_HZ / g_cmt_clock_dividers[i];
+
+    /* A tick must be at least 1 count and fit in the counter. */
+    if ((tick_hz > counts_hz) || ((counts_hz / tick_hz) > (uint32_t)CMT_RX_MAX_TIMER_TICKS))
+    {
+        return false;
+    }
+
+    g_cmt_timer_counts_per_tick = counts_hz / tick_hz;
+    g_cmt_timer_margin = (CMT_TIMER_MARGIN_PCLK / g_cmt_clock_dividers[i]) + 1;
+    g_cmt_timer_base = 0;
+
+    /* Grab state to make sure we do not interfere with another operation. */
+    if (cmt_lock_state() != true)
+    {
+        /* Another operation is already in progress. */
+        return false;
+    }
+
+    /* Was a channel found? */
+    if (true == cmt_find_channel(&g_cmt_timer_channel))
+    {
+        /* Enable peripheral channel. */
+        power_on(g_cmt_timer_channel);
+
+        /* No timers are pending yet so count the full range of the counter. */
+        (*g_cmt_channels[g_cmt_timer_channel]).CMCOR = (uint16_t)(CMT_RX_MAX_TIMER_TICKS - 1);
+
+        /* Set clock divider to be used. */
+        (*g_cmt_channels[g_cmt_timer_channel]).CMCR.BIT.CKS = i;
+
+        /* Set mode of operation. The compare match value is changed by cmt_timer_program() after each match. */
+        g_cmt_modes[g_cmt_timer_channel] = CMT_RX_MODE_PERIODIC;
+
+        /* Save callback function to be used. */
+        g_cmt_callbacks[g_cmt_timer_channel] = cmt_timer_isr;
+
+        /* Start channel counting. */
+        cmt_counter_start(g_cmt_timer_channel);
+
+        ret = true;
+    }
+
+    /* Release state so other operations can be performed. */
+    cmt_unlock_state();
+#else
+    /* Interrupt on every tick. */
+    ret = cmt_create(tick_hz, cmt_timer_isr, CMT_RX_MODE_PERIODIC, &g_cmt_timer_channel);
+#endif
+
+    g_cmt_timer_ready = ret;
+
+    return ret;
+}
+
+/***********************************************************************************************************************
+* Function Name: R_CMT_TimerStart
+* Description  : Starts a timer on the timer wheel. A timer that is already pending is started again. Takes the same
+*                time however many timers are pending. Can be called from a timer callback.
+* Arguments    : p_timer -
+*                    Timer to start. Must have been cleared or used with this module before.
+*                ticks -
+*                    Ticks until the callback is called. 0 is taken as 1. Must not be more than 0x7FFFFFFF.
+*                period_ticks -
+*                    Ticks between later callbacks, or 0 to call the callback once. Must not be more than 0x7FFFFFFF.
+*                    If a periodic callback is late, the missed callbacks are not made up.
+*                callback -
+*                    Function to call from the CMT interrupt when the timer is due.
+*                pdata -
+*                    Passed to callback.
+* Return Value : true - 
+*                    Timer started.
+*                false -
+*                    Timer wheel not set up or invalid argument.
+***********************************************************************************************************************/
+bool R_CMT_TimerStart (cmt_timer_t * p_timer, uint32_t ticks, uint32_t period_ticks, void (* callback)(void * pdata),
+                       void * pdata)
+{
+    uint32_t psw_i;
+
+    if ((false == g_cmt_timer_ready) || (NULL == p_timer) || (NULL == callback) ||
+        (ticks > CMT_TIMER_MAX_TICKS) || (period_ticks > CMT_TIMER_MAX_TICKS))
+    {
+        return false;
+    }
+
+    if (0 == ticks)
+    {
+        ticks = 1;
+    }
+
+    /* The wheel is changed from the CMT interrupt. */
+    psw_i = get_psw() & CMT_PSW_I;
+    clrpsw_i();
+
+    if (NULL != p_timer->pp_prev)
+    {
+        /* Already pending, take it out first. */
+        cmt_timer_unlink(p_timer);
+    }
+
+    /* Ticks counted but not yet taken into the wheel are added so the timer runs for the full time asked for. */
+    p_timer->expires  = g_cmt_timer_now + cmt_timer_elapsed() + ticks;
+    p_timer->period   = period_ticks;
+    p_timer->callback = callback;
+    p_timer->pdata    = pdata;
+
+    cmt_timer_insert(p_timer);
+
+#if CMT_RX_CFG_TIMER_TICKLESS == 1
+    /* Interrupt sooner if this timer is due before the current compare match. */
+    cmt_timer_wake(p_timer->expires - g_cmt_timer_now);
+#endif
+
+    if (0 != psw_i)
+    {
+        setpsw_i();
+    }
+
+    return true;
+}
+
+/***********************************************************************************************************************
+* Function Name: R_CMT_TimerCancel
+* Description  : Stops a pending timer. Takes the same time however many timers are pending. Can be called from a timer
+*                callback. In tickless mode the channel is not reprogrammed, so there may be one interrupt with nothing
+*                to do.
+* Arguments    : p_timer -
+*                    Timer to stop.
+* Return Value : true - 
+*                    Timer was pending and has been stopped.
+*                false -
+*                    Timer was not pending.
+***********************************************************************************************************************/
+bool R_CMT_TimerCancel (cmt_timer_t * p_timer)
+{
+    bool     ret = false;
+    uint32_t psw_i;
+
+    if (NULL == p_timer)
+    {
+        return false;
+    }
+
+    /* The wheel is changed from the CMT interrupt. */
+    psw_i = get_psw() & CMT_PSW_I;
+    clrpsw_i();
+
+    if (NULL != p_timer->pp_prev)
+    {
+        cmt_timer_unlink(p_timer);
+
+        ret = true;
+    }
+
+    if (0 != psw_i)
+    {
+        setpsw_i();
+    }
+
+    return ret;
+}
+
+/***********************************************************************************************************************
+* Function Name: R_CMT_TimerNow
+* Description  : Returns the number of ticks since R_CMT_TimerInit(). Wraps after 2^32 ticks.
+* Arguments    : none
+* Return Value : Tick count.
+***********************************************************************************************************************/
+uint32_t R_CMT_TimerNow (void)
+{
+    uint32_t now;
+    uint32_t psw_i;
+
+    psw_i = get_psw() & CMT_PSW_I;
+    clrpsw_i();
+
+    now = g_cmt_timer_now + cmt_timer_elapsed();
+
+    if (0 != psw_i)
+    {
+        setpsw_i();
+    }
+
+    return now;
+}
+
+/***********************************************************************************************************************
+* Function Name: cmt_timer_isr
+* Description  : Callback for the timer wheel channel. Moves the wheel on by the ticks counted since the last call and
+*                calls the callbacks of timers that are due. In tickless mode the next compare match is then set for
+*                the next tick that has something to do.
+* Arguments    : pdata -
+*                    Channel number (not used).
+* Return Value : none
+***********************************************************************************************************************/
+static void cmt_timer_isr (void * pdata)
+{
+#if CMT_RX_CFG_TIMER_TICKLESS == 1
+    int32_t  counts;
+    uint32_t ticks;
+
+    /* The counter went back to 0 after counting CMCOR + 1. Counts left over after whole ticks count towards the next
+       tick. */
+    counts = ((int32_t)(*g_cmt_channels[g_cmt_timer_channel]).CMCOR + 1) - g_cmt_timer_base;
+    ticks = (uint32_t)counts / g_cmt_timer_counts_per_tick;
+    g_cmt_timer_base = -(int32_t)((uint32_t)counts % g_cmt_timer_counts_per_tick);
+
+    g_cmt_timer_running = true;
+
+    while (ticks > 0)
+    {
+        cmt_timer_run_tick();
+        ticks--;
+    }
+
+    g_cmt_timer_running = false;
+
+    cmt_timer_program();
+#else
+    g_cmt_timer_running = true;
+
+    cmt_timer_run_tick();
+
+    g_cmt_timer_running = false;
+#endif
+}
+
+/***********************************************************************************************************************
+* Function Name: cmt_timer_insert
+* Description  : Adds a timer to the slot for its expiry time, at the lowest level that reaches that far. Must be called
+*                with interrupts disabled or from the CMT interrupt.
+* Arguments    : p_timer -
+*                    Timer to add. Must not be pending.
+* Return Value : none
+***********************************************************************************************************************/
+static void cmt_timer_insert (cmt_timer_t * p_timer)
+{
+    uint32_t        delta;
+    uint32_t        level;
+    cmt_timer_t  ** pp_head;
+
+    delta = p_timer->expires - g_cmt_timer_now;
+
+    if ((int32_t)delta < 0)
+    {
+        /* Already due. Goes in the slot for the tick being run. */
+        delta = 0;
+    }
+    else if (delta > CMT_TIMER_MAX_DELTA)
+    {
+        /* Further than the wheel reaches. Will be placed again when its slot comes round. */
+        delta = CMT_TIMER_MAX_DELTA;
+    }
+    else
+    {
+        /* Placed directly. */
+    }
+
+    level = 0;
+
+    while ((delta >> (CMT_RX_CFG_TIMER_SLOT_BITS * (level + 1))) != 0)
+    {
+        level++;
+    }
+
+    pp_head = &g_cmt_timer_slots[level][((g_cmt_timer_now + delta) >> (CMT_RX_CFG_TIMER_SLOT_BITS * level)) &
+                                        CMT_TIMER_SLOT_MASK];
+
+    p_timer->p_next = *pp_head;
+
+    if (NULL != p_timer->p_next)
+    {
+        p_timer->p_next->pp_prev = &p_timer->p_next;
+    }
+
+    *pp_head = p_timer;
+    p_timer->pp_prev = pp_head;
+}
+
+/***********************************************************************************************************************
+* Function Name: cmt_timer_unlink
+* Description  : Takes a timer out of the list it is in. Must be called with interrupts disabled or from the CMT
+*                interrupt.
+* Arguments    : p_timer -
+*                    Timer to take out. Must be pending.
+* Return Value : none
+***********************************************************************************************************************/
+static void cmt_timer_unlink (cmt_timer_t * p_timer)
+{
+    *p_timer->pp_prev = p_timer->p_next;
+
+    if (NULL != p_timer->p_next)
+    {
+        p_timer->p_next->pp_prev = p_timer->pp_prev;
+    }
+
+    p_timer->p_next = NULL;
+    p_timer->pp_prev = NULL;
+}
+
+/***********************************************************************************************************************
+* Function Name: cmt_timer_run_tick
+* Description  : Moves the timer wheel on by 1 tick. When a level comes round, the timers in the next slot of the level
+*                above are placed again at lower levels. Then the timers in the level 0 slot for this tick are due.
+* Arguments    : none
+* Return Value : none
+***********************************************************************************************************************/
+static void cmt_timer_run_tick (void)
+{
+    cmt_timer_t  * p_list;
+    cmt_timer_t  * p_timer;
+    uint32_t       level;
+    uint32_t       shift;
+
+    g_cmt_timer_now++;
+
+    for (level = 1; level < CMT_RX_CFG_TIMER_LEVELS; level++)
+    {
+        shift = CMT_RX_CFG_TIMER_SLOT_BITS * level;
+
+        /* A level comes round when the tick bits of the levels below are all 0. */
+        if ((g_cmt_timer_now & ((1UL << shift) - 1)) != 0)
+        {
+            break;
+        }
+
+        /* Move the slot to a local list so timers placed again cannot land back in it. */
+        p_list = g_cmt_timer_slots[level][(g_cmt_timer_now >> shift) & CMT_TIMER_SLOT_MASK];
+        g_cmt_timer_slots[level][(g_cmt_timer_now >> shift) & CMT_TIMER_SLOT_MASK] = NULL;
+
+        if (NULL != p_list)
+        {
+            p_list->pp_prev = &p_list;
+        }
+
+        while (NULL != p_list)
+        {
+            p_timer = p_list;
+            cmt_timer_unlink(p_timer);
+            cmt_timer_insert(p_timer);
+        }
+    }
+
+    /* Timers due now. A callback may cancel or start any timer, including ones still in this list. */
+    p_list = g_cmt_timer_slots[0][g_cmt_timer_now & CMT_TIMER_SLOT_MASK];
+    g_cmt_timer_slots[0][g_cmt_timer_now & CMT_TIMER_SLOT_MASK] = NULL;
+
+    if (NULL != p_list)
+    {
+        p_list->pp_prev = &p_list;
+    }
+
+    while (NULL != p_list)
+    {
+        p_timer = p_list;
+        cmt_timer_unlink(p_timer);
+
+        if (0 != p_timer->period)
+        {
+            p_timer->expires += p_timer->period;
+
+            /* Skip callbacks that were missed. */
+            if ((int32_t)(p_timer->expires - g_cmt_timer_now) <= 0)
+            {
+                p_timer->expires = g_cmt_timer_now + 1;
+            }
+
+            /* Placed again before the callback so the callback can cancel it. */
+            cmt_timer_insert(p_timer);
+        }
+
+        p_timer->callback(p_timer->pdata);
+    }
+}
+
+/***********************************************************************************************************************
+* Function Name: cmt_timer_elapsed
+* Description  : Returns the whole ticks counted by the channel that have not yet been taken into the timer wheel. These
+*                are only there in tickless mode, outside of the CMT interrupt. Must be called with interrupts disabled.
+* Arguments    : none
+* Return Value : Ticks counted but not yet taken into the wheel.
+***********************************************************************************************************************/
+static uint32_t cmt_timer_elapsed (void)
+{
+#if CMT_RX_CFG_TIMER_TICKLESS == 1
+    int32_t counts;
+
+    if (true == g_cmt_timer_running)
+    {
+        /* The wheel is being moved on, ticks are taken in when it is done. */
+        return 0;
+    }
+
+    counts = (int32_t)(*g_cmt_channels[g_cmt_timer_channel]).CMCNT;
+
+    if (true == cmt_match_pending(g_cmt_timer_channel))
+    {
+        /* The counter has gone back to 0 since the wheel was last moved on. Read it again, as it may have gone back to
+           0 after the first read. */
+        counts = (int32_t)(*g_cmt_channels[g_cmt_timer_channel]).CMCNT +
+                 (int32_t)(*g_cmt_channels[g_cmt_timer_channel]).CMCOR + 1;
+    }
+
+    return (uint32_t)(counts - g_cmt_timer_base) / g_cmt_timer_counts_per_tick;
+#else
+    /* The wheel is moved on each tick. */
+    return 0;
+#endif
+}
+
+#if CMT_RX_CFG_TIMER_TICKLESS == 1
+/***********************************************************************************************************************
+* Function Name: cmt_timer_next_event
+* Description  : Finds how many ticks from now the wheel next has something to do. That is the first non-empty slot at
+*                level 0, or the time the first non-empty slot of a higher level is placed again at lower levels.
+* Arguments    : none
+* Return Value : Ticks until the next event, or CMT_TIMER_NO_EVENT if no timers are pending.
+***********************************************************************************************************************/
+static uint32_t cmt_timer_next_event (void)
+{
+    uint32_t ret = CMT_TIMER_NO_EVENT;
+    uint32_t level;
+    uint32_t shift;
+    uint32_t current;
+    uint32_t ticks;
+    uint32_t i;
+
+    for (level = 0; level < CMT_RX_CFG_TIMER_LEVELS; level++)
+    {
+        shift = CMT_RX_CFG_TIMER_SLOT_BITS * level;
+        current = g_cmt_timer_now >> shift;
+
+        /* The current slot of each level has already been run or placed again, so it comes round next after all the
+           others. */
+        for (i = 1; i <= CMT_TIMER_SLOTS; i++)
+        {
+            if (NULL != g_cmt_timer_slots[level][(current + i) & CMT_TIMER_SLOT_MASK])
+            {
+                ticks = ((current + i) << shift) - g_cmt_timer_now;
+
+                if (ticks < ret)
+                {
+                    ret = ticks;
+                }
+
+                break;
+            }
+        }
+    }
+
+    return ret;
+}
+
+/***********************************************************************************************************************
+* Function Name: cmt_timer_wake
+* Description  : Brings the compare match forward if the wheel has something to do before it. Must be called with
+*                interrupts disabled.
+* Arguments    : ticks -
+*                    Ticks after g_cmt_timer_now that the wheel has something to do.
+* Return Value : none
+***********************************************************************************************************************/
+static void cmt_timer_wake (uint32_t ticks)
+{
+    uint32_t target;
+    uint32_t counts;
+
+    if ((true == g_cmt_timer_running) || (true == cmt_match_pending(g_cmt_timer_channel)))
+    {
+        /* cmt_timer_program() will be called before interrupts are taken again. */
+        return;
+    }
+
+    if (ticks > ((uint32_t)CMT_RX_MAX_TIMER_TICKS / g_cmt_timer_counts_per_tick))
+    {
+        /* Past the end of the counter, so after the current compare match. */
+        return;
+    }
+
+    target = (uint32_t)((g_cmt_timer_base + (int32_t)(ticks * g_cmt_timer_counts_per_tick)) - 1);
+    counts = (uint32_t)(*g_cmt_channels[g_cmt_timer_channel]).CMCNT + g_cmt_timer_margin;
+
+    if (target < counts)
+    {
+        /* Due now or too close to set. Interrupt as soon as possible; cmt_timer_program() sets the rest. */
+        target = counts;
+    }
+
+    if (target < (uint32_t)(*g_cmt_channels[g_cmt_timer_channel]).CMCOR)
+    {
+        (*g_cmt_channels[g_cmt_timer_channel]).CMCOR = (uint16_t)target;
+    }
+}
+
+/***********************************************************************************************************************
+* Function Name: cmt_timer_program
+* Description  : Sets the compare match for the next tick that the wheel has something to do, or for the end of the
+*                counter if that is sooner. Called from the CMT interrupt.
+* Arguments    : none
+* Return Value : none
+***********************************************************************************************************************/
+static void cmt_timer_program (void)
+{
+    uint32_t ticks;
+    uint32_t target;
+    uint32_t counts;
+
+    ticks = cmt_timer_next_event();
+
+    if (ticks > ((uint32_t)(CMT_RX_MAX_TIMER_TICKS - g_cmt_timer_base) / g_cmt_timer_counts_per_tick))
+    {
+        /* Count to the end of the counter. The part tick is taken into account at the next compare match. */
+        target = (uint32_t)CMT_RX_MAX_TIMER_TICKS - 1;
+    }
+    else
+    {
+        target = (uint32_t)((g_cmt_timer_base + (int32_t)(ticks * g_cmt_timer_counts_per_tick)) - 1);
+    }
+
+    counts = (uint32_t)(*g_cmt_channels[g_cmt_timer_channel]).CMCNT + g_cmt_timer_margin;
+
+    if (target < counts)
+    {
+        /* Callbacks took longer than the time to the next event. */
+        target = counts;
+    }
+
+    (*g_cmt_channels[g_cmt_timer_channel]).CMCOR = (uint16_t)target;
+}
+#endif
+#endif
+
+#if CMT_RX_CFG_CLOCK_ENABLE == 1
+/***********************************************************************************************************************
+* Function Name: R_CMT_ClockInit
+* Description  : Starts the microsecond clock. A CMT channel counts PCLK/CMT_RX_CFG_CLOCK_DIVIDER from 0 to 0xFFFF and
+*                its compare match interrupt adds each wrap to a 64-bit count, so the clock does not wrap. One wrap
+*                is still counted correctly if interrupts are disabled when it happens, so interrupts must not be
+*                disabled for longer than a wrap (43.7ms with PCLK/32 and a 48MHz PCLK).
+* Arguments    : none
+* Return Value : true -
+*                    Clock is running (or was already).
+*                false -
+*                    No channel available.
+***********************************************************************************************************************/
+bool R_CMT_ClockInit (void)
+{
+    if (true == g_cmt_clock_ready)
+    {
+        return true;
+    }
+
+    /* Grab state to make sure we do not interfere with another operation. */
+    if (cmt_lock_state() != true)
+    {
+        /* Another operation is already in progress. */
+        return false;
+    }
+
+    /* Was a channel found? */
+    if (true == cmt_find_channel(&g_cmt_clock_channel))
+    {
+        /* Enable peripheral channel. */
+        power_on(g_cmt_clock_channel);
+
+        /* Count the full range of the counter. */
+        (*g_cmt_channels[g_cmt_clock_channel]).CMCOR = (uint16_t)(CMT_RX_MAX_TIMER_TICKS - 1);
+
+        /* Set clock divider to be used. */
+        (*g_cmt_channels[g_cmt_clock_channel]).CMCR.BIT.CKS = CMT_CLOCK_CKS;
+
+        /* Compare match on each wrap. */
+        g_cmt_modes[g_cmt_clock_channel] = CMT_RX_MODE_PERIODIC;
+
+        /* Save callback function to be used. */
+        g_cmt_callbacks[g_cmt_clock_channel] = cmt_clock_isr;
+
+        g_cmt_clock_us = 0;
+        g_cmt_clock_us_fraction = 0;
+
+        /* Start channel counting. */
+        cmt_counter_start(g_cmt_clock_channel);
+
+        g_cmt_clock_ready = true;
+    }
+
+    /* Release state so other operations can be performed. */
+    cmt_unlock_state();
+
+    return g_cmt_clock_ready;
+}
+
+/***********************************************************************************************************************
+* Function Name: R_CMT_ClockNowUs
+* Description  : Returns the microseconds since R_CMT_ClockInit(). Never goes backwards. Can be called from interrupts.
+*                Resolution is 1 count of the channel (0.67us with PCLK/32 and a 48MHz PCLK).
+* Arguments    : none
+* Return Value : Microseconds since R_CMT_ClockInit(), or 0 if the clock is not running.
+***********************************************************************************************************************/
+uint64_t R_CMT_ClockNowUs (void)
+{
+    uint64_t us;
+    uint64_t fraction;
+    uint32_t count;
+    uint32_t psw_i;
+
+    if (false == g_cmt_clock_ready)
+    {
+        return 0;
+    }
+
+    /* The wrap interrupt must not change the totals while they are read. */
+    psw_i = get_psw() & CMT_PSW_I;
+    clrpsw_i();
+
+    us = g_cmt_clock_us;
+    fraction = g_cmt_clock_us_fraction;
+    count = (*g_cmt_channels[g_cmt_clock_channel]).CMCNT;
+
+    if (true == cmt_match_pending(g_cmt_clock_channel))
+    {
+        /* The counter has wrapped but the interrupt has not been taken yet. Read it again, as it may have wrapped after
+           the first read. */
+        count = (*g_cmt_channels[g_cmt_clock_channel]).CMCNT;
+        fraction += CMT_CLOCK_US_PER_WRAP;
+    }
+
+    if (0 != psw_i)
+    {
+        setpsw_i();
+    }
+
+    fraction += (uint64_t)count * CMT_CLOCK_US_PER_COUNT;
+
+    return us + (fraction >> 32);
+}
+
+/***********************************************************************************************************************
+* Function Name: R_CMT_ClockElapsedUs
+* Description  : Returns the microseconds since an earlier R_CMT_ClockNowUs(). Can be called from interrupts.
+* Arguments    : start_us -
+*                    Value returned by R_CMT_ClockNowUs() at the start.
+* Return Value : Microseconds since start_us.
+***********************************************************************************************************************/
+uint64_t R_CMT_ClockElapsedUs (uint64_t start_us)
+{
+    return R_CMT_ClockNowUs() - start_us;
+}
+
+/***********************************************************************************************************************
+* Function Name: R_CMT_ClockDeadlineUs
+* Description  : Returns the clock value a timeout from now, for use with R_CMT_ClockExpired(). Can be called from
+*                interrupts.
+* Arguments    : timeout_us -
+*                    Microseconds from now.
+* Return Value : Clock value of the deadline.
+***********************************************************************************************************************/
+uint64_t R_CMT_ClockDeadlineUs (uint32_t timeout_us)
+{
+    return R_CMT_ClockNowUs() + timeout_us;
+}
+
+/***********************************************************************************************************************
+* Function Name: R_CMT_ClockExpired
+* Description  : Checks if a deadline from R_CMT_ClockDeadlineUs() has passed. The clock does not wrap so a plain
+*                compare is used. Can be called from interrupts.
+* Arguments    : deadline_us -
+*                    Value returned by R_CMT_ClockDeadlineUs().
+* Return Value : true -
+*                    Deadline has passed.
+*                false -
+*                    Deadline has not passed, or the clock is not running.
+***********************************************************************************************************************/
+bool R_CMT_ClockExpired (uint64_t deadline_us)
+{
+    return (R_CMT_ClockNowUs() >= deadline_us) && (true == g_cmt_clock_ready);
+}
+
+/***********************************************************************************************************************
+* Function Name: cmt_clock_isr
+* Description  : Callback for the clock channel. Adds a counter wrap to the totals.
+* Arguments    : pdata -
+*                    Channel number (not used).
+* Return Value : none
+***********************************************************************************************************************/
+static void cmt_clock_isr (void * pdata)
+{
+    uint64_t fraction;
+
+    fraction = (uint64_t)g_cmt_clock_us_fraction + CMT_CLOCK_US_PER_WRAP;
+
+    g_cmt_clock_us += fraction >> 32;
+    g_cmt_clock_us_fraction = (uint32_t)fraction;
+}
+#endif
+
 /***********************************************************************************************************************
 * Function Name: cmt_create
 * Description  : Sets up a CMT channel based on user input options.
@@ -516,12 +1448,42 @@ static void power_off (uint32_t channel)
 ***********************************************************************************************************************/
 static void cmt_counter_start (uint32_t channel)
 {
-    /* Enable compare match interurpt. */
-    (*g_cmt_channels[channel]).CMCR.BIT.CMIE = 1;
-
     /* Clear counter. */
     (*g_cmt_channels[channel]).CMCNT = 0;
 
+    /* Free running channels do not use the compare match interrupt. */
+    if (CMT_RX_MODE_FREE_RUNNING == g_cmt_modes[channel])
+    {
+        /* Disable compare match interrupt. */
+        (*g_cmt_channels[channel]).CMCR.BIT.CMIE = 0;
+
+        switch (channel)
+        {
+            case 0:
+                CMT.CMSTR0.BIT.STR0 = 1;
+            break;
+            case 1:
+                CMT.CMSTR0.BIT.STR1 = 1;
+            break;
+#if   CMT_RX_NUM_CHANNELS == 4
+            case 2:
+                CMT.CMSTR1.BIT.STR2 = 1;
+            break;
+            case 3:
+                CMT.CMSTR1.BIT.STR3 = 1;
+            break;
+#endif
+            default:
+                /* Should never get here. Valid channel number is checked above. */
+            break;
+        }
+
+        return;
+    }
+
+    /* Enable compare match interurpt. */
+    (*g_cmt_channels[channel]).CMCR.BIT.CMIE = 1;
+
     /* Start counter channel. */
     switch (channel)
     {
@@ -670,6 +1632,47 @@ static bool cmt_setup_channel (uint32_t channel, uint32_t frequency_hz)
     return ret;
 }
 
+#if ((CMT_RX_CFG_TIMER_ENABLE == 1) && (CMT_RX_CFG_TIMER_TICKLESS == 1)) || (CMT_RX_CFG_CLOCK_ENABLE == 1)
+/***********************************************************************************************************************
+* Function Name: cmt_match_pending
+* Description  : Checks if a channel has a compare match interrupt waiting to be taken. Used to see if the counter has
+*                gone back to 0 while interrupts are disabled.
+* Arguments    : channel -
+*                    Which channel to check.
+* Return Value : true -
+*                    Interrupt is waiting.
+*                false -
+*                    No interrupt waiting.
+***********************************************************************************************************************/
+static bool cmt_match_pending (uint32_t channel)
+{
+    bool ret = false;
+
+    switch (channel)
+    {
+        case 0:
+            ret = (1 == IR(CMT0, CMI0));
+        break;
+        case 1:
+            ret = (1 == IR(CMT1, CMI1));
+        break;
+#if   CMT_RX_NUM_CHANNELS == 4
+        case 2:
+            ret = (1 == IR(CMT2, CMI2));
+        break;
+        case 3:
+            ret = (1 == IR(CMT3, CMI3));
+        break;
+#endif
+        default:
+            /* Should never get here. Channel was found by cmt_find_channel(). */
+        break;
+    }
+
+    return ret;
+}
+#endif
+
 /***********************************************************************************************************************
 * Function Name: R_CMT_GetVersion
 * Description  : Returns the current version of this module. The version number is encoded where the top 2 bytes are the
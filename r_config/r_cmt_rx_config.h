@@ -27,6 +27,9 @@
 *                              API did have to change.
 *         : 07.11.2012 1.30    Updated to be compliant with FIT Module Spec v1.00. Added R_CMT_CreateOneShot() function.                               
 *         : 14.12.2012 1.40    Added support for RX111. Completed updates to FIT 1.0 spec to support hardware locking.
+*         : 19.10.2026 1.70    Added timer wheel options.
+*         : 19.10.2026 1.80    Added microsecond clock options.
+*         : 19.10.2026 1.90    Microsecond clock is not included by default.
 ***********************************************************************************************************************/
 #ifndef CMT_CONFIG_HEADER_FILE
 #define CMT_CONFIG_HEADER_FILE
@@ -37,6 +40,41 @@ Configuration Options
 /* The interrupt priority level to be used for CMT interrupts. */
 #define CMT_RX_CFG_IPR         (5)
 
+/* Whether to include the timer wheel (R_CMT_TimerInit() and friends). Any number of software timers share one CMT
+   channel. Starting and cancelling a timer take the same time however many timers there are.
+   '0' means do not include the timer wheel.
+   '1' means include the timer wheel. */
+#define CMT_RX_CFG_TIMER_ENABLE         (0)
+
+/* Bits of the tick count handled by each level of the timer wheel. Each level has 2^bits slots and each slot uses 4
+   bytes of RAM. */
+#define CMT_RX_CFG_TIMER_SLOT_BITS      (5)
+
+/* Number of levels in the timer wheel. Timers up to 2^(bits x levels) - 1 ticks away are placed directly. Timers
+   further away are placed again as time goes by. Bits x levels must not be more than 30. */
+#define CMT_RX_CFG_TIMER_LEVELS         (4)
+
+/* Whether the timer wheel channel interrupts on every tick or only when the next timer is due.
+   '0' means interrupt on every tick.
+   '1' means interrupt only when the next timer is due (tickless). The channel uses the slowest PCLK divider that gives
+       a whole number of counts per tick. With a 48MHz PCLK and 1kHz ticks that is PCLK/128, and the channel sleeps for
+       up to 174 ticks at a time. */
+#define CMT_RX_CFG_TIMER_TICKLESS       (1)
+
+/* Whether to include the microsecond clock (R_CMT_ClockInit() and friends). The clock takes a CMT channel once
+   R_CMT_ClockInit() is called.
+   '0' means do not include the clock.
+   '1' means include the clock. */
+#define CMT_RX_CFG_CLOCK_ENABLE         (0)
+
+/* PCLK divider for the clock channel: 8, 32, 128 or 512. A smaller divider gives a finer resolution but the counter
+   wraps more often, and interrupts must not be disabled for longer than a wrap. With a 48MHz PCLK:
+   8   - 0.17us resolution, wraps every 10.9ms.
+   32  - 0.67us resolution, wraps every 43.7ms.
+   128 - 2.67us resolution, wraps every 175ms.
+   512 - 10.7us resolution, wraps every 699ms. */
+#define CMT_RX_CFG_CLOCK_DIVIDER        (32)
+
 #endif /* CMT_CONFIG_HEADER_FILE */
 
 
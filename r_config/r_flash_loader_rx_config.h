@@ -47,7 +47,9 @@ Configuration Options
    time for each tick is 20ms. */
 #define FL_CFG_TIMEOUT_TICKS                (100)
 
-/* Number of load file slots available. */
+/* Number of load file slots available. Any number of slots can be used as long as they fit in memory. The addresses 
+   of the slots are generated at init. When more than one slot holds a valid image the image with the highest 
+   'generation' in its header is used. */
 #define FL_CFG_MEM_NUM_LOAD_IMAGES          (1)
 
 /* Starting address of where Flash Loader load images are stored. The address for each load image will be based on this
@@ -64,6 +66,191 @@ Configuration Options
    MCU will deny the request. */
 #define FL_CFG_MEM_MAX_LI_SIZE_BYTES        (0x100000)
 
+/* Erase sector size of the memory holding load images (SF_MEM_MIN_ERASE_BYTES of the SPI flash chip). The slot 
+   directory, delta scratch area and saved profile are laid out after the load images in whole sectors of this size. 
+   Each area must be sector aligned and none may overlap the load images or each other. r_fl_store_manager.c checks 
+   this at build time. */
+#define FL_CFG_MEM_SECTOR_BYTES             (0x1000)
+
+/* Whether to keep a slot directory in memory. The directory is a single page that holds a copy of each slot's load 
+   image header along with the slot's size, CRC and lifecycle state (receiving, complete, installed, bad). When it is
+   present the boot decision only needs one read and slots that are still being downloaded are never verified. If the
+   directory has not been formatted the Bootloader falls back to reading the header from each slot.
+   '0' means do not use the directory.
+   '1' means do use the directory. */
+#define FL_CFG_MEM_DIR_ENABLE               (0)
+
+/* Address in memory of the slot directory. The directory uses one erase sector which must not overlap any load image.
+   The default places it right after the last load image. */
+#define FL_CFG_MEM_DIR_ADDR                 (FL_CFG_MEM_BASE_ADDR + \
+                                             (FL_CFG_MEM_NUM_LOAD_IMAGES * FL_CFG_MEM_MAX_LI_SIZE_BYTES))
+
+/* Address in memory of the scratch area used when installing delta images. Before a MCU flash block is rebuilt its old
+   contents are copied here so the delta can still reference them, and so the block can be finished if the install is
+   cut short. The default is right after the slot directory. */
+#define FL_CFG_DELTA_SCRATCH_ADDR           (FL_CFG_MEM_DIR_ADDR + FL_CFG_MEM_SECTOR_BYTES)
+
+/* Size of the delta scratch area. It must be at least as large as the largest MCU flash erase block (32KB on a 1MB 
+   RX63N) and a whole number of sectors. Delta images with larger blocks are rejected. */
+#define FL_CFG_DELTA_SCRATCH_BYTES          (0x8000)
+
+/* Whether to put a small page cache in front of the memory holding load images. The boot path does several small,
+   scattered reads (load image headers, block headers) that each cost a full command and address phase on the SPI bus.
+   With the cache enabled those reads are served from RAM after the first access. The cache is write-through and any
+   cached page is invalidated when it is written or erased. Reads of FL_CFG_MEM_CACHE_PAGE_BYTES or more bypass the 
+   cache.
+   '0' means do not use the cache.
+   '1' means do use the cache. */
+#define FL_CFG_MEM_CACHE_ENABLE             (0)
+
+/* Number of pages held in the cache. Each page uses FL_CFG_MEM_CACHE_PAGE_BYTES of RAM. */
+#define FL_CFG_MEM_CACHE_NUM_PAGES          (4)
+
+/* Size of each cache page in bytes. This must be a power of 2. */
+#define FL_CFG_MEM_CACHE_PAGE_BYTES         (256)
+
+/* Number of MCU flash erase/program jobs that can be queued (see r_fl_rom_queue.c). When FLASH_API_RX_CFG_ROM_BGO is 
+   enabled in r_flash_api_rx_config.h the jobs run back-to-back from the flash ready interrupt while the Bootloader
+   reads the next data. Without ROM BGO each job runs as soon as it is queued. */
+#define FL_CFG_ROM_QUEUE_LENGTH             (8)
+
+/* MCU flash area holding the Bootloader. fl_rom_queue_erase_range() never erases a block that overlaps this area. 
+   Set FL_CFG_BOOTLOADER_ROM_BYTES to 0 when the Bootloader runs from the User Boot area. */
+#define FL_CFG_BOOTLOADER_ROM_ADDR          (0xFFFF8000)
+#define FL_CFG_BOOTLOADER_ROM_BYTES         (0)
+
+/* Whether to time each MCU flash block erase (see fl_rom_queue_erase_time()). This uses a free running CMT channel.
+   '0' means do not time erases.
+   '1' means do time erases. */
+#define FL_CFG_ROM_ERASE_TIMING_ENABLE      (0)
+
+/* Whether to keep a key-value store in data flash (see r_fl_kv.c). Small values such as boot and install counters are
+   kept here. Each change appends an 8 byte record so nothing is erased on a normal boot.
+   '0' means do not use the key-value store.
+   '1' means do use the key-value store. */
+#define FL_CFG_KV_ENABLE                    (0)
+
+/* First data flash block (0 = DB0) used by the key-value store. Each page of the store is 1 data flash block. The 
+   blocks are erased as the store moves between pages, so the User Application must not keep anything in them. */
+#define FL_CFG_KV_FIRST_DF_BLOCK            (0)
+
+/* Number of data flash blocks used by the key-value store. Must be at least 2. Pages are used in turn so the wear is 
+   spread over all of them. */
+#define FL_CFG_KV_NUM_PAGES                 (4)
+
+/* Number of keys. Keys are numbered 0 to FL_CFG_KV_NUM_KEYS - 1. Each key uses 5 bytes of RAM. */
+#define FL_CFG_KV_NUM_KEYS                  (16)
+
+/* Whether to keep flash operation timing in data flash (see r_fl_stats.c). The Flash API times every erase, ROM program
+   and entry to P/E mode with a free running CMT channel. The number of erases and longest erase of each block and a
+   histogram for each kind of operation are added up over the life of the part. This needs 
+   FLASH_API_RX_CFG_COLLECT_STATS to be defined in r_flash_api_rx_config.h.
+   '0' means do not keep flash timing.
+   '1' means do keep flash timing. */
+#define FL_CFG_STATS_ENABLE                 (0)
+
+/* First data flash block (0 = DB0) used for flash timing. 2 blocks are used and they must not overlap the key-value 
+   store. */
+#define FL_CFG_STATS_FIRST_DF_BLOCK         (4)
+
+/* The part is flagged as aging (FL_KV_KEY_FLASH_AGING is set in the key-value store) when any flash operation times out
+   or an erase of any MCU flash block takes longer than this many microseconds. The Flash API gives up on an erase after
+   1152ms with a 50MHz FCLK. */
+#define FL_CFG_STATS_AGING_ERASE_US         (576000)
+
+/* Number of times an install goes back to the first unfinished MCU flash block and tries again after an erase or 
+   program fails. The FCU is reset with R_FlashReset() before each try. 0 means do not retry. */
+#define FL_CFG_INSTALL_RETRIES              (2)
+
+/* Whether to record install progress in the key-value store (see r_fl_journal.c). An install cut short by power loss
+   or a reset then goes on from the first unfinished MCU flash block on the next boot instead of starting again. For
+   delta images the block being rebuilt is finished from its old contents in FL_CFG_DELTA_SCRATCH_ADDR. Without the 
+   journal a delta install cut short cannot be recovered. This needs FL_CFG_KV_ENABLE.
+   '0' means do not record install progress.
+   '1' means do record install progress. */
+#define FL_CFG_INSTALL_JOURNAL_ENABLE       (0)
+
+/* Whether the Bootloader puts a table of its services at FL_CFG_SERVICES_ADDR (see r_fl_services.c). The User 
+   Application finds it with R_FL_GetServices() and can then use the Bootloader's memory, CRC, Flash API and load image
+   checking code instead of linking its own copies. The Bootloader's linker settings must place the 'FLSERVICES' 
+   section at FL_CFG_SERVICES_ADDR. The services keep their state in the Bootloader's own RAM sections (B, R and 
+   RPFRAM) so the User Application must be linked to leave that RAM free.
+   '0' means there is no services table.
+   '1' means there is a services table. */
+#define FL_CFG_SERVICES_ENABLE              (0)
+
+/* Address of the services table. It must not move once User Applications that use it have shipped. The default is 
+   the end of the User Boot area, just below the User Boot settings. */
+#define FL_CFG_SERVICES_ADDR                (0xFF7FFF80)
+
+/* Whether the Bootloader trusts the result of a check of MCU flash done by the User Application (see r_fl_check.c). 
+   The User Application checks its image a few bytes at a time with fl_check_step() while it runs and saves the result
+   with fl_check_put_record(). While the saved result is a pass for the image in MCU flash the Bootloader only checks
+   the image's header at boot instead of the CRC of all of MCU flash. Any other result, and every install, makes the
+   Bootloader do the full check. This needs FL_CFG_KV_ENABLE.
+   '0' means always do the full check at boot.
+   '1' means trust a passed check saved by the User Application. */
+#define FL_CFG_CHECK_RECORD_ENABLE          (0)
+
+/* Whether to sample where the Bootloader spends its time while it checks and installs a new image (see 
+   r_fl_profile.c). A CMT channel interrupts FL_CFG_PROFILE_HZ times a second and the interrupted PC is counted in a
+   histogram in RAM, which is saved to memory at FL_CFG_PROFILE_MEM_ADDR when the install is done. 
+   utilities\python\r_fl_profile.py turns a copy of that memory into a list of functions using the linker map file.
+   '0' means do not profile.
+   '1' means do profile. */
+#define FL_CFG_PROFILE_ENABLE               (0)
+
+/* Samples per second. A prime number keeps the samples from lining up with work that repeats at a fixed rate. */
+#define FL_CFG_PROFILE_HZ                   (997)
+
+/* Code covered by the histogram. Samples anywhere else are only counted. The default is the User Boot area that the 
+   Bootloader runs from. */
+#define FL_CFG_PROFILE_START                (0xFF7FC000)
+#define FL_CFG_PROFILE_BYTES                (0x4000)
+
+/* Each histogram bucket covers 2^FL_CFG_PROFILE_BUCKET_SHIFT bytes of code and uses 4 bytes of RAM. The default of 4
+   gives 1024 buckets (4KB of RAM) for a 16KB Bootloader. */
+#define FL_CFG_PROFILE_BUCKET_SHIFT         (4)
+
+/* Address in memory where the profile is saved. The sectors it covers are erased before each save. The default is 
+   right after the delta scratch area. */
+#define FL_CFG_PROFILE_MEM_ADDR             (FL_CFG_DELTA_SCRATCH_ADDR + FL_CFG_DELTA_SCRATCH_BYTES)
+
+/* Whether the Bootloader can start the User Application straight out of reset (see r_fl_fast_boot.c). After a boot that
+   found the image in MCU flash good and nothing newer to install, a record for that image is written to data flash. 
+   While the record is there, boots jump to the User Application before the clocks, RAM, ports, CRC and memory are set
+   up. Define BSP_CFG_FAST_BOOT_CALLBACK as fl_fast_boot in r_bsp_config.h so the check is made out of reset. The User
+   Application must call fl_fast_boot_clear() (or the 'fast_boot_clear' service) after storing a new load image, or the
+   Bootloader will not install it. Boots that go straight to the User Application are not counted in the key-value 
+   store.
+   '0' means every boot does the full checks.
+   '1' means boots go straight to a known good User Application. */
+#define FL_CFG_FAST_BOOT_ENABLE             (0)
+
+/* Data flash block (0 = DB0) holding the fast boot record. It must not be used by the key-value store or for flash 
+   timing. */
+#define FL_CFG_FAST_BOOT_DF_BLOCK           (6)
+
+/* Whether the clocks are raised while a new image is checked and installed (see r_fl_clock.c). FCLK and PCLKB are set
+   with FL_CFG_INSTALL_FCK_DIV and FL_CFG_INSTALL_PCKB_DIV, the Flash API is told the new FCLK and the RSPI bit rate is
+   raised to the fastest the SPI flash allows. The clocks from r_bsp_config.h and the RSPI bit rate set by 
+   R_RSPI_Init() are put back before the User Application is started.
+   '0' means the clocks from r_bsp_config.h are used throughout.
+   '1' means installs use the clocks below. */
+#define FL_CFG_INSTALL_CLOCK_ENABLE         (0)
+
+/* FCLK and PCLKB dividers (of the clock selected in r_bsp_config.h) used during an install. They must not be larger 
+   than BSP_CFG_FCK_DIV and BSP_CFG_PCKB_DIV, since Flash API timeouts are worked out from the BSP clocks, and neither 
+   clock may go over 50MHz. With the 192MHz PLL the fastest is /4 (48MHz). A PCLKB divider other than BSP_CFG_PCKB_DIV
+   needs FL_CFG_STATS_ENABLE, FL_CFG_ROM_ERASE_TIMING_ENABLE and FL_CFG_PROFILE_ENABLE set to 0, as they time with 
+   the CMT from BSP_PCLKB_HZ. */
+#define FL_CFG_INSTALL_FCK_DIV              (4)
+#define FL_CFG_INSTALL_PCKB_DIV             (4)
+
+/* Fastest RSPI bit rate the SPI flash takes for the commands the Bootloader uses. The SST25 READ command (0x03) is 
+   good to 25MHz, which gives 24Mbps from a 48MHz PCLKB. */
+#define FL_CFG_INSTALL_RSPI_MAX_HZ          (25000000)
+
 #endif /* FLASH_LOADER_CONFIG_HEADER_FILE */
 
 
@@ -86,6 +86,26 @@
 *                              statements that tested against MCU groups. Now
 *                              have 'targets' directory for easier addition
 *                              of new MCUs. Updated to use r_bsp v2.00.
+*         : 19.10.2026 2.50    Added R_FlashGetRomBlocks() and 
+*                              R_FlashEraseRomRange() so ROM can be erased 
+*                              by address instead of by block number.
+*         : 19.10.2026 2.60    Added R_FlashWriteRomLong() and 
+*                              R_FlashWriteRomStream() which program any 
+*                              amount of ROM with 1 entry to P/E mode per 
+*                              ROM area.
+*         : 19.10.2026 2.70    Added R_FlashStatsInit(), R_FlashStatsGet() 
+*                              and R_FlashStatsClear() for timing flash 
+*                              operations.
+*         : 19.10.2026 2.80    FRAM section only holds code that runs during
+*                              ROM P/E and is copied to RAM on first use.
+*                              Added R_FlashGetCodeSize().
+*         : 19.10.2026 2.90    Added R_FlashClockChanged(). The clock is 
+*                              notified once per P/E area.
+*         : 19.10.2026 2.91    Added R_FlashReset().
+*         : 19.10.2026 2.92    R_FlashWriteRomLong() and R_FlashWriteRomStream()
+*                              need FLASH_API_RX_CFG_ROM_LONG_WRITE.
+*         : 19.10.2026 2.93    R_FlashEraseRomRange() needs 
+*                              FLASH_API_RX_CFG_ROM_ERASE_RANGE.
 ******************************************************************************/
 
 #ifndef _FLASH_API_RX_H
@@ -129,7 +149,7 @@ Macro definitions
 ******************************************************************************/
 /* Version Number of API. */
 #define RX_FLASH_API_VERSION_MAJOR           (2)
-#define RX_FLASH_API_VERSION_MINOR           (40)
+#define RX_FLASH_API_VERSION_MINOR           (91)
 
 /* Pointer definitions for what should be sent in to R_FlashWrite */
 #define FLASH_PTR_TYPE uint32_t
@@ -171,6 +191,65 @@ Macro definitions
 /* 'size' parameter for R_FlashDataAreaBlankCheck */
 #define BLANK_CHECK_ENTIRE_BLOCK     1  
 
+#if defined(FLASH_API_RX_CFG_COLLECT_STATS)
+/* Operations timed by the Flash API. Used as index into flash_stats_t.op[] */
+/* Entering P/E mode, including FCU initialization the first time */
+#define FLASH_STATS_OP_ENTER_PE      (0)
+/* One FCU erase command. A RX63N data flash block takes 64 of these. */
+#define FLASH_STATS_OP_ERASE         (1)
+/* One ROM program command of ROM_PROGRAM_SIZE bytes */
+#define FLASH_STATS_OP_ROM_WRITE     (2)
+/* Number of operations timed */
+#define FLASH_STATS_NUM_OPS          (3)
+
+/* Number of buckets in each histogram. Bucket 0 counts durations of 0 
+   ticks and bucket n counts durations from 2^(n-1) to (2^n)-1 ticks. The
+   last bucket also counts anything longer. */
+#define FLASH_STATS_NUM_BUCKETS      (20)
+
+/* Size of flash_stats_t.block_erases[]. Indexed by block number so data 
+   flash blocks start at BLOCK_DB0. */
+#define FLASH_STATS_NUM_BLOCKS       (BLOCK_DB0 + DF_NUM_BLOCKS)
+#endif
+
+/******************************************************************************
+Typedef definitions
+******************************************************************************/
+/* Supplies data for R_FlashWriteRomStream(). 'flash_addr' is the next ROM
+   address to be programmed. The function places the RAM address of the data
+   for it in '*p_buffer_addr' and returns how many bytes are there. This must
+   be a multiple of ROM_PROGRAM_SIZE. Returning 0 stops programming with 
+   FLASH_FAILURE. The function is called while ROM is in P/E mode so it must
+   execute from RAM and must not read ROM. */
+typedef uint32_t (* flash_producer_t)(uint32_t flash_addr, uint32_t * p_buffer_addr);
+
+#if defined(FLASH_API_RX_CFG_COLLECT_STATS)
+/* Timing of one operation. Durations are in ticks of the counter passed to
+   R_FlashStatsInit(). */
+typedef struct
+{
+    /* Number of times the operation completed */
+    uint32_t count;
+    /* Number of times the operation timed out and the FCU was reset */
+    uint32_t timeouts;
+    /* Longest duration */
+    uint32_t max_ticks;
+    /* Number of durations in each bucket */
+    uint32_t histogram[FLASH_STATS_NUM_BUCKETS];
+} flash_op_stats_t;
+
+/* Everything collected since R_FlashStatsInit() or R_FlashStatsClear() */
+typedef struct
+{
+    /* Timing of each operation, indexed by FLASH_STATS_OP_* */
+    flash_op_stats_t op[FLASH_STATS_NUM_OPS];
+    /* Number of R_FlashErase() calls for each block */
+    uint32_t         block_erases[FLASH_STATS_NUM_BLOCKS];
+    /* Longest R_FlashErase() of each block, adding up all erase commands */
+    uint32_t         block_erase_max_ticks[FLASH_STATS_NUM_BLOCKS];
+} flash_stats_t;
+#endif
+
 /******************************************************************************
 Exported global functions (to be accessed by other files)
 ******************************************************************************/
@@ -178,12 +257,23 @@ uint8_t  R_FlashErase(uint32_t block);
 #if defined(DF_GROUPED_BLOCKS)
 uint8_t  R_FlashEraseRange(uint32_t start_addr, uint32_t bytes);
 #endif
+uint8_t  R_FlashGetRomBlocks(uint32_t start_addr, uint32_t bytes, uint32_t * p_first_block, uint32_t * p_num_blocks);
+#if defined(FLASH_API_RX_CFG_ROM_ERASE_RANGE) && !defined(FLASH_API_RX_CFG_ROM_BGO)
+uint8_t  R_FlashEraseRomRange(uint32_t start_addr, uint32_t bytes);
+#endif
+#if defined(FLASH_API_RX_CFG_ROM_LONG_WRITE) && !defined(FLASH_API_RX_CFG_ROM_BGO)
+uint8_t  R_FlashWriteRomLong(uint32_t flash_addr, uint32_t buffer_addr, uint32_t bytes);
+uint8_t  R_FlashWriteRomStream(uint32_t flash_addr, uint32_t bytes, flash_producer_t producer);
+#endif
 uint8_t  R_FlashWrite(uint32_t flash_addr, uint32_t buffer_addr, uint16_t bytes);
 uint8_t  R_FlashProgramLockBit(uint32_t block);
 uint8_t  R_FlashReadLockBit(uint32_t block);
 uint8_t  R_FlashSetLockBitProtection(uint32_t lock_bit);                       
 uint8_t  R_FlashGetStatus(void);       
 uint32_t R_FlashGetVersion(void);
+uint32_t R_FlashGetCodeSize(void);
+uint8_t  R_FlashClockChanged(uint32_t flash_clock_hz);
+void     R_FlashReset(void);
 /* Data Flash Only Functions */
 void     R_FlashDataAreaAccess(uint16_t read_en_mask, uint16_t write_en_mask);
 uint8_t  R_FlashDataAreaBlankCheck(uint32_t address, uint8_t size);
@@ -205,4 +295,10 @@ void FlashBlankCheckDone(uint8_t result);
 void R_FlashCodeCopy(void);
 #endif
 
+#if defined(FLASH_API_RX_CFG_COLLECT_STATS)
+void                  R_FlashStatsInit(uint32_t counter_addr);
+const flash_stats_t * R_FlashStatsGet(void);
+void                  R_FlashStatsClear(void);
+#endif
+
 #endif /* _FLASH_API_RX_H */
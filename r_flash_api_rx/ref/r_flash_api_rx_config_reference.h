@@ -83,6 +83,13 @@
 *                              statements that tested against MCU groups. Now
 *                              have 'targets' directory for easier addition
 *                              of new MCUs. Updated to use r_bsp v2.00.
+*         : 19.10.2026 2.70    Added FLASH_API_RX_CFG_COLLECT_STATS.
+*         : 19.10.2026 2.80    R_FlashCodeCopy() is called by the API on 
+*                              first use.
+*         : 19.10.2026 2.90    FLASH_API_RX_CFG_COLLECT_STATS is not defined
+*                              by default.
+*         : 19.10.2026 2.91    Added FLASH_API_RX_CFG_ROM_LONG_WRITE.
+*         : 19.10.2026 2.92    Added FLASH_API_RX_CFG_ROM_ERASE_RANGE.
 ******************************************************************************/
 
 #ifndef _FLASH_API_CONFIG_H
@@ -99,11 +106,14 @@ Macro definitions
    Flash. Since this code must be executed from within RAM, the sections
    'PFRAM'(ROM) and 'RPFRAM'(RAM) must be added to the linker settings. Also
    the linker option '-rom=PFRAM=RPFRAM' must be added. Finally, the 
-   initialization of the 'RPFRAM' section must be done before calling a Flash 
-   API function. This can be done by using the R_FlashCodeCopy() function or
+   initialization of the 'RPFRAM' section must be done before code in it 
+   runs. With FLASH_API_RX_CFG_COPY_CODE_BY_API the API does this itself the
+   first time a program, erase or blank check function is called. Otherwise
    you can have it done on reset by adding the section to the 'dbsct.c' file as 
    such:
    { __sectop("PFRAM"), __secend("PFRAM"), __sectop("RPFRAM") } 
+   Only code that runs while ROM is in P/E mode is in the section. Its size
+   is returned by R_FlashGetCodeSize() and shown in the linker map file. 
 
    If this macro is not defined (commented out) then the user does not need to
    setup and initialize the PFRAM and RPFRAM sections. If the user calls the
@@ -173,8 +183,41 @@ Macro definitions
    copy the code over when other RAM sections are initialized. There is now
    the R_FlashCodeCopy() function which does the same thing. Uncomment this 
    macro if you will be using the R_FlashCodeCopy() function. Comment out this
-   macro if you are using the original dbsct.c method. */
+   macro if you are using the original dbsct.c method. The API calls 
+   R_FlashCodeCopy() the first time it is needed so it only has to be called
+   by the user when FLASH_API_RX_CFG_ROM_BGO is enabled. */
 #define FLASH_API_RX_CFG_COPY_CODE_BY_API
 
+/******************************************************************************
+ ENABLE LONG ROM WRITES
+******************************************************************************/
+/* If this is defined then R_FlashWriteRomLong() and R_FlashWriteRomStream()
+   are included. They program any number of bytes with one entry to P/E mode
+   per ROM area instead of one per call to R_FlashWrite(). Their code is in 
+   the FRAM section so leave this commented out if nothing calls them. Not 
+   available with FLASH_API_RX_CFG_ROM_BGO. */
+//#define FLASH_API_RX_CFG_ROM_LONG_WRITE
+
+/******************************************************************************
+ ENABLE ROM ERASES BY ADDRESS RANGE
+******************************************************************************/
+/* If this is defined then R_FlashEraseRomRange() is included. It erases all
+   of the ROM blocks in an address range with one call. Leave this commented 
+   out if nothing calls it. R_FlashGetRomBlocks() is always available. Not 
+   available with FLASH_API_RX_CFG_ROM_BGO. */
+//#define FLASH_API_RX_CFG_ROM_ERASE_RANGE
+
+/******************************************************************************
+ COLLECT TIMING STATISTICS FOR FLASH OPERATIONS
+******************************************************************************/
+/* If this is defined then enter_pe_mode(), every ROM program and every erase
+   command are timed using a free running 16-bit counter chosen with 
+   R_FlashStatsInit(). A count of erases for each block and a histogram of 
+   durations for each operation are kept in RAM and can be read with 
+   R_FlashStatsGet(). Operations started with BGO enabled are not timed. 
+   Comment out this macro to remove the timing code and save about 1KB 
+   of RAM. r_fl_stats.c (FL_CFG_STATS_ENABLE) needs this macro. */
+//#define FLASH_API_RX_CFG_COLLECT_STATS
+
 #endif /* _FLASH_API_CONFIG_H */
 
@@ -0,0 +1,67 @@
+/*******************************************************************************
+* DISCLAIMER
+* This software is supplied by Renesas Electronics Corporation and is only 
+* intended for use with Renesas products. No other uses are authorized. This 
+* software is owned by Renesas Electronics Corporation and is protected under
+* all applicable laws, including copyright laws.
+* THIS SOFTWARE IS PROVIDED "AS IS" AND RENESAS MAKES NO WARRANTIES REGARDING
+* THIS SOFTWARE, WHETHER EXPRESS, IMPLIED OR STATUTORY, INCLUDING BUT NOT
+* LIMITED TO WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE 
+* AND NON-INFRINGEMENT. ALL SUCH WARRANTIES ARE EXPRESSLY DISCLAIMED.
+* TO THE MAXIMUM EXTENT PERMITTED NOT PROHIBITED BY LAW, NEITHER RENESAS 
+* ELECTRONICS CORPORATION NOR ANY OF ITS AFFILIATED COMPANIES SHALL BE LIABLE 
+* FOR ANY DIRECT, INDIRECT, SPECIAL, INCIDENTAL OR CONSEQUENTIAL DAMAGES FOR
+* ANY REASON RELATED TO THIS SOFTWARE, EVEN IF RENESAS OR ITS AFFILIATES HAVE
+* BEEN ADVISED OF THE POSSIBILITY OF SUCH DAMAGES.
+* Renesas reserves the right, without notice, to make changes to this software
+* and to discontinue the availability of this software. By using this software,
+* you agree to the additional terms and conditions found by accessing the 
+* following link:
+* http://www.renesas.com/disclaimer 
+*
+* Copyright (C) 2013 Renesas Electronics Corporation. All rights reserved.    
+*******************************************************************************/
+/******************************************************************************
+* File Name    : machine.h
+* Device       : RX631, RX63N
+* Tool-Chain   : GCC (Linux x86-64)
+* H/W Platform : PC, with r_flash_sim.c standing in for the FCU
+* Description  : Stands in for the CC-RX intrinsic functions when the Flash API
+*                is built for a PC. There are no interrupts to mask.
+*******************************************************************************
+* History : DD.MM.YYYY Version Description
+*         : 19.10.2026 1.00    First Release
+*         : 19.10.2026 1.10    Added the section operators. APPHEADER_1 is 
+*                              where the Flash Loader's link map puts it.
+******************************************************************************/
+
+#ifndef MACHINE_H
+#define MACHINE_H
+
+/******************************************************************************
+Includes   <System Includes> , "Project Includes"
+******************************************************************************/
+/* Used for uintptr_t. */
+#include <stdint.h>
+
+/******************************************************************************
+Macro definitions
+******************************************************************************/
+#define nop()                         ((void)0)
+#define wait()                        ((void)0)
+#define brk()                         ((void)0)
+#define setpsw_i()                    ((void)0)
+#define clrpsw_i()                    ((void)0)
+#define get_psw()                     (0u)
+#define set_ipl(level)                ((void)0)
+#define get_ipl()                     (0u)
+
+/* Section operators. Only the sections the Flash Loader looks up have an 
+   address: its image header, 0x200 bytes below the top of ROM. */
+#define __sectop(name)                                                       \
+    ((void *)(uintptr_t)((__builtin_strcmp((name), "APPHEADER_1") == 0) ?     \
+                         0xFFFFFE00u : 0u))
+#define __secend(name)                ((void *)0)
+#define __secsize(name)               (0)
+
+#endif /* MACHINE_H */
@@ -0,0 +1,92 @@
+/*******************************************************************************
+* DISCLAIMER
+* This software is supplied by Renesas Electronics Corporation and is only 
+* intended for use with Renesas products. No other uses are authorized. This 
+* software is owned by Renesas Electronics Corporation and is protected under
+* all applicable laws, including copyright laws.
+* THIS SOFTWARE IS PROVIDED "AS IS" AND RENESAS MAKES NO WARRANTIES REGARDING
+* THIS SOFTWARE, WHETHER EXPRESS, IMPLIED OR STATUTORY, INCLUDING BUT NOT
+* LIMITED TO WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE 
+* AND NON-INFRINGEMENT. ALL SUCH WARRANTIES ARE EXPRESSLY DISCLAIMED.
+* TO THE MAXIMUM EXTENT PERMITTED NOT PROHIBITED BY LAW, NEITHER RENESAS 
+* ELECTRONICS CORPORATION NOR ANY OF ITS AFFILIATED COMPANIES SHALL BE LIABLE 
+* FOR ANY DIRECT, INDIRECT, SPECIAL, INCIDENTAL OR CONSEQUENTIAL DAMAGES FOR
+* ANY REASON RELATED TO THIS SOFTWARE, EVEN IF RENESAS OR ITS AFFILIATES HAVE
+* BEEN ADVISED OF THE POSSIBILITY OF SUCH DAMAGES.
+* Renesas reserves the right, without notice, to make changes to this software
+* and to discontinue the availability of this software. By using this software,
+* you agree to the additional terms and conditions found by accessing the 
+* following link:
+* http://www.renesas.com/disclaimer 
+*
+* Copyright (C) 2013 Renesas Electronics Corporation. All rights reserved.    
+*******************************************************************************/
+/******************************************************************************
+* File Name    : platform.h
+* Device       : RX631, RX63N
+* Tool-Chain   : GCC (Linux x86-64)
+* H/W Platform : PC, with r_flash_sim.c standing in for the FCU
+* Description  : Stands in for r_bsp\platform.h when the Flash API is built for
+*                a PC. The MCU and clocks come from r_bsp_config.h as they do
+*                on the board.
+*******************************************************************************
+* History : DD.MM.YYYY Version Description
+*         : 19.10.2026 1.00    First Release
+*         : 19.10.2026 1.10    Section operators moved to machine.h.
+******************************************************************************/
+
+#ifndef PLATFORM_H
+#define PLATFORM_H
+
+/******************************************************************************
+Includes   <System Includes> , "Project Includes"
+******************************************************************************/
+/* Fixed width types support. */
+#include <stdint.h>
+/* Used for bool. */
+#include <stdbool.h>
+
+/******************************************************************************
+Macro definitions
+******************************************************************************/
+/* A platform has been chosen. */
+#define PLATFORM_DEFINED
+
+/* Version Number of r_bsp this stands in for. */
+#define R_BSP_VERSION_MAJOR           (2)
+#define R_BSP_VERSION_MINOR           (00)
+
+/* CC-RX keywords that have no meaning on a PC. Every access on x86-64 is 
+   done at the width of the C type so __evenaccess is not needed. */
+#define __evenaccess
+
+/* Hardware lock of the Flash API */
+#define BSP_LOCK_FLASH                (0)
+
+/******************************************************************************
+Includes   <System Includes> , "Project Includes"
+******************************************************************************/
+/* Section operators */
+#include "machine.h"
+/* MCU group, memory sizes and clock speeds from r_bsp_config.h */
+#include "mcu_info.h"
+/* RX63N registers. The FLASH registers are backed by r_flash_sim.c. */
+#include "iodefine.h"
+
+/******************************************************************************
+Exported global functions (to be accessed by other files)
+******************************************************************************/
+/* There is only one thread of execution so locks always succeed. */
+static inline bool R_BSP_HardwareLock (int32_t hw_index)
+{
+    (void)hw_index;
+    return true;
+}
+
+static inline bool R_BSP_HardwareUnlock (int32_t hw_index)
+{
+    (void)hw_index;
+    return true;
+}
+
+#endif /* PLATFORM_H */
@@ -0,0 +1,2452 @@
+/*******************************************************************************
+* DISCLAIMER
+* This software is supplied by Renesas Electronics Corporation and is only 
+* intended for use with Renesas products. No other uses are authorized. This 
+* software is owned by Renesas Electronics Corporation and is protected under
+* all applicable laws, including copyright laws.
+* THIS SOFTWARE IS PROVIDED "AS IS" AND RENESAS MAKES NO WARRANTIES REGARDING
+* THIS SOFTWARE, WHETHER EXPRESS, IMPLIED OR STATUTORY, INCLUDING BUT NOT
+* LIMITED TO WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE 
+* AND NON-INFRINGEMENT. ALL SUCH WARRANTIES ARE EXPRESSLY DISCLAIMED.
+* TO THE MAXIMUM EXTENT PERMITTED NOT PROHIBITED BY LAW, NEITHER RENESAS 
+* ELECTRONICS CORPORATION NOR ANY OF ITS AFFILIATED COMPANIES SHALL BE LIABLE 
+* FOR ANY DIRECT, INDIRECT, SPECIAL, INCIDENTAL OR CONSEQUENTIAL DAMAGES FOR
+* ANY REASON RELATED TO THIS SOFTWARE, EVEN IF RENESAS OR ITS AFFILIATES HAVE
+* BEEN ADVISED OF THE POSSIBILITY OF SUCH DAMAGES.
+* Renesas reserves the right, without notice, to make changes to this software
+* and to discontinue the availability of this software. By using this software,
+* you agree to the additional terms and conditions found by accessing the 
+* following link:
+* http://www.renesas.com/disclaimer 
+*
+* Copyright (C) 2013 Renesas Electronics Corporation. All rights reserved.    
+*******************************************************************************/
+/******************************************************************************
+* File Name    : r_flash_sim.c
+* Device       : RX631, RX63N
+* Tool-Chain   : GCC (Linux x86-64)
+* H/W Platform : PC
+* Description  : Simulates the FCU, ROM and data flash of the RX63N on a PC.
+*
+*                The Flash API is built unchanged and drives the registers 
+*                in iodefine.h as it does on the part. The FLASH registers,
+*                ROM, data flash and the FCU RAM/firmware areas are mapped at
+*                their RX addresses. Register pages and the ROM and data 
+*                flash windows are write protected. A write to them raises
+*                SIGSEGV, the page is opened and the writing instruction is
+*                single stepped, then SIGTRAP hands the written value to the
+*                FCU model and the page is protected again. Reads of 
+*                registers are not trapped so the model keeps FSTATR0 and
+*                the other registers up to date as it goes.
+*
+*                The FCU model checks the command sequences, keys and 
+*                protection the part does (P/E mode entry, FWEPROR, lock 
+*                bits, DFLRE/DFLWE, the peripheral clock notification, the 
+*                FCU firmware copy) and reports mistakes through FSTATR0 and
+*                FASTAT like the part. ROM and data flash only program 1 
+*                bits to 0. Erased data flash holds random data, as it reads
+*                undefined on the part, and blank checks use what was really
+*                erased. Reads of ROM or data flash the part does not allow
+*                return random data and are counted.
+*
+*                Each operation takes a configurable time. By default the 
+*                operation completes at once and only the simulated time
+*                moves on. Faults can be injected into chosen operations. 
+*                BGO and the FRDYI/FIFERR interrupts are not simulated.
+*
+*                ROM, data flash, wear and statistics are in memory shared
+*                across fork() so each boot of the code under test can run
+*                in a child process and a power loss is the child exiting.
+*******************************************************************************
+* History : DD.MM.YYYY Version Description
+*         : 19.10.2026 1.00    First Release
+*         : 19.10.2026 1.10    Counts writes to the FCU in fcu_writes.
+******************************************************************************/
+
+/******************************************************************************
+Includes   <System Includes> , "Project Includes"
+******************************************************************************/
+/* Needed for memfd_create(), MAP_FIXED_NOREPLACE and REG_ERR */
+#define _GNU_SOURCE
+/* Used for signal handling and single stepping. */
+#include <signal.h>
+/* Used for ucontext_t */
+#include <ucontext.h>
+/* Used for mmap() and mprotect() */
+#include <sys/mman.h>
+/* Used for ftruncate(), sysconf() and _exit() */
+#include <unistd.h>
+/* Used for clock_gettime() */
+#include <time.h>
+/* Used for fprintf() */
+#include <stdio.h>
+/* Used for memcpy(), memcmp() and memset() */
+#include <string.h>
+/* Fixed width types support. */
+#include <stdint.h>
+/* Used for bool. */
+#include <stdbool.h>
+/* Board and MCU definitions, FLASH registers. */
+#include <platform.h>
+/* Flash API block layout and sizes. */
+#include "r_flash_api_rx_if.h"
+/* FCU firmware and FCU RAM addresses. */
+#include "r_flash_api_rx_private.h"
+/* Interface of this file. */
+#include "r_flash_sim.h"
+
+#if !defined(__linux__) || !defined(__x86_64__)
+    #error "r_flash_sim.c single steps through x86-64 Linux signal frames. It only builds for Linux on x86-64."
+#endif
+
+#if !defined(BSP_MCU_RX63N) && !defined(BSP_MCU_RX631)
+    #error "r_flash_sim.c simulates the FCU of the RX631/RX63N."
+#endif
+
+/******************************************************************************
+Macro definitions
+******************************************************************************/
+#if !defined(MAP_FIXED_NOREPLACE)
+    #define MAP_FIXED_NOREPLACE     (0x100000)
+#endif
+
+/* Page size the protection works in */
+#define SIM_PAGE_SIZE           (0x1000u)
+#define SIM_PAGE(addr)          ((uintptr_t)(addr) & ~(uintptr_t)(SIM_PAGE_SIZE - 1))
+
+/* Lowest ROM P/E address and the matching read address */
+#define SIM_ROM_PE_BASE         (0x01000000u - BSP_ROM_SIZE_BYTES)
+#define SIM_ROM_READ_BASE       (0xFF000000u | SIM_ROM_PE_BASE)
+
+/* Units of data flash tracked */
+#define SIM_DF_ERASE_UNITS      (BSP_DATA_FLASH_SIZE_BYTES / DF_ERASE_BLOCK_SIZE)
+#define SIM_DF_PROGRAM_UNITS    (BSP_DATA_FLASH_SIZE_BYTES / DF_PROGRAM_SIZE_SMALL)
+
+/* ICU up to and including the page holding FWEPROR */
+#define SIM_PERIPH_BASE         (0x00087000u)
+#define SIM_PERIPH_SIZE         (0x00006000u)
+
+/* FCU RAM, the simulated time counter and the FCU registers */
+#define SIM_FCU_BASE            (0x007F8000u)
+#define SIM_FCU_SIZE            (0x00008000u)
+
+/* 16-bit counter of simulated microseconds, in the gap after FCU RAM */
+#define SIM_COUNTER_ADDR        (0x007FA000u)
+
+/* Number of pages 1 instruction may touch in simulated areas */
+#define SIM_MAX_ACCESS          (4)
+
+/* Trap flag in EFLAGS */
+#define SIM_EFLAGS_TF           (0x100)
+
+/* Page fault error code bit set for writes */
+#define SIM_PF_WRITE            (0x2)
+
+/* FASTAT bits at their positions on the part. The Flash API only reads and
+   writes FASTAT as a byte. */
+#define SIM_FASTAT_ROMAE        (0x80)
+#define SIM_FASTAT_CMDLK        (0x10)
+#define SIM_FASTAT_DFLAE        (0x08)
+#define SIM_FASTAT_DFLRPE       (0x02)
+#define SIM_FASTAT_DFLWPE       (0x01)
+
+/* Register keys and bits at their positions on the part */
+#define SIM_FENTRYR_KEY         (0xAA00)
+#define SIM_FENTRYD             (0x0080)
+#define SIM_FPROTR_KEY          (0x5500)
+#define SIM_FRESETR_KEY         (0xCC00)
+#define SIM_FCURAME_KEY         (0xC400)
+#define SIM_DFLRE0_KEY          (0x2D00)
+#define SIM_DFLRE1_KEY          (0xD200)
+#define SIM_DFLWE0_KEY          (0x1E00)
+#define SIM_DFLWE1_KEY          (0xE100)
+#define SIM_FWEPROR_ENABLED     (0x01)
+#define SIM_DFLBCCNT_BCSIZE     (0x8000)
+#define SIM_DFLBCCNT_BCADR      (0x07FE)
+
+/* FCU commands */
+#define SIM_CMD_PROGRAM         (0xE8)
+#define SIM_CMD_ERASE           (0x20)
+#define SIM_CMD_READ_CHECK      (0x71)
+#define SIM_CMD_LOCK_BIT        (0x77)
+#define SIM_CMD_NOTIFY          (0xE9)
+#define SIM_CMD_STATUS_CLEAR    (0x50)
+#define SIM_CMD_NORMAL          (0xFF)
+#define SIM_CMD_EXECUTE         (0xD0)
+#define SIM_NOTIFY_WORDS        (3)
+#define SIM_NOTIFY_DATA         (0x0F0F)
+
+/* Valid peripheral clock notification, in MHz */
+#define SIM_PCKA_MIN            (8)
+#define SIM_PCKA_MAX            (50)
+
+/******************************************************************************
+Typedef definitions
+******************************************************************************/
+/* Simulated areas that are trapped */
+typedef enum
+{
+    SIM_REGION_NONE = 0,
+    SIM_REGION_REGS,            /* Pages holding FLASH registers */
+    SIM_REGION_ROM_READ,        /* ROM at its read address */
+    SIM_REGION_ROM_PE,          /* ROM P/E addresses, FCU commands only */
+    SIM_REGION_DF               /* Data flash, reads and FCU commands */
+} sim_region_t;
+
+/* Where the FCU is in a command sequence */
+typedef enum
+{
+    SIM_STATE_IDLE = 0,
+    SIM_STATE_LOCK_READ,        /* Reads of ROM P/E addresses give lock bits */
+    SIM_STATE_PROGRAM_COUNT,    /* Waiting for the number of words */
+    SIM_STATE_PROGRAM_DATA,     /* Waiting for data words */
+    SIM_STATE_PROGRAM_GO,       /* Waiting for 0xD0 */
+    SIM_STATE_ERASE_GO,
+    SIM_STATE_BLANK_GO,
+    SIM_STATE_LOCK_GO,
+    SIM_STATE_NOTIFY_COUNT,
+    SIM_STATE_NOTIFY_DATA,
+    SIM_STATE_NOTIFY_GO
+} sim_state_t;
+
+/* One FCU operation */
+typedef struct
+{
+    flash_sim_op_t         op;
+    /* First P/E address affected and number of bytes */
+    uint32_t               addr;
+    uint32_t               bytes;
+    /* Flash API block number */
+    uint32_t               block;
+    /* Time the operation takes */
+    uint32_t               us;
+    /* Fault injected into this operation */
+    flash_sim_fault_kind_t fault;
+    /* Data to program */
+    uint8_t                data[ROM_PROGRAM_SIZE];
+} sim_op_t;
+
+/* State of the FCU, lost at power off */
+typedef struct
+{
+    sim_state_t     state;
+    /* Address of the first write of the current command */
+    uint32_t        cmd_addr;
+    /* Program data collected so far */
+    uint32_t        words_expected;
+    uint32_t        words;
+    uint32_t        data_addr;
+    uint8_t         data[ROM_PROGRAM_SIZE];
+    /* A valid peripheral clock notification has been done */
+    bool            notified;
+    /* FCU RAM held the firmware when P/E mode was entered */
+    bool            firmware_ok;
+    /* An operation is in progress */
+    bool            busy;
+    /* The operation in progress ends at 'done' in real time */
+    bool            wall;
+    struct timespec done;
+    sim_op_t        op;
+    /* Power was lost during this trap */
+    bool            power_lost;
+} sim_fcu_t;
+
+/* State that lasts across power off and is shared across fork() */
+typedef struct
+{
+    flash_sim_stats_t stats;
+    flash_sim_fault_t fault;
+    /* Matching operations seen since the fault was set */
+    uint32_t          fault_matches;
+    /* The fault has happened */
+    bool              fault_done;
+    /* Simulated time */
+    uint64_t          now_us;
+    /* State of the random number generator */
+    uint32_t          random;
+    /* Erases done on each ROM block and each data flash erase unit */
+    uint32_t          rom_erases[ROM_NUM_BLOCKS];
+    uint32_t          df_erases[SIM_DF_ERASE_UNITS];
+    /* Lock bit programmed, per ROM block */
+    uint8_t           rom_locked[ROM_NUM_BLOCKS];
+    /* Bit per data flash program unit, set while erased */
+    uint8_t           df_blank[SIM_DF_PROGRAM_UNITS / 8];
+} sim_shared_t;
+
+/* A simulated page opened for the instruction being single stepped */
+typedef struct
+{
+    uintptr_t    page;
+    sim_region_t region;
+    /* Address written */
+    uintptr_t    addr;
+    bool         read;
+    bool         write;
+    /* 'old' holds the page contents from before the instruction */
+    bool         saved;
+    /* Page contents were replaced with random data for a denied read */
+    bool         swapped;
+    uint8_t      old[SIM_PAGE_SIZE];
+} sim_access_t;
+
+/******************************************************************************
+Private global variables and functions
+******************************************************************************/
+/* Configuration given to R_FlashSimInit() */
+static flash_sim_config_t g_sim_cfg;
+/* True once R_FlashSimInit() has succeeded */
+static bool               g_sim_ready = false;
+/* Writable views of the ROM and data flash cells */
+static uint8_t          * g_sim_rom;
+static uint8_t          * g_sim_df;
+/* State kept across power off */
+static sim_shared_t     * g_sim_shared;
+/* State of the FCU */
+static sim_fcu_t          g_sim_fcu;
+/* Pages holding FLASH registers */
+static uintptr_t          g_sim_reg_pages[3];
+/* Page holding FSTATR0, read trapped while an operation runs in real time */
+static uintptr_t          g_sim_status_page;
+/* Pages opened for the instruction being single stepped */
+static sim_access_t       g_sim_access[SIM_MAX_ACCESS];
+static uint32_t           g_sim_num_access = 0;
+
+/* Start of each ROM area, by FENTRYR bit */
+static const uint32_t g_sim_area_start[NUM_ROM_AREAS] =
+{
+    ROM_AREA_0, ROM_AREA_1, ROM_AREA_2, ROM_AREA_3
+};
+
+/* ROM blocks from the top of ROM down, as on the part */
+static const struct
+{
+    uint32_t count;
+    uint32_t size;
+} g_sim_rom_layout[] =
+{
+    {  8, 0x1000  },
+    { 30, 0x4000  },
+    { 16, 0x8000  },
+    { 16, 0x10000 }
+};
+
+static bool         sim_map(uintptr_t addr, size_t size, int prot, int flags, int fd, off_t offset);
+static uint32_t     sim_random(void);
+static void         sim_fill_random(uint8_t * p_dst, uint32_t bytes);
+static uint64_t     sim_now_ns(void);
+static sim_region_t sim_region_find(uintptr_t addr);
+static int          sim_page_prot(sim_region_t region, uintptr_t page);
+static void         sim_regs_open(void);
+static void         sim_regs_close(void);
+static void         sim_protect_rom(void);
+static uint32_t     sim_rom_block(uint32_t addr, uint32_t * p_start, uint32_t * p_size);
+static bool         sim_rom_in_pe(uint32_t addr);
+static bool         sim_df_enabled(uint16_t reg0, uint16_t reg1, uint32_t addr);
+static bool         sim_df_is_blank(uint32_t addr, uint32_t bytes);
+static void         sim_df_set_blank(uint32_t addr, uint32_t bytes, bool blank);
+static uint8_t    * sim_cells(uint32_t addr);
+static uint32_t     sim_wear(uint32_t us, uint32_t erases);
+static void         sim_illegal(uint8_t cause);
+static void         sim_access_error(uint8_t cause);
+static bool         sim_command_locked(void);
+static void         sim_status_clear(void);
+static void         sim_fcu_reset(void);
+static void         sim_command(uint32_t addr, uint16_t value);
+static void         sim_execute(uint32_t addr);
+static void         sim_op_start(sim_op_t * p_op);
+static void         sim_op_finish(void);
+static void         sim_op_partial(void);
+static void         sim_op_flip(void);
+static void         sim_update(void);
+static flash_sim_fault_kind_t sim_fault_check(const sim_op_t * p_op);
+static void         sim_reg_write(sim_access_t * p_acc);
+static void         sim_read_prepare(sim_access_t * p_acc, uintptr_t addr);
+static void         sim_save(sim_access_t * p_acc);
+static void         sim_restore(sim_access_t * p_acc);
+static void         sim_segv_handler(int signo, siginfo_t * p_info, void * p_context);
+static void         sim_trap_handler(int signo, siginfo_t * p_info, void * p_context);
+
+/******************************************************************************
+* Function Name: R_FlashSimDefaultConfig
+* Description  : Fills in a configuration with the default timing. Op times 
+*                are in the range of the typical times for the RX63N; the 
+*                maximums the Flash API waits for are in 
+*                targets\rx63n\r_flash_api_rx63n.h.
+* Arguments    : p_cfg - 
+*                    Configuration to fill in
+* Return Value : none
+******************************************************************************/
+void R_FlashSimDefaultConfig (flash_sim_config_t * p_cfg)
+{
+    memset(p_cfg, 0, sizeof(flash_sim_config_t));
+
+    p_cfg->rom_program_us       = 2000;
+    p_cfg->rom_erase_us_per_kb  = 6000;
+    p_cfg->df_program_us        = 400;
+    p_cfg->df_erase_us          = 3000;
+    p_cfg->blank_check_us       = 30;
+    p_cfg->blank_check_block_us = 700;
+    p_cfg->notify_us            = 10;
+    p_cfg->lock_bit_us          = 2000;
+    p_cfg->fclk_hz              = BSP_FCLK_HZ;
+    p_cfg->seed                 = 1;
+}
+/******************************************************************************
+End of function  R_FlashSimDefaultConfig
+******************************************************************************/
+
+/******************************************************************************
+* Function Name: R_FlashSimInit
+* Description  : Maps the simulated part at its RX addresses and installs the
+*                SIGSEGV and SIGTRAP handlers. ROM starts erased, data flash
+*                starts erased (random) and the FCU is in its power on state.
+*                Call once, before any Flash API function. The program must 
+*                be linked so that nothing else is below 0x01000000 or at 
+*                the top of the 32-bit address space, see readme.txt.
+* Arguments    : p_cfg - 
+*                    Configuration, or NULL for R_FlashSimDefaultConfig()
+* Return Value : true - 
+*                    Simulation is running
+*                false - 
+*                    Could not map the part
+******************************************************************************/
+bool R_FlashSimInit (const flash_sim_config_t * p_cfg)
+{
+    /* Backs ROM and data flash */
+    int              fd;
+    /* Used to install the handlers */
+    struct sigaction action;
+    /* Loop counter */
+    uint32_t         i;
+
+    if (true == g_sim_ready)
+    {
+        return true;
+    }
+
+    if (NULL == p_cfg)
+    {
+        R_FlashSimDefaultConfig(&g_sim_cfg);
+    }
+    else
+    {
+        g_sim_cfg = *p_cfg;
+    }
+
+    /* The FLASH registers must be on the pages this file traps */
+    g_sim_reg_pages[0] = SIM_PAGE(&FLASH.FWEPROR);
+    g_sim_reg_pages[1] = SIM_PAGE(&FLASH.FMODR);
+    g_sim_reg_pages[2] = SIM_PAGE(&FLASH.FSTATR0);
+    g_sim_status_page  = g_sim_reg_pages[2];
+
+    if ((SIM_PAGE_SIZE != (uint32_t)sysconf(_SC_PAGESIZE)) ||
+        (g_sim_reg_pages[1] != SIM_PAGE(&FLASH.FCURAME)) ||
+        (g_sim_reg_pages[2] != SIM_PAGE(&FLASH.PCKAR)) ||
+        (g_sim_reg_pages[0] <  SIM_PERIPH_BASE) ||
+        (g_sim_reg_pages[0] >= (SIM_PERIPH_BASE + SIM_PERIPH_SIZE)))
+    {
+        fprintf(stderr, "flash sim: unexpected page size or FLASH register layout\n");
+        return false;
+    }
+
+    /* ROM followed by data flash, mapped at both their RX addresses and 
+       writable for this file. */
+    fd = memfd_create("flash_sim", 0);
+
+    if ((fd < 0) || 
+        (0 != ftruncate(fd, BSP_ROM_SIZE_BYTES + BSP_DATA_FLASH_SIZE_BYTES)))
+    {
+        fprintf(stderr, "flash sim: cannot create ROM and data flash\n");
+        return false;
+    }
+
+    g_sim_rom = mmap(NULL, BSP_ROM_SIZE_BYTES + BSP_DATA_FLASH_SIZE_BYTES, 
+                     PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    g_sim_shared = mmap(NULL, sizeof(sim_shared_t), PROT_READ | PROT_WRITE, 
+                        MAP_SHARED | MAP_ANONYMOUS, -1, 0);
+
+    if ((MAP_FAILED == g_sim_rom) || (MAP_FAILED == g_sim_shared))
+    {
+        fprintf(stderr, "flash sim: out of memory\n");
+        return false;
+    }
+
+    g_sim_df = g_sim_rom + BSP_ROM_SIZE_BYTES;
+
+    if ((false == sim_map(SIM_ROM_READ_BASE, BSP_ROM_SIZE_BYTES, PROT_READ,
+                          MAP_SHARED, fd, 0)) ||
+        (false == sim_map(DF_ADDRESS, BSP_DATA_FLASH_SIZE_BYTES, PROT_NONE,
+                          MAP_SHARED, fd, BSP_ROM_SIZE_BYTES)) ||
+        (false == sim_map(SIM_ROM_PE_BASE, BSP_ROM_SIZE_BYTES, PROT_NONE,
+                          MAP_PRIVATE | MAP_ANONYMOUS, -1, 0)) ||
+        (false == sim_map(SIM_PERIPH_BASE, SIM_PERIPH_SIZE, 
+                          PROT_READ | PROT_WRITE, 
+                          MAP_PRIVATE | MAP_ANONYMOUS, -1, 0)) ||
+        (false == sim_map(SIM_FCU_BASE, SIM_FCU_SIZE, PROT_READ | PROT_WRITE,
+                          MAP_PRIVATE | MAP_ANONYMOUS, -1, 0)) ||
+        (false == sim_map(FCU_PRG_TOP, FCU_RAM_SIZE, PROT_READ | PROT_WRITE,
+                          MAP_PRIVATE | MAP_ANONYMOUS, -1, 0)))
+    {
+        return false;
+    }
+
+    /* Contents of the FCU firmware area only have to be copied right */
+    g_sim_shared->random = (0 == g_sim_cfg.seed) ? 1 : g_sim_cfg.seed;
+    sim_fill_random((uint8_t *)(uintptr_t)FCU_PRG_TOP, FCU_RAM_SIZE);
+    mprotect((void *)(uintptr_t)FCU_PRG_TOP, FCU_RAM_SIZE, PROT_READ);
+
+    /* ROM is erased. Data flash is erased, which reads as random data. */
+    memset(g_sim_rom, 0xFF, BSP_ROM_SIZE_BYTES);
+    sim_fill_random(g_sim_df, BSP_DATA_FLASH_SIZE_BYTES);
+    sim_df_set_blank(DF_ADDRESS, BSP_DATA_FLASH_SIZE_BYTES, true);
+
+    for (i = 0; i < ROM_NUM_BLOCKS; i++)
+    {
+        g_sim_shared->rom_locked[i] = 0;
+    }
+
+    memset(&action, 0, sizeof(action));
+    action.sa_flags = SA_SIGINFO;
+    sigemptyset(&action.sa_mask);
+
+    action.sa_sigaction = sim_segv_handler;
+    sigaction(SIGSEGV, &action, NULL);
+
+    action.sa_sigaction = sim_trap_handler;
+    sigaction(SIGTRAP, &action, NULL);
+
+    g_sim_ready = true;
+
+    R_FlashSimPowerOn();
+
+    return true;
+}
+/******************************************************************************
+End of function  R_FlashSimInit
+******************************************************************************/
+
+/******************************************************************************
+* Function Name: R_FlashSimPowerOn
+* Description  : Puts the FCU and its registers in their power on state and 
+*                clears FCU RAM. ROM, data flash, wear, statistics and the
+*                fault stay as they are. Static state of the Flash API is not
+*                reset, so code under test is best restarted in a new 
+*                process, see readme.txt.
+* Arguments    : none
+* Return Value : none
+******************************************************************************/
+void R_FlashSimPowerOn (void)
+{
+    memset(&g_sim_fcu, 0, sizeof(g_sim_fcu));
+    g_sim_num_access = 0;
+
+    sim_regs_open();
+
+    memset((void *)g_sim_reg_pages[1], 0, SIM_PAGE_SIZE);
+    memset((void *)g_sim_reg_pages[2], 0, SIM_PAGE_SIZE);
+    memset((void *)(uintptr_t)FCU_RAM_TOP, 0, FCU_RAM_SIZE);
+
+    FLASH.FWEPROR.BYTE = 0x02;
+    FLASH.FSTATR0.BIT.FRDY = 1;
+
+    sim_regs_close();
+    sim_protect_rom();
+}
+/******************************************************************************
+End of function  R_FlashSimPowerOn
+******************************************************************************/
+
+/******************************************************************************
+* Function Name: R_FlashSimSetFault
+* Description  : Sets the fault to inject, replacing any earlier one. 
+* Arguments    : p_fault - 
+*                    Fault to inject, or NULL for none
+* Return Value : none
+******************************************************************************/
+void R_FlashSimSetFault (const flash_sim_fault_t * p_fault)
+{
+    if (NULL == p_fault)
+    {
+        memset(&g_sim_shared->fault, 0, sizeof(flash_sim_fault_t));
+    }
+    else
+    {
+        g_sim_shared->fault = *p_fault;
+    }
+
+    g_sim_shared->fault_matches = 0;
+    g_sim_shared->fault_done = false;
+}
+/******************************************************************************
+End of function  R_FlashSimSetFault
+******************************************************************************/
+
+/******************************************************************************
+* Function Name: R_FlashSimGetStats
+* Description  : Returns what the simulated part has done since 
+*                R_FlashSimInit() or the last R_FlashSimClearStats().
+* Arguments    : p_stats - 
+*                    Filled in with the statistics
+* Return Value : none
+******************************************************************************/
+void R_FlashSimGetStats (flash_sim_stats_t * p_stats)
+{
+    sim_update();
+
+    *p_stats = g_sim_shared->stats;
+}
+/******************************************************************************
+End of function  R_FlashSimGetStats
+******************************************************************************/
+
+/******************************************************************************
+* Function Name: R_FlashSimClearStats
+* Description  : Clears the statistics. Wear and simulated time are kept.
+* Arguments    : none
+* Return Value : none
+******************************************************************************/
+void R_FlashSimClearStats (void)
+{
+    memset(&g_sim_shared->stats, 0, sizeof(flash_sim_stats_t));
+}
+/******************************************************************************
+End of function  R_FlashSimClearStats
+******************************************************************************/
+
+/******************************************************************************
+* Function Name: R_FlashSimTimeUs
+* Description  : Returns the simulated time, which moves on by the time each 
+*                operation takes when it completes.
+* Arguments    : none
+* Return Value : Microseconds since R_FlashSimInit()
+******************************************************************************/
+uint64_t R_FlashSimTimeUs (void)
+{
+    sim_update();
+
+    return g_sim_shared->now_us;
+}
+/******************************************************************************
+End of function  R_FlashSimTimeUs
+******************************************************************************/
+
+/******************************************************************************
+* Function Name: R_FlashSimCounterAddress
+* Description  : Returns the address of a 16-bit counter of simulated 
+*                microseconds that wraps like a CMT channel. Pass it to 
+*                R_FlashStatsInit() to time operations on a PC.
+* Arguments    : none
+* Return Value : Address of the counter
+******************************************************************************/
+uint32_t R_FlashSimCounterAddress (void)
+{
+    return SIM_COUNTER_ADDR;
+}
+/******************************************************************************
+End of function  R_FlashSimCounterAddress
+******************************************************************************/
+
+/******************************************************************************
+* Function Name: R_FlashSimLoad
+* Description  : Writes straight into ROM or data flash, as a flash writer 
+*                would before the code under test runs. Data flash written 
+*                this way is no longer blank.
+* Arguments    : addr - 
+*                    ROM read address or data flash address
+*                p_data - 
+*                    Data to write
+*                bytes - 
+*                    Number of bytes to write
+* Return Value : none
+******************************************************************************/
+void R_FlashSimLoad (uint32_t addr, const void * p_data, uint32_t bytes)
+{
+    if ((addr >= SIM_ROM_READ_BASE) && 
+        ((uint64_t)addr + bytes <= 0x100000000ull))
+    {
+        memcpy(g_sim_rom + (addr - SIM_ROM_READ_BASE), p_data, bytes);
+    }
+    else if ((addr >= DF_ADDRESS) && 
+             ((addr + bytes) <= (DF_ADDRESS + BSP_DATA_FLASH_SIZE_BYTES)))
+    {
+        memcpy(g_sim_df + (addr - DF_ADDRESS), p_data, bytes);
+
+        sim_df_set_blank(addr & ~(uint32_t)(DF_PROGRAM_SIZE_SMALL - 1), 
+                         bytes + (addr & (DF_PROGRAM_SIZE_SMALL - 1)), false);
+    }
+    else
+    {
+        fprintf(stderr, "flash sim: cannot load 0x%08lx bytes at 0x%08lx\n",
+                (unsigned long)bytes, (unsigned long)addr);
+    }
+}
+/******************************************************************************
+End of function  R_FlashSimLoad
+******************************************************************************/
+
+/******************************************************************************
+* Function Name: R_FlashSimRom
+* Description  : Returns a writable view of ROM, lowest address first. Reads 
+*                and writes through it are not checked.
+* Arguments    : none
+* Return Value : ROM contents
+******************************************************************************/
+uint8_t * R_FlashSimRom (void)
+{
+    return g_sim_rom;
+}
+/******************************************************************************
+End of function  R_FlashSimRom
+******************************************************************************/
+
+/******************************************************************************
+* Function Name: R_FlashSimDataFlash
+* Description  : Returns a writable view of data flash. Reads and writes 
+*                through it are not checked and do not change what blank
+*                checks report; use R_FlashSimLoad() to fill data flash.
+* Arguments    : none
+* Return Value : Data flash contents
+******************************************************************************/
+uint8_t * R_FlashSimDataFlash (void)
+{
+    return g_sim_df;
+}
+/******************************************************************************
+End of function  R_FlashSimDataFlash
+******************************************************************************/
+
+/******************************************************************************
+* Function Name: sim_map
+* Description  : Maps memory at a fixed address, failing if anything is 
+*                already there.
+* Arguments    : addr, size, prot, flags, fd, offset - 
+*                    As for mmap()
+* Return Value : true - 
+*                    Mapped
+*                false - 
+*                    Address in use
+******************************************************************************/
+static bool sim_map (uintptr_t addr, size_t size, int prot, int flags, int fd, 
+                     off_t offset)
+{
+    void * p_map;
+
+    p_map = mmap((void *)addr, size, prot, flags | MAP_FIXED_NOREPLACE, fd, 
+                 offset);
+
+    if ((void *)addr != p_map)
+    {
+        fprintf(stderr, "flash sim: 0x%08lx-0x%08lx is in use. Link with "
+                "-no-pie -Wl,-Ttext-segment=0x10000000 and no sanitizers.\n",
+                (unsigned long)addr, (unsigned long)(addr + size - 1));
+
+        if (MAP_FAILED != p_map)
+        {
+            munmap(p_map, size);
+        }
+
+        return false;
+    }
+
+    return true;
+}
+/******************************************************************************
+End of function  sim_map
+******************************************************************************/
+
+/******************************************************************************
+* Function Name: sim_random
+* Description  : Returns the next pseudo random number (xorshift32).
+* Arguments    : none
+* Return Value : Random number
+******************************************************************************/
+static uint32_t sim_random (void)
+{
+    uint32_t x = g_sim_shared->random;
+
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+
+    g_sim_shared->random = x;
+
+    return x;
+}
+/******************************************************************************
+End of function  sim_random
+******************************************************************************/
+
+/******************************************************************************
+* Function Name: sim_fill_random
+* Description  : Fills memory with pseudo random bytes.
+* Arguments    : p_dst - 
+*                    Memory to fill
+*                bytes - 
+*                    Number of bytes
+* Return Value : none
+******************************************************************************/
+static void sim_fill_random (uint8_t * p_dst, uint32_t bytes)
+{
+    while (bytes-- > 0)
+    {
+        *p_dst++ = (uint8_t)sim_random();
+    }
+}
+/******************************************************************************
+End of function  sim_fill_random
+******************************************************************************/
+
+/******************************************************************************
+* Function Name: sim_now_ns
+* Description  : Returns real time.
+* Arguments    : none
+* Return Value : Monotonic time in nanoseconds
+******************************************************************************/
+static uint64_t sim_now_ns (void)
+{
+    struct timespec now;
+
+    clock_gettime(CLOCK_MONOTONIC, &now);
+
+    return ((uint64_t)now.tv_sec * 1000000000ull) + (uint64_t)now.tv_nsec;
+}
+/******************************************************************************
+End of function  sim_now_ns
+******************************************************************************/
+
+/******************************************************************************
+* Function Name: sim_region_find
+* Description  : Finds which trapped area an address is in.
+* Arguments    : addr - 
+*                    Address that faulted
+* Return Value : Area, SIM_REGION_NONE if not one of ours
+******************************************************************************/
+static sim_region_t sim_region_find (uintptr_t addr)
+{
+    uintptr_t page = SIM_PAGE(addr);
+
+    if ((page == g_sim_reg_pages[0]) || (page == g_sim_reg_pages[1]) ||
+        (page == g_sim_reg_pages[2]))
+    {
+        return SIM_REGION_REGS;
+    }
+
+    if ((addr >= SIM_ROM_READ_BASE) && (addr < 0x100000000ull))
+    {
+        return SIM_REGION_ROM_READ;
+    }
+
+    if ((addr >= SIM_ROM_PE_BASE) && (addr < 0x01000000u))
+    {
+        return SIM_REGION_ROM_PE;
+    }
+
+    if ((addr >= DF_ADDRESS) && 
+        (addr < (DF_ADDRESS + BSP_DATA_FLASH_SIZE_BYTES)))
+    {
+        return SIM_REGION_DF;
+    }
+
+    return SIM_REGION_NONE;
+}
+/******************************************************************************
+End of function  sim_region_find
+******************************************************************************/
+
+/******************************************************************************
+* Function Name: sim_page_prot
+* Description  : Returns the protection a trapped page has between accesses.
+* Arguments    : region - 
+*                    Area the page is in
+*                page - 
+*                    Page address
+* Return Value : Protection for mprotect()
+******************************************************************************/
+static int sim_page_prot (sim_region_t region, uintptr_t page)
+{
+    switch (region)
+    {
+        case SIM_REGION_REGS:
+            /* Reads of FSTATR0 are trapped to end operations on time */
+            if ((page == g_sim_status_page) && (true == g_sim_fcu.wall))
+            {
+                return PROT_NONE;
+            }
+            return PROT_READ;
+
+        case SIM_REGION_ROM_READ:
+            /* ROM cannot be read during ROM P/E */
+            if (0 != (FLASH.FENTRYR.WORD & ~SIM_FENTRYD))
+            {
+                return PROT_NONE;
+            }
+            return PROT_READ;
+
+        default:
+            /* Every access to data flash and P/E addresses is checked */
+            return PROT_NONE;
+    }
+}
+/******************************************************************************
+End of function  sim_page_prot
+******************************************************************************/
+
+/******************************************************************************
+* Function Name: sim_regs_open
+* Description  : Lets this file write the FLASH registers.
+* Arguments    : none
+* Return Value : none
+******************************************************************************/
+static void sim_regs_open (void)
+{
+    uint32_t i;
+
+    for (i = 0; i < 3; i++)
+    {
+        mprotect((void *)g_sim_reg_pages[i], SIM_PAGE_SIZE, 
+                 PROT_READ | PROT_WRITE);
+    }
+}
+/******************************************************************************
+End of function  sim_regs_open
+******************************************************************************/
+
+/******************************************************************************
+* Function Name: sim_regs_close
+* Description  : Protects the FLASH register pages again, other than any 
+*                opened for the instruction being single stepped.
+* Arguments    : none
+* Return Value : none
+******************************************************************************/
+static void sim_regs_close (void)
+{
+    uint32_t i;
+    uint32_t j;
+
+    for (i = 0; i < 3; i++)
+    {
+        for (j = 0; j < g_sim_num_access; j++)
+        {
+            if (g_sim_access[j].page == g_sim_reg_pages[i])
+            {
+                break;
+            }
+        }
+
+        if (j == g_sim_num_access)
+        {
+            mprotect((void *)g_sim_reg_pages[i], SIM_PAGE_SIZE, 
+                     sim_page_prot(SIM_REGION_REGS, g_sim_reg_pages[i]));
+        }
+    }
+}
+/******************************************************************************
+End of function  sim_regs_close
+******************************************************************************/
+
+/******************************************************************************
+* Function Name: sim_protect_rom
+* Description  : Sets the protection of ROM at its read address for the 
+*                current mode.
+* Arguments    : none
+* Return Value : none
+******************************************************************************/
+static void sim_protect_rom (void)
+{
+    mprotect((void *)(uintptr_t)SIM_ROM_READ_BASE, BSP_ROM_SIZE_BYTES, 
+             sim_page_prot(SIM_REGION_ROM_READ, SIM_ROM_READ_BASE));
+}
+/******************************************************************************
+End of function  sim_protect_rom
+******************************************************************************/
+
+/******************************************************************************
+* Function Name: sim_rom_block
+* Description  : Finds the ROM block holding a P/E address.
+* Arguments    : addr - 
+*                    ROM P/E address
+*                p_start - 
+*                    Set to the first P/E address of the block
+*                p_size - 
+*                    Set to the size of the block
+* Return Value : Flash API block number
+******************************************************************************/
+static uint32_t sim_rom_block (uint32_t addr, uint32_t * p_start, 
+                               uint32_t * p_size)
+{
+    uint32_t block = 0;
+    uint32_t top = 0x01000000u;
+    uint32_t i;
+    uint32_t j;
+
+    for (i = 0; i < (sizeof(g_sim_rom_layout) / sizeof(g_sim_rom_layout[0])); i++)
+    {
+        for (j = 0; j < g_sim_rom_layout[i].count; j++)
+        {
+            top -= g_sim_rom_layout[i].size;
+
+            if (addr >= top)
+            {
+                *p_start = top;
+                *p_size = g_sim_rom_layout[i].size;
+                return block;
+            }
+
+            block++;
+        }
+    }
+
+    /* Not reached for addresses in ROM */
+    *p_start = top;
+    *p_size = 0;
+    return block;
+}
+/******************************************************************************
+End of function  sim_rom_block
+******************************************************************************/
+
+/******************************************************************************
+* Function Name: sim_rom_in_pe
+* Description  : Checks that a ROM P/E address is in an area in P/E mode.
+* Arguments    : addr - 
+*                    ROM P/E address
+* Return Value : true - 
+*                    The area is in P/E mode
+*                false - 
+*                    It is not
+******************************************************************************/
+static bool sim_rom_in_pe (uint32_t addr)
+{
+    uint32_t area;
+
+    for (area = 0; area < NUM_ROM_AREAS; area++)
+    {
+        if (addr >= g_sim_area_start[area])
+        {
+            return (0 != (FLASH.FENTRYR.WORD & (1u << area)));
+        }
+    }
+
+    return false;
+}
+/******************************************************************************
+End of function  sim_rom_in_pe
+******************************************************************************/
+
+/******************************************************************************
+* Function Name: sim_df_enabled
+* Description  : Checks the DFLRE or DFLWE bit for the data flash block 
+*                holding an address.
+* Arguments    : reg0 - 
+*                    DFLRE0 or DFLWE0
+*                reg1 - 
+*                    DFLRE1 or DFLWE1
+*                addr - 
+*                    Data flash address
+* Return Value : true - 
+*                    Block is enabled
+*                false - 
+*                    It is not
+******************************************************************************/
+static bool sim_df_enabled (uint16_t reg0, uint16_t reg1, uint32_t addr)
+{
+    uint32_t block = (addr - DF_ADDRESS) / DF_BLOCK_SIZE_LARGE;
+    uint16_t bits = (block < 8) ? reg0 : reg1;
+
+    return (0 != (bits & (1u << (block & 7))));
+}
+/******************************************************************************
+End of function  sim_df_enabled
+******************************************************************************/
+
+/******************************************************************************
+* Function Name: sim_df_is_blank
+* Description  : Checks that data flash has been erased and not programmed.
+* Arguments    : addr - 
+*                    Data flash address, program unit aligned
+*                bytes - 
+*                    Number of bytes to check
+* Return Value : true - 
+*                    All blank
+*                false - 
+*                    Something was programmed
+******************************************************************************/
+static bool sim_df_is_blank (uint32_t addr, uint32_t bytes)
+{
+    uint32_t unit = (addr - DF_ADDRESS) / DF_PROGRAM_SIZE_SMALL;
+    uint32_t end = unit + ((bytes + DF_PROGRAM_SIZE_SMALL - 1) / DF_PROGRAM_SIZE_SMALL);
+
+    for ( ; unit < end; unit++)
+    {
+        if (0 == (g_sim_shared->df_blank[unit / 8] & (1u << (unit % 8))))
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+/******************************************************************************
+End of function  sim_df_is_blank
+******************************************************************************/
+
+/******************************************************************************
+* Function Name: sim_df_set_blank
+* Description  : Marks data flash as erased or programmed.
+* Arguments    : addr - 
+*                    Data flash address, program unit aligned
+*                bytes - 
+*                    Number of bytes
+*                blank - 
+*                    true if erased
+* Return Value : none
+******************************************************************************/
+static void sim_df_set_blank (uint32_t addr, uint32_t bytes, bool blank)
+{
+    uint32_t unit = (addr - DF_ADDRESS) / DF_PROGRAM_SIZE_SMALL;
+    uint32_t end = unit + ((bytes + DF_PROGRAM_SIZE_SMALL - 1) / DF_PROGRAM_SIZE_SMALL);
+
+    for ( ; unit < end; unit++)
+    {
+        if (true == blank)
+        {
+            g_sim_shared->df_blank[unit / 8] |= (uint8_t)(1u << (unit % 8));
+        }
+        else
+        {
+            g_sim_shared->df_blank[unit / 8] &= (uint8_t)~(1u << (unit % 8));
+        }
+    }
+}
+/******************************************************************************
+End of function  sim_df_set_blank
+******************************************************************************/
+
+/******************************************************************************
+* Function Name: sim_cells
+* Description  : Returns the writable view of a P/E address.
+* Arguments    : addr - 
+*                    ROM P/E address or data flash address
+* Return Value : Pointer into g_sim_rom or g_sim_df
+******************************************************************************/
+static uint8_t * sim_cells (uint32_t addr)
+{
+    if (addr >= SIM_ROM_PE_BASE)
+    {
+        return g_sim_rom + (addr - SIM_ROM_PE_BASE);
+    }
+
+    return g_sim_df + (addr - DF_ADDRESS);
+}
+/******************************************************************************
+End of function  sim_cells
+******************************************************************************/
+
+/******************************************************************************
+* Function Name: sim_wear
+* Description  : Scales an erase time by the wear of the unit erased.
+* Arguments    : us - 
+*                    Erase time of a new part
+*                erases - 
+*                    Erases the unit has had
+* Return Value : Erase time
+******************************************************************************/
+static uint32_t sim_wear (uint32_t us, uint32_t erases)
+{
+    return us + (uint32_t)(((uint64_t)us * erases * g_sim_cfg.erase_wear_ppm) / 1000000u);
+}
+/******************************************************************************
+End of function  sim_wear
+******************************************************************************/
+
+/******************************************************************************
+* Function Name: sim_illegal
+* Description  : Rejects a command. The FCU goes to the command locked state
+*                until a status clear.
+* Arguments    : cause - 
+*                    FASTAT bits to set as well as CMDLK
+* Return Value : none
+******************************************************************************/
+static void sim_illegal (uint8_t cause)
+{
+    FLASH.FSTATR0.BIT.ILGLERR = 1;
+    FLASH.FASTAT.BYTE |= (uint8_t)(cause | SIM_FASTAT_CMDLK);
+
+    g_sim_fcu.state = SIM_STATE_IDLE;
+    g_sim_shared->stats.illegal_commands++;
+}
+/******************************************************************************
+End of function  sim_illegal
+******************************************************************************/
+
+/******************************************************************************
+* Function Name: sim_access_error
+* Description  : Records a read or write of ROM or data flash that the part 
+*                does not allow. Like an illegal command this locks the FCU.
+* Arguments    : cause - 
+*                    FASTAT bit to set
+* Return Value : none
+******************************************************************************/
+static void sim_access_error (uint8_t cause)
+{
+    FLASH.FSTATR0.BIT.ILGLERR = 1;
+    FLASH.FASTAT.BYTE |= (uint8_t)(cause | SIM_FASTAT_CMDLK);
+
+    g_sim_shared->stats.access_errors++;
+}
+/******************************************************************************
+End of function  sim_access_error
+******************************************************************************/
+
+/******************************************************************************
+* Function Name: sim_command_locked
+* Description  : Checks for the command locked state.
+* Arguments    : none
+* Return Value : true - 
+*                    Only a status clear is accepted
+*                false - 
+*                    Commands are accepted
+******************************************************************************/
+static bool sim_command_locked (void)
+{
+    return ((1 == FLASH.FSTATR0.BIT.ILGLERR) || 
+            (1 == FLASH.FSTATR0.BIT.ERSERR)  ||
+            (1 == FLASH.FSTATR0.BIT.PRGERR));
+}
+/******************************************************************************
+End of function  sim_command_locked
+******************************************************************************/
+
+/******************************************************************************
+* Function Name: sim_status_clear
+* Description  : Carries out the status clear command.
+* Arguments    : none
+* Return Value : none
+******************************************************************************/
+static void sim_status_clear (void)
+{
+    /* With ILGLERR set the access error bits must have been cleared first */
+    if ((1 == FLASH.FSTATR0.BIT.ILGLERR) &&
+        (0 != (FLASH.FASTAT.BYTE & (uint8_t)~SIM_FASTAT_CMDLK)))
+    {
+        return;
+    }
+
+    FLASH.FSTATR0.BIT.ILGLERR = 0;
+    FLASH.FSTATR0.BIT.ERSERR = 0;
+    FLASH.FSTATR0.BIT.PRGERR = 0;
+    FLASH.FASTAT.BYTE = 0;
+
+    g_sim_fcu.state = SIM_STATE_IDLE;
+}
+/******************************************************************************
+End of function  sim_status_clear
+******************************************************************************/
+
+/******************************************************************************
+* Function Name: sim_fcu_reset
+* Description  : Resets the FCU through FRESETR. An operation in progress 
+*                stops part way through.
+* Arguments    : none
+* Return Value : none
+******************************************************************************/
+static void sim_fcu_reset (void)
+{
+    if (true == g_sim_fcu.busy)
+    {
+        sim_op_partial();
+    }
+
+    g_sim_fcu.busy = false;
+    g_sim_fcu.wall = false;
+    g_sim_fcu.state = SIM_STATE_IDLE;
+
+    FLASH.FSTATR0.BYTE = 0;
+    FLASH.FSTATR0.BIT.FRDY = 1;
+    FLASH.FSTATR1.BYTE = 0;
+    FLASH.FASTAT.BYTE = 0;
+    FLASH.DFLBCSTAT.WORD = 0;
+
+    g_sim_shared->stats.fcu_resets++;
+}
+/******************************************************************************
+End of function  sim_fcu_reset
+******************************************************************************/
+
+/******************************************************************************
+* Function Name: sim_command
+* Description  : Takes a write to a ROM P/E address or data flash.
+* Arguments    : addr - 
+*                    P/E address written
+*                value - 
+*                    Word written during data phases, otherwise the byte
+* Return Value : none
+******************************************************************************/
+static void sim_command (uint32_t addr, uint16_t value)
+{
+    uint8_t cmd = (uint8_t)value;
+    bool    df = (addr < SIM_ROM_PE_BASE);
+
+    /* Commands are ignored while the FCU is held in reset */
+    if (0 != (FLASH.FRESETR.WORD & 0x0001))
+    {
+        return;
+    }
+
+    /* Outside P/E mode the part ignores writes to flash */
+    if (0 == FLASH.FENTRYR.WORD)
+    {
+        g_sim_shared->stats.access_errors++;
+        return;
+    }
+
+    /* Commands must go to the area in P/E mode */
+    if (true == df)
+    {
+        if (SIM_FENTRYD != FLASH.FENTRYR.WORD)
+        {
+            sim_illegal(SIM_FASTAT_DFLAE);
+            return;
+        }
+    }
+    else if (false == sim_rom_in_pe(addr))
+    {
+        sim_illegal(SIM_FASTAT_ROMAE);
+        return;
+    }
+
+    if (true == g_sim_fcu.busy)
+    {
+        sim_illegal(0);
+        return;
+    }
+
+    if (true == sim_command_locked())
+    {
+        if (SIM_CMD_STATUS_CLEAR == cmd)
+        {
+            sim_status_clear();
+        }
+        return;
+    }
+
+    switch (g_sim_fcu.state)
+    {
+        case SIM_STATE_IDLE:
+        case SIM_STATE_LOCK_READ:
+            g_sim_fcu.cmd_addr = addr;
+
+            switch (cmd)
+            {
+                case SIM_CMD_PROGRAM:
+                    g_sim_fcu.state = SIM_STATE_PROGRAM_COUNT;
+                    break;
+
+                case SIM_CMD_ERASE:
+                    g_sim_fcu.state = SIM_STATE_ERASE_GO;
+                    break;
+
+                case SIM_CMD_READ_CHECK:
+                    /* Blank check in data flash with FRDMD set, otherwise
+                       lock bit read of ROM */
+                    if ((true == df) && (1 == FLASH.FMODR.BIT.FRDMD))
+                    {
+                        g_sim_fcu.state = SIM_STATE_BLANK_GO;
+                    }
+                    else if ((false == df) && (0 == FLASH.FMODR.BIT.FRDMD))
+                    {
+                        g_sim_fcu.state = SIM_STATE_LOCK_READ;
+                    }
+                    else
+                    {
+                        sim_illegal(0);
+                    }
+                    break;
+
+                case SIM_CMD_LOCK_BIT:
+                    if (true == df)
+                    {
+                        sim_illegal(0);
+                    }
+                    else
+                    {
+                        g_sim_fcu.state = SIM_STATE_LOCK_GO;
+                    }
+                    break;
+
+                case SIM_CMD_NOTIFY:
+                    g_sim_fcu.state = SIM_STATE_NOTIFY_COUNT;
+                    break;
+
+                case SIM_CMD_STATUS_CLEAR:
+                    sim_status_clear();
+                    break;
+
+                case SIM_CMD_NORMAL:
+                    g_sim_fcu.state = SIM_STATE_IDLE;
+                    break;
+
+                default:
+                    sim_illegal(0);
+                    break;
+            }
+            break;
+
+        case SIM_STATE_PROGRAM_COUNT:
+            /* RX63N programs 128 bytes of ROM or 2 bytes of data flash */
+            if (cmd != ((true == df) ? (DF_PROGRAM_SIZE_SMALL / 2) : (ROM_PROGRAM_SIZE / 2)))
+            {
+                sim_illegal(0);
+                break;
+            }
+
+            g_sim_fcu.words_expected = cmd;
+            g_sim_fcu.words = 0;
+            g_sim_fcu.state = SIM_STATE_PROGRAM_DATA;
+            break;
+
+        case SIM_STATE_PROGRAM_DATA:
+            /* The first data write gives the address programmed */
+            if (0 == g_sim_fcu.words)
+            {
+                g_sim_fcu.data_addr = addr;
+            }
+
+            g_sim_fcu.data[(g_sim_fcu.words * 2)]     = (uint8_t)value;
+            g_sim_fcu.data[(g_sim_fcu.words * 2) + 1] = (uint8_t)(value >> 8);
+
+            if (++g_sim_fcu.words == g_sim_fcu.words_expected)
+            {
+                g_sim_fcu.state = SIM_STATE_PROGRAM_GO;
+            }
+            break;
+
+        case SIM_STATE_NOTIFY_COUNT:
+            if (SIM_NOTIFY_WORDS != cmd)
+            {
+                sim_illegal(0);
+                break;
+            }
+
+            g_sim_fcu.words = 0;
+            g_sim_fcu.state = SIM_STATE_NOTIFY_DATA;
+            break;
+
+        case SIM_STATE_NOTIFY_DATA:
+            if (SIM_NOTIFY_DATA != value)
+            {
+                sim_illegal(0);
+                break;
+            }
+
+            if (++g_sim_fcu.words == SIM_NOTIFY_WORDS)
+            {
+                g_sim_fcu.state = SIM_STATE_NOTIFY_GO;
+            }
+            break;
+
+        default:
+            /* Waiting for the execute command */
+            if (SIM_CMD_EXECUTE != cmd)
+            {
+                sim_illegal(0);
+                break;
+            }
+
+            sim_execute(addr);
+            break;
+    }
+}
+/******************************************************************************
+End of function  sim_command
+******************************************************************************/
+
+/******************************************************************************
+* Function Name: sim_execute
+* Description  : Checks and starts the command that 0xD0 was written for.
+* Arguments    : addr - 
+*                    P/E address 0xD0 was written to
+* Return Value : none
+******************************************************************************/
+static void sim_execute (uint32_t addr)
+{
+    sim_op_t    op;
+    sim_state_t state = g_sim_fcu.state;
+    uint32_t    start;
+    uint32_t    size;
+
+    g_sim_fcu.state = SIM_STATE_IDLE;
+
+    memset(&op, 0, sizeof(op));
+
+    if (false == g_sim_fcu.firmware_ok)
+    {
+        /* FCU RAM did not hold the firmware */
+        sim_illegal(0);
+        return;
+    }
+
+    if (SIM_STATE_NOTIFY_GO == state)
+    {
+        uint32_t mhz = FLASH.PCKAR.WORD & 0x00FF;
+
+        if ((mhz < SIM_PCKA_MIN) || (mhz > SIM_PCKA_MAX))
+        {
+            sim_illegal(0);
+            return;
+        }
+
+        if ((0 != g_sim_cfg.fclk_hz) && (mhz != (g_sim_cfg.fclk_hz / 1000000)))
+        {
+            g_sim_shared->stats.clock_mismatches++;
+        }
+
+        op.op = FLASH_SIM_OP_NOTIFY;
+        op.addr = addr;
+        op.us = g_sim_cfg.notify_us;
+        sim_op_start(&op);
+        return;
+    }
+
+    /* Programming, erasing and blank checks need P/E enabled and the clock 
+       notified */
+    if ((SIM_FWEPROR_ENABLED != FLASH.FWEPROR.BYTE) || 
+        (false == g_sim_fcu.notified))
+    {
+        sim_illegal(0);
+        return;
+    }
+
+    switch (state)
+    {
+        case SIM_STATE_PROGRAM_GO:
+            op.addr = g_sim_fcu.data_addr;
+            op.bytes = g_sim_fcu.words * 2;
+            memcpy(op.data, g_sim_fcu.data, op.bytes);
+
+            if ((op.addr & (op.bytes - 1)) != 0)
+            {
+                sim_illegal(0);
+                return;
+            }
+
+            if (op.addr < SIM_ROM_PE_BASE)
+            {
+                op.op = FLASH_SIM_OP_DF_PROGRAM;
+                op.block = BLOCK_DB0 + ((op.addr - DF_ADDRESS) / DF_BLOCK_SIZE_LARGE);
+                op.us = g_sim_cfg.df_program_us;
+            }
+            else
+            {
+                op.op = FLASH_SIM_OP_ROM_PROGRAM;
+                op.block = sim_rom_block(op.addr, &start, &size);
+                op.us = g_sim_cfg.rom_program_us;
+            }
+            break;
+
+        case SIM_STATE_ERASE_GO:
+            if (addr < SIM_ROM_PE_BASE)
+            {
+                op.op = FLASH_SIM_OP_DF_ERASE;
+                op.addr = addr & ~(uint32_t)(DF_ERASE_BLOCK_SIZE - 1);
+                op.bytes = DF_ERASE_BLOCK_SIZE;
+                op.block = BLOCK_DB0 + ((op.addr - DF_ADDRESS) / DF_BLOCK_SIZE_LARGE);
+                op.us = sim_wear(g_sim_cfg.df_erase_us, 
+                           g_sim_shared->df_erases[(op.addr - DF_ADDRESS) / DF_ERASE_BLOCK_SIZE]);
+            }
+            else
+            {
+                op.op = FLASH_SIM_OP_ROM_ERASE;
+                op.block = sim_rom_block(addr, &op.addr, &op.bytes);
+                op.us = sim_wear(g_sim_cfg.rom_erase_us_per_kb * (op.bytes / 1024),
+                                 g_sim_shared->rom_erases[op.block]);
+            }
+            break;
+
+        case SIM_STATE_BLANK_GO:
+            op.op = FLASH_SIM_OP_BLANK_CHECK;
+            op.addr = g_sim_fcu.cmd_addr & DF_MASK;
+            op.block = BLOCK_DB0 + ((op.addr - DF_ADDRESS) / DF_BLOCK_SIZE_LARGE);
+
+            /* BCSIZE is set through .BIT by the Flash API, so it is read 
+               back the same way as well as at its position on the part. 
+               iodefine.h lays out bitfields for CC-RX so the two differ 
+               under GCC. */
+            if ((1 == FLASH.DFLBCCNT.BIT.BCSIZE) || 
+                (0 != (FLASH.DFLBCCNT.WORD & SIM_DFLBCCNT_BCSIZE)))
+            {
+                op.bytes = DF_BLOCK_SIZE_LARGE;
+                op.us = g_sim_cfg.blank_check_block_us;
+            }
+            else
+            {
+                op.addr += FLASH.DFLBCCNT.WORD & SIM_DFLBCCNT_BCADR;
+                op.bytes = DF_PROGRAM_SIZE_SMALL;
+                op.us = g_sim_cfg.blank_check_us;
+            }
+            break;
+
+        case SIM_STATE_LOCK_GO:
+            op.op = FLASH_SIM_OP_LOCK_BIT;
+            op.block = sim_rom_block(g_sim_fcu.cmd_addr, &op.addr, &size);
+            op.us = g_sim_cfg.lock_bit_us;
+            break;
+
+        default:
+            sim_illegal(0);
+            return;
+    }
+
+    /* Data flash has to be enabled for programming and erasing */
+    if (((FLASH_SIM_OP_DF_PROGRAM == op.op) || (FLASH_SIM_OP_DF_ERASE == op.op)) &&
+        (false == sim_df_enabled(FLASH.DFLWE0.WORD, FLASH.DFLWE1.WORD, op.addr)))
+    {
+        sim_illegal(SIM_FASTAT_DFLWPE);
+        return;
+    }
+
+    /* Locked ROM blocks fail unless lock bit protection is cancelled */
+    if (((FLASH_SIM_OP_ROM_PROGRAM == op.op) || (FLASH_SIM_OP_ROM_ERASE == op.op)) &&
+        (0 != g_sim_shared->rom_locked[op.block]) &&
+        (0 == (FLASH.FPROTR.WORD & 0x0001)))
+    {
+        if (FLASH_SIM_OP_ROM_ERASE == op.op)
+        {
+            FLASH.FSTATR0.BIT.ERSERR = 1;
+        }
+        else
+        {
+            FLASH.FSTATR0.BIT.PRGERR = 1;
+        }
+
+        g_sim_shared->stats.op_errors++;
+        return;
+    }
+
+    sim_op_start(&op);
+}
+/******************************************************************************
+End of function  sim_execute
+******************************************************************************/
+
+/******************************************************************************
+* Function Name: sim_fault_check
+* Description  : Decides whether to inject the fault into an operation.
+* Arguments    : p_op - 
+*                    Operation about to start
+* Return Value : Fault to inject, FLASH_SIM_FAULT_NONE for none
+******************************************************************************/
+static flash_sim_fault_kind_t sim_fault_check (const sim_op_t * p_op)
+{
+    flash_sim_fault_t * p_fault = &g_sim_shared->fault;
+
+    if ((FLASH_SIM_FAULT_NONE == p_fault->kind) ||
+        ((FLASH_SIM_OP_ANY != p_fault->op) && (p_op->op != p_fault->op)))
+    {
+        return FLASH_SIM_FAULT_NONE;
+    }
+
+    if (((0 != p_fault->start_addr) || (0 != p_fault->end_addr)) &&
+        ((p_op->addr < p_fault->start_addr) || (p_op->addr > p_fault->end_addr)))
+    {
+        return FLASH_SIM_FAULT_NONE;
+    }
+
+    if ((true == g_sim_shared->fault_done) && (false == p_fault->sticky))
+    {
+        return FLASH_SIM_FAULT_NONE;
+    }
+
+    if (g_sim_shared->fault_matches < p_fault->skip)
+    {
+        g_sim_shared->fault_matches++;
+        return FLASH_SIM_FAULT_NONE;
+    }
+
+    g_sim_shared->fault_done = true;
+    g_sim_shared->stats.faults++;
+
+    return p_fault->kind;
+}
+/******************************************************************************
+End of function  sim_fault_check
+******************************************************************************/
+
+/******************************************************************************
+* Function Name: sim_op_start
+* Description  : Starts an operation. FRDY goes low until it completes.
+* Arguments    : p_op - 
+*                    Operation to start
+* Return Value : none
+******************************************************************************/
+static void sim_op_start (sim_op_t * p_op)
+{
+    uint64_t done_ns;
+
+    p_op->fault = sim_fault_check(p_op);
+
+    g_sim_shared->stats.ops[FLASH_SIM_OP_ANY]++;
+    g_sim_shared->stats.ops[p_op->op]++;
+    g_sim_shared->stats.busy_us += p_op->us;
+
+    g_sim_fcu.op = *p_op;
+    g_sim_fcu.busy = true;
+    FLASH.FSTATR0.BIT.FRDY = 0;
+
+    if (FLASH_SIM_FAULT_TIMEOUT == p_op->fault)
+    {
+        /* Stays busy until the FCU is reset */
+        return;
+    }
+
+    if (FLASH_SIM_FAULT_POWER_LOSS == p_op->fault)
+    {
+        sim_op_partial();
+        g_sim_fcu.busy = false;
+        g_sim_fcu.power_lost = true;
+        return;
+    }
+
+    if (0 != g_sim_cfg.wall_percent)
+    {
+        done_ns = sim_now_ns() + (((uint64_t)p_op->us * g_sim_cfg.wall_percent) * 10u);
+
+        g_sim_fcu.done.tv_sec = (time_t)(done_ns / 1000000000ull);
+        g_sim_fcu.done.tv_nsec = (long)(done_ns % 1000000000ull);
+        g_sim_fcu.wall = true;
+        return;
+    }
+
+    sim_op_finish();
+}
+/******************************************************************************
+End of function  sim_op_start
+******************************************************************************/
+
+/******************************************************************************
+* Function Name: sim_op_finish
+* Description  : Completes the operation in progress.
+* Arguments    : none
+* Return Value : none
+******************************************************************************/
+static void sim_op_finish (void)
+{
+    sim_op_t * p_op = &g_sim_fcu.op;
+    uint8_t  * p_cells = sim_cells(p_op->addr);
+    bool       overprogram = false;
+    uint32_t   i;
+
+    if (FLASH_SIM_FAULT_ERROR == p_op->fault)
+    {
+        switch (p_op->op)
+        {
+            case FLASH_SIM_OP_ROM_ERASE:
+            case FLASH_SIM_OP_DF_ERASE:
+                FLASH.FSTATR0.BIT.ERSERR = 1;
+                g_sim_shared->stats.op_errors++;
+                break;
+
+            case FLASH_SIM_OP_ROM_PROGRAM:
+            case FLASH_SIM_OP_DF_PROGRAM:
+            case FLASH_SIM_OP_LOCK_BIT:
+                FLASH.FSTATR0.BIT.PRGERR = 1;
+                g_sim_shared->stats.op_errors++;
+                break;
+
+            default:
+                FLASH.FSTATR0.BIT.ILGLERR = 1;
+                FLASH.FASTAT.BYTE |= SIM_FASTAT_CMDLK;
+                break;
+        }
+    }
+    else
+    {
+        switch (p_op->op)
+        {
+            case FLASH_SIM_OP_ROM_PROGRAM:
+                for (i = 0; i < p_op->bytes; i++)
+                {
+                    overprogram |= (0xFF != p_cells[i]);
+                    p_cells[i] &= p_op->data[i];
+                }
+                break;
+
+            case FLASH_SIM_OP_DF_PROGRAM:
+                overprogram = !sim_df_is_blank(p_op->addr, p_op->bytes);
+
+                for (i = 0; i < p_op->bytes; i++)
+                {
+                    p_cells[i] = (true == overprogram) ? (p_cells[i] & p_op->data[i]) : p_op->data[i];
+                }
+
+                sim_df_set_blank(p_op->addr, p_op->bytes, false);
+                break;
+
+            case FLASH_SIM_OP_ROM_ERASE:
+                if ((0 != g_sim_cfg.erase_endurance) && 
+                    (g_sim_shared->rom_erases[p_op->block] >= g_sim_cfg.erase_endurance))
+                {
+                    /* Worn out */
+                    FLASH.FSTATR0.BIT.ERSERR = 1;
+                    g_sim_shared->stats.op_errors++;
+                    break;
+                }
+
+                memset(p_cells, 0xFF, p_op->bytes);
+                g_sim_shared->rom_locked[p_op->block] = 0;
+                g_sim_shared->rom_erases[p_op->block]++;
+                g_sim_shared->stats.block_erases[p_op->block]++;
+                break;
+
+            case FLASH_SIM_OP_DF_ERASE:
+                if ((0 != g_sim_cfg.erase_endurance) && 
+                    (g_sim_shared->df_erases[(p_op->addr - DF_ADDRESS) / DF_ERASE_BLOCK_SIZE] >= 
+                     g_sim_cfg.erase_endurance))
+                {
+                    /* Worn out */
+                    FLASH.FSTATR0.BIT.ERSERR = 1;
+                    g_sim_shared->stats.op_errors++;
+                    break;
+                }
+
+                sim_fill_random(p_cells, p_op->bytes);
+                sim_df_set_blank(p_op->addr, p_op->bytes, true);
+                g_sim_shared->df_erases[(p_op->addr - DF_ADDRESS) / DF_ERASE_BLOCK_SIZE]++;
+                g_sim_shared->stats.block_erases[p_op->block]++;
+                break;
+
+            case FLASH_SIM_OP_BLANK_CHECK:
+                FLASH.DFLBCSTAT.BIT.BCST = (true == sim_df_is_blank(p_op->addr, p_op->bytes)) ? 0 : 1;
+                break;
+
+            case FLASH_SIM_OP_NOTIFY:
+                g_sim_fcu.notified = true;
+                break;
+
+            case FLASH_SIM_OP_LOCK_BIT:
+                g_sim_shared->rom_locked[p_op->block] = 1;
+                break;
+
+            default:
+                break;
+        }
+
+        if (true == overprogram)
+        {
+            g_sim_shared->stats.overprograms++;
+        }
+
+        if (FLASH_SIM_FAULT_BIT_FLIP == p_op->fault)
+        {
+            sim_op_flip();
+        }
+    }
+
+    g_sim_shared->now_us += p_op->us;
+    *(volatile uint16_t *)(uintptr_t)SIM_COUNTER_ADDR = (uint16_t)g_sim_shared->now_us;
+
+    g_sim_fcu.busy = false;
+    g_sim_fcu.wall = false;
+    FLASH.FSTATR0.BIT.FRDY = 1;
+}
+/******************************************************************************
+End of function  sim_op_finish
+******************************************************************************/
+
+/******************************************************************************
+* Function Name: sim_op_partial
+* Description  : Leaves flash as an operation stopped part way through would.
+*                Half of a program is done. An erase leaves random bits set.
+* Arguments    : none
+* Return Value : none
+******************************************************************************/
+static void sim_op_partial (void)
+{
+    sim_op_t * p_op = &g_sim_fcu.op;
+    uint8_t  * p_cells = sim_cells(p_op->addr);
+    uint32_t   i;
+
+    switch (p_op->op)
+    {
+        case FLASH_SIM_OP_ROM_PROGRAM:
+        case FLASH_SIM_OP_DF_PROGRAM:
+            for (i = 0; i < (p_op->bytes / 2); i++)
+            {
+                p_cells[i] &= p_op->data[i];
+            }
+
+            if (FLASH_SIM_OP_DF_PROGRAM == p_op->op)
+            {
+                sim_df_set_blank(p_op->addr, p_op->bytes, false);
+            }
+            break;
+
+        case FLASH_SIM_OP_ROM_ERASE:
+            for (i = 0; i < p_op->bytes; i++)
+            {
+                p_cells[i] |= (uint8_t)sim_random();
+            }
+            break;
+
+        case FLASH_SIM_OP_DF_ERASE:
+            sim_fill_random(p_cells, p_op->bytes);
+            sim_df_set_blank(p_op->addr, p_op->bytes, false);
+            break;
+
+        default:
+            break;
+    }
+}
+/******************************************************************************
+End of function  sim_op_partial
+******************************************************************************/
+
+/******************************************************************************
+* Function Name: sim_op_flip
+* Description  : Leaves 1 bit of a completed operation wrong.
+* Arguments    : none
+* Return Value : none
+******************************************************************************/
+static void sim_op_flip (void)
+{
+    sim_op_t * p_op = &g_sim_fcu.op;
+    uint8_t  * p_cells = sim_cells(p_op->addr);
+    uint32_t   bit;
+    uint32_t   i;
+
+    switch (p_op->op)
+    {
+        case FLASH_SIM_OP_ROM_PROGRAM:
+        case FLASH_SIM_OP_DF_PROGRAM:
+            /* A bit that should have been programmed to 0 stays 1 */
+            bit = sim_random() % (p_op->bytes * 8);
+
+            for (i = 0; i < (p_op->bytes * 8); i++, bit = (bit + 1) % (p_op->bytes * 8))
+            {
+                if (0 == (p_cells[bit / 8] & (1u << (bit % 8))))
+                {
+                    p_cells[bit / 8] |= (uint8_t)(1u << (bit % 8));
+                    break;
+                }
+            }
+            break;
+
+        case FLASH_SIM_OP_ROM_ERASE:
+        case FLASH_SIM_OP_DF_ERASE:
+            /* A bit stays programmed */
+            bit = sim_random() % (p_op->bytes * 8);
+            p_cells[bit / 8] &= (uint8_t)~(1u << (bit % 8));
+
+            if (FLASH_SIM_OP_DF_ERASE == p_op->op)
+            {
+                sim_df_set_blank(p_op->addr + ((bit / 8) & ~(uint32_t)(DF_PROGRAM_SIZE_SMALL - 1)), 
+                                 DF_PROGRAM_SIZE_SMALL, false);
+            }
+            break;
+
+        case FLASH_SIM_OP_BLANK_CHECK:
+            FLASH.DFLBCSTAT.BIT.BCST ^= 1;
+            break;
+
+        default:
+            break;
+    }
+}
+/******************************************************************************
+End of function  sim_op_flip
+******************************************************************************/
+
+/******************************************************************************
+* Function Name: sim_update
+* Description  : Completes an operation running in real time once its time is
+*                up.
+* Arguments    : none
+* Return Value : none
+******************************************************************************/
+static void sim_update (void)
+{
+    uint64_t done_ns;
+
+    if ((true == g_sim_ready) && (true == g_sim_fcu.wall))
+    {
+        done_ns = ((uint64_t)g_sim_fcu.done.tv_sec * 1000000000ull) + 
+                  (uint64_t)g_sim_fcu.done.tv_nsec;
+
+        if (sim_now_ns() >= done_ns)
+        {
+            sim_regs_open();
+            sim_op_finish();
+            sim_regs_close();
+        }
+    }
+}
+/******************************************************************************
+End of function  sim_update
+******************************************************************************/
+
+/******************************************************************************
+* Function Name: sim_reg_write
+* Description  : Applies a write to a FLASH register page. Keys are checked
+*                and read only registers and bits are put back.
+* Arguments    : p_acc - 
+*                    Page written, with its contents from before the write
+* Return Value : none
+******************************************************************************/
+static void sim_reg_write (sim_access_t * p_acc)
+{
+    uintptr_t addr = p_acc->addr;
+    uint16_t  value;
+    uint16_t  old;
+
+    /* Value before the write of the register at 'reg' */
+    #define SIM_OLD16(reg)  (*(uint16_t *)&p_acc->old[(uintptr_t)&(reg) - p_acc->page])
+    #define SIM_OLD8(reg)   (p_acc->old[(uintptr_t)&(reg) - p_acc->page])
+    /* True if the write was to 'reg' */
+    #define SIM_WROTE(reg)  ((addr >= (uintptr_t)&(reg)) && (addr < ((uintptr_t)&(reg) + sizeof(reg))))
+
+    if (SIM_WROTE(FLASH.FENTRYR))
+    {
+        value = FLASH.FENTRYR.WORD;
+        old = SIM_OLD16(FLASH.FENTRYR);
+
+        /* The key is not kept. The mode only changes with the right key, 
+           when no operation is running, through 0x0000 and to a single 
+           area that exists. */
+        FLASH.FENTRYR.WORD = old;
+
+        if ((SIM_FENTRYR_KEY == (value & 0xFF00)) && (false == g_sim_fcu.busy))
+        {
+            value &= 0x00FF;
+
+            if ((0 == value) || 
+                ((0 == old) && 
+                 ((SIM_FENTRYD == value) ||
+                  ((0x01 == value) && (ROM_AREA_0 >= SIM_ROM_PE_BASE)) ||
+                  ((0x02 == value) && (ROM_AREA_1 >= SIM_ROM_PE_BASE)) ||
+                  ((0x04 == value) && (ROM_AREA_2 >= SIM_ROM_PE_BASE)) ||
+                  ((0x08 == value) && (ROM_AREA_3 >= SIM_ROM_PE_BASE)))))
+            {
+                FLASH.FENTRYR.WORD = value;
+                g_sim_fcu.state = SIM_STATE_IDLE;
+
+                if ((0 == old) && (0 != value))
+                {
+                    g_sim_shared->stats.pe_entries++;
+                    g_sim_fcu.firmware_ok = 
+                        (0 == memcmp((void *)(uintptr_t)FCU_RAM_TOP, 
+                                     (void *)(uintptr_t)FCU_PRG_TOP, FCU_RAM_SIZE));
+                }
+
+                sim_protect_rom();
+            }
+        }
+    }
+    else if (SIM_WROTE(FLASH.FRESETR))
+    {
+        value = FLASH.FRESETR.WORD;
+        old = SIM_OLD16(FLASH.FRESETR);
+
+        FLASH.FRESETR.WORD = old;
+
+        if (SIM_FRESETR_KEY == (value & 0xFF00))
+        {
+            FLASH.FRESETR.WORD = value & 0x0001;
+
+            if ((0 == (old & 0x0001)) && (0 != (value & 0x0001)))
+            {
+                sim_fcu_reset();
+            }
+        }
+    }
+    else if (SIM_WROTE(FLASH.FPROTR))
+    {
+        value = FLASH.FPROTR.WORD;
+
+        FLASH.FPROTR.WORD = (SIM_FPROTR_KEY == (value & 0xFF00)) ? 
+                            (value & 0x0001) : SIM_OLD16(FLASH.FPROTR);
+    }
+    else if (SIM_WROTE(FLASH.FCURAME))
+    {
+        value = FLASH.FCURAME.WORD;
+
+        FLASH.FCURAME.WORD = (SIM_FCURAME_KEY == (value & 0xFF00)) ? 
+                             (value & 0x0001) : SIM_OLD16(FLASH.FCURAME);
+    }
+    else if (SIM_WROTE(FLASH.DFLRE0))
+    {
+        value = FLASH.DFLRE0.WORD;
+
+        FLASH.DFLRE0.WORD = (SIM_DFLRE0_KEY == (value & 0xFF00)) ? 
+                            (value & 0x00FF) : SIM_OLD16(FLASH.DFLRE0);
+    }
+    else if (SIM_WROTE(FLASH.DFLRE1))
+    {
+        value = FLASH.DFLRE1.WORD;
+
+        FLASH.DFLRE1.WORD = (SIM_DFLRE1_KEY == (value & 0xFF00)) ? 
+                            (value & 0x00FF) : SIM_OLD16(FLASH.DFLRE1);
+    }
+    else if (SIM_WROTE(FLASH.DFLWE0))
+    {
+        value = FLASH.DFLWE0.WORD;
+
+        FLASH.DFLWE0.WORD = (SIM_DFLWE0_KEY == (value & 0xFF00)) ? 
+                            (value & 0x00FF) : SIM_OLD16(FLASH.DFLWE0);
+    }
+    else if (SIM_WROTE(FLASH.DFLWE1))
+    {
+        value = FLASH.DFLWE1.WORD;
+
+        FLASH.DFLWE1.WORD = (SIM_DFLWE1_KEY == (value & 0xFF00)) ? 
+                            (value & 0x00FF) : SIM_OLD16(FLASH.DFLWE1);
+    }
+    else if (SIM_WROTE(FLASH.FASTAT))
+    {
+        /* Bits can only be cleared and CMDLK only by a status clear */
+        old = SIM_OLD8(FLASH.FASTAT);
+
+        FLASH.FASTAT.BYTE = (uint8_t)((old & FLASH.FASTAT.BYTE & ~SIM_FASTAT_CMDLK) | 
+                                      (old & SIM_FASTAT_CMDLK));
+    }
+    else if (SIM_WROTE(FLASH.PCKAR))
+    {
+        FLASH.PCKAR.WORD &= 0x00FF;
+    }
+    else if (SIM_WROTE(FLASH.FSTATR0) || SIM_WROTE(FLASH.FSTATR1) ||
+             SIM_WROTE(FLASH.FCMDR)   || SIM_WROTE(FLASH.FCPSR)   ||
+             SIM_WROTE(FLASH.FPESTAT) || SIM_WROTE(FLASH.DFLBCSTAT))
+    {
+        /* Read only */
+        memcpy((void *)(addr & ~(uintptr_t)1), &p_acc->old[(addr & ~(uintptr_t)1) - p_acc->page], 2);
+    }
+    else
+    {
+        /* FWEPROR, FMODR, FAEINT, FRDYIE and DFLBCCNT keep what was 
+           written */
+    }
+
+    #undef SIM_OLD16
+    #undef SIM_OLD8
+    #undef SIM_WROTE
+}
+/******************************************************************************
+End of function  sim_reg_write
+******************************************************************************/
+
+/******************************************************************************
+* Function Name: sim_save
+* Description  : Saves the contents of a page before the instruction runs.
+* Arguments    : p_acc - 
+*                    Page to save
+* Return Value : none
+******************************************************************************/
+static void sim_save (sim_access_t * p_acc)
+{
+    if (true == p_acc->saved)
+    {
+        return;
+    }
+
+    switch (p_acc->region)
+    {
+        case SIM_REGION_ROM_READ:
+            memcpy(p_acc->old, g_sim_rom + (p_acc->page - SIM_ROM_READ_BASE), SIM_PAGE_SIZE);
+            break;
+
+        case SIM_REGION_DF:
+            memcpy(p_acc->old, g_sim_df + (p_acc->page - DF_ADDRESS), SIM_PAGE_SIZE);
+            break;
+
+        case SIM_REGION_REGS:
+            memcpy(p_acc->old, (void *)p_acc->page, SIM_PAGE_SIZE);
+            break;
+
+        default:
+            /* P/E addresses hold nothing */
+            break;
+    }
+
+    p_acc->saved = true;
+}
+/******************************************************************************
+End of function  sim_save
+******************************************************************************/
+
+/******************************************************************************
+* Function Name: sim_restore
+* Description  : Puts back ROM or data flash contents after the instruction.
+* Arguments    : p_acc - 
+*                    Page to restore
+* Return Value : none
+******************************************************************************/
+static void sim_restore (sim_access_t * p_acc)
+{
+    switch (p_acc->region)
+    {
+        case SIM_REGION_ROM_READ:
+            memcpy(g_sim_rom + (p_acc->page - SIM_ROM_READ_BASE), p_acc->old, SIM_PAGE_SIZE);
+            break;
+
+        case SIM_REGION_DF:
+            memcpy(g_sim_df + (p_acc->page - DF_ADDRESS), p_acc->old, SIM_PAGE_SIZE);
+            break;
+
+        default:
+            break;
+    }
+}
+/******************************************************************************
+End of function  sim_restore
+******************************************************************************/
+
+/******************************************************************************
+* Function Name: sim_read_prepare
+* Description  : Sets up what a trapped read returns.
+* Arguments    : p_acc - 
+*                    Page being read
+*                addr - 
+*                    Address read
+* Return Value : none
+******************************************************************************/
+static void sim_read_prepare (sim_access_t * p_acc, uintptr_t addr)
+{
+    uint8_t cause = 0;
+    uint32_t start;
+    uint32_t size;
+
+    switch (p_acc->region)
+    {
+        case SIM_REGION_DF:
+            if (0 != FLASH.FENTRYR.WORD)
+            {
+                cause = SIM_FASTAT_DFLAE;
+            }
+            else if (false == sim_df_enabled(FLASH.DFLRE0.WORD, FLASH.DFLRE1.WORD, (uint32_t)addr))
+            {
+                cause = SIM_FASTAT_DFLRPE;
+            }
+            break;
+
+        case SIM_REGION_ROM_READ:
+            /* Only trapped during ROM P/E */
+            cause = SIM_FASTAT_ROMAE;
+            break;
+
+        case SIM_REGION_ROM_PE:
+            /* Gives the lock bit in lock bit read mode, 0xFF otherwise */
+            mprotect((void *)p_acc->page, SIM_PAGE_SIZE, PROT_READ | PROT_WRITE);
+            memset((void *)p_acc->page, 0xFF, SIM_PAGE_SIZE);
+
+            if ((SIM_STATE_LOCK_READ == g_sim_fcu.state) && 
+                (0 != g_sim_shared->rom_locked[sim_rom_block((uint32_t)addr, &start, &size)]))
+            {
+                *(uint8_t *)addr = 0x00;
+            }
+            break;
+
+        default:
+            break;
+    }
+
+    if (0 != cause)
+    {
+        /* What is read is undefined on the part */
+        sim_access_error(cause);
+        sim_save(p_acc);
+        sim_fill_random((SIM_REGION_DF == p_acc->region) ? 
+                            (g_sim_df + (p_acc->page - DF_ADDRESS)) : 
+                            (g_sim_rom + (p_acc->page - SIM_ROM_READ_BASE)), 
+                        SIM_PAGE_SIZE);
+        p_acc->swapped = true;
+    }
+}
+/******************************************************************************
+End of function  sim_read_prepare
+******************************************************************************/
+
+/******************************************************************************
+* Function Name: sim_segv_handler
+* Description  : Called when a trapped page is accessed. Opens the page and 
+*                single steps the instruction.
+* Arguments    : signo, p_info, p_context - 
+*                    As for an SA_SIGINFO handler
+* Return Value : none
+******************************************************************************/
+static void sim_segv_handler (int signo, siginfo_t * p_info, void * p_context)
+{
+    ucontext_t   * p_uc = (ucontext_t *)p_context;
+    uintptr_t      addr = (uintptr_t)p_info->si_addr;
+    uintptr_t      page = SIM_PAGE(addr);
+    bool           write = (0 != (p_uc->uc_mcontext.gregs[REG_ERR] & SIM_PF_WRITE));
+    sim_region_t   region = sim_region_find(addr);
+    sim_access_t * p_acc = NULL;
+    uint32_t       i;
+
+    (void)signo;
+
+    if ((false == g_sim_ready) || (SIM_REGION_NONE == region))
+    {
+        /* Not a simulated address. Fault again without the handler. */
+        signal(SIGSEGV, SIG_DFL);
+        return;
+    }
+
+    for (i = 0; i < g_sim_num_access; i++)
+    {
+        if (g_sim_access[i].page == page)
+        {
+            p_acc = &g_sim_access[i];
+        }
+    }
+
+    if (NULL == p_acc)
+    {
+        if (g_sim_num_access >= SIM_MAX_ACCESS)
+        {
+            signal(SIGSEGV, SIG_DFL);
+            return;
+        }
+
+        p_acc = &g_sim_access[g_sim_num_access++];
+        p_acc->page = page;
+        p_acc->region = region;
+        p_acc->read = false;
+        p_acc->write = false;
+        p_acc->saved = false;
+        p_acc->swapped = false;
+    }
+
+    sim_regs_open();
+    sim_update();
+
+    if (true == write)
+    {
+        if (false == p_acc->write)
+        {
+            sim_save(p_acc);
+            p_acc->write = true;
+            p_acc->addr = addr;
+        }
+    }
+    else if (false == p_acc->read)
+    {
+        p_acc->read = true;
+        sim_read_prepare(p_acc, addr);
+    }
+
+    sim_regs_close();
+
+    mprotect((void *)page, SIM_PAGE_SIZE, 
+             (true == p_acc->write) ? (PROT_READ | PROT_WRITE) : PROT_READ);
+
+    /* Run the instruction then come back through SIGTRAP */
+    p_uc->uc_mcontext.gregs[REG_EFL] |= SIM_EFLAGS_TF;
+}
+/******************************************************************************
+End of function  sim_segv_handler
+******************************************************************************/
+
+/******************************************************************************
+* Function Name: sim_trap_handler
+* Description  : Called after the trapped instruction has run. Hands writes to
+*                the FCU model and protects the pages again.
+* Arguments    : signo, p_info, p_context - 
+*                    As for an SA_SIGINFO handler
+* Return Value : none
+******************************************************************************/
+static void sim_trap_handler (int signo, siginfo_t * p_info, void * p_context)
+{
+    ucontext_t   * p_uc = (ucontext_t *)p_context;
+    sim_access_t * p_acc;
+    uint32_t       num_access = g_sim_num_access;
+    uint16_t       value;
+    bool           word;
+    uint32_t       i;
+
+    (void)signo;
+    (void)p_info;
+
+    p_uc->uc_mcontext.gregs[REG_EFL] &= ~SIM_EFLAGS_TF;
+
+    if (0 == num_access)
+    {
+        return;
+    }
+
+    sim_regs_open();
+
+    /* Pages are protected below however they were left */
+    g_sim_num_access = 0;
+
+    for (i = 0; i < num_access; i++)
+    {
+        p_acc = &g_sim_access[i];
+
+        if (true == p_acc->write)
+        {
+            /* Data is written as words, commands as bytes */
+            word = ((SIM_STATE_PROGRAM_DATA == g_sim_fcu.state) || 
+                    (SIM_STATE_NOTIFY_DATA == g_sim_fcu.state));
+            value = (true == word) ? *(volatile uint16_t *)p_acc->addr : 
+                                     *(volatile uint8_t *)p_acc->addr;
+
+            if (SIM_REGION_ROM_READ != p_acc->region)
+            {
+                g_sim_shared->stats.fcu_writes++;
+            }
+
+            switch (p_acc->region)
+            {
+                case SIM_REGION_REGS:
+                    sim_reg_write(p_acc);
+                    break;
+
+                case SIM_REGION_ROM_READ:
+                    /* ROM is written through P/E addresses only */
+                    sim_restore(p_acc);
+                    g_sim_shared->stats.access_errors++;
+                    break;
+
+                case SIM_REGION_DF:
+                    /* Writes are FCU commands and do not change the cells */
+                    sim_restore(p_acc);
+                    sim_command((uint32_t)p_acc->addr, value);
+                    break;
+
+                case SIM_REGION_ROM_PE:
+                    sim_command((uint32_t)p_acc->addr, value);
+                    break;
+
+                default:
+                    break;
+            }
+        }
+        else if (true == p_acc->swapped)
+        {
+            sim_restore(p_acc);
+        }
+    }
+
+    for (i = 0; i < num_access; i++)
+    {
+        mprotect((void *)g_sim_access[i].page, SIM_PAGE_SIZE, 
+                 sim_page_prot(g_sim_access[i].region, g_sim_access[i].page));
+    }
+
+    sim_regs_close();
+
+    if (true == g_sim_fcu.power_lost)
+    {
+        R_FlashSimPowerOn();
+
+        if (NULL != g_sim_cfg.power_loss)
+        {
+            g_sim_cfg.power_loss();
+        }
+
+        _exit(FLASH_SIM_EXIT_POWER_LOSS);
+    }
+}
+/******************************************************************************
+End of function  sim_trap_handler
+******************************************************************************/
@@ -0,0 +1,186 @@
+/*******************************************************************************
+* DISCLAIMER
+* This software is supplied by Renesas Electronics Corporation and is only 
+* intended for use with Renesas products. No other uses are authorized. This 
+* software is owned by Renesas Electronics Corporation and is protected under
+* all applicable laws, including copyright laws.
+* THIS SOFTWARE IS PROVIDED "AS IS" AND RENESAS MAKES NO WARRANTIES REGARDING
+* THIS SOFTWARE, WHETHER EXPRESS, IMPLIED OR STATUTORY, INCLUDING BUT NOT
+* LIMITED TO WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE 
+* AND NON-INFRINGEMENT. ALL SUCH WARRANTIES ARE EXPRESSLY DISCLAIMED.
+* TO THE MAXIMUM EXTENT PERMITTED NOT PROHIBITED BY LAW, NEITHER RENESAS 
+* ELECTRONICS CORPORATION NOR ANY OF ITS AFFILIATED COMPANIES SHALL BE LIABLE 
+* FOR ANY DIRECT, INDIRECT, SPECIAL, INCIDENTAL OR CONSEQUENTIAL DAMAGES FOR
+* ANY REASON RELATED TO THIS SOFTWARE, EVEN IF RENESAS OR ITS AFFILIATES HAVE
+* BEEN ADVISED OF THE POSSIBILITY OF SUCH DAMAGES.
+* Renesas reserves the right, without notice, to make changes to this software
+* and to discontinue the availability of this software. By using this software,
+* you agree to the additional terms and conditions found by accessing the 
+* following link:
+* http://www.renesas.com/disclaimer 
+*
+* Copyright (C) 2013 Renesas Electronics Corporation. All rights reserved.    
+*******************************************************************************/
+/******************************************************************************
+* File Name    : r_flash_sim.h
+* Device       : RX631, RX63N
+* Tool-Chain   : GCC (Linux x86-64)
+* H/W Platform : PC
+* Description  : Simulates the FCU, ROM and data flash of the RX63N on a PC so
+*                that the unmodified Flash API, and code built on it, can be
+*                run, timed and fault tested off target. See readme.txt.
+*******************************************************************************
+* History : DD.MM.YYYY Version Description
+*         : 19.10.2026 1.00    First Release
+*         : 19.10.2026 1.10    Added fcu_writes to flash_sim_stats_t.
+******************************************************************************/
+
+#ifndef FLASH_SIM_H
+#define FLASH_SIM_H
+
+/******************************************************************************
+Includes   <System Includes> , "Project Includes"
+******************************************************************************/
+/* Fixed width types support. */
+#include <stdint.h>
+/* Used for bool. */
+#include <stdbool.h>
+/* Block numbers and sizes of the part being simulated. */
+#include "r_flash_api_rx_if.h"
+
+/******************************************************************************
+Macro definitions
+******************************************************************************/
+/* Number of blocks in flash_sim_stats_t, numbered as in the Flash API */
+#define FLASH_SIM_NUM_BLOCKS        (BLOCK_DB0 + DF_NUM_BLOCKS)
+
+/* Exit status of the process when power is lost and no power_loss callback
+   was given, or the callback returned. */
+#define FLASH_SIM_EXIT_POWER_LOSS   (86)
+
+/******************************************************************************
+Typedef definitions
+******************************************************************************/
+/* Operations carried out by the FCU */
+typedef enum
+{
+    FLASH_SIM_OP_ANY = 0,           /* Any operation, only used for faults */
+    FLASH_SIM_OP_ROM_PROGRAM,       /* 128 byte ROM program */
+    FLASH_SIM_OP_ROM_ERASE,         /* ROM block erase */
+    FLASH_SIM_OP_DF_PROGRAM,        /* 2 byte data flash program */
+    FLASH_SIM_OP_DF_ERASE,          /* 32 byte data flash erase */
+    FLASH_SIM_OP_BLANK_CHECK,       /* Data flash blank check */
+    FLASH_SIM_OP_NOTIFY,            /* Peripheral clock notification */
+    FLASH_SIM_OP_LOCK_BIT,          /* Lock bit program */
+    FLASH_SIM_NUM_OPS
+} flash_sim_op_t;
+
+/* What goes wrong when a fault is injected */
+typedef enum
+{
+    FLASH_SIM_FAULT_NONE = 0,
+    FLASH_SIM_FAULT_ERROR,          /* Op fails with PRGERR/ERSERR/ILGLERR and
+                                       flash is not changed. */
+    FLASH_SIM_FAULT_TIMEOUT,        /* FRDY never returns. An FCU reset stops 
+                                       the op part way through. */
+    FLASH_SIM_FAULT_BIT_FLIP,       /* Op reports success but one bit was not
+                                       programmed or erased. */
+    FLASH_SIM_FAULT_POWER_LOSS      /* Op stops part way through and power is
+                                       lost. */
+} flash_sim_fault_kind_t;
+
+/* Fault to inject. Ops that match 'op' and the address range are counted and
+   the fault happens on the one after the first 'skip' of them. */
+typedef struct
+{
+    flash_sim_fault_kind_t kind;
+    flash_sim_op_t         op;
+    /* Matching ops that complete normally before the fault */
+    uint32_t               skip;
+    /* P/E address range of matching ops, inclusive. 0 and 0 for any. */
+    uint32_t               start_addr;
+    uint32_t               end_addr;
+    /* false: fault happens once. true: every later matching op faults. */
+    bool                   sticky;
+} flash_sim_fault_t;
+
+/* Timing and behaviour of the simulated part */
+typedef struct
+{
+    /* Time each op keeps the FCU busy */
+    uint32_t rom_program_us;        /* One 128 byte program */
+    uint32_t rom_erase_us_per_kb;   /* Per KB of the ROM block erased */
+    uint32_t df_program_us;         /* One 2 byte program */
+    uint32_t df_erase_us;           /* One 32 byte erase */
+    uint32_t blank_check_us;        /* 2 byte blank check */
+    uint32_t blank_check_block_us;  /* 2KB blank check */
+    uint32_t notify_us;             /* Peripheral clock notification */
+    uint32_t lock_bit_us;           /* Lock bit program */
+    /* Erases take this many parts per million longer for each erase the unit
+       has already had. Lets stats and aging checks be exercised. */
+    uint32_t erase_wear_ppm;
+    /* Erases fail with ERSERR once a unit has had this many. 0 for no 
+       limit. */
+    uint32_t erase_endurance;
+    /* 0: ops complete at once and only simulated time passes. Otherwise FRDY
+       stays low for this percentage of the op time in real time, for
+       exercising background operation. */
+    uint32_t wall_percent;
+    /* FCLK the part runs at. Peripheral clock notifications of a different
+       value are counted in clock_mismatches. 0 to not check. */
+    uint32_t fclk_hz;
+    /* Seed for erased data flash contents and partial operations */
+    uint32_t seed;
+    /* Called when power is lost. It may siglongjmp() out (the sim is already
+       back to its power on state) otherwise the process exits with 
+       FLASH_SIM_EXIT_POWER_LOSS. NULL to just exit. */
+    void     (*power_loss)(void);
+} flash_sim_config_t;
+
+/* What the simulated part has been asked to do */
+typedef struct
+{
+    /* Simulated time the FCU has been busy */
+    uint64_t busy_us;
+    /* Ops completed or started, by op. [FLASH_SIM_OP_ANY] is the total. */
+    uint32_t ops[FLASH_SIM_NUM_OPS];
+    /* Ops that ended with PRGERR or ERSERR */
+    uint32_t op_errors;
+    /* Commands rejected with ILGLERR */
+    uint32_t illegal_commands;
+    /* ROM or data flash accesses the part does not allow, e.g. reading ROM
+       during ROM P/E or data flash without read permission */
+    uint32_t access_errors;
+    /* Programs of cells that were not erased */
+    uint32_t overprograms;
+    /* Clock notifications that did not match fclk_hz */
+    uint32_t clock_mismatches;
+    /* FCU resets through FRESETR */
+    uint32_t fcu_resets;
+    /* Entries to ROM or data flash P/E mode */
+    uint32_t pe_entries;
+    /* Writes to FLASH registers, ROM P/E addresses and data flash. Each is 
+       a bus cycle the CPU spent driving the FCU. */
+    uint32_t fcu_writes;
+    /* Faults injected */
+    uint32_t faults;
+    /* Erases of each block. Data flash blocks count 32 byte erases. */
+    uint32_t block_erases[FLASH_SIM_NUM_BLOCKS];
+} flash_sim_stats_t;
+
+/******************************************************************************
+Exported global functions (to be accessed by other files)
+******************************************************************************/
+void       R_FlashSimDefaultConfig(flash_sim_config_t * p_cfg);
+bool       R_FlashSimInit(const flash_sim_config_t * p_cfg);
+void       R_FlashSimPowerOn(void);
+void       R_FlashSimSetFault(const flash_sim_fault_t * p_fault);
+void       R_FlashSimGetStats(flash_sim_stats_t * p_stats);
+void       R_FlashSimClearStats(void);
+uint64_t   R_FlashSimTimeUs(void);
+uint32_t   R_FlashSimCounterAddress(void);
+void       R_FlashSimLoad(uint32_t addr, const void * p_data, uint32_t bytes);
+uint8_t  * R_FlashSimRom(void);
+uint8_t  * R_FlashSimDataFlash(void);
+
+#endif /* FLASH_SIM_H */
@@ -0,0 +1,270 @@
+/*******************************************************************************
+* DISCLAIMER
+* This software is supplied by Renesas Electronics Corporation and is only 
+* intended for use with Renesas products. No other uses are authorized. This 
+* software is owned by Renesas Electronics Corporation and is protected under
+* all applicable laws, including copyright laws.
+* THIS SOFTWARE IS PROVIDED "AS IS" AND RENESAS MAKES NO WARRANTIES REGARDING
+* THIS SOFTWARE, WHETHER EXPRESS, IMPLIED OR STATUTORY, INCLUDING BUT NOT
+* LIMITED TO WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE 
+* AND NON-INFRINGEMENT. ALL SUCH WARRANTIES ARE EXPRESSLY DISCLAIMED.
+* TO THE MAXIMUM EXTENT PERMITTED NOT PROHIBITED BY LAW, NEITHER RENESAS 
+* ELECTRONICS CORPORATION NOR ANY OF ITS AFFILIATED COMPANIES SHALL BE LIABLE 
+* FOR ANY DIRECT, INDIRECT, SPECIAL, INCIDENTAL OR CONSEQUENTIAL DAMAGES FOR
+* ANY REASON RELATED TO THIS SOFTWARE, EVEN IF RENESAS OR ITS AFFILIATES HAVE
+* BEEN ADVISED OF THE POSSIBILITY OF SUCH DAMAGES.
+* Renesas reserves the right, without notice, to make changes to this software
+* and to discontinue the availability of this software. By using this software,
+* you agree to the additional terms and conditions found by accessing the 
+* following link:
+* http://www.renesas.com/disclaimer 
+*
+* Copyright (C) 2013 Renesas Electronics Corporation. All rights reserved.    
+*******************************************************************************/
+/******************************************************************************
+* File Name    : r_flash_sim_bench.c
+* Device       : RX631, RX63N
+* Tool-Chain   : GCC (Linux x86-64)
+* H/W Platform : PC
+* Description  : Measures what the Flash API spends setting up the FCU for 
+*                many small writes, as the bootloader issues during an 
+*                install. Each run of data flash and ROM writes is done
+*                twice: as the API runs normally, with the peripheral clock
+*                notification kept per P/E area, and with 
+*                R_FlashClockChanged() called before every write so the 
+*                clock is notified each time. The difference is printed as
+*                FCU writes, simulated time and ICLK cycles.
+*                Build it with the simulator as shown in readme.txt.
+*******************************************************************************
+* History : DD.MM.YYYY Version Description
+*         : 19.10.2026 1.00    First Release
+******************************************************************************/
+
+/******************************************************************************
+Includes   <System Includes> , "Project Includes"
+******************************************************************************/
+/* Used for printf() */
+#include <stdio.h>
+/* Used for memset() */
+#include <string.h>
+/* Fixed width types support. */
+#include <stdint.h>
+/* Used for bool. */
+#include <stdbool.h>
+/* Board and MCU definitions. */
+#include <platform.h>
+/* Flash API being measured. */
+#include "r_flash_api_rx_if.h"
+/* Simulated FCU. */
+#include "r_flash_sim.h"
+
+/******************************************************************************
+Macro definitions
+******************************************************************************/
+/* Data flash block written. All of it is written 2 bytes at a time. */
+#define BENCH_DF_BLOCK          (BLOCK_DB0)
+#define BENCH_DF_BYTES          (2048)
+#define BENCH_DF_WRITE_BYTES    (2)
+/* ROM block written. All of it is written ROM_PROGRAM_SIZE at a time. */
+#define BENCH_ROM_BLOCK         (BLOCK_3)
+#define BENCH_ROM_BYTES         (4096)
+
+/******************************************************************************
+Typedef definitions
+******************************************************************************/
+/* Cost of one run of writes */
+typedef struct
+{
+    /* Writes made */
+    uint32_t writes;
+    /* Writes that failed */
+    uint32_t failures;
+    /* Simulated time taken */
+    uint64_t us;
+    /* What the simulated FCU was asked to do */
+    flash_sim_stats_t sim;
+} bench_result_t;
+
+/******************************************************************************
+Private global variables and functions
+******************************************************************************/
+/* Data written. Static so its address fits the Flash API's uint32_t. */
+static uint8_t g_bench_data[ROM_PROGRAM_SIZE];
+
+static void bench_run(uint32_t block, uint32_t bytes, uint32_t write_bytes, 
+                      bool notify_each, bench_result_t * p_result);
+static void bench_print(const char * p_name, const bench_result_t * p_cached,
+                        const bench_result_t * p_each);
+
+/******************************************************************************
+* Function Name: main
+* Description  : Runs the data flash and ROM benchmarks and prints the cost
+*                per write with and without the cached FCU setup.
+* Arguments    : none
+* Return Value : 0 if every write succeeded, 1 otherwise
+******************************************************************************/
+int main (void)
+{
+    flash_sim_config_t cfg;
+    bench_result_t     cached;
+    bench_result_t     each;
+    uint32_t           failures;
+
+    R_FlashSimDefaultConfig(&cfg);
+
+    if (false == R_FlashSimInit(&cfg))
+    {
+        printf("Simulator could not be started\n");
+        return 1;
+    }
+
+    /* Data flash has to be readable and writable */
+    R_FlashDataAreaAccess(0xFFFF, 0xFFFF);
+
+    memset(g_bench_data, 0x5A, sizeof(g_bench_data));
+
+    printf("Flash API v%u.%02u, FCLK %u MHz, ICLK %u MHz, clock notification "
+           "%u us\n\n", 
+           (unsigned)(R_FlashGetVersion() >> 16), 
+           (unsigned)(R_FlashGetVersion() & 0xFFFF),
+           (unsigned)(BSP_FCLK_HZ / 1000000), 
+           (unsigned)(BSP_ICLK_HZ / 1000000),
+           (unsigned)cfg.notify_us);
+    printf("%-22s %8s %12s %10s %12s %12s\n", "", "writes", "notifies", 
+           "P/E entry", "FCU writes", "us/write");
+
+    bench_run(BENCH_DF_BLOCK, BENCH_DF_BYTES, BENCH_DF_WRITE_BYTES, false, 
+              &cached);
+    bench_run(BENCH_DF_BLOCK, BENCH_DF_BYTES, BENCH_DF_WRITE_BYTES, true, 
+              &each);
+    bench_print("Data flash", &cached, &each);
+    failures = cached.failures + each.failures;
+
+    bench_run(BENCH_ROM_BLOCK, BENCH_ROM_BYTES, ROM_PROGRAM_SIZE, false, 
+              &cached);
+    bench_run(BENCH_ROM_BLOCK, BENCH_ROM_BYTES, ROM_PROGRAM_SIZE, true, 
+              &each);
+    bench_print("ROM", &cached, &each);
+    failures += cached.failures + each.failures;
+
+    if (0 != failures)
+    {
+        printf("\n%u writes failed\n", (unsigned)failures);
+        return 1;
+    }
+
+    return 0;
+}
+/******************************************************************************
+End of function  main
+******************************************************************************/
+
+/******************************************************************************
+* Function Name: bench_run
+* Description  : Erases a block and writes all of it, counting only the 
+*                writes.
+* Arguments    : block - 
+*                    Flash API block number
+*                bytes - 
+*                    Size of the block
+*                write_bytes - 
+*                    Bytes given to each R_FlashWrite()
+*                notify_each - 
+*                    true to make the API notify the clock before every write
+*                p_result - 
+*                    Where to put the cost of the writes
+* Return Value : none
+******************************************************************************/
+static void bench_run (uint32_t block, uint32_t bytes, uint32_t write_bytes, 
+                       bool notify_each, bench_result_t * p_result)
+{
+    uint32_t addr;
+    uint32_t offset;
+    uint64_t start_us;
+
+    memset(p_result, 0, sizeof(*p_result));
+
+    if (FLASH_SUCCESS != R_FlashErase(block))
+    {
+        p_result->failures++;
+        return;
+    }
+
+    /* Write addresses are ROM read addresses or data flash addresses */
+    addr = g_flash_BlockAddresses[block];
+
+    R_FlashSimClearStats();
+    start_us = R_FlashSimTimeUs();
+
+    for (offset = 0; offset < bytes; offset += write_bytes)
+    {
+        if (true == notify_each)
+        {
+            R_FlashClockChanged(BSP_FCLK_HZ);
+        }
+
+        if (FLASH_SUCCESS != R_FlashWrite(addr + offset, 
+                                          (uint32_t)(uintptr_t)g_bench_data,
+                                          (uint16_t)write_bytes))
+        {
+            p_result->failures++;
+        }
+
+        p_result->writes++;
+    }
+
+    p_result->us = R_FlashSimTimeUs() - start_us;
+    R_FlashSimGetStats(&p_result->sim);
+}
+/******************************************************************************
+End of function  bench_run
+******************************************************************************/
+
+/******************************************************************************
+* Function Name: bench_print
+* Description  : Prints both runs of one benchmark and what caching saved.
+* Arguments    : p_name - 
+*                    Name of the benchmark
+*                p_cached - 
+*                    Run with the clock notification cached
+*                p_each - 
+*                    Run with the clock notified before every write
+* Return Value : none
+******************************************************************************/
+static void bench_print (const char * p_name, const bench_result_t * p_cached,
+                         const bench_result_t * p_each)
+{
+    const bench_result_t * p_run[2];
+    const char           * p_label[2];
+    uint64_t               saved_us;
+    uint32_t               i;
+
+    p_run[0] = p_each;
+    p_label[0] = "notify every write";
+    p_run[1] = p_cached;
+    p_label[1] = "cached";
+
+    printf("%s\n", p_name);
+
+    for (i = 0; i < 2; i++)
+    {
+        printf("  %-20s %8u %12u %10u %12.1f %12.2f\n", p_label[i],
+               (unsigned)p_run[i]->writes, 
+               (unsigned)p_run[i]->sim.ops[FLASH_SIM_OP_NOTIFY],
+               (unsigned)p_run[i]->sim.pe_entries,
+               (double)p_run[i]->sim.fcu_writes / p_run[i]->writes,
+               (double)p_run[i]->us / p_run[i]->writes);
+    }
+
+    saved_us = (p_each->us > p_cached->us) ? (p_each->us - p_cached->us) : 0;
+
+    printf("  saved %u FCU writes and %llu us, %llu ICLK cycles per write\n\n",
+           (unsigned)((p_each->sim.fcu_writes - p_cached->sim.fcu_writes) / 
+                      p_cached->writes),
+           (unsigned long long)(saved_us / p_cached->writes),
+           (unsigned long long)((saved_us * (BSP_ICLK_HZ / 1000000)) / 
+                                p_cached->writes));
+}
+/******************************************************************************
+End of function  bench_print
+******************************************************************************/
@@ -86,6 +86,36 @@
 *                              statements that tested against MCU groups. Now
 *                              have 'targets' directory for easier addition
 *                              of new MCUs. Updated to use r_bsp v2.00.
+*         : 19.10.2026 2.50    Added R_FlashGetRomBlocks() and 
+*                              R_FlashEraseRomRange() so ROM can be erased 
+*                              by address instead of by block number.
+*         : 19.10.2026 2.60    Added R_FlashWriteRomLong() and 
+*                              R_FlashWriteRomStream() which program any 
+*                              amount of ROM with 1 entry to P/E mode per 
+*                              ROM area.
+*         : 19.10.2026 2.70    Added R_FlashStatsInit(), R_FlashStatsGet() 
+*                              and R_FlashStatsClear(). When 
+*                              FLASH_API_RX_CFG_COLLECT_STATS is defined 
+*                              enter_pe_mode(), rom_write() and 
+*                              flash_erase_command() are timed.
+*         : 19.10.2026 2.80    Only code that runs while ROM is in P/E mode
+*                              is in the FRAM section. Program, erase and
+*                              blank check functions copy it to RAM the 
+*                              first time they are called so 
+*                              R_FlashCodeCopy() no longer has to be called
+*                              first unless ROM BGO is used. Added 
+*                              R_FlashGetCodeSize().
+*         : 19.10.2026 2.90    The peripheral clock notification is kept per
+*                              P/E area and only redone after an FCU reset,
+*                              an error or R_FlashClockChanged(). Entering
+*                              P/E mode no longer clears the FCU status or 
+*                              FENTRYR when there is nothing to clear.
+*         : 19.10.2026 2.91    Added R_FlashReset().
+*         : 19.10.2026 2.92    R_FlashWriteRomLong() and R_FlashWriteRomStream()
+*                              are only built with 
+*                              FLASH_API_RX_CFG_ROM_LONG_WRITE.
+*         : 19.10.2026 2.93    R_FlashEraseRomRange() is only built with
+*                              FLASH_API_RX_CFG_ROM_ERASE_RANGE.
 ******************************************************************************/
 
 /******************************************************************************
@@ -93,6 +123,10 @@ Includes   <System Includes> , "Project Includes"
 ******************************************************************************/
 /* Intrinsic functions of MCU */
 #include <machine.h>
+/* Used for NULL */
+#include <stddef.h>
+/* Used for memset() */
+#include <string.h>
 
 /* Allocate flash block array here. This is required before including
    r_flash_api_rx.h */
@@ -131,6 +165,12 @@ Macro definitions
 #define WAIT_T10USEC            (10*(BSP_ICLK_HZ/1000000))      
 /* The number of loops to wait for FENTRYR timeout. */
 #define FLASH_FENTRYR_TIMEOUT   (4)
+/* Bits of g_fcu_pclk_areas. These are the FENTRYR bits for each area. */
+#define FCU_AREA_ROM_0          (0x01)
+#define FCU_AREA_ROM_1          (0x02)
+#define FCU_AREA_ROM_2          (0x04)
+#define FCU_AREA_ROM_3          (0x08)
+#define FCU_AREA_DF             (0x80)
 
 /******************************************************************************
 Typedef definitions
@@ -151,6 +191,18 @@ typedef enum
     FLASH_LOCK_BIT  
 } flash_states_t;
 
+#if defined(FLASH_API_RX_CFG_COLLECT_STATS)
+/* Times one operation. The 16-bit counter is sampled in every wait loop so 
+   durations longer than 1 wrap of the counter are still measured. */
+typedef struct
+{
+    /* Counter value when last sampled */
+    uint16_t last;
+    /* Ticks elapsed since the operation started */
+    uint32_t ticks;
+} flash_stats_timer_t;
+#endif
+
 /******************************************************************************
 Exported global variables 
 ******************************************************************************/
@@ -163,12 +215,19 @@ Private global variables and functions
 static uint8_t        g_fcu_transfer_complete = 0;
 /* Valid values are 'READ_MODE','ROM_PE_MODE' or 'FLD_PE_MODE' */
 static uint8_t        g_current_mode;        
-/* Stores whether the peripheral clock notification command has 
-   been executed */
-static uint8_t        g_fcu_pclk_command = 0;   
+/* P/E areas (FCU_AREA_*) the peripheral clock notification command has 
+   been executed for since the last FCU reset, error or clock change */
+static uint8_t        g_fcu_pclk_areas = 0;   
+/* Flash clock in MHz given in the peripheral clock notification */
+static uint8_t        g_fcu_pclk_mhz = (uint8_t)(FLASH_CLOCK_HZ/1000000);
 /* States for flash operations */
 static flash_states_t g_flash_state;
 
+#if defined(FLASH_API_RX_CFG_ENABLE_ROM_PROGRAMMING) && defined(FLASH_API_RX_CFG_COPY_CODE_BY_API)
+/* Set once R_FlashCodeCopy() has copied the FRAM section to RAM */
+static bool           g_fram_copied = false;
+#endif
+
 #ifndef FLASH_API_RX_CFG_IGNORE_LOCK_BITS                          
 /* Determines whether lock bit protection is used when programming/erasing */
 static uint8_t g_lock_bit_protection = true;                          
@@ -195,8 +254,26 @@ static uint32_t  g_bgo_flash_addr;
 static uint32_t  g_bgo_buffer_addr;
 #endif
 
+#if defined(FLASH_API_RX_CFG_COLLECT_STATS)
+/* Free running counter used for timing. NULL until R_FlashStatsInit() */
+static FCU_WORD_PTR  g_stats_counter = NULL;
+/* Timing collected so far */
+static flash_stats_t g_stats;
+/* Ticks spent in erase commands for the current R_FlashErase() */
+static uint32_t      g_stats_erase_ticks;
+#endif
+
 /* Flash intialisation function prototype */
 static uint8_t  flash_init(void);
+/* Copies the FRAM section to RAM the first time it is needed */
+static void     flash_code_ready(void);
+/* Bodies of the API functions that run while ROM is in P/E mode */
+static uint8_t  flash_erase(uint32_t block);
+static uint8_t  flash_write(uint32_t flash_addr, uint32_t buffer_addr, uint16_t bytes);
+#ifndef FLASH_API_RX_CFG_IGNORE_LOCK_BITS
+static uint8_t  flash_program_lock_bit(uint32_t block);
+static uint8_t  flash_read_lock_bit(uint32_t block);
+#endif
 /* Enter PE mode function prototype */
 static uint8_t  enter_pe_mode(uint32_t flash_addr);
 /* Exit PE mode function prototype */
@@ -219,6 +296,23 @@ static void     flash_release_state(void);
 static uint8_t  flash_erase_command(FCU_BYTE_PTR const erase_addr);
 /* Used to get largest programming size that can be used. */
 static uint32_t flash_get_program_size(uint32_t bytes, uint32_t flash_addr);
+#if defined(FLASH_API_RX_CFG_ROM_LONG_WRITE) && !defined(FLASH_API_RX_CFG_ROM_BGO)
+/* Used to program ROM for R_FlashWriteRomLong() and R_FlashWriteRomStream() */
+static uint8_t  rom_write_long(uint32_t flash_addr, 
+                               uint32_t buffer_addr, 
+                               uint32_t bytes, 
+                               flash_producer_t producer);
+/* Used to find where the ROM area holding an address ends */
+static uint32_t rom_area_end(uint32_t flash_addr);
+#endif
+#if defined(FLASH_API_RX_CFG_COLLECT_STATS)
+/* Starts timing an operation */
+static void     flash_stats_start(flash_stats_timer_t * p_timer);
+/* Samples the counter, called while waiting on the FCU */
+static void     flash_stats_poll(flash_stats_timer_t * p_timer);
+/* Adds a finished operation to the histogram */
+static uint32_t flash_stats_record(uint8_t op, flash_stats_timer_t * p_timer);
+#endif
 
 /******************************************************************************
 * Function Name: flash_init
@@ -330,9 +424,11 @@ End of function  flash_init
 #ifdef FLASH_API_RX_CFG_COPY_CODE_BY_API
 /******************************************************************************
 * Function Name: R_FlashCodeCopy
-* Description  : Copies Flash API code from ROM to RAM. This function needs to
-*                be called before any program/erase functions. This function
-*                does not need to be used when 
+* Description  : Copies Flash API code from ROM to RAM. Program, erase and
+*                blank check functions call this the first time they are 
+*                used so it only has to be called by the user when ROM BGO 
+*                is enabled, as the API functions themselves then run from 
+*                RAM.
 *                NOTE: This function does not have to execute from in RAM.
 * Arguments    : none
 * Return Value : none
@@ -359,6 +455,9 @@ void R_FlashCodeCopy (void)
         /* Copy over data 1 byte at a time. */
         p_ram_section[bytes_copied] = p_rom_section[bytes_copied];
     }
+
+    /* Later calls to flash_code_ready() do not need to copy again */
+    g_fram_copied = true;
 #endif
 }
 /******************************************************************************
@@ -366,6 +465,91 @@ End of function  R_FlashCodeCopy
 ******************************************************************************/
 #endif
 
+/******************************************************************************
+* Function Name: flash_code_ready
+* Description  : Makes sure the FRAM section has been copied to RAM before 
+*                any code in it is called. Copying is left until the first 
+*                program, erase or blank check so boots that never change 
+*                flash do not spend the time.
+*                NOTE: This function does not have to execute from in RAM.
+* Arguments    : none
+* Return Value : none
+******************************************************************************/
+static void flash_code_ready (void)
+{
+#if defined(FLASH_API_RX_CFG_ENABLE_ROM_PROGRAMMING) && defined(FLASH_API_RX_CFG_COPY_CODE_BY_API)
+    if( g_fram_copied == false )
+    {
+        R_FlashCodeCopy();
+    }
+#endif
+}
+/******************************************************************************
+End of function  flash_code_ready
+******************************************************************************/
+
+/******************************************************************************
+* Function Name: R_FlashGetCodeSize
+* Description  : Returns how much RAM the Flash API code that has to run from
+*                RAM takes up. This is the size of the FRAM section. 
+* Arguments    : none
+* Return Value : Size of the FRAM section in bytes. 0 if ROM programming is 
+*                not enabled.
+******************************************************************************/
+uint32_t R_FlashGetCodeSize (void)
+{
+#ifdef FLASH_API_RX_CFG_ENABLE_ROM_PROGRAMMING
+    return (uint32_t)__secsize("PFRAM");
+#else
+    return 0;
+#endif
+}
+/******************************************************************************
+End of function  R_FlashGetCodeSize
+******************************************************************************/
+
+/******************************************************************************
+* Function Name: R_FlashClockChanged
+* Description  : Tells the Flash API that the flash clock (FCLK) has changed.
+*                The FCU is given the new clock in the peripheral clock 
+*                notification before the next operation on each area. Call 
+*                it after every FCLK change while no operation is running.
+*                NOTE: Timeouts are still worked out from FLASH_CLOCK_HZ so 
+*                FCLK should not be set much below it.
+* Arguments    : flash_clock_hz - 
+*                    New FCLK in Hz. Must be in the range the MCU allows.
+* Return Value : FLASH_SUCCESS -
+*                    The clock will be notified before the next operation.
+*                FLASH_FAILURE -
+*                    The clock is below 1MHz.
+*                FLASH_BUSY -
+*                    A flash operation is running. Nothing was changed.
+******************************************************************************/
+uint8_t R_FlashClockChanged (uint32_t flash_clock_hz)
+{
+    /* The FCU is told the clock in MHz */
+    if( flash_clock_hz < 1000000 )
+    {
+        return FLASH_FAILURE;
+    }
+
+    /* Cannot change the notified clock part way through an operation */
+    if( g_flash_state != FLASH_READY )
+    {
+        return FLASH_BUSY;
+    }
+
+    g_fcu_pclk_mhz = (uint8_t)(flash_clock_hz/1000000);
+
+    /* Every area has to be notified of the new clock */
+    g_fcu_pclk_areas = 0;
+
+    return FLASH_SUCCESS;
+}
+/******************************************************************************
+End of function  R_FlashClockChanged
+******************************************************************************/
+
 /******************************************************************************
 * Function Name: R_FlashGetVersion
 * Description  : Returns the current version of this module. The version number
@@ -384,6 +568,61 @@ uint32_t R_FlashGetVersion (void)
 End of function  R_FlashGetVersion
 ******************************************************************************/
 
+#if defined(FLASH_API_RX_CFG_COLLECT_STATS)
+/******************************************************************************
+* Function Name: R_FlashStatsInit
+* Description  : Starts timing flash operations and clears the statistics.
+*                The counter must be a 16-bit register that counts up from 0 
+*                to 0xFFFF and wraps, such as a CMT channel created with 
+*                R_CMT_CreateFreeRunning(). It is read directly because
+*                ROM cannot be read while operations are timed.
+* Arguments    : counter_addr - 
+*                    Address of the counter register
+* Return Value : none
+******************************************************************************/
+void R_FlashStatsInit (uint32_t counter_addr)
+{
+    /* Clear first so nothing is timed against old values */
+    R_FlashStatsClear();
+
+    /* Start timing */
+    g_stats_counter = (FCU_WORD_PTR)counter_addr;
+}
+/******************************************************************************
+End of function  R_FlashStatsInit
+******************************************************************************/
+
+/******************************************************************************
+* Function Name: R_FlashStatsGet
+* Description  : Returns the statistics collected since R_FlashStatsInit() or
+*                the last R_FlashStatsClear(). 
+* Arguments    : none
+* Return Value : Pointer to statistics
+******************************************************************************/
+const flash_stats_t * R_FlashStatsGet (void)
+{
+    return &g_stats;
+}
+/******************************************************************************
+End of function  R_FlashStatsGet
+******************************************************************************/
+
+/******************************************************************************
+* Function Name: R_FlashStatsClear
+* Description  : Clears the statistics. Must not be called while a flash 
+*                operation is in progress.
+* Arguments    : none
+* Return Value : none
+******************************************************************************/
+void R_FlashStatsClear (void)
+{
+    memset(&g_stats, 0, sizeof(g_stats));
+}
+/******************************************************************************
+End of function  R_FlashStatsClear
+******************************************************************************/
+#endif /* FLASH_API_RX_CFG_COLLECT_STATS */
+
 /******************************************************************************
 * Function Name: data_flash_status_clear
 * Description  : Clear the status of the Data Flash operation.
@@ -598,7 +837,10 @@ uint8_t R_FlashDataAreaBlankCheck (uint32_t address, uint8_t size)
         /* 'size' parameter is not valid. */
         return FLASH_ERROR_BYTES;
     }
-        
+
+    /* enter_pe_mode() is in the FRAM section */
+    flash_code_ready();
+
     /* Attempt to grab state */
     if( flash_grab_state(FLASH_BLANKCHECK) != FLASH_SUCCESS )
     {
@@ -1199,155 +1441,535 @@ End of function  flash_ready_isr
 
 #endif
 
-#ifdef FLASH_API_RX_CFG_ENABLE_ROM_PROGRAMMING
-#pragma section FRAM
-#endif
-
 /******************************************************************************
-* Function Name: rom_write
-* Description  : Write bytes to ROM Area Flash.
-*                NOTE: This function MUST execute from in RAM.
-* Arguments    : address - 
-*                    ROM address of where to write to
-*                data - 
-*                    Pointer to the data to write
-*                size - 
-*                    The size of the data to write. Must be set to 
-*                    either a supported write size of the MCU.
+* Function Name: R_FlashErase
+* Description  : Erases an entire flash block.
+*                NOTE: This function does not have to execute from in RAM
+*                unless FLASH_API_RX_CFG_ROM_BGO is enabled. The FRAM 
+*                section is copied to RAM the first time it is called.
+* Arguments    : block - 
+*                    The block number to erase (BLOCK_0, BLOCK_1, etc...)
 * Return Value : FLASH_SUCCESS - 
 *                    Operation Successful
 *                FLASH_FAILURE - 
 *                    Operation Failed
+*                FLASH_BUSY - 
+*                    Another flash operation is in progress
 ******************************************************************************/
-static uint8_t rom_write (uint32_t address, uint32_t data, uint32_t size)
+uint8_t R_FlashErase (uint32_t block)
 {
-/* If ROM programming is not enabled then do not compile this code as it is
-   not needed. */
-#ifdef FLASH_API_RX_CFG_ENABLE_ROM_PROGRAMMING
-
-    /* Declare iteration loop count variable */
-    volatile uint32_t i;  
-    /* Declare wait counter variable */
-    volatile int32_t  wait_cnt;
-
-    /* Writes are done 16-bit at a time, scale 'size' argument */
-    size = size >> 1;
-
-    /* Write the FCU Program command */
-    *(FCU_BYTE_PTR)address = 0xE8;  
-    *(FCU_BYTE_PTR)address = size;    
-
-    /* Write 'size' bytes into flash, 16-bits at a time */
-    for(i = 0; i < size; i++)
-    {
-        /* Copy data from source address to destination ROM */
-        *(FCU_WORD_PTR)address = *(uint16_t *)data;
-        
-        /* Increment destination address by 2 bytes */
-        data += 2;
-    }
-
-    /* Write the final FCU command for programming */
-    *(FCU_BYTE_PTR)address = 0xD0;
-
-    #ifdef FLASH_API_RX_CFG_ROM_BGO            
-    /* Return, rest of programming will be done in interrupt */
-    return FLASH_SUCCESS;
-    #endif
-
-    /* Set timeout wait counter value */
-    wait_cnt = WAIT_MAX_ROM_WRITE;
-
-    /* Wait until FCU operation finishes, or a timeout occurs */
-    while(FLASH.FSTATR0.BIT.FRDY == 0)
-    {
-        /* Decrement the wait counter */
-        wait_cnt--;
+    /* flash_erase() is in the FRAM section */
+    flash_code_ready();
 
-        /* Check if the wait counter has reached zero */
-        if(wait_cnt == 0)
-        {    
-            /* Maximum timeout duration for writing to ROM has elapsed - 
-               assume operation failure and reset the FCU */
-            flash_reset();
+    return flash_erase(block);
+}
+/******************************************************************************
+End of function  R_FlashErase
+******************************************************************************/
 
-            /* Return FLASH_FAILURE, operation failure */
-            return FLASH_FAILURE;
-        }
-    }
+/******************************************************************************
+* Function Name: R_FlashReset
+* Description  : Resets the FCU and leaves flash in read mode. An operation 
+*                in progress is stopped and the area it was working on must
+*                be erased again. Use it to recover before retrying after an
+*                operation failed. The FCU is initialized again before the 
+*                next operation.
+*                NOTE: This function does not have to execute from in RAM
+*                unless FLASH_API_RX_CFG_ROM_BGO is enabled. The FRAM 
+*                section is copied to RAM the first time it is called.
+* Arguments    : none
+* Return Value : none
+******************************************************************************/
+void R_FlashReset (void)
+{
+    /* flash_reset() is in the FRAM section */
+    flash_code_ready();
 
-    /* Check for illegal command or programming errors */
-    if((FLASH.FSTATR0.BIT.ILGLERR == 1) || (FLASH.FSTATR0.BIT.PRGERR  == 1)) 
-    {        
-        /* Return FLASH_FAILURE, operation failure */
-        return FLASH_FAILURE;
-    }                
+    flash_reset();
+}
+/******************************************************************************
+End of function  R_FlashReset
+******************************************************************************/
 
-#endif /* FLASH_API_RX_CFG_ENABLE_ROM_PROGRAMMING */
+/******************************************************************************
+* Function Name: R_FlashWrite
+* Description  : Writes bytes into flash.
+*                NOTE: This function does not have to execute from in RAM
+*                unless FLASH_API_RX_CFG_ROM_BGO is enabled. The FRAM 
+*                section is copied to RAM the first time it is called.
+* Arguments    : flash_addr - 
+*                    Flash address location to write to. This address 
+*                    must be on a program boundary (e.g. RX62N has 
+*                    256-byte ROM writes and 8-byte DF writes).
+*                buffer_addr - 
+*                    Address location of data buffer to write into flash.
+*                bytes - 
+*                    The number of bytes to write. You must always pass a 
+*                    multiple of the programming size (e.g. RX62N has 
+*                    256-byte ROM writes and 8-byte DF writes).
+* Return Value : FLASH_SUCCESS - 
+*                    Operation Successful
+*                FLASH_FAILURE - 
+*                    Operation Failed
+*                FLASH_ERROR_ALIGNED - 
+*                    Flash address was not on correct boundary
+*                FLASH_ERROR_BYTES - 
+*                    Number of bytes did not match programming size of ROM or DF
+*                FLASH_ERROR_ADDRESS - 
+*                    Invalid address
+*                FLASH_ERROR_BOUNDARY - 
+*                    (ROM) Cannot write across flash areas.                                       
+*                FLASH_BUSY - 
+*                    Flash is busy with another operation
+******************************************************************************/
+uint8_t R_FlashWrite (uint32_t flash_addr, 
+                      uint32_t buffer_addr, 
+                      uint16_t bytes)
+{
+    /* flash_write() is in the FRAM section */
+    flash_code_ready();
 
-    /* If ROM programming is not enabled then this function will always just
-       return FLASH_SUCCESS. This is okay because this function will never
-       actually be called. The API write function will return an error when
-       a ROM address is entered for programming. */
-    
-    /* Return FLASH_SUCCESS, operation successful */
-    return FLASH_SUCCESS;
+    return flash_write(flash_addr, buffer_addr, bytes);
 }
 /******************************************************************************
-End of function  rom_write
+End of function  R_FlashWrite
 ******************************************************************************/
 
+#if defined(FLASH_API_RX_CFG_ROM_LONG_WRITE) && !defined(FLASH_API_RX_CFG_ROM_BGO)
 /******************************************************************************
-* Function Name: enter_pe_mode
-* Description  : Puts the FCU into program/erase mode.
-*                NOTE: This function MUST execute from in RAM for 'ROM Area' 
-*                programming, but if you are ONLY doing Data Flash programming,
-*                this function can reside and execute in Flash.
+* Function Name: R_FlashWriteRomLong
+* Description  : Writes a buffer of any size into ROM. Unlike R_FlashWrite()
+*                the write may cross ROM areas. P/E mode is entered once for
+*                each ROM area written.
+*                NOTE: This function does not have to execute from in RAM.
+*                The FRAM section is copied to RAM the first time it is 
+*                called.
+*                NOTE: This function is not available when ROM BGO is 
+*                enabled.
 * Arguments    : flash_addr - 
-*                    The programming/erasure address
+*                    ROM address to write to. Must be on a ROM program 
+*                    boundary. Read or program/erase address.
+*                buffer_addr - 
+*                    RAM address of data to write
 *                bytes - 
-*                    The number of bytes you are writing (if you are writing).  
+*                    The number of bytes to write. Must be a multiple of 
+*                    ROM_PROGRAM_SIZE.
 * Return Value : FLASH_SUCCESS - 
 *                    Operation Successful
 *                FLASH_FAILURE - 
 *                    Operation Failed
+*                FLASH_ERROR_ALIGNED - 
+*                    Flash address was not on correct boundary
+*                FLASH_ERROR_BYTES - 
+*                    Number of bytes was not a multiple of ROM_PROGRAM_SIZE
+*                FLASH_ERROR_ADDRESS - 
+*                    Flash address is not in ROM
+*                FLASH_ERROR_BOUNDARY - 
+*                    Write goes past the end of ROM
+*                FLASH_BUSY - 
+*                    Flash is busy with another operation
 ******************************************************************************/
-static uint8_t enter_pe_mode (uint32_t flash_addr)
+uint8_t R_FlashWriteRomLong (uint32_t flash_addr, 
+                             uint32_t buffer_addr, 
+                             uint32_t bytes)
 {
-    /* Used for timeout on FENTRYR write/read. */
-    volatile int32_t wait_cnt;
+    /* rom_write_long() is in the FRAM section */
+    flash_code_ready();
 
-    /* If FCU firmware has already been transferred to FCU RAM,
-       no need to do it again */
-    if( !g_fcu_transfer_complete )
-    {
-        /* Initialise the FCU, and store operation resilt in result variable */             
-        /* Check if FCU initialisation was successful */
-        if( flash_init() != FLASH_SUCCESS )
-        {
-            /* FCU initialisiation failed - return operation failure */
-            return FLASH_FAILURE;
-        }
-    }
-    
-    /* FENTRYR must be 0x0000 before bit FENTRY0 or FENTRYD can be set to 1 */
-    FLASH.FENTRYR.WORD = 0xAA00;
+    return rom_write_long(flash_addr, buffer_addr, bytes, NULL);
+}
+/******************************************************************************
+End of function  R_FlashWriteRomLong
+******************************************************************************/
 
-    /* Initialize timeout for FENTRYR being written. */
-    wait_cnt = FLASH_FENTRYR_TIMEOUT;
+/******************************************************************************
+* Function Name: R_FlashWriteRomStream
+* Description  : Writes data supplied by a function into ROM. The function 
+*                is called each time the data it last supplied has been 
+*                written. P/E mode is entered once for each ROM area written.
+*                NOTE: This function does not have to execute from in RAM.
+*                The FRAM section is copied to RAM the first time it is 
+*                called.
+*                NOTE: This function is not available when ROM BGO is 
+*                enabled.
+* Arguments    : flash_addr - 
+*                    ROM address to write to. Must be on a ROM program 
+*                    boundary. Read or program/erase address.
+*                bytes - 
+*                    The total number of bytes to write. Must be a multiple 
+*                    of ROM_PROGRAM_SIZE.
+*                producer - 
+*                    Function supplying the data (see flash_producer_t)
+* Return Value : FLASH_SUCCESS - 
+*                    Operation Successful
+*                FLASH_FAILURE - 
+*                    Operation Failed or producer supplied no data
+*                FLASH_ERROR_ALIGNED - 
+*                    Flash address was not on correct boundary
+*                FLASH_ERROR_BYTES - 
+*                    Number of bytes was not a multiple of ROM_PROGRAM_SIZE
+*                FLASH_ERROR_ADDRESS - 
+*                    Flash address is not in ROM
+*                FLASH_ERROR_BOUNDARY - 
+*                    Write goes past the end of ROM
+*                FLASH_BUSY - 
+*                    Flash is busy with another operation
+******************************************************************************/
+uint8_t R_FlashWriteRomStream (uint32_t flash_addr, 
+                               uint32_t bytes, 
+                               flash_producer_t producer)
+{
+    /* rom_write_long() is in the FRAM section */
+    flash_code_ready();
 
-    /* Read FENTRYR to ensure it has been set to 0. Note that the top byte
-       of the FENTRYR register is not retained and is read as 0x00. */
-    while(0x0000 != FLASH.FENTRYR.WORD)
+    return rom_write_long(flash_addr, 0, bytes, producer);
+}
+/******************************************************************************
+End of function  R_FlashWriteRomStream
+******************************************************************************/
+#endif /* defined(FLASH_API_RX_CFG_ROM_LONG_WRITE) && !defined(FLASH_API_RX_CFG_ROM_BGO) */
+
+#ifndef  FLASH_API_RX_CFG_IGNORE_LOCK_BITS
+/******************************************************************************
+* Function Name: R_FlashProgramLockBit
+* Description  : Programs the lock bit for a specified ROM erasure block. If
+*                the lock bit for a block is set and lock bit protection is 
+*                enabled then that block cannot be programmed/erased.
+*                NOTE: This function does not have to execute from in RAM
+*                unless FLASH_API_RX_CFG_ROM_BGO is enabled. The FRAM 
+*                section is copied to RAM the first time it is called.
+* Arguments    : block - 
+*                    Which ROM erasure block to set the lock bit for
+* Return Value : FLASH_SUCCESS -
+*                    Operation Successful
+*                FLASH_FAILURE -
+*                    Operation Failed
+*                FLASH_BUSY -
+*                    Another flash operation is in progress
+******************************************************************************/
+uint8_t R_FlashProgramLockBit (uint32_t block)
+{
+    /* flash_program_lock_bit() is in the FRAM section */
+    flash_code_ready();
+
+    return flash_program_lock_bit(block);
+}
+/******************************************************************************
+End of function  R_FlashProgramLockBit
+******************************************************************************/
+
+/******************************************************************************
+* Function Name: R_FlashReadLockBit
+* Description  : Reads and returns the lock bit status for a ROM block
+*                NOTE: This function does not have to execute from in RAM
+*                unless FLASH_API_RX_CFG_ROM_BGO is enabled. The FRAM 
+*                section is copied to RAM the first time it is called.
+* Arguments    : block - 
+*                    Which ROM erasure block to read the lock bit of
+* Return Value : FLASH_LOCK_BIT_SET -
+*                    Lock bit was set
+*                FLASH_LOCK_BIT_NOT_SET -
+*                    Lock bit was not set
+*                FLASH_FAILURE -
+*                    Operation Failed
+*                FLASH_BUSY -
+*                    Another flash operation is in progress
+******************************************************************************/
+uint8_t R_FlashReadLockBit (uint32_t block)
+{
+    /* flash_read_lock_bit() is in the FRAM section */
+    flash_code_ready();
+
+    return flash_read_lock_bit(block);
+}
+/******************************************************************************
+End of function  R_FlashReadLockBit
+******************************************************************************/
+#endif /* FLASH_API_RX_CFG_IGNORE_LOCK_BITS */
+
+/* Code from here on runs while ROM is in P/E mode so it is put in the FRAM
+   section, which is copied to RAM. Keep it to what has to be there as it is
+   RAM the application cannot use. */
+#ifdef FLASH_API_RX_CFG_ENABLE_ROM_PROGRAMMING
+#pragma section FRAM
+#endif
+
+#if defined(FLASH_API_RX_CFG_COLLECT_STATS)
+/******************************************************************************
+* Function Name: flash_stats_start
+* Description  : Starts timing an operation. Does nothing until 
+*                R_FlashStatsInit() has been called.
+*                NOTE: This function MUST execute from in RAM.
+* Arguments    : p_timer - 
+*                    Timer to start
+* Return Value : none
+******************************************************************************/
+static void flash_stats_start (flash_stats_timer_t * p_timer)
+{
+    p_timer->ticks = 0;
+
+    if( g_stats_counter != NULL )
     {
-        /* Wait until FENTRYR is 0 unless timeout occurs. */
-        if (wait_cnt-- <= 0)
+        p_timer->last = *g_stats_counter;
+    }
+}
+/******************************************************************************
+End of function  flash_stats_start
+******************************************************************************/
+
+/******************************************************************************
+* Function Name: flash_stats_poll
+* Description  : Adds the ticks since the last sample to a timer. This must 
+*                be called more often than the counter wraps.
+*                NOTE: This function MUST execute from in RAM.
+* Arguments    : p_timer - 
+*                    Timer to update
+* Return Value : none
+******************************************************************************/
+static void flash_stats_poll (flash_stats_timer_t * p_timer)
+{
+    /* Current counter value */
+    uint16_t now;
+
+    if( g_stats_counter != NULL )
+    {
+        now = *g_stats_counter;
+
+        /* 16-bit subtraction handles the counter wrapping */
+        p_timer->ticks += (uint16_t)(now - p_timer->last);
+        p_timer->last   = now;
+    }
+}
+/******************************************************************************
+End of function  flash_stats_poll
+******************************************************************************/
+
+/******************************************************************************
+* Function Name: flash_stats_record
+* Description  : Stops timing an operation and adds it to the statistics.
+*                NOTE: This function MUST execute from in RAM.
+* Arguments    : op - 
+*                    Which operation (FLASH_STATS_OP_*)
+*                p_timer - 
+*                    Timer started when the operation began
+* Return Value : Duration of the operation in ticks
+******************************************************************************/
+static uint32_t flash_stats_record (uint8_t op, flash_stats_timer_t * p_timer)
+{
+    /* Histogram bucket */
+    uint32_t bucket;
+    /* Statistics of this operation */
+    flash_op_stats_t * p_op;
+
+    if( g_stats_counter == NULL )
+    {
+        /* Not timing */
+        return 0;
+    }
+
+    flash_stats_poll(p_timer);
+
+    p_op = &g_stats.op[op];
+
+    p_op->count++;
+
+    if( p_timer->ticks > p_op->max_ticks )
+    {
+        p_op->max_ticks = p_timer->ticks;
+    }
+
+    /* Bucket is the number of significant bits in the duration */
+    bucket = 0;
+    while( (bucket < (FLASH_STATS_NUM_BUCKETS - 1)) && 
+           ((p_timer->ticks >> bucket) != 0) )
+    {
+        bucket++;
+    }
+
+    p_op->histogram[bucket]++;
+
+    return p_timer->ticks;
+}
+/******************************************************************************
+End of function  flash_stats_record
+******************************************************************************/
+#endif /* FLASH_API_RX_CFG_COLLECT_STATS */
+
+/******************************************************************************
+* Function Name: rom_write
+* Description  : Write bytes to ROM Area Flash.
+*                NOTE: This function MUST execute from in RAM.
+* Arguments    : address - 
+*                    ROM address of where to write to
+*                data - 
+*                    Pointer to the data to write
+*                size - 
+*                    The size of the data to write. Must be set to 
+*                    either a supported write size of the MCU.
+* Return Value : FLASH_SUCCESS - 
+*                    Operation Successful
+*                FLASH_FAILURE - 
+*                    Operation Failed
+******************************************************************************/
+static uint8_t rom_write (uint32_t address, uint32_t data, uint32_t size)
+{
+/* If ROM programming is not enabled then do not compile this code as it is
+   not needed. */
+#ifdef FLASH_API_RX_CFG_ENABLE_ROM_PROGRAMMING
+
+    /* Declare iteration loop count variable */
+    volatile uint32_t i;  
+    /* Declare wait counter variable */
+    volatile int32_t  wait_cnt;
+    #if defined(FLASH_API_RX_CFG_COLLECT_STATS)
+    /* Times this program */
+    flash_stats_timer_t timer;
+
+    flash_stats_start(&timer);
+    #endif
+
+    /* Writes are done 16-bit at a time, scale 'size' argument */
+    size = size >> 1;
+
+    /* Write the FCU Program command */
+    *(FCU_BYTE_PTR)address = 0xE8;  
+    *(FCU_BYTE_PTR)address = size;    
+
+    /* Write 'size' bytes into flash, 16-bits at a time */
+    for(i = 0; i < size; i++)
+    {
+        /* Copy data from source address to destination ROM */
+        *(FCU_WORD_PTR)address = *(uint16_t *)data;
+        
+        /* Increment destination address by 2 bytes */
+        data += 2;
+    }
+
+    /* Write the final FCU command for programming */
+    *(FCU_BYTE_PTR)address = 0xD0;
+
+    #ifdef FLASH_API_RX_CFG_ROM_BGO            
+    /* Return, rest of programming will be done in interrupt */
+    return FLASH_SUCCESS;
+    #endif
+
+    /* Set timeout wait counter value */
+    wait_cnt = WAIT_MAX_ROM_WRITE;
+
+    /* Wait until FCU operation finishes, or a timeout occurs */
+    while(FLASH.FSTATR0.BIT.FRDY == 0)
+    {
+        /* Decrement the wait counter */
+        wait_cnt--;
+
+    #if defined(FLASH_API_RX_CFG_COLLECT_STATS)
+        flash_stats_poll(&timer);
+    #endif
+
+        /* Check if the wait counter has reached zero */
+        if(wait_cnt == 0)
+        {    
+            /* Maximum timeout duration for writing to ROM has elapsed - 
+               assume operation failure and reset the FCU */
+            flash_reset();
+
+    #if defined(FLASH_API_RX_CFG_COLLECT_STATS)
+            g_stats.op[FLASH_STATS_OP_ROM_WRITE].timeouts++;
+    #endif
+
+            /* Return FLASH_FAILURE, operation failure */
+            return FLASH_FAILURE;
+        }
+    }
+
+    #if defined(FLASH_API_RX_CFG_COLLECT_STATS)
+    flash_stats_record(FLASH_STATS_OP_ROM_WRITE, &timer);
+    #endif
+
+    /* Check for illegal command or programming errors */
+    if((FLASH.FSTATR0.BIT.ILGLERR == 1) || (FLASH.FSTATR0.BIT.PRGERR  == 1)) 
+    {        
+        /* Return FLASH_FAILURE, operation failure */
+        return FLASH_FAILURE;
+    }                
+
+#endif /* FLASH_API_RX_CFG_ENABLE_ROM_PROGRAMMING */
+
+    /* If ROM programming is not enabled then this function will always just
+       return FLASH_SUCCESS. This is okay because this function will never
+       actually be called. The API write function will return an error when
+       a ROM address is entered for programming. */
+    
+    /* Return FLASH_SUCCESS, operation successful */
+    return FLASH_SUCCESS;
+}
+/******************************************************************************
+End of function  rom_write
+******************************************************************************/
+
+/******************************************************************************
+* Function Name: enter_pe_mode
+* Description  : Puts the FCU into program/erase mode.
+*                NOTE: This function MUST execute from in RAM for 'ROM Area' 
+*                programming, but if you are ONLY doing Data Flash programming,
+*                this function can reside and execute in Flash.
+* Arguments    : flash_addr - 
+*                    The programming/erasure address
+*                bytes - 
+*                    The number of bytes you are writing (if you are writing).  
+* Return Value : FLASH_SUCCESS - 
+*                    Operation Successful
+*                FLASH_FAILURE - 
+*                    Operation Failed
+******************************************************************************/
+static uint8_t enter_pe_mode (uint32_t flash_addr)
+{
+    /* Used for timeout on FENTRYR write/read. */
+    volatile int32_t wait_cnt;
+    /* P/E area being entered (FCU_AREA_*) */
+    uint8_t pe_area = 0;
+#if defined(FLASH_API_RX_CFG_COLLECT_STATS)
+    /* Times entry to P/E mode */
+    flash_stats_timer_t timer;
+
+    flash_stats_start(&timer);
+#endif
+
+    /* If FCU firmware has already been transferred to FCU RAM,
+       no need to do it again */
+    if( !g_fcu_transfer_complete )
+    {
+        /* Initialise the FCU, and store operation resilt in result variable */             
+        /* Check if FCU initialisation was successful */
+        if( flash_init() != FLASH_SUCCESS )
         {
-            /* This should not happen. FENTRYR getting written to 0 should
-               only take 2-4 PCLK cycles. */
+            /* FCU initialisiation failed - return operation failure */
             return FLASH_FAILURE;
         }
     }
+    
+    /* FENTRYR must be 0x0000 before bit FENTRY0 or FENTRYD can be set to 1.
+       exit_pe_mode() normally leaves it 0x0000 already. */
+    if(FLASH.FENTRYR.WORD != 0x0000)
+    {
+        FLASH.FENTRYR.WORD = 0xAA00;
+
+        /* Initialize timeout for FENTRYR being written. */
+        wait_cnt = FLASH_FENTRYR_TIMEOUT;
+
+        /* Read FENTRYR to ensure it has been set to 0. Note that the top byte
+           of the FENTRYR register is not retained and is read as 0x00. */
+        while(0x0000 != FLASH.FENTRYR.WORD)
+        {
+            /* Wait until FENTRYR is 0 unless timeout occurs. */
+            if (wait_cnt-- <= 0)
+            {
+                /* This should not happen. FENTRYR getting written to 0 should
+                   only take 2-4 PCLK cycles. */
+                return FLASH_FAILURE;
+            }
+        }
+    }
 
     /* Check if FCU mode is set to ROM PE */
     if( g_current_mode == ROM_PE_MODE) 
@@ -1370,6 +1992,7 @@ static uint8_t enter_pe_mode (uint32_t flash_addr)
             /* Area 0 */
             /* Enter ROM PE mode for ROM Area 0 */
             FLASH.FENTRYR.WORD = 0xAA01;
+            pe_area = FCU_AREA_ROM_0;
         } 
 #if defined(ROM_AREA_1)
         else if((flash_addr < ROM_AREA_0) && (flash_addr >= ROM_AREA_1)) 
@@ -1377,6 +2000,7 @@ static uint8_t enter_pe_mode (uint32_t flash_addr)
             /* Area 1 */
             /* Enter ROM PE mode for ROM Area 1 */
             FLASH.FENTRYR.WORD = 0xAA02;
+            pe_area = FCU_AREA_ROM_1;
         }
 #endif
 #if defined(ROM_AREA_2)
@@ -1385,6 +2009,7 @@ static uint8_t enter_pe_mode (uint32_t flash_addr)
             /* Area 2 */
             /* Enter ROM PE mode for ROM Area 2 */
             FLASH.FENTRYR.WORD = 0xAA04;
+            pe_area = FCU_AREA_ROM_2;
         }
 #endif
 #if defined(ROM_AREA_3)
@@ -1393,6 +2018,7 @@ static uint8_t enter_pe_mode (uint32_t flash_addr)
             /* Area 3 */
             /* Enter ROM PE mode for ROM Area 3 */
             FLASH.FENTRYR.WORD = 0xAA08;
+            pe_area = FCU_AREA_ROM_3;
         }
 #endif
                 
@@ -1410,12 +2036,19 @@ static uint8_t enter_pe_mode (uint32_t flash_addr)
                         
         /* Set FENTRYD bit(Bit 7) and FKEY (B8-15 = 0xAA) */
         FLASH.FENTRYR.WORD = 0xAA80;    
+        pe_area = FCU_AREA_DF;
 
         /*  First clear the FCU's status before doing Data Flash programming.
             This is to clear out any previous errors that may have occured.
             For example, if you attempt to read the Data Flash area 
-            before you make it readable using R_FlashDataAreaAccess(). */
-        data_flash_status_clear();
+            before you make it readable using R_FlashDataAreaAccess(). 
+            Skipped when no error is flagged as there is nothing to clear. */
+        if(     (FLASH.FSTATR0.BIT.ILGLERR == 1)
+            ||  (FLASH.FSTATR0.BIT.ERSERR  == 1)
+            ||  (FLASH.FSTATR0.BIT.PRGERR  == 1)) 
+        {
+            data_flash_status_clear();
+        }
         
     }
     /* Catch-all for invalid FCU mode */
@@ -1434,12 +2067,16 @@ static uint8_t enter_pe_mode (uint32_t flash_addr)
         ||  (FLASH.FSTATR0.BIT.PRGERR  == 1)
         ||  (FLASH.FSTATR1.BIT.FCUERR  == 1)) 
     {
+        /* Notify the clock again once the error has been dealt with */
+        g_fcu_pclk_areas = 0;
+
         /* Return FLASH_FAILURE, operation failure */
         return FLASH_FAILURE;    
     }
     
-    /* Check to see if peripheral clock notification command is needed */
-    if( g_fcu_pclk_command == 0 )
+    /* Check to see if peripheral clock notification command is needed for
+       this area */
+    if( (g_fcu_pclk_areas & pe_area) == 0 )
     {
         /* Disable FCU interrupts, so interrupt will not trigger after
            peripheral clock notification command */
@@ -1472,10 +2109,15 @@ static uint8_t enter_pe_mode (uint32_t flash_addr)
         }
 #endif
         
-        /* No need to notify FCU of clock supplied to flash again */
-        g_fcu_pclk_command = 1;
+        /* No need to notify FCU of clock supplied to flash again for this 
+           area */
+        g_fcu_pclk_areas |= pe_area;
     }    
 
+#if defined(FLASH_API_RX_CFG_COLLECT_STATS)
+    flash_stats_record(FLASH_STATS_OP_ENTER_PE, &timer);
+#endif
+
     /* Return FLASH_SUCCESS, operation successful */
     return FLASH_SUCCESS;
 }
@@ -1547,6 +2189,9 @@ static void exit_pe_mode (uint32_t flash_addr)
         
         /* Send status clear command to FCU */
         *p_addr = 0x50;
+
+        /* Notify the clock again before the next operation */
+        g_fcu_pclk_areas = 0;
     }
 
     /* Enter ROM Read mode */
@@ -1581,21 +2226,14 @@ End of function  exit_pe_mode
 ******************************************************************************/
 
 /******************************************************************************
-* Function Name: R_FlashErase
-* Description  : Erases an entire flash block.
-*                NOTE: This function MUST execute from in RAM for 'ROM Area' 
-*                programming, but if you are ONLY doing Data Flash programming,
-*                this function can reside and execute in Flash.
-* Arguments    : block - 
-*                    The block number to erase (BLOCK_0, BLOCK_1, etc...)
-* Return Value : FLASH_SUCCESS - 
-*                    Operation Successful
-*                FLASH_FAILURE - 
-*                    Operation Failed
-*                FLASH_BUSY - 
-*                    Another flash operation is in progress
+* Function Name: flash_erase
+* Description  : Does the work of R_FlashErase() once the FRAM section 
+*                is in RAM.
+*                NOTE: This function MUST execute from in RAM.
+* Arguments    : See R_FlashErase()
+* Return Value : See R_FlashErase()
 ******************************************************************************/
-uint8_t R_FlashErase (uint32_t block)
+static uint8_t flash_erase (uint32_t block)
 {
     /* Declare address pointer */
     uint32_t p_addr;
@@ -1652,6 +2290,10 @@ uint8_t R_FlashErase (uint32_t block)
     }       
 #endif
 
+#if defined(FLASH_API_RX_CFG_COLLECT_STATS)
+    /* Erase commands for this block add to this */
+    g_stats_erase_ticks = 0;
+#endif
 
 #if defined(DF_GROUPED_BLOCKS)
     /* NOTE:
@@ -1718,6 +2360,16 @@ uint8_t R_FlashErase (uint32_t block)
     }
 #endif 
 
+#if defined(FLASH_API_RX_CFG_COLLECT_STATS)
+    /* Count the erase and keep the longest time taken for this block */
+    g_stats.block_erases[block]++;
+
+    if( g_stats_erase_ticks > g_stats.block_erase_max_ticks[block] )
+    {
+        g_stats.block_erase_max_ticks[block] = g_stats_erase_ticks;
+    }
+#endif
+
     /* Leave Program/Erase Mode */
     exit_pe_mode(p_addr);
 
@@ -1728,9 +2380,15 @@ uint8_t R_FlashErase (uint32_t block)
     return result;
 }
 /******************************************************************************
-End of function  R_FlashErase
+End of function  flash_erase
 ******************************************************************************/
 
+#if !defined(FLASH_API_RX_CFG_ROM_BGO)
+/* Back to default code section. The functions up to flash_erase_command() do 
+   not run while ROM is in P/E mode. */
+#pragma section
+#endif
+
 #if defined(DF_GROUPED_BLOCKS)
 /******************************************************************************
 * Function Name: R_FlashEraseRange
@@ -1738,9 +2396,9 @@ End of function  R_FlashErase
 *                number of bytes to erase has been reached.
 *                NOTE: This function is currently only for data flash blocks
 *                on RX MCUs.
-*                NOTE: This function MUST execute from in RAM for 'ROM Area' 
-*                programming, but if you are ONLY doing Data Flash programming,
-*                this function can reside and execute in Flash.
+*                NOTE: This function does not have to execute from in RAM.
+*                The FRAM section is copied to RAM the first time it is 
+*                called.
 * Arguments    : start_addr - 
 *                    The address of where to start erasing. Must be on
 *                    erase boundary.
@@ -1793,64 +2451,221 @@ uint8_t R_FlashEraseRange (uint32_t start_addr, uint32_t bytes)
         return FLASH_ERROR_ADDRESS;
     }
 
-    /* Attempt to grab state */
-    if( flash_grab_state(FLASH_ERASING) != FLASH_SUCCESS )
+    /* enter_pe_mode() is in the FRAM section */
+    flash_code_ready();
+
+    /* Attempt to grab state */
+    if( flash_grab_state(FLASH_ERASING) != FLASH_SUCCESS )
+    {
+        /* Another operation is already in progress */
+        return FLASH_BUSY;
+    }
+    
+    /* Set current FCU mode to data flash PE */
+    g_current_mode = FLD_PE_MODE;   
+
+    /* Enter ROM PE mode, check if operation successful */
+    if( enter_pe_mode(start_addr) != FLASH_SUCCESS)        
+    {
+        /* Make sure part is in ROM read mode. */
+        exit_pe_mode(start_addr);
+
+        /* Release state */
+        flash_release_state();
+        
+        /* Return FLASH_FAILURE, operation failure */
+        return FLASH_FAILURE;
+    }
+
+    /* Erase real data flash blocks until the 'fake' block is erased .*/
+    while(0 < bytes) {
+
+        /* Send FCU command to erase block */
+        result = flash_erase_command((FCU_BYTE_PTR)start_addr);
+
+        /* Advance pointer to next block */
+        start_addr += DF_ERASE_BLOCK_SIZE;
+
+        /* Subtract off bytes erased */
+        bytes -= DF_ERASE_BLOCK_SIZE;
+
+#if defined(FLASH_API_RX_CFG_DATA_FLASH_BGO)
+        /* Set global variables so that erase can continue in ISR. */
+        g_bgo_flash_addr = start_addr;
+        g_bgo_bytes = bytes;
+
+        /* Return, check result and continue erasure later in ISR */
+        return FLASH_SUCCESS;
+#endif    
+    }
+
+    /* Leave Program/Erase Mode */
+    exit_pe_mode(start_addr);
+
+    /* Release state */
+    flash_release_state();
+
+    /* Return erase result */
+    return result;
+}
+/******************************************************************************
+End of function  R_FlashEraseRange
+******************************************************************************/
+#endif /* defined(DF_GROUPED_BLOCKS) */
+
+/******************************************************************************
+* Function Name: R_FlashGetRomBlocks
+* Description  : Finds the ROM blocks that make up an address range. ROM 
+*                blocks are not all the same size so the range is looked up
+*                in g_flash_BlockAddresses[]. Block numbers go down as 
+*                addresses go up, so the first block is the one at the top 
+*                of the range.
+* Arguments    : start_addr - 
+*                    The address of where the range starts. Must be on a ROM
+*                    erase boundary. Read or program/erase address.
+*                bytes - 
+*                    The numbers of bytes in the range. The range must end
+*                    on a ROM erase boundary.
+*                p_first_block - 
+*                    Where to place the lowest block number in the range
+*                p_num_blocks - 
+*                    Where to place the number of blocks in the range
+* Return Value : FLASH_SUCCESS - 
+*                    Blocks found
+*                FLASH_ERROR_ADDRESS - 
+*                    Range is empty or is not all in ROM
+*                FLASH_ERROR_ALIGNED - 
+*                    Start address was not on an erase boundary
+*                FLASH_ERROR_BYTES - 
+*                    End of range was not on an erase boundary
+******************************************************************************/
+uint8_t R_FlashGetRomBlocks (uint32_t start_addr, 
+                             uint32_t bytes, 
+                             uint32_t * p_first_block, 
+                             uint32_t * p_num_blocks)
+{
+    uint32_t i;
+    uint32_t end_addr;
+    uint32_t block_end;
+    bool     end_found = false;
+
+    /* Take off upper byte since for programming/erase addresses for ROM are 
+        the same as read addresses except upper byte is masked off to 0's. */
+    start_addr &= 0x00FFFFFF;
+    end_addr    = start_addr + bytes;
+
+    /* Confirm whole range is in ROM */
+    if( (bytes == 0) ||
+        (start_addr < ROM_PE_ADDR) ||
+        (end_addr > (ROM_PE_ADDR + BSP_ROM_SIZE_BYTES)) )
+    {
+        return FLASH_ERROR_ADDRESS;
+    }
+
+    for(i = 0; i < ROM_NUM_BLOCKS; i++)
+    {
+        /* Block 0 ends at the top of ROM */
+        if( i == 0 )
+        {
+            block_end = ROM_PE_ADDR + BSP_ROM_SIZE_BYTES;
+        }
+        else
+        {
+            block_end = g_flash_BlockAddresses[i - 1];
+        }
+
+        if( block_end == end_addr )
+        {
+            /* Top of range found */
+            *p_first_block = i;
+            end_found = true;
+        }
+
+        if( g_flash_BlockAddresses[i] <= start_addr )
+        {
+            /* Block holding the start address */
+            break;
+        }
+    }
+
+    if( g_flash_BlockAddresses[i] != start_addr )
     {
-        /* Another operation is already in progress */
-        return FLASH_BUSY;
+        /* Start address is inside a block */
+        return FLASH_ERROR_ALIGNED;
     }
-    
-    /* Set current FCU mode to data flash PE */
-    g_current_mode = FLD_PE_MODE;   
 
-    /* Enter ROM PE mode, check if operation successful */
-    if( enter_pe_mode(start_addr) != FLASH_SUCCESS)        
+    if( end_found == false )
     {
-        /* Make sure part is in ROM read mode. */
-        exit_pe_mode(start_addr);
-
-        /* Release state */
-        flash_release_state();
-        
-        /* Return FLASH_FAILURE, operation failure */
-        return FLASH_FAILURE;
+        /* End of range is inside a block */
+        return FLASH_ERROR_BYTES;
     }
 
-    /* Erase real data flash blocks until the 'fake' block is erased .*/
-    while(0 < bytes) {
+    *p_num_blocks = (i - *p_first_block) + 1;
 
-        /* Send FCU command to erase block */
-        result = flash_erase_command((FCU_BYTE_PTR)start_addr);
+    return FLASH_SUCCESS;
+}
+/******************************************************************************
+End of function  R_FlashGetRomBlocks
+******************************************************************************/
 
-        /* Advance pointer to next block */
-        start_addr += DF_ERASE_BLOCK_SIZE;
+#if defined(FLASH_API_RX_CFG_ROM_ERASE_RANGE) && !defined(FLASH_API_RX_CFG_ROM_BGO)
+/******************************************************************************
+* Function Name: R_FlashEraseRomRange
+* Description  : Erases the ROM blocks that make up an address range. Blocks
+*                are erased from the top of the range down. If an erase 
+*                fails the blocks below it are not erased.
+*                NOTE: This function does not have to execute from in RAM.
+*                NOTE: This function is not available when ROM BGO is 
+*                enabled because only 1 erase can be started at a time. Use
+*                R_FlashGetRomBlocks() and start each R_FlashErase() from
+*                FlashEraseDone() instead.
+* Arguments    : start_addr - 
+*                    The address of where to start erasing. Must be on a ROM
+*                    erase boundary. Read or program/erase address.
+*                bytes - 
+*                    The numbers of bytes to erase. The range must end on a
+*                    ROM erase boundary.
+* Return Value : FLASH_SUCCESS - 
+*                    Operation Successful
+*                FLASH_FAILURE - 
+*                    Operation Failed
+*                FLASH_BUSY - 
+*                    Another flash operation is in progress
+*                FLASH_ERROR_ADDRESS - 
+*                    Range is empty or is not all in ROM
+*                FLASH_ERROR_ALIGNED - 
+*                    Start address was not on an erase boundary
+*                FLASH_ERROR_BYTES - 
+*                    End of range was not on an erase boundary
+******************************************************************************/
+uint8_t R_FlashEraseRomRange (uint32_t start_addr, uint32_t bytes)
+{
+    /* Declare erase operation result container variable */
+    uint8_t  result;
+    uint32_t block;
+    uint32_t num_blocks;
 
-        /* Subtract off bytes erased */
-        bytes -= DF_ERASE_BLOCK_SIZE;
+    result = R_FlashGetRomBlocks(start_addr, bytes, &block, &num_blocks);
 
-#if defined(FLASH_API_RX_CFG_DATA_FLASH_BGO)
-        /* Set global variables so that erase can continue in ISR. */
-        g_bgo_flash_addr = start_addr;
-        g_bgo_bytes = bytes;
+    while( (result == FLASH_SUCCESS) && (num_blocks > 0) )
+    {
+        result = R_FlashErase(block);
 
-        /* Return, check result and continue erasure later in ISR */
-        return FLASH_SUCCESS;
-#endif    
+        block++;
+        num_blocks--;
     }
 
-    /* Leave Program/Erase Mode */
-    exit_pe_mode(start_addr);
-
-    /* Release state */
-    flash_release_state();
-
     /* Return erase result */
     return result;
 }
 /******************************************************************************
-End of function  R_FlashEraseRange
+End of function  R_FlashEraseRomRange
 ******************************************************************************/
-#endif /* defined(DF_GROUPED_BLOCKS) */
+#endif /* defined(FLASH_API_RX_CFG_ROM_ERASE_RANGE) && !defined(FLASH_API_RX_CFG_ROM_BGO) */
+
+#if defined(FLASH_API_RX_CFG_ENABLE_ROM_PROGRAMMING) && !defined(FLASH_API_RX_CFG_ROM_BGO)
+#pragma section FRAM
+#endif
 
 /******************************************************************************
 * Function Name: flash_erase_command
@@ -1871,6 +2686,12 @@ static uint8_t flash_erase_command (FCU_BYTE_PTR const erase_addr)
     volatile int32_t wait_cnt;
     /* Declare erase operation result container variable */
     uint8_t result = FLASH_SUCCESS;
+#if defined(FLASH_API_RX_CFG_COLLECT_STATS)
+    /* Times this erase */
+    flash_stats_timer_t timer;
+
+    flash_stats_start(&timer);
+#endif
 
     /* Send the FCU Command */
     *erase_addr = 0x20;
@@ -1900,6 +2721,10 @@ static uint8_t flash_erase_command (FCU_BYTE_PTR const erase_addr)
     {
         /* Decrement the wait counter */
         wait_cnt--;
+
+#if defined(FLASH_API_RX_CFG_COLLECT_STATS)
+        flash_stats_poll(&timer);
+#endif
         
         /* Check if the wait counter has reached zero */
         if(wait_cnt == 0){
@@ -1908,11 +2733,20 @@ static uint8_t flash_erase_command (FCU_BYTE_PTR const erase_addr)
                elapsed, assuming operation failure - reset the FCU */
             flash_reset();
 
+#if defined(FLASH_API_RX_CFG_COLLECT_STATS)
+            g_stats.op[FLASH_STATS_OP_ERASE].timeouts++;
+            g_stats_erase_ticks += timer.ticks;
+#endif
+
             /* Return FLASH_FAILURE, operation failure */
             return FLASH_FAILURE;
         }
     }
 
+#if defined(FLASH_API_RX_CFG_COLLECT_STATS)
+    g_stats_erase_ticks += flash_stats_record(FLASH_STATS_OP_ERASE, &timer);
+#endif
+
     /* Check if erase operation was successful by checking 
        bit 'ERSERR' (bit5) and 'ILGLERR' (bit 6) of register 'FSTATR0' */
     /* Check FCU error */
@@ -1929,39 +2763,16 @@ End of function  flash_erase_command
 ******************************************************************************/
 
 /******************************************************************************
-* Function Name: R_FlashWrite
-* Description  : Writes bytes into flash.
-*                NOTE: This function MUST execute from in RAM for 'ROM Area' 
-*                programming, but if you are ONLY doing Data Flash programming,
-*                this function can reside and execute in Flash.
-* Arguments    : flash_addr - 
-*                    Flash address location to write to. This address 
-*                    must be on a program boundary (e.g. RX62N has 
-*                    256-byte ROM writes and 8-byte DF writes).
-*                buffer_addr - 
-*                    Address location of data buffer to write into flash.
-*                bytes - 
-*                    The number of bytes to write. You must always pass a 
-*                    multiple of the programming size (e.g. RX62N has 
-*                    256-byte ROM writes and 8-byte DF writes).
-* Return Value : FLASH_SUCCESS - 
-*                    Operation Successful
-*                FLASH_FAILURE - 
-*                    Operation Failed
-*                FLASH_ERROR_ALIGNED - 
-*                    Flash address was not on correct boundary
-*                FLASH_ERROR_BYTES - 
-*                    Number of bytes did not match programming size of ROM or DF
-*                FLASH_ERROR_ADDRESS - 
-*                    Invalid address
-*                FLASH_ERROR_BOUNDARY - 
-*                    (ROM) Cannot write across flash areas.                                       
-*                FLASH_BUSY - 
-*                    Flash is busy with another operation
+* Function Name: flash_write
+* Description  : Does the work of R_FlashWrite() once the FRAM section 
+*                is in RAM.
+*                NOTE: This function MUST execute from in RAM.
+* Arguments    : See R_FlashWrite()
+* Return Value : See R_FlashWrite()
 ******************************************************************************/
-uint8_t R_FlashWrite (uint32_t flash_addr, 
-                      uint32_t buffer_addr, 
-                      uint16_t bytes)
+static uint8_t flash_write (uint32_t flash_addr, 
+                            uint32_t buffer_addr, 
+                            uint16_t bytes)
 {
     /* Declare result container and number of bytes to write variables */
     uint8_t  result = FLASH_SUCCESS;
@@ -2290,8 +3101,222 @@ uint8_t R_FlashWrite (uint32_t flash_addr,
     return result;
 }
 /******************************************************************************
-End of function  R_FlashWrite
+End of function  flash_write
+******************************************************************************/
+
+#if defined(FLASH_API_RX_CFG_ROM_LONG_WRITE) && !defined(FLASH_API_RX_CFG_ROM_BGO)
+/******************************************************************************
+* Function Name: rom_write_long
+* Description  : Writes a long run of ROM. The arguments are checked once and
+*                P/E mode is only left and entered again when the write 
+*                moves in to the next ROM area.
+*                NOTE: This function MUST execute from in RAM.
+* Arguments    : flash_addr - 
+*                    ROM address to write to
+*                buffer_addr - 
+*                    RAM address of data to write when 'producer' is NULL
+*                bytes - 
+*                    The total number of bytes to write
+*                producer - 
+*                    Function supplying the data, or NULL
+* Return Value : See R_FlashWriteRomStream()
+******************************************************************************/
+static uint8_t rom_write_long (uint32_t flash_addr, 
+                               uint32_t buffer_addr, 
+                               uint32_t bytes, 
+                               flash_producer_t producer)
+{
+    uint8_t  result = FLASH_SUCCESS;
+    /* Address P/E mode was entered with */
+    uint32_t pe_addr;
+    /* End of the ROM area P/E mode was entered for. 0 before entering. */
+    uint32_t area_end = 0;
+    /* Bytes left at buffer_addr */
+    uint32_t available;
+    uint32_t num_byte_to_write;
+
+#ifndef FLASH_API_RX_CFG_ENABLE_ROM_PROGRAMMING
+    /* ROM operations are not enabled! Enable them in r_flash_api_rx_config.h */
+    return FLASH_FAILURE;
+#endif
+
+    /* Take off upper byte since for programming/erase addresses for ROM are 
+        the same as read addresses except upper byte is masked off to 0's. */
+    flash_addr &= 0x00FFFFFF;
+
+    /* Check for ROM area */
+    if( (flash_addr < ROM_PE_ADDR) ||
+        (flash_addr >= (ROM_PE_ADDR + BSP_ROM_SIZE_BYTES)) )
+    {
+        /* Return invalid flash address */
+        return FLASH_ERROR_ADDRESS;
+    }
+
+    /* Check if the number of bytes were passed is a multiple of the 
+       programming size for ROM */
+    if( bytes & (ROM_PROGRAM_SIZE-1) )
+    {
+        /* Return number of bytes not a multiple of the programming size */
+        return FLASH_ERROR_BYTES;
+    }
+
+    /* Check for an address on a programming boundary. */
+    if( flash_addr & (ROM_PROGRAM_SIZE-1) )
+    {
+        /* Return address not on a ROM programming byte boundary */
+        return FLASH_ERROR_ALIGNED; 
+    }
+
+    /* Make sure write is not going over end of flash. */
+    if( bytes > ((ROM_PE_ADDR + BSP_ROM_SIZE_BYTES) - flash_addr) )
+    {
+        return FLASH_ERROR_BOUNDARY;
+    }
+
+    /* Attempt to grab state */
+    if( flash_grab_state(FLASH_WRITING) != FLASH_SUCCESS )
+    {
+        /* Another operation is already in progress */
+        return FLASH_BUSY;
+    }
+
+    /* Set FCU to ROM PE mode */
+    g_current_mode = ROM_PE_MODE;
+
+    /* Buffer holds everything unless data is coming from producer */
+    available = (producer == NULL) ? bytes : 0;
+    pe_addr   = flash_addr;
+
+    while( bytes > 0 )
+    {
+        /* Move to next ROM area when needed */
+        if( flash_addr >= area_end )
+        {
+            if( area_end != 0 )
+            {
+                /* Leave the area just written */
+                exit_pe_mode(pe_addr);
+            }
+
+            pe_addr  = flash_addr;
+            area_end = rom_area_end(flash_addr);
+
+            /* Enter PE mode, check if operation is successful */
+            if( enter_pe_mode(pe_addr) != FLASH_SUCCESS )
+            {
+                result = FLASH_FAILURE;
+                break;
+            }
+
+#ifdef  FLASH_API_RX_CFG_IGNORE_LOCK_BITS
+            /* Cancel the ROM Protect feature */
+            FLASH.FPROTR.WORD = 0x5501;
+#else
+            /* Only disable lock bit protection if user has specified to 
+               do so earlier */
+            if( g_lock_bit_protection == false )
+            {
+                /* Cancel the ROM Protect feature */
+                FLASH.FPROTR.WORD = 0x5501;    
+            }       
+#endif
+        }
+
+        /* Get more data when needed */
+        if( available == 0 )
+        {
+            available = producer(flash_addr, &buffer_addr);
+
+            if( (available == 0) || (available & (ROM_PROGRAM_SIZE-1)) )
+            {
+                /* Producer failed or supplied a bad size */
+                result = FLASH_FAILURE;
+                break;
+            }
+
+            /* Ignore data past the end of the write */
+            if( available > bytes )
+            {
+                available = bytes;
+            }
+        }
+
+        /* Do not write past the end of this ROM area */
+        num_byte_to_write = area_end - flash_addr;
+
+        if( num_byte_to_write > available )
+        {
+            num_byte_to_write = available;
+        }
+
+        /* Get maximum programming size that can currently be used. */
+        num_byte_to_write = flash_get_program_size(num_byte_to_write, flash_addr);
+
+        /* Call the Programming function, store the operation status */
+        result = rom_write(flash_addr, buffer_addr, num_byte_to_write);
+
+        /* Check the result for errors */
+        if( result != FLASH_SUCCESS )
+        {
+            break;
+        }
+
+        /* Increment flash address, buffer address and decrement counts */
+        flash_addr  += num_byte_to_write;
+        buffer_addr += num_byte_to_write;
+        bytes       -= num_byte_to_write;
+        available   -= num_byte_to_write;
+    }
+
+    /* Leave Program/Erase Mode */
+    exit_pe_mode(pe_addr);
+
+    /* Release state */
+    flash_release_state();
+
+    return result;
+}
+/******************************************************************************
+End of function  rom_write_long
+******************************************************************************/
+
+/******************************************************************************
+* Function Name: rom_area_end
+* Description  : Returns the address just past the ROM area holding an 
+*                address. P/E mode is entered for one ROM area at a time.
+*                NOTE: This function MUST execute from in RAM.
+* Arguments    : flash_addr - 
+*                    ROM program/erase address
+* Return Value : End of ROM area
+******************************************************************************/
+static uint32_t rom_area_end (uint32_t flash_addr)
+{
+#if defined(ROM_AREA_3)
+    if( flash_addr < ROM_AREA_2 )
+    {
+        return ROM_AREA_2;
+    }
+#endif
+#if defined(ROM_AREA_2)
+    if( flash_addr < ROM_AREA_1 )
+    {
+        return ROM_AREA_1;
+    }
+#endif
+#if defined(ROM_AREA_1)
+    if( flash_addr < ROM_AREA_0 )
+    {
+        return ROM_AREA_0;
+    }
+#endif
+
+    /* Area 0 ends at the top of ROM */
+    return ROM_PE_ADDR + BSP_ROM_SIZE_BYTES;
+}
+/******************************************************************************
+End of function  rom_area_end
 ******************************************************************************/
+#endif /* defined(FLASH_API_RX_CFG_ROM_LONG_WRITE) && !defined(FLASH_API_RX_CFG_ROM_BGO) */
 
 /******************************************************************************
 * Function Name: notify_peripheral_clock
@@ -2313,7 +3338,7 @@ static uint8_t notify_peripheral_clock (FCU_BYTE_PTR flash_addr)
 
     /* Notify Peripheral Clock(PCK) */
     /* Set frequency of PCK in MHz */
-    FLASH.PCKAR.WORD = (FLASH_CLOCK_HZ/1000000);            
+    FLASH.PCKAR.WORD = g_fcu_pclk_mhz;            
 
     /* Execute Peripheral Clock Notification Commands */
     *flash_addr = 0xE9;         
@@ -2388,6 +3413,10 @@ static void flash_reset (void)
     /* Release state */
     flash_release_state();
 
+    /* The FCU has to be initialized and told the clock again after a reset */
+    g_fcu_transfer_complete = 0;
+    g_fcu_pclk_areas = 0;
+
     /* FCU is not reset anymore */
     FLASH.FRESETR.WORD = 0xCC00;
     
@@ -2487,21 +3516,14 @@ static uint32_t flash_get_program_size (uint32_t bytes, uint32_t flash_addr)
 
 #ifndef  FLASH_API_RX_CFG_IGNORE_LOCK_BITS
 /******************************************************************************
-* Function Name: R_FlashProgramLockBit
-* Description  : Programs the lock bit for a specified ROM erasure block. If
-*                the lock bit for a block is set and lock bit protection is 
-*                enabled then that block cannot be programmed/erased.
-*                NOTE: This function MUST execute from RAM
-* Arguments    : block - 
-*                    Which ROM erasure block to set the lock bit for
-* Return Value : FLASH_SUCCESS -
-*                    Operation Successful
-*                FLASH_FAILURE -
-*                    Operation Failed
-*                FLASH_BUSY -
-*                    Another flash operation is in progress
+* Function Name: flash_program_lock_bit
+* Description  : Does the work of R_FlashProgramLockBit() once the FRAM section 
+*                is in RAM.
+*                NOTE: This function MUST execute from in RAM.
+* Arguments    : See R_FlashProgramLockBit()
+* Return Value : See R_FlashProgramLockBit()
 ******************************************************************************/
-uint8_t R_FlashProgramLockBit (uint32_t block)
+static uint8_t flash_program_lock_bit (uint32_t block)
 {
     /* Declare address pointer */
     FCU_BYTE_PTR p_addr;
@@ -2580,25 +3602,18 @@ uint8_t R_FlashProgramLockBit (uint32_t block)
     return result;
 }
 /******************************************************************************
-End of function  R_FlashProgramLockBit
+End of function  flash_program_lock_bit
 ******************************************************************************/
 
 /******************************************************************************
-* Function Name: R_FlashReadLockBit
-* Description  : Reads and returns the lock bit status for a ROM block
-*                NOTE: This function MUST execute from RAM
-* Arguments    : block - 
-*                    Which ROM erasure block to read the lock bit of
-* Return Value : FLASH_LOCK_BIT_SET -
-*                    Lock bit was set
-*                FLASH_LOCK_BIT_NOT_SET -
-*                    Lock bit was not set
-*                FLASH_FAILURE -
-*                    Operation Failed
-*                FLASH_BUSY -
-*                    Another flash operation is in progress
+* Function Name: flash_read_lock_bit
+* Description  : Does the work of R_FlashReadLockBit() once the FRAM section 
+*                is in RAM.
+*                NOTE: This function MUST execute from in RAM.
+* Arguments    : See R_FlashReadLockBit()
+* Return Value : See R_FlashReadLockBit()
 ******************************************************************************/
-uint8_t R_FlashReadLockBit (uint32_t block)
+static uint8_t flash_read_lock_bit (uint32_t block)
 {
     /* Declare address pointer */
     FCU_BYTE_PTR p_addr;
@@ -2672,7 +3687,7 @@ uint8_t R_FlashReadLockBit (uint32_t block)
     return result;
 }
 /******************************************************************************
-End of function  R_FlashReadLockBit
+End of function  flash_read_lock_bit
 ******************************************************************************/
 #endif /* FLASH_API_RX_CFG_IGNORE_LOCK_BITS */
 
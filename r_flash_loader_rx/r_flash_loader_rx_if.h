@@ -23,6 +23,9 @@
 ************************************************************************************************************************
 * History : DD.MM.YYYY Version Description           
 *         : 22.03.2012 3.00    First Release  (Was not present in past FL versions)          
+*         : 19.10.2026 3.10    Added the Bootloader services table and R_FL_GetServices().
+*         : 19.10.2026 3.20    Added 'fast_boot_clear' to the services table.
+*         : 19.10.2026 3.30    Added the slot directory to the services table.
 ***********************************************************************************************************************/
 
 #ifndef FLASH_LOADER_IF_HEADER_FILE
@@ -37,6 +40,8 @@ Includes   <System Includes> , "Project Includes"
 #include <stdbool.h>
 /* Used for configuring the Flash Loader code */
 #include "r_flash_loader_rx_config.h"
+/* Used for load image header and slot directory types */
+#include "r_fl_types.h"
 
 /***********************************************************************************************************************
 Macro definitions
@@ -45,12 +50,66 @@ Macro definitions
 #define FLASH_LOADER_RX_VERSION_MAJOR           (3)
 #define FLASH_LOADER_RX_VERSION_MINOR           (0)
 
+/* Identifies the Bootloader services table ('FLSV') */
+#define FL_SERVICES_MAGIC                       (0x464C5356)
+/* Changes when an entry of the services table is removed or changes meaning */
+#define FL_SERVICES_VERSION_MAJOR               (1)
+/* Changes when entries are added to the end of the services table */
+#define FL_SERVICES_VERSION_MINOR               (2)
+
+/***********************************************************************************************************************
+Typedef definitions
+***********************************************************************************************************************/
+/* Services the Bootloader offers to the User Application. The table is at FL_CFG_SERVICES_ADDR in the Bootloader's ROM
+   (see r_fl_services.c). 'init' must be called before any other entry and again after anything else has used the 
+   memory or CRC peripherals. New entries are only ever added to the end. */
+typedef struct
+{
+    /* FL_SERVICES_MAGIC */
+    uint32_t magic;
+    /* FL_SERVICES_VERSION_MAJOR and FL_SERVICES_VERSION_MINOR of the Bootloader */
+    uint16_t version_major;
+    uint16_t version_minor;
+    /* Size of the table in bytes, so entries added by newer Bootloaders can be checked for */
+    uint32_t bytes;
+    /* Sets up the Bootloader's RAM, the CRC peripheral and the memory holding load images */
+    void     (*init)(void);
+    /* Memory holding load images, see r_fl_memory.h */
+    void     (*mem_read)(uint32_t address, uint8_t * p_buffer, uint32_t bytes);
+    void     (*mem_write)(uint32_t address, uint8_t * p_buffer, uint32_t bytes);
+    bool     (*mem_erase)(uint32_t address, uint8_t size);
+    bool     (*mem_get_busy)(void);
+    /* R_CRC_Compute() */
+    bool     (*crc_compute)(uint16_t seed, uint8_t * p_data, uint32_t bytes, uint16_t * p_crc);
+    /* R_FlashErase(), R_FlashWrite(), R_FlashGetStatus() and R_FlashDataAreaAccess() */
+    uint8_t  (*flash_erase)(uint32_t block);
+    uint8_t  (*flash_write)(uint32_t flash_addr, uint32_t buffer_addr, uint16_t bytes);
+    uint8_t  (*flash_get_status)(void);
+    void     (*flash_data_area_access)(uint16_t read_en_mask, uint16_t write_en_mask);
+    /* Returns the CRC of a load image, which matches raw_crc in its header when the image is complete and correct */
+    uint16_t (*verify_load_image)(uint32_t image_index);
+    /* Makes the next boot check MCU flash and install any new load image instead of going straight to the User 
+       Application (see r_fl_fast_boot.c). Call it after storing a new load image. Returns false if it failed. */
+    bool     (*fast_boot_clear)(void);
+    /* Slot directory, see r_fl_directory.c. Store each load image as: dir_clear_slot, dir_set_state with 
+       FL_DIR_STATE_RECEIVING, mem_write of the image, dir_set_image_info, then dir_set_state with 
+       FL_DIR_STATE_COMPLETE. Call dir_format once if dir_get_entry returns false. All return false if 
+       FL_CFG_MEM_DIR_ENABLE is 0. */
+    bool     (*dir_format)(void);
+    bool     (*dir_get_entry)(uint8_t slot, fl_dir_entry_t * p_entry);
+    bool     (*dir_clear_slot)(uint8_t slot);
+    bool     (*dir_set_state)(uint8_t slot, uint8_t state);
+    bool     (*dir_set_image_info)(uint8_t slot, fl_image_header_t * p_header, uint32_t image_size, 
+                                   uint16_t image_crc);
+} fl_services_t;
+
 /***********************************************************************************************************************
 Public Functions
 ***********************************************************************************************************************/
 void     R_FL_DownloaderInit(void);
 void     R_FL_StateMachine(void);
 uint32_t R_FL_GetVersion(void);
+const fl_services_t * R_FL_GetServices(void);
 
 #endif /* FLASH_LOADER_IF_HEADER_FILE */
 
@@ -0,0 +1,111 @@
+/*******************************************************************************
+* DISCLAIMER
+* This software is supplied by Renesas Electronics Corporation and is only 
+* intended for use with Renesas products. No other uses are authorized. This 
+* software is owned by Renesas Electronics Corporation and is protected under
+* all applicable laws, including copyright laws.
+* THIS SOFTWARE IS PROVIDED "AS IS" AND RENESAS MAKES NO WARRANTIES REGARDING
+* THIS SOFTWARE, WHETHER EXPRESS, IMPLIED OR STATUTORY, INCLUDING BUT NOT
+* LIMITED TO WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE 
+* AND NON-INFRINGEMENT. ALL SUCH WARRANTIES ARE EXPRESSLY DISCLAIMED.
+* TO THE MAXIMUM EXTENT PERMITTED NOT PROHIBITED BY LAW, NEITHER RENESAS 
+* ELECTRONICS CORPORATION NOR ANY OF ITS AFFILIATED COMPANIES SHALL BE LIABLE 
+* FOR ANY DIRECT, INDIRECT, SPECIAL, INCIDENTAL OR CONSEQUENTIAL DAMAGES FOR
+* ANY REASON RELATED TO THIS SOFTWARE, EVEN IF RENESAS OR ITS AFFILIATES HAVE
+* BEEN ADVISED OF THE POSSIBILITY OF SUCH DAMAGES.
+* Renesas reserves the right, without notice, to make changes to this software
+* and to discontinue the availability of this software. By using this software,
+* you agree to the additional terms and conditions found by accessing the 
+* following link:
+* http://www.renesas.com/disclaimer *
+* Copyright (C) 2013 Renesas Electronics Corporation. All rights reserved.    
+*******************************************************************************/
+/*******************************************************************************
+* File Name    : r_fl_crc_sim.c
+* Version      : 1.00
+* Description  : Stands in for the r_crc_rx package on a PC. The CRC is worked
+*                out in software with the polynomial and bit order the 
+*                Flash Loader sets in r_crc_rx_config.h (X^16 + X^12 + X^5 + 1,
+*                MSB first), so it gives the same results as the CRC 
+*                peripheral.
+******************************************************************************/  
+/******************************************************************************
+* History : DD.MM.YYYY Version Description
+*         : 19.10.2026 1.00    First Release
+******************************************************************************/
+
+/******************************************************************************
+Includes   <System Includes> , "Project Includes"
+******************************************************************************/
+/* Fixed width types support. */
+#include <stdint.h>
+/* Used for bool. */
+#include <stdbool.h>
+/* API being stood in for. */
+#include "r_crc_rx_if.h"
+
+/******************************************************************************
+Macro definitions
+******************************************************************************/
+/* X^16 + X^12 + X^5 + 1 */
+#define FL_CRC_SIM_POLY         (0x1021)
+
+/******************************************************************************
+* Function Name: R_CRC_Init
+* Description  : Nothing to set up in software.
+* Arguments    : none
+* Return Value : none
+******************************************************************************/
+void R_CRC_Init (void)
+{
+}
+/******************************************************************************
+End of function R_CRC_Init
+******************************************************************************/
+
+/******************************************************************************
+* Function Name: R_CRC_Compute
+* Description  : Compute the CRC for the input data given.
+* Arguments    : seed - 
+*                    Data to initialize the CRC calculation with
+*                data - 
+*                    Address of data to use
+*                data_bytes - 
+*                    Number of bytes of data
+*                crc_out - 
+*                    Address of where to store computed CRC value.
+* Return Value : true -
+*                    CRC value computed.
+******************************************************************************/
+bool R_CRC_Compute (uint16_t seed, uint8_t * data, uint32_t data_bytes, uint16_t * const crc_out)
+{
+    uint16_t crc;
+    uint32_t i;
+    uint32_t bit;
+
+    crc = seed;
+
+    for (i = 0; i < data_bytes; i++)
+    {
+        crc ^= (uint16_t)(data[i] << 8);
+
+        for (bit = 0; bit < 8; bit++)
+        {
+            if (0 != (crc & 0x8000))
+            {
+                crc = (uint16_t)((crc << 1) ^ FL_CRC_SIM_POLY);
+            }
+            else
+            {
+                crc = (uint16_t)(crc << 1);
+            }
+        }
+    }
+
+    *crc_out = crc;
+
+    return true;
+}
+/******************************************************************************
+End of function R_CRC_Compute
+******************************************************************************/
@@ -0,0 +1,1044 @@
+/*******************************************************************************
+* DISCLAIMER
+* This software is supplied by Renesas Electronics Corporation and is only 
+* intended for use with Renesas products. No other uses are authorized. This 
+* software is owned by Renesas Electronics Corporation and is protected under
+* all applicable laws, including copyright laws.
+* THIS SOFTWARE IS PROVIDED "AS IS" AND RENESAS MAKES NO WARRANTIES REGARDING
+* THIS SOFTWARE, WHETHER EXPRESS, IMPLIED OR STATUTORY, INCLUDING BUT NOT
+* LIMITED TO WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE 
+* AND NON-INFRINGEMENT. ALL SUCH WARRANTIES ARE EXPRESSLY DISCLAIMED.
+* TO THE MAXIMUM EXTENT PERMITTED NOT PROHIBITED BY LAW, NEITHER RENESAS 
+* ELECTRONICS CORPORATION NOR ANY OF ITS AFFILIATED COMPANIES SHALL BE LIABLE 
+* FOR ANY DIRECT, INDIRECT, SPECIAL, INCIDENTAL OR CONSEQUENTIAL DAMAGES FOR
+* ANY REASON RELATED TO THIS SOFTWARE, EVEN IF RENESAS OR ITS AFFILIATES HAVE
+* BEEN ADVISED OF THE POSSIBILITY OF SUCH DAMAGES.
+* Renesas reserves the right, without notice, to make changes to this software
+* and to discontinue the availability of this software. By using this software,
+* you agree to the additional terms and conditions found by accessing the 
+* following link:
+* http://www.renesas.com/disclaimer *
+* Copyright (C) 2013 Renesas Electronics Corporation. All rights reserved.    
+*******************************************************************************/
+/*******************************************************************************
+* File Name    : r_fl_install_test.c
+* Version      : 1.00
+* Description  : Installs a raw, an LZ compressed and a delta load image 
+*                through fl_write_new_image() on a PC, with the Flash API
+*                simulator standing in for the FCU and r_fl_memory_sim.c for
+*                the SPI flash. Each install is first run to the end, which
+*                gives the number of FCU operations it takes. It is then run
+*                again with power lost at each of those operations in turn,
+*                followed by a boot with power kept on. That boot has to
+*                finish the install from where the install journal says it 
+*                stopped, and MCU flash has to end up byte for byte the same
+*                as the new image. Each install is also run with a program or
+*                erase failing at each ROM operation, which the install has
+*                to retry on the same boot.
+*
+*                Every operation is cut by default. A stride can be given on
+*                the command line to cut only every Nth one, which is much 
+*                quicker, see main(). Build it as shown in readme.txt.
+******************************************************************************/  
+/******************************************************************************
+* History : DD.MM.YYYY Version Description
+*         : 19.10.2026 1.00    First Release
+******************************************************************************/
+
+/******************************************************************************
+Includes   <System Includes> , "Project Includes"
+******************************************************************************/
+/* Used for offsetof() */
+#include <stddef.h>
+/* Used for printf() */
+#include <stdio.h>
+/* Used for strtoul() */
+#include <stdlib.h>
+/* Used for strcasecmp() */
+#include <strings.h>
+/* Used for fork() and _exit() */
+#include <unistd.h>
+/* Used for waitpid() */
+#include <sys/wait.h>
+/* Used for makecontext() */
+#include <ucontext.h>
+/* The install functions are static, so the bootloader is built as part of 
+   this file. Its main() is renamed, as it never returns. */
+#define main fl_bootloader_main
+#include "r_fl_bootloader.c"
+#undef main
+/* Simulated FCU. */
+#include "r_flash_sim.h"
+/* Simulated load image memory. */
+#include "r_fl_memory_sim.h"
+
+/******************************************************************************
+Macro definitions
+******************************************************************************/
+/* Image offset of the load image header */
+#define TEST_HEADER_OFFSET      (FL_ROM_BYTES - 0x200)
+/* Offset of the raw_crc field in the image */
+#define TEST_CRC_OFFSET         (TEST_HEADER_OFFSET + offsetof(fl_image_header_t, raw_crc))
+/* Image offsets below this hold code, above it is erased up to the top block */
+#define TEST_CODE_BYTES         (0xA0000)
+/* Top 4KB erase block, which holds the header and the vectors */
+#define TEST_TOP_BLOCK          (FL_ROM_BYTES - 0x1000)
+
+/* Shortest LZ match, and match length field value that has extra bytes */
+#define TEST_LZ_MIN_MATCH       (3)
+#define TEST_LZ_LEN_EXTENDED    (15)
+
+/* Boot results, used as the exit status of each boot */
+#define TEST_BOOT_DONE          (0)
+#define TEST_BOOT_NO_IMAGE      (1)
+#define TEST_BOOT_BAD_IMAGE     (2)
+#define TEST_BOOT_FAILED        (3)
+#define TEST_BOOT_CRASHED       (255)
+
+/* A resumed install may redo the block it was cut in, and the block before
+   it if the journal record for it was being written. Largest block is 32KB. */
+#define TEST_RESUME_SLACK       ((2 * 0x8000) / ROM_PROGRAM_SIZE)
+
+/* Stack each boot runs on */
+#define TEST_STACK_BYTES        (0x40000)
+
+/* Failures printed for each test before the rest are only counted */
+#define TEST_MAX_REPORTS        (5)
+
+/******************************************************************************
+Typedef definitions
+******************************************************************************/
+/* How the new image is stored in the slot */
+typedef enum
+{
+    TEST_FORMAT_RAW = 0,
+    TEST_FORMAT_LZ,
+    TEST_FORMAT_DELTA,
+    TEST_NUM_FORMATS
+} test_format_t;
+
+/******************************************************************************
+Private global variables and functions
+******************************************************************************/
+/* Image in MCU flash before the install, which the delta is made against */
+static uint8_t  g_test_old[FL_ROM_BYTES];
+/* Image being installed */
+static uint8_t  g_test_new[FL_ROM_BYTES];
+/* Slot contents for each format */
+static uint8_t  g_test_slot[TEST_NUM_FORMATS][FL_CFG_MEM_MAX_LI_SIZE_BYTES];
+static uint32_t g_test_slot_bytes[TEST_NUM_FORMATS];
+/* Names of formats for printing */
+static const char * const g_test_format_names[TEST_NUM_FORMATS] = 
+{
+    "raw", "lz", "delta"
+};
+/* State of the random number generator */
+static uint32_t g_test_seed = 1;
+/* Boots run on this stack. The Flash Loader passes buffers on the stack to
+   the Flash API as uint32_t, so they have to be below 4GB. */
+static uint8_t  g_test_stack[TEST_STACK_BYTES];
+/* Function being run by test_run() and what it returned */
+static int   (* g_test_func)(void);
+static int      g_test_result;
+
+static void     test_make_images(void);
+static void     test_make_raw(void);
+static void     test_make_lz(void);
+static void     test_make_delta(void);
+static uint32_t test_delta_op(uint8_t * p_out, uint8_t * p_image, uint32_t * p_pos, uint8_t op, 
+                              uint32_t arg, uint32_t bytes, const uint8_t * p_data);
+static void     test_make_container(test_format_t format, uint8_t image_format, uint32_t stored_bytes);
+static void     test_set_header(uint8_t * p_image, uint8_t version_middle, uint32_t generation);
+static uint32_t test_rand(void);
+static uint32_t test_install(test_format_t format, uint32_t stride, uint32_t first);
+static uint32_t test_retry(test_format_t format, uint32_t stride, uint32_t first);
+static void     test_reset(test_format_t format);
+static int      test_run(int (* p_func)(void));
+static void     test_run_child(void);
+static int      test_boot(void);
+static int      test_erase_df(void);
+static bool     test_rom_is_new(void);
+
+/******************************************************************************
+* Function Name: main
+* Description  : Builds the images and runs the power loss and retry tests 
+*                for each format.
+* Arguments    : argc - 
+*                    Number of arguments
+*                argv - 
+*                    [stride [first [format...]]]
+*                    stride: only every Nth operation is cut, default 1
+*                    first: first operation cut, default 0. Runs with the 
+*                           same stride and first 0 to stride - 1 share the
+*                           work out.
+*                    format: raw, lz or delta, default all of them
+* Return Value : 0 if every install ended with the new image, 1 otherwise
+******************************************************************************/
+int main (int argc, char * argv[])
+{
+    flash_sim_config_t cfg;
+    uint32_t           stride;
+    uint32_t           first;
+    uint32_t           failures;
+    uint32_t           format;
+    bool               run[TEST_NUM_FORMATS];
+    int                arg;
+
+    stride = (argc > 1) ? (uint32_t)strtoul(argv[1], NULL, 0) : 1;
+    first  = (argc > 2) ? (uint32_t)strtoul(argv[2], NULL, 0) : 0;
+
+    for (format = 0; format < TEST_NUM_FORMATS; format++)
+    {
+        run[format] = (bool)(argc <= 3);
+    }
+
+    for (arg = 3; arg < argc; arg++)
+    {
+        for (format = 0; format < TEST_NUM_FORMATS; format++)
+        {
+            if (0 == strcasecmp(argv[arg], g_test_format_names[format]))
+            {
+                run[format] = true;
+                break;
+            }
+        }
+
+        if (TEST_NUM_FORMATS == format)
+        {
+            stride = 0;
+        }
+    }
+
+    if (0 == stride)
+    {
+        printf("Usage: %s [stride [first [raw|lz|delta...]]]\n", argv[0]);
+        return 1;
+    }
+
+    R_FlashSimDefaultConfig(&cfg);
+
+    if ((false == R_FlashSimInit(&cfg)) || (false == fl_mem_sim_init()))
+    {
+        printf("Simulator could not be started\n");
+        return 1;
+    }
+
+    test_make_images();
+
+    failures = 0;
+
+    for (format = 0; format < TEST_NUM_FORMATS; format++)
+    {
+        if (true == run[format])
+        {
+            failures += test_install((test_format_t)format, stride, first);
+            failures += test_retry((test_format_t)format, stride, first);
+        }
+    }
+
+    printf("\n%s: %u failures\n", (0 == failures) ? "PASSED" : "FAILED", (unsigned)failures);
+
+    return (0 == failures) ? 0 : 1;
+}
+/******************************************************************************
+End of function main
+******************************************************************************/
+
+/******************************************************************************
+* Function Name: test_install
+* Description  : Installs one format with power lost at every stride'th FCU
+*                operation, and checks that the next boot finishes it.
+* Arguments    : format - 
+*                    How the new image is stored
+*                stride - 
+*                    Operations between cuts
+*                first - 
+*                    First operation cut
+* Return Value : Number of cuts after which the image was not installed
+******************************************************************************/
+static uint32_t test_install (test_format_t format, uint32_t stride, uint32_t first)
+{
+    flash_sim_fault_t fault;
+    flash_sim_stats_t stats;
+    uint32_t          total_ops;
+    uint32_t          total_programs;
+    uint32_t          programs_before;
+    uint32_t          cut;
+    uint32_t          cuts;
+    uint32_t          failures;
+    int               result;
+
+    /* Uncut install gives the number of operations to cut */
+    test_reset(format);
+
+    result = test_run(test_boot);
+
+    R_FlashSimGetStats(&stats);
+
+    total_ops      = stats.ops[FLASH_SIM_OP_ANY];
+    total_programs = stats.ops[FLASH_SIM_OP_ROM_PROGRAM];
+
+    printf("%-6s install: %u FCU operations, %u ROM programs, %u ROM erases\n", 
+           g_test_format_names[format], (unsigned)total_ops, (unsigned)total_programs,
+           (unsigned)stats.ops[FLASH_SIM_OP_ROM_ERASE]);
+
+    if ((TEST_BOOT_DONE != result) || (false == test_rom_is_new()))
+    {
+        printf("  install without power loss failed (%d)\n", result);
+        return 1;
+    }
+
+    failures = 0;
+    cuts     = 0;
+
+    memset(&fault, 0, sizeof(fault));
+    fault.kind = FLASH_SIM_FAULT_POWER_LOSS;
+    fault.op   = FLASH_SIM_OP_ANY;
+
+    for (cut = first; cut < total_ops; cut += stride)
+    {
+        test_reset(format);
+
+        fault.skip = cut;
+        R_FlashSimSetFault(&fault);
+
+        result = test_run(test_boot);
+
+        R_FlashSimSetFault(NULL);
+        R_FlashSimGetStats(&stats);
+
+        programs_before = stats.ops[FLASH_SIM_OP_ROM_PROGRAM];
+
+        if (FLASH_SIM_EXIT_POWER_LOSS != result)
+        {
+            if (failures++ < TEST_MAX_REPORTS)
+            {
+                printf("  cut at op %u: boot ended with %d before power was lost\n", (unsigned)cut, result);
+            }
+
+            continue;
+        }
+
+        /* Boot with power kept on finishes the install */
+        R_FlashSimClearStats();
+
+        result = test_run(test_boot);
+
+        R_FlashSimGetStats(&stats);
+
+        cuts++;
+
+        if ((TEST_BOOT_DONE != result) || (false == test_rom_is_new()))
+        {
+            if (failures++ < TEST_MAX_REPORTS)
+            {
+                printf("  cut at op %u: next boot ended with %d, MCU flash %s the new image\n", (unsigned)cut, 
+                       result, (true == test_rom_is_new()) ? "is" : "is not");
+            }
+        }
+        else if ((stats.ops[FLASH_SIM_OP_ROM_PROGRAM] + programs_before) > (total_programs + TEST_RESUME_SLACK))
+        {
+            if (failures++ < TEST_MAX_REPORTS)
+            {
+                printf("  cut at op %u: next boot did not resume, %u ROM programs after %u\n", (unsigned)cut, 
+                       (unsigned)stats.ops[FLASH_SIM_OP_ROM_PROGRAM], (unsigned)programs_before);
+            }
+        }
+    }
+
+    printf("  %u power losses, %u failures\n", (unsigned)cuts, (unsigned)failures);
+
+    return failures;
+}
+/******************************************************************************
+End of function test_install
+******************************************************************************/
+
+/******************************************************************************
+* Function Name: test_retry
+* Description  : Installs one format with a program or erase failing at every
+*                stride'th ROM operation, and checks that the same boot 
+*                retries it and installs the image.
+* Arguments    : format - 
+*                    How the new image is stored
+*                stride - 
+*                    Operations between failures
+*                first - 
+*                    First operation that fails
+* Return Value : Number of failures after which the image was not installed
+******************************************************************************/
+static uint32_t test_retry (test_format_t format, uint32_t stride, uint32_t first)
+{
+    flash_sim_fault_t fault;
+    flash_sim_stats_t stats;
+    uint32_t          total_ops;
+    uint32_t          failed;
+    uint32_t          errors;
+    uint32_t          failures;
+    int               result;
+
+    /* Number of ROM programs and erases to fail */
+    test_reset(format);
+
+    (void)test_run(test_boot);
+
+    R_FlashSimGetStats(&stats);
+
+    total_ops = stats.ops[FLASH_SIM_OP_ROM_PROGRAM] + stats.ops[FLASH_SIM_OP_ROM_ERASE];
+
+    failures = 0;
+    errors   = 0;
+
+    memset(&fault, 0, sizeof(fault));
+    fault.kind       = FLASH_SIM_FAULT_ERROR;
+    fault.op         = FLASH_SIM_OP_ANY;
+    fault.start_addr = FL_ROM_PE_START;
+    fault.end_addr   = (FL_ROM_PE_START + FL_ROM_BYTES) - 1;
+
+    for (failed = first; failed < total_ops; failed += stride)
+    {
+        test_reset(format);
+
+        fault.skip = failed;
+        R_FlashSimSetFault(&fault);
+
+        result = test_run(test_boot);
+
+        R_FlashSimGetStats(&stats);
+        R_FlashSimSetFault(NULL);
+
+        errors += stats.faults;
+
+        if ((TEST_BOOT_DONE != result) || (false == test_rom_is_new()))
+        {
+            if (failures++ < TEST_MAX_REPORTS)
+            {
+                printf("  ROM op %u failed: boot ended with %d, MCU flash %s the new image\n", (unsigned)failed,
+                       result, (true == test_rom_is_new()) ? "is" : "is not");
+            }
+        }
+    }
+
+    printf("  %u ROM op errors retried, %u failures\n", (unsigned)errors, (unsigned)failures);
+
+    return failures;
+}
+/******************************************************************************
+End of function test_retry
+******************************************************************************/
+
+/******************************************************************************
+* Function Name: test_reset
+* Description  : Puts the old image in MCU flash, erases data flash and fills
+*                the load image memory with a slot holding the new image. 
+*                Statistics are cleared.
+* Arguments    : format - 
+*                    How the new image is stored
+* Return Value : none
+******************************************************************************/
+static void test_reset (test_format_t format)
+{
+    R_FlashSimSetFault(NULL);
+
+    R_FlashSimLoad(FL_ROM_READ_START, g_test_old, FL_ROM_BYTES);
+
+    if (TEST_BOOT_DONE != test_run(test_erase_df))
+    {
+        printf("  data flash could not be erased\n");
+    }
+
+    memset(fl_mem_sim_data(), 0xFF, FL_MEM_SIM_BYTES);
+    memcpy(fl_mem_sim_data() + FL_CFG_MEM_BASE_ADDR, g_test_slot[format], g_test_slot_bytes[format]);
+
+    R_FlashSimClearStats();
+}
+/******************************************************************************
+End of function test_reset
+******************************************************************************/
+
+/******************************************************************************
+* Function Name: test_run
+* Description  : Runs a function in a new process, as if the part had just 
+*                been powered on. Flash and load image memory are shared with
+*                it, everything else starts as it is in this process.
+* Arguments    : p_func - 
+*                    Function to run
+* Return Value : What the function returned, FLASH_SIM_EXIT_POWER_LOSS if power
+*                was lost, or TEST_BOOT_CRASHED
+******************************************************************************/
+static int test_run (int (* p_func)(void))
+{
+    ucontext_t run_context;
+    ucontext_t func_context;
+    pid_t      pid;
+    int        status;
+
+    fflush(stdout);
+
+    pid = fork();
+
+    if (0 == pid)
+    {
+        R_FlashSimPowerOn();
+
+        g_test_func = p_func;
+
+        getcontext(&func_context);
+        func_context.uc_stack.ss_sp   = g_test_stack;
+        func_context.uc_stack.ss_size = sizeof(g_test_stack);
+        func_context.uc_link          = &run_context;
+        makecontext(&func_context, test_run_child, 0);
+
+        swapcontext(&run_context, &func_context);
+
+        _exit(g_test_result);
+    }
+
+    if ((pid < 0) || (waitpid(pid, &status, 0) != pid) || (!WIFEXITED(status)))
+    {
+        return TEST_BOOT_CRASHED;
+    }
+
+    return WEXITSTATUS(status);
+}
+/******************************************************************************
+End of function test_run
+******************************************************************************/
+
+/******************************************************************************
+* Function Name: test_run_child
+* Description  : Runs the function given to test_run() on g_test_stack.
+* Arguments    : none
+* Return Value : none
+******************************************************************************/
+static void test_run_child (void)
+{
+    g_test_result = g_test_func();
+}
+/******************************************************************************
+End of function test_run_child
+******************************************************************************/
+
+/******************************************************************************
+* Function Name: test_boot
+* Description  : Boots as the bootloader's main() does when a load image is 
+*                stored: a new image is checked and installed, and an image 
+*                that is already in MCU flash is left as it is. Returns 
+*                instead of starting the User Application.
+* Arguments    : none
+* Return Value : TEST_BOOT_DONE - 
+*                    New image is in MCU flash
+*                TEST_BOOT_NO_IMAGE - 
+*                    No valid load image was found
+*                TEST_BOOT_BAD_IMAGE - 
+*                    Load image failed its check
+*                TEST_BOOT_FAILED - 
+*                    Install failed
+******************************************************************************/
+static int test_boot (void)
+{
+    int32_t image_to_load;
+
+    R_CRC_Init();
+
+    fl_kv_init();
+    fl_kv_add(FL_KV_KEY_BOOT_COUNT, 1);
+
+    fl_mem_init();
+
+    g_pfl_cur_app_header = (fl_image_header_t *)__sectop("APPHEADER_1");
+
+    fl_get_load_image_headers();
+
+    image_to_load = fl_get_latest_image();
+
+    if (-1 == image_to_load)
+    {
+        return TEST_BOOT_NO_IMAGE;
+    }
+
+    /* Same image already in MCU flash */
+    if ((true == FL_LI_IS_VALID(g_pfl_cur_app_header->valid_mask)) &&
+        (g_pfl_cur_app_header->version_major == g_fl_load_image_headers[image_to_load].version_major) &&
+        (g_pfl_cur_app_header->version_middle == g_fl_load_image_headers[image_to_load].version_middle) &&
+        (g_pfl_cur_app_header->version_minor == g_fl_load_image_headers[image_to_load].version_minor) &&
+        (g_pfl_cur_app_header->version_comp == g_fl_load_image_headers[image_to_load].version_comp) &&
+        (true == fl_app_is_valid(true)))
+    {
+        return TEST_BOOT_DONE;
+    }
+
+    if (fl_verify_load_image((uint32_t)image_to_load) != g_fl_load_image_headers[image_to_load].raw_crc)
+    {
+        return TEST_BOOT_BAD_IMAGE;
+    }
+
+    if (false == fl_write_new_image((uint8_t)image_to_load))
+    {
+        return TEST_BOOT_FAILED;
+    }
+
+    fl_kv_add(FL_KV_KEY_INSTALL_COUNT, 1);
+
+    if (false == fl_app_is_valid(false))
+    {
+        return TEST_BOOT_FAILED;
+    }
+
+    return TEST_BOOT_DONE;
+}
+/******************************************************************************
+End of function test_boot
+******************************************************************************/
+
+/******************************************************************************
+* Function Name: test_erase_df
+* Description  : Erases all of data flash, leaving the key-value store empty.
+* Arguments    : none
+* Return Value : TEST_BOOT_DONE or TEST_BOOT_FAILED
+******************************************************************************/
+static int test_erase_df (void)
+{
+    uint32_t block;
+
+    R_FlashDataAreaAccess(0xFFFF, 0xFFFF);
+
+    for (block = BLOCK_DB0; block < (BLOCK_DB0 + DF_NUM_BLOCKS); block++)
+    {
+        if (FLASH_SUCCESS != R_FlashErase(block))
+        {
+            return TEST_BOOT_FAILED;
+        }
+    }
+
+    return TEST_BOOT_DONE;
+}
+/******************************************************************************
+End of function test_erase_df
+******************************************************************************/
+
+/******************************************************************************
+* Function Name: test_rom_is_new
+* Description  : Checks MCU flash against the new image.
+* Arguments    : none
+* Return Value : true if they are the same
+******************************************************************************/
+static bool test_rom_is_new (void)
+{
+    return (bool)(0 == memcmp(R_FlashSimRom(), g_test_new, FL_ROM_BYTES));
+}
+/******************************************************************************
+End of function test_rom_is_new
+******************************************************************************/
+
+/******************************************************************************
+* Function Name: test_make_images
+* Description  : Makes the old and new images and the slot contents for each
+*                format. The old image is code made of a small set of 
+*                repeated sequences, so it compresses as code does, followed
+*                by erased flash and the header and vectors in the top block.
+*                The new image is the old one with the changes in the delta.
+* Arguments    : none
+* Return Value : none
+******************************************************************************/
+static void test_make_images (void)
+{
+    uint8_t  words[64][16];
+    uint32_t offset;
+    uint32_t word;
+    uint32_t bytes;
+    uint32_t i;
+
+    for (word = 0; word < 64; word++)
+    {
+        for (i = 0; i < 16; i++)
+        {
+            words[word][i] = (uint8_t)test_rand();
+        }
+    }
+
+    memset(g_test_old, 0xFF, FL_ROM_BYTES);
+
+    for (offset = 0; offset < TEST_CODE_BYTES; offset += bytes)
+    {
+        word  = test_rand() % 64;
+        bytes = 2 + (test_rand() % 15);
+
+        if (bytes > (TEST_CODE_BYTES - offset))
+        {
+            bytes = TEST_CODE_BYTES - offset;
+        }
+
+        memcpy(&g_test_old[offset], words[word], bytes);
+    }
+
+    /* Constant data below the header, and the vectors above it */
+    for (offset = TEST_TOP_BLOCK; offset < TEST_HEADER_OFFSET; offset++)
+    {
+        g_test_old[offset] = (uint8_t)test_rand();
+    }
+
+    for (offset = FL_ROM_BYTES - 0x80; offset < FL_ROM_BYTES; offset++)
+    {
+        g_test_old[offset] = (uint8_t)test_rand();
+    }
+
+    test_set_header(g_test_old, 0, 1);
+
+    /* Delta gives the new image */
+    test_make_delta();
+    test_make_raw();
+    test_make_lz();
+}
+/******************************************************************************
+End of function test_make_images
+******************************************************************************/
+
+/******************************************************************************
+* Function Name: test_make_delta
+* Description  : Makes the new image from the old one and the delta slot 
+*                that does the same. The delta rebuilds 3 blocks:
+*                  0x00000, 32KB: 16 new bytes, then the old block moved up,
+*                                 so it copies from inside itself and needs
+*                                 the scratch copy.
+*                  0x88000, 16KB: data copied from an unchanged block, a fill
+*                                 and part of the old block moved up.
+*                  TEST_TOP_BLOCK, 4KB: the new header.
+* Arguments    : none
+* Return Value : none
+******************************************************************************/
+static void test_make_delta (void)
+{
+    uint8_t           data[16];
+    uint8_t *         p_out;
+    fl_delta_header_t delta;
+    fl_delta_block_t  block;
+    uint32_t          pos;
+    uint32_t          i;
+
+    memcpy(g_test_new, g_test_old, FL_ROM_BYTES);
+
+    for (i = 0; i < sizeof(data); i++)
+    {
+        data[i] = (uint8_t)test_rand();
+    }
+
+    /* Data starts after the container header */
+    p_out = &g_test_slot[TEST_FORMAT_DELTA][sizeof(fl_container_header_t)];
+
+    memcpy(&delta.base_crc, &g_test_old[TEST_CRC_OFFSET], sizeof(delta.base_crc));
+    delta.num_blocks = 3;
+    memcpy(p_out, &delta, sizeof(delta));
+    p_out += sizeof(delta);
+
+    /* Old block moved up by 16 bytes */
+    block.offset = 0x00000;
+    block.length = 0x8000;
+    memcpy(p_out, &block, sizeof(block));
+    p_out += sizeof(block);
+    pos = block.offset;
+    p_out += test_delta_op(p_out, g_test_new, &pos, FL_DELTA_OP_INSERT, 0, sizeof(data), data);
+    p_out += test_delta_op(p_out, g_test_new, &pos, FL_DELTA_OP_COPY, 0x00000, block.length - sizeof(data), NULL);
+
+    /* Copy from elsewhere, fill and part of the old block moved up */
+    block.offset = 0x88000;
+    block.length = 0x4000;
+    memcpy(p_out, &block, sizeof(block));
+    p_out += sizeof(block);
+    pos = block.offset;
+    p_out += test_delta_op(p_out, g_test_new, &pos, FL_DELTA_OP_COPY, 0x30000, 0x2000, NULL);
+    p_out += test_delta_op(p_out, g_test_new, &pos, FL_DELTA_OP_FILL, 0x00, 0x1000, NULL);
+    p_out += test_delta_op(p_out, g_test_new, &pos, FL_DELTA_OP_COPY, 0x89000, 0x1000, NULL);
+
+    /* New header. Its CRC covers the blocks above, so they are done first. */
+    test_set_header(g_test_new, 1, 2);
+
+    block.offset = TEST_TOP_BLOCK;
+    block.length = 0x1000;
+    memcpy(p_out, &block, sizeof(block));
+    p_out += sizeof(block);
+    pos = block.offset;
+    p_out += test_delta_op(p_out, g_test_new, &pos, FL_DELTA_OP_COPY, TEST_TOP_BLOCK, 
+                           TEST_HEADER_OFFSET - TEST_TOP_BLOCK, NULL);
+    p_out += test_delta_op(p_out, g_test_new, &pos, FL_DELTA_OP_INSERT, 0, sizeof(fl_image_header_t), 
+                           &g_test_new[TEST_HEADER_OFFSET]);
+    p_out += test_delta_op(p_out, g_test_new, &pos, FL_DELTA_OP_COPY, pos, FL_ROM_BYTES - pos, NULL);
+
+    test_make_container(TEST_FORMAT_DELTA, FL_IMAGE_FORMAT_DELTA, 
+                        (uint32_t)(p_out - &g_test_slot[TEST_FORMAT_DELTA][sizeof(fl_container_header_t)]));
+}
+/******************************************************************************
+End of function test_make_delta
+******************************************************************************/
+
+/******************************************************************************
+* Function Name: test_delta_op
+* Description  : Writes a delta operation and applies it to the new image, 
+*                with old data taken from the old image.
+* Arguments    : p_out - 
+*                    Where to write the operation
+*                p_image - 
+*                    New image
+*                p_pos - 
+*                    Image offset the operation writes to. Moved on past it.
+*                op - 
+*                    FL_DELTA_OP_xxx
+*                arg - 
+*                    Source offset for a copy, value for a fill
+*                bytes - 
+*                    Bytes the operation produces
+*                p_data - 
+*                    Data for an insert
+* Return Value : Bytes written to p_out
+******************************************************************************/
+static uint32_t test_delta_op (uint8_t * p_out, uint8_t * p_image, uint32_t * p_pos, uint8_t op, 
+                               uint32_t arg, uint32_t bytes, const uint8_t * p_data)
+{
+    uint16_t insert_bytes;
+    uint8_t  value;
+    uint32_t written;
+
+    p_out[0] = op;
+    written  = 1;
+
+    if (FL_DELTA_OP_COPY == op)
+    {
+        memcpy(&p_out[written], &arg, sizeof(arg));
+        written += sizeof(arg);
+        memcpy(&p_out[written], &bytes, sizeof(bytes));
+        written += sizeof(bytes);
+
+        memcpy(&p_image[*p_pos], &g_test_old[arg], bytes);
+    }
+    else if (FL_DELTA_OP_INSERT == op)
+    {
+        insert_bytes = (uint16_t)bytes;
+        memcpy(&p_out[written], &insert_bytes, sizeof(insert_bytes));
+        written += sizeof(insert_bytes);
+        memcpy(&p_out[written], p_data, bytes);
+        written += bytes;
+
+        memcpy(&p_image[*p_pos], p_data, bytes);
+    }
+    else
+    {
+        value = (uint8_t)arg;
+        memcpy(&p_out[written], &bytes, sizeof(bytes));
+        written += sizeof(bytes);
+        p_out[written] = value;
+        written += sizeof(value);
+
+        memset(&p_image[*p_pos], value, bytes);
+    }
+
+    *p_pos += bytes;
+
+    return written;
+}
+/******************************************************************************
+End of function test_delta_op
+******************************************************************************/
+
+/******************************************************************************
+* Function Name: test_make_raw
+* Description  : Makes the raw slot, which is a copy of the new image.
+* Arguments    : none
+* Return Value : none
+******************************************************************************/
+static void test_make_raw (void)
+{
+    memcpy(g_test_slot[TEST_FORMAT_RAW], g_test_new, FL_ROM_BYTES);
+
+    g_test_slot_bytes[TEST_FORMAT_RAW] = FL_ROM_BYTES;
+}
+/******************************************************************************
+End of function test_make_raw
+******************************************************************************/
+
+/******************************************************************************
+* Function Name: test_make_lz
+* Description  : Makes the LZ slot. The new image is compressed greedily, 
+*                using the last place each 3 byte sequence was seen, in the
+*                format described in r_fl_lz.c.
+* Arguments    : none
+* Return Value : none
+******************************************************************************/
+static void test_make_lz (void)
+{
+    static int32_t last[0x10000];
+    uint8_t *      p_out;
+    uint32_t       out;
+    uint32_t       flag_pos;
+    uint32_t       items;
+    uint32_t       pos;
+    uint32_t       len;
+    uint32_t       extra;
+    uint32_t       hash;
+    int32_t        match;
+    uint16_t       token;
+
+    p_out = &g_test_slot[TEST_FORMAT_LZ][sizeof(fl_container_header_t)];
+
+    for (hash = 0; hash < 0x10000; hash++)
+    {
+        last[hash] = -1;
+    }
+
+    out      = 0;
+    flag_pos = 0;
+    items    = 8;
+    pos      = 0;
+
+    while (pos < FL_ROM_BYTES)
+    {
+        if (8 == items)
+        {
+            flag_pos = out++;
+            p_out[flag_pos] = 0;
+            items = 0;
+        }
+
+        len   = 0;
+        match = -1;
+
+        if ((pos + TEST_LZ_MIN_MATCH) <= FL_ROM_BYTES)
+        {
+            hash  = ((uint32_t)g_test_new[pos] << 8) ^ ((uint32_t)g_test_new[pos + 1] << 4) ^ g_test_new[pos + 2];
+            hash &= 0xFFFF;
+            match = last[hash];
+
+            if ((match >= 0) && ((pos - (uint32_t)match) <= FL_LZ_WINDOW_BYTES))
+            {
+                while (((pos + len) < FL_ROM_BYTES) && (g_test_new[match + len] == g_test_new[pos + len]))
+                {
+                    len++;
+                }
+            }
+
+            last[hash] = (int32_t)pos;
+        }
+
+        if (len >= TEST_LZ_MIN_MATCH)
+        {
+            extra = len - TEST_LZ_MIN_MATCH;
+            token = (uint16_t)((pos - (uint32_t)match) - 1);
+            token |= (uint16_t)(((extra < TEST_LZ_LEN_EXTENDED) ? extra : TEST_LZ_LEN_EXTENDED) << 12);
+
+            p_out[out++] = (uint8_t)token;
+            p_out[out++] = (uint8_t)(token >> 8);
+
+            if (extra >= TEST_LZ_LEN_EXTENDED)
+            {
+                for (extra -= TEST_LZ_LEN_EXTENDED; extra >= 0xFF; extra -= 0xFF)
+                {
+                    p_out[out++] = 0xFF;
+                }
+
+                p_out[out++] = (uint8_t)extra;
+            }
+
+            pos += len;
+        }
+        else
+        {
+            p_out[flag_pos] |= (uint8_t)(1 << items);
+            p_out[out++] = g_test_new[pos];
+            pos++;
+        }
+
+        items++;
+    }
+
+    test_make_container(TEST_FORMAT_LZ, FL_IMAGE_FORMAT_LZ, out);
+}
+/******************************************************************************
+End of function test_make_lz
+******************************************************************************/
+
+/******************************************************************************
+* Function Name: test_make_container
+* Description  : Fills in the container header of a slot whose image data is
+*                already in place.
+* Arguments    : format - 
+*                    Slot to fill in
+*                image_format - 
+*                    FL_IMAGE_FORMAT_xxx
+*                stored_bytes - 
+*                    Bytes of image data after the container header
+* Return Value : none
+******************************************************************************/
+static void test_make_container (test_format_t format, uint8_t image_format, uint32_t stored_bytes)
+{
+    fl_container_header_t container;
+
+    memset(&container, 0, sizeof(container));
+
+    container.magic       = FL_CONTAINER_MAGIC;
+    container.format      = image_format;
+    container.raw_size    = FL_ROM_BYTES;
+    container.stored_size = stored_bytes;
+    memcpy(&container.header, &g_test_new[TEST_HEADER_OFFSET], sizeof(container.header));
+
+    R_CRC_Compute(FL_CRC_SEED, &g_test_slot[format][sizeof(container)], stored_bytes, &container.stored_crc);
+
+    memcpy(g_test_slot[format], &container, sizeof(container));
+
+    g_test_slot_bytes[format] = sizeof(container) + stored_bytes;
+}
+/******************************************************************************
+End of function test_make_container
+******************************************************************************/
+
+/******************************************************************************
+* Function Name: test_set_header
+* Description  : Writes a load image header in to an image and works out its
+*                raw_crc as the RX linker does.
+* Arguments    : p_image - 
+*                    Image to change
+*                version_middle - 
+*                    Version of the image
+*                generation - 
+*                    Generation of the image
+* Return Value : none
+******************************************************************************/
+static void test_set_header (uint8_t * p_image, uint8_t version_middle, uint32_t generation)
+{
+    fl_image_header_t header;
+    uint16_t          crc;
+
+    memset(&header, 0, sizeof(header));
+
+    header.valid_mask     = FL_LI_VALID_MASK_GEN;
+    header.version_major  = 1;
+    header.version_middle = version_middle;
+    header.generation     = generation;
+
+    memcpy(&p_image[TEST_HEADER_OFFSET], &header, sizeof(header));
+
+    R_CRC_Compute(RX_LINKER_SEED, p_image, TEST_CRC_OFFSET, &crc);
+    R_CRC_Compute(crc, &p_image[TEST_CRC_OFFSET + sizeof(uint16_t)], 
+                  FL_ROM_BYTES - (TEST_CRC_OFFSET + sizeof(uint16_t)), &crc);
+
+    crc = (uint16_t)~crc;
+    memcpy(&p_image[TEST_CRC_OFFSET], &crc, sizeof(crc));
+}
+/******************************************************************************
+End of function test_set_header
+******************************************************************************/
+
+/******************************************************************************
+* Function Name: test_rand
+* Description  : Returns the next pseudo random number. The sequence is the 
+*                same on every run.
+* Arguments    : none
+* Return Value : Random number
+******************************************************************************/
+static uint32_t test_rand (void)
+{
+    g_test_seed = (g_test_seed * 1103515245u) + 12345u;
+
+    return g_test_seed >> 16;
+}
+/******************************************************************************
+End of function test_rand
+******************************************************************************/
@@ -0,0 +1,322 @@
+/*******************************************************************************
+* DISCLAIMER
+* This software is supplied by Renesas Electronics Corporation and is only 
+* intended for use with Renesas products. No other uses are authorized. This 
+* software is owned by Renesas Electronics Corporation and is protected under
+* all applicable laws, including copyright laws.
+* THIS SOFTWARE IS PROVIDED "AS IS" AND RENESAS MAKES NO WARRANTIES REGARDING
+* THIS SOFTWARE, WHETHER EXPRESS, IMPLIED OR STATUTORY, INCLUDING BUT NOT
+* LIMITED TO WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE 
+* AND NON-INFRINGEMENT. ALL SUCH WARRANTIES ARE EXPRESSLY DISCLAIMED.
+* TO THE MAXIMUM EXTENT PERMITTED NOT PROHIBITED BY LAW, NEITHER RENESAS 
+* ELECTRONICS CORPORATION NOR ANY OF ITS AFFILIATED COMPANIES SHALL BE LIABLE 
+* FOR ANY DIRECT, INDIRECT, SPECIAL, INCIDENTAL OR CONSEQUENTIAL DAMAGES FOR
+* ANY REASON RELATED TO THIS SOFTWARE, EVEN IF RENESAS OR ITS AFFILIATES HAVE
+* BEEN ADVISED OF THE POSSIBILITY OF SUCH DAMAGES.
+* Renesas reserves the right, without notice, to make changes to this software
+* and to discontinue the availability of this software. By using this software,
+* you agree to the additional terms and conditions found by accessing the 
+* following link:
+* http://www.renesas.com/disclaimer *
+* Copyright (C) 2013 Renesas Electronics Corporation. All rights reserved.    
+*******************************************************************************/
+/*******************************************************************************
+* File Name    : r_fl_memory_sim.c
+* Version      : 1.00
+* Description  : Stands in for r_fl_memory_spi_flash.c on a PC. Load image 
+*                memory is held in RAM that acts like NOR flash: programming
+*                only clears bits and erasing sets a sector to 0xFF. The RAM
+*                is shared across fork() like the simulated MCU flash, so what
+*                one boot leaves in it is seen by the next.
+******************************************************************************/  
+/******************************************************************************
+* History : DD.MM.YYYY Version Description
+*         : 19.10.2026 1.00    First Release
+******************************************************************************/
+
+/******************************************************************************
+Includes   <System Includes> , "Project Includes"
+******************************************************************************/
+/* Used for mmap(). */
+#include <sys/mman.h>
+/* Used for memset() and memcpy(). */
+#include <string.h>
+/* Fixed width types support. */
+#include <stdint.h>
+/* Used for bool. */
+#include <stdbool.h>
+/* Flash Loader project includes. */
+#include "r_fl_includes.h"
+/* Simulated memory. */
+#include "r_fl_memory_sim.h"
+
+/******************************************************************************
+Macro definitions
+******************************************************************************/
+/* Everything the Flash Loader keeps in memory must fit */
+#if (FL_CFG_DELTA_SCRATCH_ADDR + FL_CFG_DELTA_SCRATCH_BYTES) > FL_MEM_SIM_BYTES
+    #error "Memory areas do not fit in FL_MEM_SIM_BYTES. Please fix in r_fl_memory_sim.h"
+#endif
+
+/******************************************************************************
+Private global variables and functions
+******************************************************************************/
+/* Contents of the simulated memory */
+static uint8_t * g_fl_mem_sim_data = NULL;
+
+/******************************************************************************
+Exported global variables (to be accessed by other files)
+******************************************************************************/
+/* This structure defines the memory that load images will be stored in. The
+   'addresses' table is filled in by fl_mem_init(). */
+fl_li_storage_t g_fl_li_mem_info = 
+{
+    /* The minimum erase size in bytes. */
+    (uint32_t)FL_CFG_MEM_SECTOR_BYTES,
+    /* The maximum bytes that can be programmed at once. */
+    (0x400),
+    /* Addresses of FL Load Images. These are generated at init. */
+    { 0 }
+};
+
+/******************************************************************************
+* Function Name: fl_mem_sim_init
+* Description  : Maps the simulated memory, erased. Call once, before the 
+*                first fork(). Later calls do nothing.
+* Arguments    : none
+* Return value : true - 
+*                    Memory is ready
+*                false - 
+*                    Could not map it
+******************************************************************************/
+bool fl_mem_sim_init(void)
+{
+    void * p_map;
+
+    if(g_fl_mem_sim_data != NULL)
+    {
+        return true;
+    }
+
+    /* Below 4GB, as pointers in to memory may be passed as uint32_t */
+    p_map = mmap(NULL, FL_MEM_SIM_BYTES, PROT_READ | PROT_WRITE, 
+                 MAP_SHARED | MAP_ANONYMOUS | MAP_32BIT, -1, 0);
+
+    if(p_map == MAP_FAILED)
+    {
+        return false;
+    }
+
+    g_fl_mem_sim_data = (uint8_t *)p_map;
+
+    memset(g_fl_mem_sim_data, 0xFF, FL_MEM_SIM_BYTES);
+
+    return true;
+}
+/******************************************************************************
+End of function fl_mem_sim_init
+******************************************************************************/
+
+/******************************************************************************
+* Function Name: fl_mem_sim_data
+* Description  : Returns a writable view of the simulated memory, so tests 
+*                can fill it as a download would. Writes through it are not
+*                checked.
+* Arguments    : none
+* Return value : Memory contents, address 0 first
+******************************************************************************/
+uint8_t * fl_mem_sim_data(void)
+{
+    return g_fl_mem_sim_data;
+}
+/******************************************************************************
+End of function fl_mem_sim_data
+******************************************************************************/
+
+/******************************************************************************
+* Function Name: fl_mem_read
+* Description  : Reads data from memory where load images are stored
+* Arguments    : rx_address - 
+*                    Where to read from in memory
+*                rx_buffer - 
+*                    Where to place read data
+*                rx_bytes - 
+*                    How many bytes to read
+* Return value : none
+******************************************************************************/
+void fl_mem_read(uint32_t rx_address, uint8_t * rx_buffer, uint32_t rx_bytes)
+{
+    memcpy(rx_buffer, &g_fl_mem_sim_data[rx_address], rx_bytes);
+}
+/******************************************************************************
+End of function fl_mem_read
+******************************************************************************/
+
+/******************************************************************************
+* Function Name: fl_mem_map
+* Description  : Gives access to data in memory. The memory is in RAM so this
+*                always points straight in to it.
+* Arguments    : rx_address - 
+*                    Where to read from in memory
+*                rx_buffer - 
+*                    Not used
+*                rx_bytes - 
+*                    How many bytes are needed
+* Return value : Pointer to the data
+******************************************************************************/
+uint8_t * fl_mem_map(uint32_t rx_address, uint8_t * rx_buffer, uint32_t rx_bytes)
+{
+    (void)rx_buffer;
+    (void)rx_bytes;
+
+    return &g_fl_mem_sim_data[rx_address];
+}
+/******************************************************************************
+End of function fl_mem_map
+******************************************************************************/
+
+/******************************************************************************
+* Function Name: fl_mem_write
+* Description  : Writes data to memory where load images are stored. As with
+*                flash, bits that are already 0 stay 0.
+* Arguments    : tx_address - 
+*                    Where to write in memory
+*                tx_buffer - 
+*                    What data to write                 
+*                tx_bytes - 
+*                    How many bytes to write
+* Return value : none
+******************************************************************************/
+void fl_mem_write(uint32_t tx_address, uint8_t *tx_buffer, uint32_t tx_bytes)
+{
+    uint32_t i;
+
+    for(i = 0; i < tx_bytes; i++)
+    {
+        g_fl_mem_sim_data[tx_address + i] &= tx_buffer[i];
+    }
+}
+/******************************************************************************
+End of function fl_mem_write
+******************************************************************************/
+
+/******************************************************************************
+* Function Name: fl_mem_get_busy
+* Description  : Returns whether the memory is currently busy
+* Arguments    : none
+* Return value : false - 
+*                    Operations complete at once
+******************************************************************************/
+bool fl_mem_get_busy(void)
+{
+    return false;
+}
+/******************************************************************************
+End of function fl_mem_get_busy
+******************************************************************************/
+
+/******************************************************************************
+* Function Name: fl_mem_init
+* Description  : Generates the load image addresses. The memory itself is 
+*                set up by fl_mem_sim_init() and keeps its contents.
+* Arguments    : none
+* Return value : none
+******************************************************************************/
+void fl_mem_init(void)
+{
+    uint32_t i;
+
+    /* Load images are placed back to back starting at FL_CFG_MEM_BASE_ADDR.
+       The last entry in the array is the max address for load image data. */
+    for(i = 0; i <= FL_CFG_MEM_NUM_LOAD_IMAGES; i++)
+    {
+        g_fl_li_mem_info.addresses[i] = FL_CFG_MEM_BASE_ADDR + (i * FL_CFG_MEM_MAX_LI_SIZE_BYTES);
+    }
+}
+/******************************************************************************
+End of function fl_mem_init
+******************************************************************************/
+
+/******************************************************************************
+* Function Name: fl_mem_erase
+* Description  : Erases parts, or whole, memory used for FL load images
+* Arguments    : address - 
+*                    Where you want to erase
+*                size - 
+*                    How many bytes to erase
+* Return value : true - 
+*                    Sucessfull
+*                false - 
+*                    Not successfull, invalid argument
+******************************************************************************/
+bool fl_mem_erase(const uint32_t address, const uint8_t size)
+{
+    if(size == FL_MEM_ERASE_SECTOR)
+    {
+        memset(&g_fl_mem_sim_data[address & ~(g_fl_li_mem_info.erase_size - 1)], 
+               0xFF, 
+               g_fl_li_mem_info.erase_size);
+    } 
+    else if(size == FL_MEM_ERASE_CHIP)
+    {
+        memset(g_fl_mem_sim_data, 0xFF, FL_MEM_SIM_BYTES);
+    } 
+    else 
+    {
+        /* Unknown option */
+        return false;
+    }
+    
+    return true;
+}
+/******************************************************************************
+End of function fl_mem_erase
+******************************************************************************/
+
+/******************************************************************************
+* Function Name: fl_mem_cache_invalidate
+* Description  : Nothing to do, there is no cache in front of RAM.
+* Arguments    : none
+* Return value : none
+******************************************************************************/
+void fl_mem_cache_invalidate(void)
+{
+}
+/******************************************************************************
+End of function fl_mem_cache_invalidate
+******************************************************************************/
+
+/******************************************************************************
+* Function Name: fl_mem_cache_get_stats
+* Description  : Returns the hit and miss counters of the page cache, which 
+*                are always 0.
+* Arguments    : p_stats - 
+*                    Where to place the counters
+* Return value : none
+******************************************************************************/
+void fl_mem_cache_get_stats(fl_mem_cache_stats_t * p_stats)
+{
+    p_stats->hits   = 0;
+    p_stats->misses = 0;
+}
+/******************************************************************************
+End of function fl_mem_cache_get_stats
+******************************************************************************/
+
+/******************************************************************************
+* Function Name: fl_mem_set_speed
+* Description  : Nothing to do, RAM has no bit rate.
+* Arguments    : pclk_hz - 
+*                    Not used
+*                max_hz - 
+*                    Not used
+* Return value : none
+******************************************************************************/
+void fl_mem_set_speed(uint32_t pclk_hz, uint32_t max_hz)
+{
+    (void)pclk_hz;
+    (void)max_hz;
+}
+/******************************************************************************
+End of function fl_mem_set_speed
+******************************************************************************/
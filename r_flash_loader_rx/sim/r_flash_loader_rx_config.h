@@ -0,0 +1,55 @@
+/*******************************************************************************
+* DISCLAIMER
+* This software is supplied by Renesas Electronics Corporation and is only 
+* intended for use with Renesas products. No other uses are authorized. This 
+* software is owned by Renesas Electronics Corporation and is protected under
+* all applicable laws, including copyright laws.
+* THIS SOFTWARE IS PROVIDED "AS IS" AND RENESAS MAKES NO WARRANTIES REGARDING
+* THIS SOFTWARE, WHETHER EXPRESS, IMPLIED OR STATUTORY, INCLUDING BUT NOT
+* LIMITED TO WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE 
+* AND NON-INFRINGEMENT. ALL SUCH WARRANTIES ARE EXPRESSLY DISCLAIMED.
+* TO THE MAXIMUM EXTENT PERMITTED NOT PROHIBITED BY LAW, NEITHER RENESAS 
+* ELECTRONICS CORPORATION NOR ANY OF ITS AFFILIATED COMPANIES SHALL BE LIABLE 
+* FOR ANY DIRECT, INDIRECT, SPECIAL, INCIDENTAL OR CONSEQUENTIAL DAMAGES FOR
+* ANY REASON RELATED TO THIS SOFTWARE, EVEN IF RENESAS OR ITS AFFILIATES HAVE
+* BEEN ADVISED OF THE POSSIBILITY OF SUCH DAMAGES.
+* Renesas reserves the right, without notice, to make changes to this software
+* and to discontinue the availability of this software. By using this software,
+* you agree to the additional terms and conditions found by accessing the 
+* following link:
+* http://www.renesas.com/disclaimer *
+* Copyright (C) 2013 Renesas Electronics Corporation. All rights reserved.    
+*******************************************************************************/
+/*******************************************************************************
+* File Name    : r_flash_loader_rx_config.h
+* Version      : 1.00
+* Description  : Flash Loader configuration used by r_fl_install_test.c. It is
+*                the reference configuration with the key-value store and the
+*                install journal turned on, so installs cut short by a power
+*                loss go on from where they stopped. Put this directory on
+*                the include path before r_config.
+******************************************************************************/  
+/******************************************************************************
+* History : DD.MM.YYYY Version Description
+*         : 19.10.2026 1.00    First Release
+******************************************************************************/
+
+#ifndef FL_SIM_CONFIG_H
+#define FL_SIM_CONFIG_H
+
+/******************************************************************************
+Includes   <System Includes> , "Project Includes"
+******************************************************************************/
+/* Options not changed here come from the reference configuration. */
+#include "../ref/r_flash_loader_rx_config_reference.h"
+
+/******************************************************************************
+Macro definitions
+******************************************************************************/
+/* Install journal, which keeps its records in the key-value store */
+#undef  FL_CFG_KV_ENABLE
+#define FL_CFG_KV_ENABLE                    (1)
+#undef  FL_CFG_INSTALL_JOURNAL_ENABLE
+#define FL_CFG_INSTALL_JOURNAL_ENABLE       (1)
+
+#endif /* FL_SIM_CONFIG_H */
@@ -40,6 +40,19 @@
 *                              replaced with g_fl_li_mem_info structure. This
 *                              was done to make the Memory portion of the FL
 *                              project more modular.
+*         : 19.10.2026 3.10    Added optional write-through page cache in front
+*                              of the SPI flash (FL_CFG_MEM_CACHE_ENABLE).
+*         : 19.10.2026 3.20    Load image addresses are now generated in
+*                              fl_mem_init() for any number of load images.
+*         : 19.10.2026 3.30    fl_mem_init() now finds the latest metadata
+*                              record (FL_CFG_META_ENABLE).
+*         : 19.10.2026 3.40    Added fl_mem_map().
+*         : 19.10.2026 3.50    Added fl_mem_set_speed().
+*         : 19.10.2026 3.60    Removed the metadata log from fl_mem_init().
+*         : 19.10.2026 3.70    Checks FL_CFG_MEM_SECTOR_BYTES against the
+*                              SPI flash erase size.
+*         : 19.10.2026 3.80    fl_mem_map() points in to the cache for a 
+*                              whole page too.
 ******************************************************************************/
 
 /******************************************************************************
@@ -47,6 +60,8 @@ Includes   <System Includes> , "Project Includes"
 ******************************************************************************/
 /* Info on which board is being used. */
 #include <platform.h>
+/* Used for memcpy(). */
+#include <string.h>
 #include "r_fl_includes.h"
 /* Uses r_rspi_rx package. */
 #include "r_rspi_rx_if.h"
@@ -66,12 +81,49 @@ Macro definitions
 #else
     #error "No RSPI channel chosen for SPI flash communications. Please choose channel in r_fl_memory_p5q.c"
 #endif
+/* SPBR value set by R_RSPI_Init() */
+#define FL_RSPI_INIT_DIVISOR    (2)
+
+/* Areas after the load images are laid out in sectors of the chip being used. */
+#if FL_CFG_MEM_SECTOR_BYTES != SF_MEM_MIN_ERASE_BYTES
+    #error "FL_CFG_MEM_SECTOR_BYTES must match SF_MEM_MIN_ERASE_BYTES. Please fix in r_flash_loader_rx_config.h"
+#endif
+
+#if FL_CFG_MEM_CACHE_ENABLE == 1
+/* Check that the page size is a power of 2 so masking can be used. */
+#if (FL_CFG_MEM_CACHE_PAGE_BYTES & (FL_CFG_MEM_CACHE_PAGE_BYTES - 1)) != 0
+    #error "FL_CFG_MEM_CACHE_PAGE_BYTES must be a power of 2. Please fix in r_flash_loader_rx_config.h"
+#endif
+/* Tag value used to mark an empty cache entry. This can never be a page address because pages are aligned. */
+#define FL_MEM_CACHE_TAG_EMPTY  (0xFFFFFFFF)
+/* Mask used to get the start address of the page that holds an address. */
+#define FL_MEM_CACHE_PAGE_MASK  (~((uint32_t)FL_CFG_MEM_CACHE_PAGE_BYTES - 1))
+#endif
+
+/******************************************************************************
+Private global variables and functions
+******************************************************************************/
+#if FL_CFG_MEM_CACHE_ENABLE == 1
+/* Data held for each cache page. */
+static uint8_t  g_fl_mem_cache_data[FL_CFG_MEM_CACHE_NUM_PAGES][FL_CFG_MEM_CACHE_PAGE_BYTES];
+/* Memory address of the page held in each cache entry. */
+static uint32_t g_fl_mem_cache_tags[FL_CFG_MEM_CACHE_NUM_PAGES];
+/* Next cache entry to replace on a miss (round-robin). */
+static uint8_t  g_fl_mem_cache_victim;
+/* Hit and miss counters. */
+static fl_mem_cache_stats_t g_fl_mem_cache_stats;
+
+static uint8_t * fl_mem_cache_get_page(uint32_t page_address);
+static void fl_mem_cache_invalidate_range(uint32_t address, uint32_t bytes);
+#endif
+static void fl_mem_read_direct(uint32_t rx_address, uint8_t * rx_buffer, uint32_t rx_bytes);
 
 /******************************************************************************
 Exported global variables (to be accessed by other files)
 ******************************************************************************/
-/* This structure defines the memory that load images will be stored in. */
-const fl_li_storage_t g_fl_li_mem_info = 
+/* This structure defines the memory that load images will be stored in. The
+   'addresses' table is filled in by fl_mem_init(). */
+fl_li_storage_t g_fl_li_mem_info = 
 {
     /* The minimum erase size in bytes. */
     (uint32_t)SF_MEM_MIN_ERASE_BYTES,
@@ -80,23 +132,8 @@ const fl_li_storage_t g_fl_li_mem_info =
        is still kept in the event that you do want to split up SPI flash programs. Another reason I am leaving this in 
        here is because other memories may be used where this is more of a requirement.  */
     (0x400),
-    /* Addresses of FL Load Images. '+1' is used because the last entry in the
-       array is the max address for load image data. */
-#if   FL_CFG_MEM_NUM_LOAD_IMAGES == 1
-    { FL_CFG_MEM_BASE_ADDR, 
-      FL_CFG_MEM_BASE_ADDR + FL_CFG_MEM_MAX_LI_SIZE_BYTES }
-#elif   FL_CFG_MEM_NUM_LOAD_IMAGES == 2
-    { FL_CFG_MEM_BASE_ADDR, 
-      FL_CFG_MEM_BASE_ADDR + FL_CFG_MEM_MAX_LI_SIZE_BYTES,
-      FL_CFG_MEM_BASE_ADDR + (FL_CFG_MEM_MAX_LI_SIZE_BYTES*2) }
-#elif FL_CFG_MEM_NUM_LOAD_IMAGES == 3
-    { FL_CFG_MEM_BASE_ADDR, 
-      FL_CFG_MEM_BASE_ADDR + FL_CFG_MEM_MAX_LI_SIZE_BYTES,
-      FL_CFG_MEM_BASE_ADDR + (FL_CFG_MEM_MAX_LI_SIZE_BYTES*2),
-      FL_CFG_MEM_BASE_ADDR + (FL_CFG_MEM_MAX_LI_SIZE_BYTES*3) }
-#else
-    #error "Addresses are not specified for this many Load Images. Please add details for this setup in r_fl_memory**.c"
-#endif
+    /* Addresses of FL Load Images. These are generated at init. */
+    { 0 }
 };
 
 /******************************************************************************
@@ -112,6 +149,103 @@ const fl_li_storage_t g_fl_li_mem_info =
 ******************************************************************************/
 void fl_mem_read(uint32_t rx_address, uint8_t * rx_buffer, uint32_t rx_bytes)
 {      
+#if FL_CFG_MEM_CACHE_ENABLE == 1
+    uint8_t * p_page;
+    uint32_t  offset;
+    uint32_t  chunk;
+
+    /* Large reads gain nothing from the cache and would only evict pages that
+       hold headers. Read these straight from memory. */
+    if(rx_bytes >= FL_CFG_MEM_CACHE_PAGE_BYTES)
+    {
+        fl_mem_read_direct(rx_address, rx_buffer, rx_bytes);
+        return;
+    }
+
+    /* Small reads are served page by page. A read can span 2 pages. */
+    while(rx_bytes > 0)
+    {
+        /* Get cache page holding this address */
+        p_page = fl_mem_cache_get_page(rx_address & FL_MEM_CACHE_PAGE_MASK);
+
+        /* Copy out as much as this page holds */
+        offset = rx_address & ~FL_MEM_CACHE_PAGE_MASK;
+        chunk  = FL_CFG_MEM_CACHE_PAGE_BYTES - offset;
+
+        if(chunk > rx_bytes)
+        {
+            chunk = rx_bytes;
+        }
+
+        memcpy(rx_buffer, &p_page[offset], chunk);
+
+        rx_address += chunk;
+        rx_buffer  += chunk;
+        rx_bytes   -= chunk;
+    }
+#else
+    /* Read data from external SPI flash */
+    fl_mem_read_direct(rx_address, rx_buffer, rx_bytes);
+#endif
+}
+/******************************************************************************
+End of function fl_mem_read
+******************************************************************************/
+
+/******************************************************************************
+* Function Name: fl_mem_map
+* Description  : Gets a pointer to data in memory where load images are 
+*                stored. Memories that can be read directly by the MCU return
+*                a pointer to the data itself so nothing is copied. SPI flash
+*                cannot be, so reads that fit in 1 cache page return a pointer
+*                in to the cache and everything else is read in to 
+*                rx_buffer. The pointer is only valid until the next call to
+*                a fl_mem_xxx() function.
+* Arguments    : rx_address - 
+*                    Where to read from in memory
+*                rx_buffer - 
+*                    Where to place read data if it has to be copied. Must 
+*                    hold rx_bytes.
+*                rx_bytes - 
+*                    How many bytes to read
+* Return value : Pointer to data
+******************************************************************************/
+uint8_t * fl_mem_map(uint32_t rx_address, uint8_t * rx_buffer, uint32_t rx_bytes)
+{
+#if FL_CFG_MEM_CACHE_ENABLE == 1
+    uint8_t * p_page;
+
+    /* Data is in 1 page */
+    if( (rx_bytes <= FL_CFG_MEM_CACHE_PAGE_BYTES) &&
+        ((rx_address & FL_MEM_CACHE_PAGE_MASK) == ((rx_address + rx_bytes - 1) & FL_MEM_CACHE_PAGE_MASK)) )
+    {
+        p_page = fl_mem_cache_get_page(rx_address & FL_MEM_CACHE_PAGE_MASK);
+
+        return &p_page[rx_address & ~FL_MEM_CACHE_PAGE_MASK];
+    }
+#endif
+
+    fl_mem_read(rx_address, rx_buffer, rx_bytes);
+
+    return rx_buffer;
+}
+/******************************************************************************
+End of function fl_mem_map
+******************************************************************************/
+
+/******************************************************************************
+* Function Name: fl_mem_read_direct
+* Description  : Reads data from memory without going through the cache
+* Arguments    : rx_address - 
+*                    Where to read from in memory
+*                rx_buffer - 
+*                    Where to place read data
+*                rx_bytes - 
+*                    How many bytes to read
+* Return value : none
+******************************************************************************/
+static void fl_mem_read_direct(uint32_t rx_address, uint8_t * rx_buffer, uint32_t rx_bytes)
+{
     while((R_SF_ReadStatus(FL_RSPI_CHANNEL) & SF_WIP_BIT_MASK) == 1) 
     {
         /* Make sure SPI flash is not busy */
@@ -124,7 +258,7 @@ void fl_mem_read(uint32_t rx_address, uint8_t * rx_buffer, uint32_t rx_bytes)
                    rx_bytes);
 }
 /******************************************************************************
-End of function fl_mem_read
+End of function fl_mem_read_direct
 ******************************************************************************/
 
 /******************************************************************************
@@ -145,6 +279,11 @@ void fl_mem_write(uint32_t tx_address, uint8_t *tx_buffer, uint32_t tx_bytes)
         /* Make sure SPI flash is not busy */
     }
     
+#if FL_CFG_MEM_CACHE_ENABLE == 1
+    /* Cached copies of these pages will be stale after the write */
+    fl_mem_cache_invalidate_range(tx_address, tx_bytes);
+#endif
+
     /* Write data to external SPI flash */
     R_SF_WriteData( FL_RSPI_CHANNEL,
                     tx_address,
@@ -183,16 +322,28 @@ uint8_t teste[5] = "teste";
 /******************************************************************************
 * Function Name: fl_mem_init
 * Description  : Initializes resources needed for talking to memory holding
-*                FL load images
+*                FL load images.
 * Arguments    : none
 * Return value : none
 ******************************************************************************/
 void fl_mem_init(void)
 {
+    uint32_t i;
+
+    /* Generate load image addresses. Load images are placed back to back 
+       starting at FL_CFG_MEM_BASE_ADDR. The last entry in the array is the 
+       max address for load image data. */
+    for(i = 0; i <= FL_CFG_MEM_NUM_LOAD_IMAGES; i++)
+    {
+        g_fl_li_mem_info.addresses[i] = FL_CFG_MEM_BASE_ADDR + (i * FL_CFG_MEM_MAX_LI_SIZE_BYTES);
+    }
 
     /* Initialize peripherals used for talking to SPI flash */
     R_RSPI_Init(FL_RSPI_CHANNEL);
 
+    /* Start with an empty cache */
+    fl_mem_cache_invalidate();
+
     R_SF_ReadData (FL_RSPI_CHANNEL, 0, testeRead, sizeof(testeRead));
 
     while((R_SF_ReadStatus(FL_RSPI_CHANNEL) & SF_WIP_BIT_MASK) == 1)
@@ -226,11 +377,18 @@ bool fl_mem_erase(const uint32_t address, const uint8_t size)
     /* Erase requested part of memory */
     if(size == FL_MEM_ERASE_SECTOR)
     {
+#if FL_CFG_MEM_CACHE_ENABLE == 1
+        /* Drop any cached pages inside the sector */
+        fl_mem_cache_invalidate_range(address & ~(g_fl_li_mem_info.erase_size - 1), g_fl_li_mem_info.erase_size);
+#endif
         /* Erase sector */
         R_SF_Erase(FL_RSPI_CHANNEL, address, SF_ERASE_SECTOR);
     } 
     else if(size == FL_MEM_ERASE_CHIP)
     {
+        /* Whole memory is erased so no cached page is valid */
+        fl_mem_cache_invalidate();
+
         /* Bulk erase */
         R_SF_Erase(FL_RSPI_CHANNEL, address, SF_ERASE_BULK);
     } 
@@ -246,3 +404,177 @@ bool fl_mem_erase(const uint32_t address, const uint8_t size)
 End of function fl_mem_erase
 ******************************************************************************/
 
+/******************************************************************************
+* Function Name: fl_mem_cache_invalidate
+* Description  : Empties the page cache. Call this if memory holding load
+*                images is changed without going through this file.
+* Arguments    : none
+* Return value : none
+******************************************************************************/
+void fl_mem_cache_invalidate(void)
+{
+#if FL_CFG_MEM_CACHE_ENABLE == 1
+    uint32_t i;
+
+    for(i = 0; i < FL_CFG_MEM_CACHE_NUM_PAGES; i++)
+    {
+        g_fl_mem_cache_tags[i] = FL_MEM_CACHE_TAG_EMPTY;
+    }
+
+    g_fl_mem_cache_victim = 0;
+#endif
+}
+/******************************************************************************
+End of function fl_mem_cache_invalidate
+******************************************************************************/
+
+/******************************************************************************
+* Function Name: fl_mem_cache_get_stats
+* Description  : Returns the hit and miss counters of the page cache. Counters
+*                stay at 0 when the cache is disabled.
+* Arguments    : p_stats - 
+*                    Where to place the counters
+* Return value : none
+******************************************************************************/
+void fl_mem_cache_get_stats(fl_mem_cache_stats_t * p_stats)
+{
+#if FL_CFG_MEM_CACHE_ENABLE == 1
+    *p_stats = g_fl_mem_cache_stats;
+#else
+    p_stats->hits   = 0;
+    p_stats->misses = 0;
+#endif
+}
+/******************************************************************************
+End of function fl_mem_cache_get_stats
+******************************************************************************/
+
+/******************************************************************************
+* Function Name: fl_mem_set_speed
+* Description  : Sets the RSPI bit rate to the fastest the divider allows that
+*                is not above max_hz. Call it after changing PCLKB and while
+*                no transfer is running.
+* Arguments    : pclk_hz - 
+*                    PCLKB the RSPI is running from
+*                max_hz - 
+*                    Fastest bit rate the memory takes. 0 puts back the bit 
+*                    rate set by fl_mem_init().
+* Return value : none
+******************************************************************************/
+void fl_mem_set_speed(uint32_t pclk_hz, uint32_t max_hz)
+{
+    uint32_t divisor;
+
+    if(max_hz == 0)
+    {
+        divisor = FL_RSPI_INIT_DIVISOR;
+    }
+    else
+    {
+        /* Bit rate is pclk_hz / (2 * (divisor + 1)) */
+        divisor = (pclk_hz + (2 * max_hz) - 1) / (2 * max_hz);
+
+        if(divisor > 0)
+        {
+            divisor--;
+        }
+
+        if(divisor > 255)
+        {
+            divisor = 255;
+        }
+    }
+
+    R_RSPI_BaudRateSet(FL_RSPI_CHANNEL, (uint8_t)divisor, 0);
+}
+/******************************************************************************
+End of function fl_mem_set_speed
+******************************************************************************/
+
+#if FL_CFG_MEM_CACHE_ENABLE == 1
+/******************************************************************************
+* Function Name: fl_mem_cache_get_page
+* Description  : Returns the cache entry holding a page. On a miss the page is
+*                read from memory into the next entry (round-robin).
+* Arguments    : page_address - 
+*                    Page aligned address in memory
+* Return value : Pointer to the cached page data
+******************************************************************************/
+static uint8_t * fl_mem_cache_get_page(uint32_t page_address)
+{
+    uint32_t i;
+
+    /* Look for the page in the cache */
+    for(i = 0; i < FL_CFG_MEM_CACHE_NUM_PAGES; i++)
+    {
+        if(g_fl_mem_cache_tags[i] == page_address)
+        {
+            g_fl_mem_cache_stats.hits++;
+
+            return g_fl_mem_cache_data[i];
+        }
+    }
+
+    g_fl_mem_cache_stats.misses++;
+
+    /* Not cached, replace the next entry */
+    i = g_fl_mem_cache_victim;
+
+    g_fl_mem_cache_victim++;
+
+    if(g_fl_mem_cache_victim >= FL_CFG_MEM_CACHE_NUM_PAGES)
+    {
+        g_fl_mem_cache_victim = 0;
+    }
+
+    /* Fill entry with whole page */
+    fl_mem_read_direct(page_address, g_fl_mem_cache_data[i], FL_CFG_MEM_CACHE_PAGE_BYTES);
+
+    g_fl_mem_cache_tags[i] = page_address;
+
+    return g_fl_mem_cache_data[i];
+}
+/******************************************************************************
+End of function fl_mem_cache_get_page
+******************************************************************************/
+
+/******************************************************************************
+* Function Name: fl_mem_cache_invalidate_range
+* Description  : Drops any cached page that overlaps an address range
+* Arguments    : address - 
+*                    Start of range
+*                bytes - 
+*                    Length of range
+* Return value : none
+******************************************************************************/
+static void fl_mem_cache_invalidate_range(uint32_t address, uint32_t bytes)
+{
+    uint32_t i;
+    uint32_t first_page;
+
+    /* Nothing is touched */
+    if(bytes == 0)
+    {
+        return;
+    }
+
+    /* Page holding first byte of range */
+    first_page = address & FL_MEM_CACHE_PAGE_MASK;
+
+    for(i = 0; i < FL_CFG_MEM_CACHE_NUM_PAGES; i++)
+    {
+        /* Page overlaps if it holds the first byte or starts inside the 
+           range. Empty entries never match because of their tag value. */
+        if( (g_fl_mem_cache_tags[i] == first_page) ||
+            ((g_fl_mem_cache_tags[i] != FL_MEM_CACHE_TAG_EMPTY) &&
+             (g_fl_mem_cache_tags[i] > address) &&
+             ((g_fl_mem_cache_tags[i] - address) < bytes)) )
+        {
+            g_fl_mem_cache_tags[i] = FL_MEM_CACHE_TAG_EMPTY;
+        }
+    }
+}
+/******************************************************************************
+End of function fl_mem_cache_invalidate_range
+******************************************************************************/
+#endif /* FL_CFG_MEM_CACHE_ENABLE */
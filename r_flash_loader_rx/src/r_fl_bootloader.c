@@ -36,6 +36,64 @@
 *                              package to trigger the FL state machine. Fixed
 *                              bugs found in fl_process_write_buffer() 
 *                              function.
+*         : 19.10.2026 3.10    fl_write_new_image() now reads from the 
+*                              address of the selected load image.
+*         : 19.10.2026 3.20    Slot directory state is updated after an image
+*                              is verified and installed.
+*         : 19.10.2026 3.30    CRC is initialized before memory so that
+*                              fl_mem_init() can check metadata records.
+*         : 19.10.2026 3.40    fl_write_new_image() expands LZ compressed
+*                              load images while programming.
+*         : 19.10.2026 3.50    Delta load images only rebuild the MCU flash
+*                              blocks that changed.
+*         : 19.10.2026 3.60    Sparse load images only program their 
+*                              segments.
+*         : 19.10.2026 3.70    Image data is read with fl_mem_map() so it is
+*                              not copied when the memory allows it.
+*         : 19.10.2026 3.80    MCU flash is erased and programmed through the
+*                              job queue in r_fl_rom_queue.c. Each half of
+*                              fl_app_buffer is filled while the other is
+*                              programmed.
+*         : 19.10.2026 3.90    Blocks that are already erased are not erased
+*                              again.
+*         : 19.10.2026 4.00    MCU flash is erased by address range with 
+*                              fl_rom_queue_erase_range().
+*         : 19.10.2026 4.10    Boots and installs are counted in the data 
+*                              flash key-value store.
+*         : 19.10.2026 4.20    Flash operations are timed and the totals 
+*                              are saved to data flash after each install.
+*         : 19.10.2026 4.30    R_FlashCodeCopy() is left to the Flash API,
+*                              which copies its RAM code on first use, so 
+*                              boots that do not write flash skip it.
+*         : 19.10.2026 4.40    Failed installs are retried from the first
+*                              unfinished MCU flash block after an FCU 
+*                              reset, and installs cut short by power loss
+*                              go on from there on the next boot.
+*         : 19.10.2026 4.50    With FL_CFG_CHECK_RECORD_ENABLE a pass saved
+*                              by the User Application's background check 
+*                              stands in for the CRC of MCU flash at boot.
+*         : 19.10.2026 4.60    With FL_CFG_PROFILE_ENABLE the check and
+*                              install of a new image are profiled.
+*         : 19.10.2026 4.70    With FL_CFG_FAST_BOOT_ENABLE a fast boot 
+*                              record is written before jumping to a checked
+*                              image with nothing newer to install, and 
+*                              cleared before an install.
+*         : 19.10.2026 4.80    With FL_CFG_INSTALL_CLOCK_ENABLE installs run
+*                              with the install clocks, and the BSP clocks 
+*                              are put back before jumping to the User 
+*                              Application.
+*         : 19.10.2026 4.90    Headers with FL_LI_VALID_MASK_GEN are valid.
+*         : 19.10.2026 5.00    Delta installs are retried like the other 
+*                              formats, and go on from the block that was
+*                              being rebuilt, using its old contents in the
+*                              scratch area, after a power loss.
+*         : 19.10.2026 5.10    The free running CMT channel used to time 
+*                              flash is stopped before jumping to the User
+*                              Application.
+*         : 19.10.2026 5.20    The metadata log was removed. CRC is still
+*                              initialized first for the key-value store.
+*         : 19.10.2026 5.30    Delta blocks larger than the scratch area are
+*                              rejected.
 ******************************************************************************/
 
 /******************************************************************************
@@ -67,6 +125,16 @@ Macro definitions
 #define MCU_RESET_VECTOR        (0xFFFFFFFC)
 #define JUMP_TO_APPLICATION     ((void (*)(void))*((uint32_t *)MCU_RESET_VECTOR))
 
+/* Program/erase address of start of application image in MCU flash */
+#define FL_ROM_PE_START         (0x00F00000)
+/* Read address of start of application image in MCU flash */
+#define FL_ROM_READ_START       (0xFFF00000)
+/* Size of application image area in MCU flash */
+#define FL_ROM_BYTES            (0x00100000)
+/* Bytes programmed per job. fl_app_buffer holds 2 of these so one can be 
+   filled while the other is programmed. */
+#define FL_ROM_CHUNK_BYTES      (sizeof(fl_app_buffer) / 2)
+
 
 extern uint8_t fl_app_buffer[4096];
 fl_image_header_t   g_fl_load_image_headers[FL_CFG_MEM_NUM_LOAD_IMAGES];
@@ -74,11 +142,32 @@ fl_image_header_t   g_fl_load_image_headers[FL_CFG_MEM_NUM_LOAD_IMAGES];
 /******************************************************************************
 Private global variables and functions
 ******************************************************************************/
+static bool fl_app_is_valid(bool use_record);
+static void fl_start_app(void);
 static bool fl_write_new_image(uint8_t image_index);
+static bool fl_install_image(uint8_t image_index, bool has_container, fl_container_header_t * p_container);
+static bool fl_install_write(uint32_t flash_addr, uint8_t * p_data, uint32_t bytes);
+static uint32_t fl_rom_block_start(uint32_t flash_addr);
+static bool fl_write_delta_image(uint8_t image_index, fl_container_header_t * p_container);
+static bool fl_write_sparse_image(uint8_t image_index, fl_container_header_t * p_container);
+static bool fl_find_rom_block(uint32_t offset, uint32_t length, uint32_t * p_block);
 static bool fl_process_write_buffer(uint32_t address, uint8_t * data, uint32_t bytes);
 static bool fl_flush_write_buffer(void);
 static void fl_trigger_sm(void * pdata);
 
+/* Decompression state used when installing */
+static fl_lz_state_t g_fl_install_lz;
+/* Delta state used when installing */
+static fl_delta_state_t g_fl_install_delta;
+/* Segment state used when installing */
+static fl_sparse_state_t g_fl_install_sparse;
+/* Program/erase address below which MCU flash already holds the image being
+   installed. Blocks at and above it are erased and programmed. */
+static uint32_t g_fl_install_done;
+/* Program/erase address of the delta block whose old contents are in the 
+   scratch area, or FL_DELTA_NO_SCRATCH */
+static uint32_t g_fl_install_saved;
+
 /* Points to info on current application */
 volatile fl_image_header_t * g_pfl_cur_app_header;
 
@@ -102,12 +191,31 @@ void main(void)
 	/* Initialize to -1, no valid image */
 	image_to_load = -1;
 
+	/* Initialize CRC code. This is done first because the key-value store
+	   and flash timing check their records with it. */
+	R_CRC_Init();
+
+#if defined(FLASH_API_RX_CFG_COPY_CODE_BY_API) && defined(FLASH_API_RX_CFG_ROM_BGO)
+	/* With ROM BGO the Flash API functions run from RAM so they cannot copy
+	   themselves there on first use. Otherwise the API copies its code when
+	   flash is first programmed or erased. */
+	R_FlashCodeCopy();
+#endif
+
+#if FL_CFG_STATS_ENABLE == 1
+	/* Load saved flash timing and start timing flash operations */
+	fl_stats_init();
+#endif
+
+#if FL_CFG_KV_ENABLE == 1
+	/* Load values kept in data flash and count this boot */
+	fl_kv_init();
+	fl_kv_add(FL_KV_KEY_BOOT_COUNT, 1);
+#endif
+
 	/* Initialize resources needed for using external memory */
 	fl_mem_init();
 
-	/* Initialize CRC code. */
-	R_CRC_Init();
-
 	/* Initialize pointer to current app's load image header */
 	g_pfl_cur_app_header = (fl_image_header_t *)__sectop("APPHEADER_1");
 
@@ -123,13 +231,13 @@ void main(void)
 	{
 		/* No valid image found in external memory */
 		/* Check to see if valid image header is already in MCU flash */
-		if(g_pfl_cur_app_header->valid_mask == FL_LI_VALID_MASK)
+		if(FL_LI_IS_VALID(g_pfl_cur_app_header->valid_mask) == true)
 		{
 			/* Valid image header in MCU flash, validate the whole image */
-			if( fl_check_application() == g_pfl_cur_app_header->raw_crc )
+			if( fl_app_is_valid(true) == true )
 			{
 				/* Valid image in MCU flash, jump to it */
-				JUMP_TO_APPLICATION();
+				fl_start_app();
 			}
 			/* Else, the image was not successfully validated, wait for new
 			   load image */
@@ -138,7 +246,7 @@ void main(void)
 	else
 	{
 		/* Check to see if there is a current image in MCU flash */
-		if( (g_pfl_cur_app_header->valid_mask == FL_LI_VALID_MASK) &&
+		if( (FL_LI_IS_VALID(g_pfl_cur_app_header->valid_mask) == true) &&
 			(g_pfl_cur_app_header->version_major == g_fl_load_image_headers[image_to_load].version_major) &&
 			(g_pfl_cur_app_header->version_middle == g_fl_load_image_headers[image_to_load].version_middle) &&
 			(g_pfl_cur_app_header->version_minor == g_fl_load_image_headers[image_to_load].version_minor) &&
@@ -147,25 +255,83 @@ void main(void)
 			/* Valid image was found but it is same as the one already in flash.
 			   Check to make sure image in MCU flash is valid, if so then jump
 			   to it.  If not, then program in the load image. */
-			if( fl_check_application() == g_pfl_cur_app_header->raw_crc )
+			if( fl_app_is_valid(true) == true )
 			{
 				/* Valid image in MCU flash, jump to it */
-				JUMP_TO_APPLICATION();
+				fl_start_app();
 			}
 		}
 
+#if FL_CFG_FAST_BOOT_ENABLE == 1
+		/* Boots must not skip the checks until the new image is in */
+		fl_fast_boot_clear();
+#endif
+
+#if FL_CFG_INSTALL_CLOCK_ENABLE == 1
+		/* Check and install with FCLK, PCLKB and the RSPI at their install
+		   rates */
+		fl_clock_install_start();
+#endif
+
+#if FL_CFG_PROFILE_ENABLE == 1
+		/* Sample where the time goes while the new image is checked and
+		   installed */
+		fl_profile_start();
+#endif
+
 		/* Verify load image is complete and error free */
 		if( fl_verify_load_image((uint32_t)image_to_load) == g_fl_load_image_headers[image_to_load].raw_crc )
 		{
+#if FL_CFG_CHECK_RECORD_ENABLE == 1
+			/* Whatever was checked before is about to change */
+			fl_check_put_record(0, FL_CHECK_NONE);
+#endif
+
 			/* Load image is valid, program in new image */
-			fl_write_new_image((uint8_t)image_to_load);
+			if( fl_write_new_image((uint8_t)image_to_load) == true )
+			{
+#if FL_CFG_KV_ENABLE == 1
+				fl_kv_add(FL_KV_KEY_INSTALL_COUNT, 1);
+#endif
+#if FL_CFG_MEM_DIR_ENABLE == 1
+				/* Record that this slot is now in MCU flash. Does nothing
+				   if the slot is already marked installed or there is no
+				   directory. */
+				fl_dir_set_state((uint8_t)image_to_load, FL_DIR_STATE_INSTALLED);
+#endif
+			}
+
+#if FL_CFG_STATS_ENABLE == 1
+			/* Save how long this install's flash operations took, even if 
+			   it failed, and flag the part if its flash is slowing down */
+			fl_stats_save();
+#if FL_CFG_KV_ENABLE == 1
+			if(fl_stats_is_aging() == true)
+			{
+				fl_kv_put(FL_KV_KEY_FLASH_AGING, 1);
+			}
+#endif
+#endif
+		}
+#if FL_CFG_MEM_DIR_ENABLE == 1
+		else
+		{
+			/* Never try this slot again */
+			fl_dir_set_state((uint8_t)image_to_load, FL_DIR_STATE_BAD);
 		}
+#endif
+
+#if FL_CFG_PROFILE_ENABLE == 1
+		/* Keep the profile in memory for r_fl_profile.py */
+		fl_profile_stop();
+		fl_profile_save();
+#endif
 
 		/* Verify image in MCU flash and jump to it */
-		if( fl_check_application() == g_pfl_cur_app_header->raw_crc )
+		if( fl_app_is_valid(false) == true )
 		{
 			/* Valid image in MCU flash, jump to it */
-			JUMP_TO_APPLICATION();
+			fl_start_app();
 		}
 	}
     
@@ -175,9 +341,92 @@ void main(void)
     }       
 }
 
+/******************************************************************************
+* Function Name: fl_app_is_valid
+* Description  : Checks the image in MCU flash. With 
+*                FL_CFG_CHECK_RECORD_ENABLE a pass saved by the User 
+*                Application for the same image is trusted, otherwise the 
+*                CRC of all of MCU flash is worked out and a pass is saved so
+*                the next boot does not need to. The header must already be 
+*                known to be valid.
+* Arguments    : use_record - 
+*                    true to trust a saved pass. false after MCU flash has 
+*                    been written.
+* Return value : true - 
+*                    Image is valid
+*                false - 
+*                    Image has errors
+******************************************************************************/
+static bool fl_app_is_valid(bool use_record)
+{
+#if FL_CFG_CHECK_RECORD_ENABLE == 1
+    if( (use_record == true) &&
+        (fl_check_get_record(g_pfl_cur_app_header->raw_crc) == FL_CHECK_PASS) )
+    {
+        return true;
+    }
+#endif
+
+    if( fl_check_application() != g_pfl_cur_app_header->raw_crc )
+    {
+        return false;
+    }
+
+#if FL_CFG_CHECK_RECORD_ENABLE == 1
+    fl_check_put_record(g_pfl_cur_app_header->raw_crc, FL_CHECK_PASS);
+#endif
+
+    return true;
+}
+/******************************************************************************
+End of function fl_app_is_valid
+******************************************************************************/
+
+/******************************************************************************
+* Function Name: fl_start_app
+* Description  : Jumps to the image in MCU flash, which must have been checked
+*                with nothing newer left to install. With 
+*                FL_CFG_FAST_BOOT_ENABLE the next boots go straight to it out
+*                of reset until the User Application clears the fast boot 
+*                record. The clocks are put back as the BSP set them first,
+*                and the CMT channel used to time flash is stopped last.
+* Arguments    : none
+* Return value : none
+******************************************************************************/
+static void fl_start_app(void)
+{
+#if FL_CFG_INSTALL_CLOCK_ENABLE == 1
+    /* The User Application expects the clocks from r_bsp_config.h */
+    fl_clock_install_end();
+#endif
+
+#if FL_CFG_FAST_BOOT_ENABLE == 1
+    fl_fast_boot_set(g_pfl_cur_app_header->raw_crc);
+#endif
+
+#if (FL_CFG_STATS_ENABLE == 1) || (FL_CFG_ROM_ERASE_TIMING_ENABLE == 1)
+    /* Flash is not timed from here on, leave the channel to the User 
+       Application */
+    fl_free_timer_stop();
+#endif
+
+    JUMP_TO_APPLICATION();
+}
+/******************************************************************************
+End of function fl_start_app
+******************************************************************************/
+
 /******************************************************************************
 * Function Name: fl_write_new_image
-* Description  : Write load image into MCU flash.
+* Description  : Write load image into MCU flash. If an erase or program 
+*                fails the FCU is reset and the install goes on again from 
+*                the first block that was not finished, up to 
+*                FL_CFG_INSTALL_RETRIES times for each block. With 
+*                FL_CFG_INSTALL_JOURNAL_ENABLE an install of the same image
+*                that was cut short on an earlier boot goes on from where it
+*                stopped. For delta images this includes the block that was
+*                being rebuilt, which is rebuilt again from the old contents
+*                saved in the scratch area.
 * Arguments    : image_index - 
 *                    Which load image to use
 * Return value : true - 
@@ -187,53 +436,524 @@ void main(void)
 ******************************************************************************/
 static bool fl_write_new_image(uint8_t image_index)
 {
-    uint32_t i;
-    bool check;
-    uint8_t ret;
-    uint32_t address = 0x00F00000;
-    uint32_t spiaddress = 0;
-    
-#ifdef FLASH_API_RX_CFG_COPY_CODE_BY_API
-    /* Before calling any other Flash API functions the API code needs to be 
-       copied to RAM. This can still be done the 'old way' by editting dbsct.c
-       if desired. */
-    R_FlashCodeCopy();
+    bool has_container;
+    fl_container_header_t container;
+    uint32_t tries;
+    uint32_t failed_at;
+
+    fl_rom_queue_init();
+
+    has_container = fl_get_image_container(image_index, &container);
+
+    g_fl_install_saved = FL_DELTA_NO_SCRATCH;
+
+#if FL_CFG_INSTALL_JOURNAL_ENABLE == 1
+    /* Go on from where an unfinished install of this image stopped */
+    g_fl_install_done = FL_ROM_PE_START + 
+                        fl_journal_start(image_index, g_fl_load_image_headers[image_index].raw_crc);
+
+    if( fl_journal_saved_block() != FL_JOURNAL_NO_BLOCK )
+    {
+        g_fl_install_saved = FL_ROM_PE_START + fl_journal_saved_block();
+    }
+#else
+    g_fl_install_done = FL_ROM_PE_START;
 #endif
-    
-    /* Start off by erasing flash */
-    for(i = 0; i < ROM_NUM_BLOCKS; i++)
-    {
-        /* Erase Block 'i' */
-        ret = R_FlashErase((uint8_t)i);
-        
-        /* Check for errors */
-        if( ret != FLASH_SUCCESS )
+
+    tries = 0;
+    failed_at = g_fl_install_done;
+
+    while( fl_install_image(image_index, has_container, &container) == false )
+    {
+        /* Let any jobs still queued finish before the FCU is reset */
+        fl_rom_queue_wait(0);
+
+        /* Each block gets its own retries */
+        if( g_fl_install_done != failed_at )
         {
+            tries = 0;
+            failed_at = g_fl_install_done;
+        }
+
+        if( tries >= FL_CFG_INSTALL_RETRIES )
+        {
+            /* Give up. With the journal the next boot starts from here. */
             return false;
         }
+
+        tries++;
+
+        /* Clear whatever state the FCU was left in */
+        R_FlashReset();
+    }
+
+#if FL_CFG_INSTALL_JOURNAL_ENABLE == 1
+    fl_journal_finish();
+#endif
+
+    return true;
+}
+/******************************************************************************
+End of function fl_write_new_image
+******************************************************************************/
+
+/******************************************************************************
+* Function Name: fl_install_image
+* Description  : Erases MCU flash from g_fl_install_done up and programs a
+*                raw, compressed or sparse load image there. Blocks below
+*                g_fl_install_done are left as they are. Delta images are 
+*                passed on to fl_write_delta_image().
+* Arguments    : image_index - 
+*                    Which load image to use
+*                has_container - 
+*                    Whether the load image has a container header
+*                p_container - 
+*                    Container header of load image if it has one
+* Return value : true - 
+*                    Image programmed successfully
+*                false - 
+*                    Error occurred
+******************************************************************************/
+static bool fl_install_image(uint8_t image_index, bool has_container, fl_container_header_t * p_container)
+{
+    uint32_t address = 0x00F00000;
+    uint32_t spiaddress = g_fl_li_mem_info.addresses[image_index];
+    bool compressed = false;
+    uint8_t * p_half;
+    uint32_t chunks = 0;
+    
+    fl_rom_queue_init();
+
+    /* Delta images only touch the blocks that changed */
+    if( (has_container == true) &&
+        (p_container->format == FL_IMAGE_FORMAT_DELTA) )
+    {
+        return fl_write_delta_image(image_index, p_container);
+    }
+
+    /* Start off by erasing flash. The erases run while the first data is
+       read. Blocks left erased by the last install are skipped. */
+    if( fl_rom_queue_erase_range(g_fl_install_done, 
+                                 (FL_ROM_PE_START + FL_ROM_BYTES) - g_fl_install_done) == false )
+    {
+        return false;
     }
     
+    /* Erased space between segments is left as it is */
+    if( (has_container == true) &&
+        (p_container->format == FL_IMAGE_FORMAT_SPARSE) )
+    {
+        return fl_write_sparse_image(image_index, p_container);
+    }
+
+    /* Compressed images are expanded in to fl_app_buffer as they are 
+       programmed. The image was already checked in fl_verify_load_image(). */
+    if( (has_container == true) &&
+        (p_container->format == FL_IMAGE_FORMAT_LZ) )
+    {
+        fl_lz_init(&g_fl_install_lz, 
+                   spiaddress + sizeof(fl_container_header_t), 
+                   p_container->stored_size);
+
+        compressed = true;
+    }
+    else
+    {
+        /* Raw images can skip straight to the first unfinished block. 
+           Compressed ones have to be expanded from the start. */
+        spiaddress += g_fl_install_done - FL_ROM_PE_START;
+        address = g_fl_install_done;
+    }
+
     /* Now we can program flash */
     while( address < 0x01000000)
     {
-    	fl_mem_read(spiaddress,fl_app_buffer,sizeof(fl_app_buffer));
+        /* Halves are used in turn. This also matches where fl_lz_read() 
+           puts its output. */
+        p_half = &fl_app_buffer[(chunks % 2) * FL_ROM_CHUNK_BYTES];
 
-        /* Write buffer */
-    	ret = R_FlashWrite( address,
-                            (uint32_t)&fl_app_buffer[0],
-							sizeof(fl_app_buffer));
+        /* Wait for the last write from this half to finish */
+        if( (chunks >= 2) && (fl_rom_queue_wait(1) == false) )
+        {
+            return false;
+        }
 
-        /* Check for errors */
-        if( ret != FLASH_SUCCESS )
+        if(compressed == true)
+        {
+            /* Expand next part of image */
+            if(fl_lz_read(&g_fl_install_lz, fl_app_buffer, FL_ROM_CHUNK_BYTES) != FL_ROM_CHUNK_BYTES)
+            {
+                return false;
+            }
+        }
+        else
+        {
+            /* Data must stay in place until it is programmed so it is 
+               always copied here (fl_mem_map() may point in to cache). */
+    	    fl_mem_read(spiaddress,p_half,FL_ROM_CHUNK_BYTES);
+        }
+
+        /* Write buffer */
+        if( fl_install_write(address, p_half, FL_ROM_CHUNK_BYTES) == false )
         {
             return false;
-        } ;
-        address += sizeof(fl_app_buffer);
-        spiaddress += sizeof(fl_app_buffer);
+        }
+
+        address += FL_ROM_CHUNK_BYTES;
+        spiaddress += FL_ROM_CHUNK_BYTES;
+        chunks++;
     }
     
+    /* Wait for last writes */
+    return fl_rom_queue_wait(0);
+}
+/******************************************************************************
+End of function fl_install_image
+******************************************************************************/
+
+/******************************************************************************
+* Function Name: fl_install_write
+* Description  : Queues programming of part of the image being installed. 
+*                Anything below g_fl_install_done is skipped. Writes go up
+*                through MCU flash, so when one starts in a higher block all
+*                blocks below it are finished once the queue is empty. 
+*                g_fl_install_done is then moved up and recorded in the 
+*                journal.
+* Arguments    : flash_addr - 
+*                    Program/erase address to start at
+*                p_data - 
+*                    Data to program. Must not change until the job has
+*                    finished.
+*                bytes - 
+*                    Number of bytes, a multiple of ROM_PROGRAM_SIZE
+* Return value : true - 
+*                    Job queued or skipped
+*                false - 
+*                    A job has failed
+******************************************************************************/
+static bool fl_install_write(uint32_t flash_addr, uint8_t * p_data, uint32_t bytes)
+{
+    uint32_t block_addr;
+
+    /* Programmed before power was lost or the last try failed */
+    if( (flash_addr + bytes) <= g_fl_install_done )
+    {
+        return true;
+    }
+
+    if( flash_addr < g_fl_install_done )
+    {
+        /* Only the part above g_fl_install_done is left to program. It is 
+           on a block boundary so the rest is a whole number of writes. */
+        p_data += g_fl_install_done - flash_addr;
+        bytes -= g_fl_install_done - flash_addr;
+        flash_addr = g_fl_install_done;
+    }
+
+    block_addr = fl_rom_block_start(flash_addr);
+
+    if( block_addr > g_fl_install_done )
+    {
+        /* Finish the blocks below this one */
+        if( fl_rom_queue_wait(0) == false )
+        {
+            return false;
+        }
+
+        g_fl_install_done = block_addr;
+
+#if FL_CFG_INSTALL_JOURNAL_ENABLE == 1
+        fl_journal_progress(block_addr - FL_ROM_PE_START);
+#endif
+    }
+
+    return fl_rom_queue_write(flash_addr, (uint32_t)p_data, (uint16_t)bytes);
+}
+/******************************************************************************
+End of function fl_install_write
+******************************************************************************/
+
+/******************************************************************************
+* Function Name: fl_rom_block_start
+* Description  : Finds the start of the MCU flash erase block holding an 
+*                address
+* Arguments    : flash_addr - 
+*                    Program/erase address in MCU flash
+* Return value : Program/erase address of start of block
+******************************************************************************/
+static uint32_t fl_rom_block_start(uint32_t flash_addr)
+{
+    uint32_t block;
+
+    /* Blocks are in descending address order */
+    for(block = 0; block < ROM_NUM_BLOCKS; block++)
+    {
+        if(flash_addr >= g_flash_BlockAddresses[block])
+        {
+            return g_flash_BlockAddresses[block];
+        }
+    }
+
+    return FL_ROM_PE_START;
+}
+/******************************************************************************
+End of function fl_rom_block_start
+******************************************************************************/
+
+/******************************************************************************
+* Function Name: fl_write_delta_image
+* Description  : Applies a delta load image to MCU flash. Only the blocks in
+*                the delta are erased and programmed. Before a block is 
+*                erased its old contents are copied to the delta scratch area
+*                so the delta can still copy from them, and the block is 
+*                recorded in g_fl_install_saved (and the journal). The delta
+*                reads MCU flash, so each job is finished before going on.
+*
+*                The delta is always read from the start. Blocks below 
+*                g_fl_install_done were rebuilt by an earlier try and are 
+*                only read past. The block in g_fl_install_saved may be part
+*                rebuilt, so its scratch copy is used as it is instead of 
+*                copying MCU flash again.
+* Arguments    : image_index - 
+*                    Which load image to use
+*                p_container - 
+*                    Container header of load image
+* Return value : true - 
+*                    Image programmed successfully
+*                false - 
+*                    Error occurred
+******************************************************************************/
+static bool fl_write_delta_image(uint8_t image_index, fl_container_header_t * p_container)
+{
+    fl_delta_header_t delta;
+    fl_delta_block_t  block;
+    uint8_t *         p_data;
+    uint32_t          rom_block;
+    uint32_t          block_addr;
+    uint32_t          done;
+
+    if(fl_delta_init(&g_fl_install_delta, 
+                     g_fl_li_mem_info.addresses[image_index] + sizeof(fl_container_header_t), 
+                     p_container->stored_size,
+                     &delta) == false)
+    {
+        return false;
+    }
+
+    while(fl_delta_next_block(&g_fl_install_delta, &block) == true)
+    {
+        /* Delta blocks must be MCU flash erase blocks that fit in the 
+           scratch area */
+        if( (fl_find_rom_block(block.offset, block.length, &rom_block) == false) ||
+            (block.length > FL_CFG_DELTA_SCRATCH_BYTES) )
+        {
+            return false;
+        }
+
+        block_addr = FL_ROM_PE_START + block.offset;
+
+        if( (block_addr + block.length) <= g_fl_install_done )
+        {
+            /* Already rebuilt, move on to the next block */
+            for(done = 0; done < block.length; done += sizeof(fl_app_buffer))
+            {
+                if(fl_delta_read(&g_fl_install_delta, fl_app_buffer, sizeof(fl_app_buffer)) != sizeof(fl_app_buffer))
+                {
+                    return false;
+                }
+            }
+
+            continue;
+        }
+
+        if( block_addr != g_fl_install_saved )
+        {
+            /* Save old contents of block to scratch area */
+            for(done = 0; done < block.length; done += g_fl_li_mem_info.erase_size)
+            {
+                if(fl_mem_erase(FL_CFG_DELTA_SCRATCH_ADDR + done, FL_MEM_ERASE_SECTOR) == false)
+                {
+                    return false;
+                }
+            }
+
+            fl_mem_write(FL_CFG_DELTA_SCRATCH_ADDR, 
+                         (uint8_t *)(FL_ROM_READ_START + block.offset), 
+                         block.length);
+
+            /* Make sure copy is good before the block is erased */
+            for(done = 0; done < block.length; done += sizeof(fl_app_buffer))
+            {
+                p_data = fl_mem_map(FL_CFG_DELTA_SCRATCH_ADDR + done, fl_app_buffer, sizeof(fl_app_buffer));
+
+                if(memcmp(p_data, (uint8_t *)(FL_ROM_READ_START + block.offset + done), sizeof(fl_app_buffer)) != 0)
+                {
+                    return false;
+                }
+            }
+
+#if FL_CFG_INSTALL_JOURNAL_ENABLE == 1
+            /* After a power loss the next boot must know where the old 
+               contents are */
+            if(fl_journal_save_block(block.offset) == false)
+            {
+                return false;
+            }
+#endif
+
+            g_fl_install_saved = block_addr;
+        }
+
+        fl_delta_set_scratch(&g_fl_install_delta, FL_CFG_DELTA_SCRATCH_ADDR);
+
+        /* Erase block */
+        if( (fl_rom_queue_erase(rom_block) == false) ||
+            (fl_rom_queue_wait(0) == false) )
+        {
+            return false;
+        }
+
+        /* Rebuild block */
+        for(done = 0; done < block.length; done += sizeof(fl_app_buffer))
+        {
+            if(fl_delta_read(&g_fl_install_delta, fl_app_buffer, sizeof(fl_app_buffer)) != sizeof(fl_app_buffer))
+            {
+                return false;
+            }
+
+            if( (fl_rom_queue_write(block_addr + done,
+                                    (uint32_t)&fl_app_buffer[0],
+                                    sizeof(fl_app_buffer)) == false) ||
+                (fl_rom_queue_wait(0) == false) )
+            {
+                return false;
+            }
+        }
+
+        g_fl_install_done = block_addr + block.length;
+
+#if FL_CFG_INSTALL_JOURNAL_ENABLE == 1
+        fl_journal_progress(block.offset + block.length);
+#endif
+    }
+
+    /* All blocks must have been applied */
+    if(g_fl_install_delta.blocks_left != 0)
+    {
+        return false;
+    }
+
     return true;
 }
 /******************************************************************************
-End of function fl_write_new_image
+End of function fl_write_delta_image
+******************************************************************************/
+
+/******************************************************************************
+* Function Name: fl_write_sparse_image
+* Description  : Programs the segments of a sparse load image. MCU flash must
+*                already be erased from g_fl_install_done up (erase jobs may
+*                still be queued).
+* Arguments    : image_index - 
+*                    Which load image to use
+*                p_container - 
+*                    Container header of load image
+* Return value : true - 
+*                    Image programmed successfully
+*                false - 
+*                    Error occurred
+******************************************************************************/
+static bool fl_write_sparse_image(uint8_t image_index, fl_container_header_t * p_container)
+{
+    fl_segment_t segment;
+    uint32_t     data_address;
+    uint32_t     done;
+    uint32_t     bytes;
+    uint32_t     chunks;
+    uint8_t *    p_half;
+
+    if(fl_sparse_init(&g_fl_install_sparse, image_index, p_container) == false)
+    {
+        return false;
+    }
+
+    chunks = 0;
+
+    while(g_fl_install_sparse.segments_left > 0)
+    {
+        if(fl_sparse_next(&g_fl_install_sparse, &segment, &data_address) == false)
+        {
+            return false;
+        }
+
+        for(done = 0; done < segment.length; done += bytes)
+        {
+            bytes = segment.length - done;
+
+            if(bytes > FL_ROM_CHUNK_BYTES)
+            {
+                bytes = FL_ROM_CHUNK_BYTES;
+            }
+
+            /* Programmed before power was lost or the last try failed */
+            if( (FL_ROM_PE_START + segment.offset + done + bytes) <= g_fl_install_done )
+            {
+                continue;
+            }
+
+            /* Fill one half of fl_app_buffer while the other is programmed */
+            p_half = &fl_app_buffer[(chunks % 2) * FL_ROM_CHUNK_BYTES];
+
+            if( (chunks >= 2) && (fl_rom_queue_wait(1) == false) )
+            {
+                return false;
+            }
+
+            /* Copied so it stays in place until it is programmed */
+            fl_mem_read(data_address + done, p_half, bytes);
+
+            if( fl_install_write(FL_ROM_PE_START + segment.offset + done,
+                                 p_half,
+                                 bytes) == false )
+            {
+                return false;
+            }
+
+            chunks++;
+        }
+    }
+
+    return fl_rom_queue_wait(0);
+}
+/******************************************************************************
+End of function fl_write_sparse_image
+******************************************************************************/
+
+/******************************************************************************
+* Function Name: fl_find_rom_block
+* Description  : Finds the MCU flash erase block for part of the image
+* Arguments    : offset - 
+*                    Offset of block in image
+*                length - 
+*                    Size of block in bytes
+*                p_block - 
+*                    Where to place block number
+* Return value : true - 
+*                    Block found
+*                false - 
+*                    Offset and length are not an erase block
+******************************************************************************/
+static bool fl_find_rom_block(uint32_t offset, uint32_t length, uint32_t * p_block)
+{
+    uint32_t num_blocks;
+
+    if(R_FlashGetRomBlocks(FL_ROM_PE_START + offset, length, p_block, &num_blocks) != FLASH_SUCCESS)
+    {
+        return false;
+    }
+
+    return (bool)(num_blocks == 1);
+}
+/******************************************************************************
+End of function fl_find_rom_block
 ******************************************************************************/
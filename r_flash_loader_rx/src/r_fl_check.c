@@ -0,0 +1,303 @@
+/*******************************************************************************
+* DISCLAIMER
+* This software is supplied by Renesas Electronics Corporation and is only 
+* intended for use with Renesas products. No other uses are authorized. This 
+* software is owned by Renesas Electronics Corporation and is protected under
+* all applicable laws, including copyright laws.
+* THIS SOFTWARE IS PROVIDED "AS IS" AND RENESAS MAKES NO WARRANTIES REGARDING
+* THIS SOFTWARE, WHETHER EXPRESS, IMPLIED OR STATUTORY, INCLUDING BUT NOT
+* LIMITED TO WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE 
+* AND NON-INFRINGEMENT. ALL SUCH WARRANTIES ARE EXPRESSLY DISCLAIMED.
+* TO THE MAXIMUM EXTENT PERMITTED NOT PROHIBITED BY LAW, NEITHER RENESAS 
+* ELECTRONICS CORPORATION NOR ANY OF ITS AFFILIATED COMPANIES SHALL BE LIABLE 
+* FOR ANY DIRECT, INDIRECT, SPECIAL, INCIDENTAL OR CONSEQUENTIAL DAMAGES FOR
+* ANY REASON RELATED TO THIS SOFTWARE, EVEN IF RENESAS OR ITS AFFILIATES HAVE
+* BEEN ADVISED OF THE POSSIBILITY OF SUCH DAMAGES.
+* Renesas reserves the right, without notice, to make changes to this software
+* and to discontinue the availability of this software. By using this software,
+* you agree to the additional terms and conditions found by accessing the 
+* following link:
+* http://www.renesas.com/disclaimer *
+* Copyright (C) 2013 Renesas Electronics Corporation. All rights reserved.    
+*******************************************************************************/
+/*******************************************************************************
+* File Name    : r_fl_check.c
+* Version      : 3.10
+* Description  : Checks the CRC of a raw image in MCU flash or in memory a 
+*                few bytes at a time, so the User Application can check its 
+*                own image in the background instead of the Bootloader 
+*                checking all of MCU flash on every boot. The CRC is the one
+*                fl_check_application() and fl_verify_load_image() work out,
+*                kept between calls in a fl_check_state_t.
+*
+*                The result of a check of MCU flash can be saved in the 
+*                key-value store with fl_check_put_record(). The Bootloader
+*                reads it with fl_check_get_record() on the next boot.
+******************************************************************************/  
+/******************************************************************************
+* History : DD.MM.YYYY Version Description
+*         : 19.10.2026 3.10    First Release
+*         : 19.10.2026 3.20    A failed check clears the fast boot record.
+*         : 19.10.2026 3.30    Fixed signed/unsigned compares in fl_check_step().
+******************************************************************************/
+
+/******************************************************************************
+Includes   <System Includes> , "Project Includes"
+******************************************************************************/
+/* Defines intrinsic functions of the MCU */
+#include <machine.h>
+/* Used for offsetof() */
+#include <stddef.h>
+/* Fixed width types support. */
+#include <stdint.h>
+/* Used for bool. */
+#include <stdbool.h>
+/* Flash Loader project includes. */
+#include "r_fl_includes.h"
+/* Uses r_crc_rx package for CRC calculations. */
+#include "r_crc_rx_if.h"
+
+/******************************************************************************
+Macro definitions
+******************************************************************************/
+#if (FL_CFG_CHECK_RECORD_ENABLE == 1) && (FL_CFG_KV_ENABLE != 1)
+    #error "FL_CFG_CHECK_RECORD_ENABLE needs the key-value store. Please enable FL_CFG_KV_ENABLE."
+#endif
+
+/* Number of bytes of MCU flash held in a raw image */
+#define FL_CHECK_IMAGE_BYTES    (0x100000)
+/* Read address of start of raw image in MCU flash */
+#define FL_CHECK_ROM_START      (0xFFF00000)
+/* Offset in a raw image of 'raw_crc' in its header, which is left out of 
+   the CRC */
+#define FL_CHECK_CRC_OFFSET     ((uint32_t)(((uint32_t)__sectop("APPHEADER_1")) + \
+                                            offsetof(fl_image_header_t, raw_crc) - \
+                                            FL_CHECK_ROM_START))
+
+/* Most bytes read from memory at once */
+#define FL_CHECK_READ_BYTES     (256)
+
+/******************************************************************************
+Private global variables and functions
+******************************************************************************/
+/* Holds data read from memory. fl_mem_map() may point in to its cache 
+   instead. */
+static uint8_t g_fl_check_buffer[FL_CHECK_READ_BYTES];
+
+/******************************************************************************
+* Function Name: fl_check_start_app
+* Description  : Starts a check of the image in MCU flash
+* Arguments    : p_state - 
+*                    Where to keep the check between calls
+* Return value : none
+******************************************************************************/
+void fl_check_start_app(fl_check_state_t * p_state)
+{
+    p_state->base_address = FL_CHECK_ROM_START;
+    p_state->offset       = 0;
+    p_state->crc          = RX_LINKER_SEED;
+    p_state->raw_crc      = *((uint16_t *)(FL_CHECK_ROM_START + FL_CHECK_CRC_OFFSET));
+    p_state->rom          = true;
+}
+/******************************************************************************
+End of function fl_check_start_app
+******************************************************************************/
+
+/******************************************************************************
+* Function Name: fl_check_start_image
+* Description  : Starts a check of a raw load image. Images that are not raw
+*                are checked by expanding them with fl_verify_load_image().
+*                fl_mem_init() must have been called first.
+* Arguments    : p_state - 
+*                    Where to keep the check between calls
+*                image_index - 
+*                    Which load image slot to check
+* Return value : true - 
+*                    Check started
+*                false - 
+*                    Image is not a raw image
+******************************************************************************/
+bool fl_check_start_image(fl_check_state_t * p_state, uint32_t image_index)
+{
+    fl_container_header_t container;
+
+    if(fl_get_image_container(image_index, &container) == true)
+    {
+        return false;
+    }
+
+    p_state->base_address = g_fl_li_mem_info.addresses[image_index];
+    p_state->offset       = 0;
+    p_state->crc          = RX_LINKER_SEED;
+    p_state->rom          = false;
+
+    /* Header is where the linker put it */
+    fl_mem_read(p_state->base_address + FL_CHECK_CRC_OFFSET, 
+                (uint8_t *)&p_state->raw_crc, 
+                sizeof(p_state->raw_crc));
+
+    return true;
+}
+/******************************************************************************
+End of function fl_check_start_image
+******************************************************************************/
+
+/******************************************************************************
+* Function Name: fl_check_step
+* Description  : Adds up to max_bytes more of the image to the CRC. Once the
+*                whole image is done the result is returned by every call.
+* Arguments    : p_state - 
+*                    Check started with fl_check_start_app() or 
+*                    fl_check_start_image()
+*                max_bytes - 
+*                    Most bytes to add to the CRC in this call
+* Return value : FL_CHECK_BUSY - 
+*                    Part of the image is still to be checked
+*                FL_CHECK_PASS - 
+*                    CRC matches raw_crc in the image's header
+*                FL_CHECK_FAIL - 
+*                    CRC does not match
+******************************************************************************/
+uint8_t fl_check_step(fl_check_state_t * p_state, uint32_t max_bytes)
+{
+    uint32_t  bytes;
+    uint8_t * p_data;
+    uint16_t  crc;
+
+    while( (max_bytes > 0) && (p_state->offset < FL_CHECK_IMAGE_BYTES) )
+    {
+        if(p_state->offset == FL_CHECK_CRC_OFFSET)
+        {
+            /* raw_crc is not part of the CRC */
+            p_state->offset += sizeof(p_state->raw_crc);
+            continue;
+        }
+
+        /* Go no further than raw_crc or the end of the image */
+        if(p_state->offset < FL_CHECK_CRC_OFFSET)
+        {
+            bytes = FL_CHECK_CRC_OFFSET - p_state->offset;
+        }
+        else
+        {
+            bytes = FL_CHECK_IMAGE_BYTES - p_state->offset;
+        }
+
+        if(bytes > max_bytes)
+        {
+            bytes = max_bytes;
+        }
+
+        if(p_state->rom == true)
+        {
+            p_data = (uint8_t *)(p_state->base_address + p_state->offset);
+        }
+        else
+        {
+            if(bytes > FL_CHECK_READ_BYTES)
+            {
+                bytes = FL_CHECK_READ_BYTES;
+            }
+
+            p_data = fl_mem_map(p_state->base_address + p_state->offset, 
+                                g_fl_check_buffer, 
+                                bytes);
+        }
+
+        R_CRC_Compute(p_state->crc, p_data, bytes, &p_state->crc);
+
+        p_state->offset += bytes;
+        max_bytes -= bytes;
+    }
+
+    if(p_state->offset < FL_CHECK_IMAGE_BYTES)
+    {
+        return FL_CHECK_BUSY;
+    }
+
+    /* The RX linker does a bitwise NOT on the data after the CRC has 
+       finished */
+    crc = (uint16_t)(~p_state->crc);
+
+    if(crc == p_state->raw_crc)
+    {
+        return FL_CHECK_PASS;
+    }
+
+    return FL_CHECK_FAIL;
+}
+/******************************************************************************
+End of function fl_check_step
+******************************************************************************/
+
+#if FL_CFG_CHECK_RECORD_ENABLE == 1
+
+/******************************************************************************
+* Function Name: fl_check_put_record
+* Description  : Saves the result of a check of MCU flash for the Bootloader.
+*                Nothing is written if the same result is already saved.
+*                fl_kv_init() must have been called first.
+* Arguments    : raw_crc - 
+*                    raw_crc of the image that was checked
+*                result - 
+*                    FL_CHECK_PASS or FL_CHECK_FAIL. FL_CHECK_NONE forgets 
+*                    any saved result.
+* Return value : none
+******************************************************************************/
+void fl_check_put_record(uint16_t raw_crc, uint8_t result)
+{
+#if FL_CFG_FAST_BOOT_ENABLE == 1
+    if(result == FL_CHECK_FAIL)
+    {
+        /* The Bootloader must not go straight to a bad image */
+        fl_fast_boot_clear();
+    }
+#endif
+
+    fl_kv_put(FL_KV_KEY_APP_CHECK, (((uint32_t)raw_crc) << 16) | (uint32_t)result);
+}
+/******************************************************************************
+End of function fl_check_put_record
+******************************************************************************/
+
+/******************************************************************************
+* Function Name: fl_check_get_record
+* Description  : Reads the saved result of a check of MCU flash. 
+*                fl_kv_init() must have been called first.
+* Arguments    : raw_crc - 
+*                    raw_crc of the image in MCU flash
+* Return value : FL_CHECK_PASS or FL_CHECK_FAIL - 
+*                    Saved result for this image
+*                FL_CHECK_NONE - 
+*                    No result saved for this image
+******************************************************************************/
+uint8_t fl_check_get_record(uint16_t raw_crc)
+{
+    uint32_t value;
+
+    if(fl_kv_get(FL_KV_KEY_APP_CHECK, &value) == false)
+    {
+        return FL_CHECK_NONE;
+    }
+
+    /* Result is for a different image */
+    if((uint16_t)(value >> 16) != raw_crc)
+    {
+        return FL_CHECK_NONE;
+    }
+
+    value &= 0xFFFF;
+
+    if((value != FL_CHECK_PASS) && (value != FL_CHECK_FAIL))
+    {
+        return FL_CHECK_NONE;
+    }
+
+    return (uint8_t)value;
+}
+/******************************************************************************
+End of function fl_check_get_record
+******************************************************************************/
+
+#endif /* FL_CFG_CHECK_RECORD_ENABLE */
+
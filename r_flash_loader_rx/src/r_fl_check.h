@@ -0,0 +1,66 @@
+/*******************************************************************************
+* DISCLAIMER
+* This software is supplied by Renesas Electronics Corporation and is only 
+* intended for use with Renesas products. No other uses are authorized. This 
+* software is owned by Renesas Electronics Corporation and is protected under
+* all applicable laws, including copyright laws.
+* THIS SOFTWARE IS PROVIDED "AS IS" AND RENESAS MAKES NO WARRANTIES REGARDING
+* THIS SOFTWARE, WHETHER EXPRESS, IMPLIED OR STATUTORY, INCLUDING BUT NOT
+* LIMITED TO WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE 
+* AND NON-INFRINGEMENT. ALL SUCH WARRANTIES ARE EXPRESSLY DISCLAIMED.
+* TO THE MAXIMUM EXTENT PERMITTED NOT PROHIBITED BY LAW, NEITHER RENESAS 
+* ELECTRONICS CORPORATION NOR ANY OF ITS AFFILIATED COMPANIES SHALL BE LIABLE 
+* FOR ANY DIRECT, INDIRECT, SPECIAL, INCIDENTAL OR CONSEQUENTIAL DAMAGES FOR
+* ANY REASON RELATED TO THIS SOFTWARE, EVEN IF RENESAS OR ITS AFFILIATES HAVE
+* BEEN ADVISED OF THE POSSIBILITY OF SUCH DAMAGES.
+* Renesas reserves the right, without notice, to make changes to this software
+* and to discontinue the availability of this software. By using this software,
+* you agree to the additional terms and conditions found by accessing the 
+* following link:
+* http://www.renesas.com/disclaimer *
+* Copyright (C) 2013 Renesas Electronics Corporation. All rights reserved.    
+*******************************************************************************/
+/*******************************************************************************
+* File Name    : r_fl_check.h
+* Version      : 3.10
+* Description  : Checks the CRC of a raw image a few bytes at a time.
+******************************************************************************/  
+/******************************************************************************
+* History : DD.MM.YYYY Version Description
+*         : 19.10.2026 3.10    First Release
+******************************************************************************/
+
+#ifndef FL_CHECK_H
+#define FL_CHECK_H
+
+/******************************************************************************
+Includes   <System Includes> , "Project Includes"
+******************************************************************************/
+/* Fixed width types support. */
+#include <stdint.h>
+/* Used for bool. */
+#include <stdbool.h>
+
+/******************************************************************************
+Macro definitions
+******************************************************************************/
+/* Results of fl_check_step() and fl_check_get_record() */
+/* Check has not finished */
+#define FL_CHECK_BUSY               (0)
+/* CRC matches raw_crc in the image's header */
+#define FL_CHECK_PASS               (1)
+/* CRC does not match */
+#define FL_CHECK_FAIL               (2)
+/* No result saved for the image */
+#define FL_CHECK_NONE               (3)
+
+/******************************************************************************
+Exported global functions (to be accessed by other files)
+******************************************************************************/
+void    fl_check_start_app(fl_check_state_t * p_state);
+bool    fl_check_start_image(fl_check_state_t * p_state, uint32_t image_index);
+uint8_t fl_check_step(fl_check_state_t * p_state, uint32_t max_bytes);
+void    fl_check_put_record(uint16_t raw_crc, uint8_t result);
+uint8_t fl_check_get_record(uint16_t raw_crc);
+
+#endif /* FL_CHECK_H */
@@ -0,0 +1,251 @@
+/*******************************************************************************
+* DISCLAIMER
+* This software is supplied by Renesas Electronics Corporation and is only 
+* intended for use with Renesas products. No other uses are authorized. This 
+* software is owned by Renesas Electronics Corporation and is protected under
+* all applicable laws, including copyright laws.
+* THIS SOFTWARE IS PROVIDED "AS IS" AND RENESAS MAKES NO WARRANTIES REGARDING
+* THIS SOFTWARE, WHETHER EXPRESS, IMPLIED OR STATUTORY, INCLUDING BUT NOT
+* LIMITED TO WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE 
+* AND NON-INFRINGEMENT. ALL SUCH WARRANTIES ARE EXPRESSLY DISCLAIMED.
+* TO THE MAXIMUM EXTENT PERMITTED NOT PROHIBITED BY LAW, NEITHER RENESAS 
+* ELECTRONICS CORPORATION NOR ANY OF ITS AFFILIATED COMPANIES SHALL BE LIABLE 
+* FOR ANY DIRECT, INDIRECT, SPECIAL, INCIDENTAL OR CONSEQUENTIAL DAMAGES FOR
+* ANY REASON RELATED TO THIS SOFTWARE, EVEN IF RENESAS OR ITS AFFILIATES HAVE
+* BEEN ADVISED OF THE POSSIBILITY OF SUCH DAMAGES.
+* Renesas reserves the right, without notice, to make changes to this software
+* and to discontinue the availability of this software. By using this software,
+* you agree to the additional terms and conditions found by accessing the 
+* following link:
+* http://www.renesas.com/disclaimer *
+* Copyright (C) 2013 Renesas Electronics Corporation. All rights reserved.    
+*******************************************************************************/
+/*******************************************************************************
+* File Name    : r_fl_clock.c
+* Version      : 3.10
+* Description  : Install clock profile. Installing a new image is limited by 
+*                MCU flash programming (FCLK) and by reading the load image
+*                over the RSPI (PCLKB). fl_clock_install_start() sets FCLK and
+*                PCLKB from FL_CFG_INSTALL_FCK_DIV and FL_CFG_INSTALL_PCKB_DIV,
+*                tells the Flash API the new FCLK so the FCU is given it in 
+*                the next peripheral clock notification, and sets the fastest
+*                RSPI bit rate the SPI flash takes. fl_clock_install_end() 
+*                puts back the clocks from r_bsp_config.h and the RSPI bit 
+*                rate from R_RSPI_Init(), which the User Application expects.
+*
+*                Only the dividers change. The clock source, ICLK and PCLKA
+*                are left as the BSP set them.
+******************************************************************************/  
+/******************************************************************************
+* History : DD.MM.YYYY Version Description
+*         : 19.10.2026 3.10    First Release
+******************************************************************************/
+
+/******************************************************************************
+Includes   <System Includes> , "Project Includes"
+******************************************************************************/
+/* Used for SYSTEM registers and BSP clock macros. */
+#include <platform.h>
+/* Fixed width types support. */
+#include <stdint.h>
+/* Used for bool. */
+#include <stdbool.h>
+/* Flash Loader project includes. */
+#include "r_fl_includes.h"
+/* Tells the Flash API of FCLK changes. */
+#include "r_flash_api_rx_if.h"
+
+#if FL_CFG_INSTALL_CLOCK_ENABLE == 1
+
+/******************************************************************************
+Macro definitions
+******************************************************************************/
+/* Clocks used during an install */
+#define FL_CLOCK_INSTALL_FCLK_HZ    (BSP_SELECTED_CLOCK_HZ / FL_CFG_INSTALL_FCK_DIV)
+#define FL_CLOCK_INSTALL_PCLKB_HZ   (BSP_SELECTED_CLOCK_HZ / FL_CFG_INSTALL_PCKB_DIV)
+
+/* Flash API timeouts are worked out from BSP_FCLK_HZ, so FCLK must not be 
+   slowed down */
+#if FL_CFG_INSTALL_FCK_DIV > BSP_CFG_FCK_DIV
+    #error "FL_CFG_INSTALL_FCK_DIV must not be larger than BSP_CFG_FCK_DIV."
+#endif
+
+#if FL_CFG_INSTALL_PCKB_DIV > BSP_CFG_PCKB_DIV
+    #error "FL_CFG_INSTALL_PCKB_DIV must not be larger than BSP_CFG_PCKB_DIV."
+#endif
+
+#if FL_CLOCK_INSTALL_FCLK_HZ > 50000000
+    #error "FL_CFG_INSTALL_FCK_DIV gives an FCLK above 50MHz."
+#endif
+
+#if FL_CLOCK_INSTALL_PCLKB_HZ > 50000000
+    #error "FL_CFG_INSTALL_PCKB_DIV gives a PCLKB above 50MHz."
+#endif
+
+/* ICLK must be at least as fast as FCLK, and PCLKA at least as fast as 
+   PCLKB */
+#if FL_CFG_INSTALL_FCK_DIV < BSP_CFG_ICK_DIV
+    #error "FL_CFG_INSTALL_FCK_DIV must not be smaller than BSP_CFG_ICK_DIV."
+#endif
+
+#if FL_CFG_INSTALL_PCKB_DIV < BSP_CFG_PCKA_DIV
+    #error "FL_CFG_INSTALL_PCKB_DIV must not be smaller than BSP_CFG_PCKA_DIV."
+#endif
+
+/* These time with the CMT and work out their rates from BSP_PCLKB_HZ */
+#if (FL_CFG_INSTALL_PCKB_DIV != BSP_CFG_PCKB_DIV) && \
+    ((FL_CFG_STATS_ENABLE == 1) || (FL_CFG_ROM_ERASE_TIMING_ENABLE == 1) || (FL_CFG_PROFILE_ENABLE == 1))
+    #error "Changing PCLKB during installs needs FL_CFG_STATS_ENABLE, FL_CFG_ROM_ERASE_TIMING_ENABLE and FL_CFG_PROFILE_ENABLE set to 0."
+#endif
+
+/* SCKCR only needs writing when a divider changes */
+#if (FL_CFG_INSTALL_FCK_DIV != BSP_CFG_FCK_DIV) || (FL_CFG_INSTALL_PCKB_DIV != BSP_CFG_PCKB_DIV)
+    #define FL_CLOCK_SCKCR_CHANGES      (1)
+#else
+    #define FL_CLOCK_SCKCR_CHANGES      (0)
+#endif
+
+/* SCKCR FCK and PCKB bits for the install dividers */
+#define FL_CLOCK_SCKCR_MASK         (0xF0000F00)
+
+#if   FL_CFG_INSTALL_FCK_DIV == 1
+    #define FL_CLOCK_FCK_BITS           (0x00000000)
+#elif FL_CFG_INSTALL_FCK_DIV == 2
+    #define FL_CLOCK_FCK_BITS           (0x10000000)
+#elif FL_CFG_INSTALL_FCK_DIV == 4
+    #define FL_CLOCK_FCK_BITS           (0x20000000)
+#elif FL_CFG_INSTALL_FCK_DIV == 8
+    #define FL_CLOCK_FCK_BITS           (0x30000000)
+#elif FL_CFG_INSTALL_FCK_DIV == 16
+    #define FL_CLOCK_FCK_BITS           (0x40000000)
+#elif FL_CFG_INSTALL_FCK_DIV == 32
+    #define FL_CLOCK_FCK_BITS           (0x50000000)
+#elif FL_CFG_INSTALL_FCK_DIV == 64
+    #define FL_CLOCK_FCK_BITS           (0x60000000)
+#else
+    #error "Error! Invalid setting for FL_CFG_INSTALL_FCK_DIV in r_flash_loader_rx_config.h"
+#endif
+
+#if   FL_CFG_INSTALL_PCKB_DIV == 1
+    #define FL_CLOCK_PCKB_BITS          (0x00000000)
+#elif FL_CFG_INSTALL_PCKB_DIV == 2
+    #define FL_CLOCK_PCKB_BITS          (0x00000100)
+#elif FL_CFG_INSTALL_PCKB_DIV == 4
+    #define FL_CLOCK_PCKB_BITS          (0x00000200)
+#elif FL_CFG_INSTALL_PCKB_DIV == 8
+    #define FL_CLOCK_PCKB_BITS          (0x00000300)
+#elif FL_CFG_INSTALL_PCKB_DIV == 16
+    #define FL_CLOCK_PCKB_BITS          (0x00000400)
+#elif FL_CFG_INSTALL_PCKB_DIV == 32
+    #define FL_CLOCK_PCKB_BITS          (0x00000500)
+#elif FL_CFG_INSTALL_PCKB_DIV == 64
+    #define FL_CLOCK_PCKB_BITS          (0x00000600)
+#else
+    #error "Error! Invalid setting for FL_CFG_INSTALL_PCKB_DIV in r_flash_loader_rx_config.h"
+#endif
+
+/******************************************************************************
+Private global variables and functions
+******************************************************************************/
+/* True between fl_clock_install_start() and fl_clock_install_end() */
+static bool     g_fl_clock_install;
+#if FL_CLOCK_SCKCR_CHANGES == 1
+/* SCKCR as the BSP set it */
+static uint32_t g_fl_clock_sckcr;
+
+static void fl_clock_sckcr_set(uint32_t sckcr);
+#endif
+
+/******************************************************************************
+* Function Name: fl_clock_install_start
+* Description  : Switches to the install clocks. Call it before the new image
+*                is checked and while no flash operation or RSPI transfer is 
+*                running. Does nothing if the install clocks are already set.
+* Arguments    : none
+* Return value : none
+******************************************************************************/
+void fl_clock_install_start(void)
+{
+    if(g_fl_clock_install == true)
+    {
+        return;
+    }
+
+#if FL_CLOCK_SCKCR_CHANGES == 1
+    g_fl_clock_sckcr = SYSTEM.SCKCR.LONG;
+    fl_clock_sckcr_set((g_fl_clock_sckcr & ~FL_CLOCK_SCKCR_MASK) | FL_CLOCK_FCK_BITS | FL_CLOCK_PCKB_BITS);
+#endif
+
+#if FL_CFG_INSTALL_FCK_DIV != BSP_CFG_FCK_DIV
+    /* Every P/E area is notified of the new FCLK before its next operation */
+    R_FlashClockChanged(FL_CLOCK_INSTALL_FCLK_HZ);
+#endif
+
+    fl_mem_set_speed(FL_CLOCK_INSTALL_PCLKB_HZ, FL_CFG_INSTALL_RSPI_MAX_HZ);
+
+    g_fl_clock_install = true;
+}
+/******************************************************************************
+End of function fl_clock_install_start
+******************************************************************************/
+
+/******************************************************************************
+* Function Name: fl_clock_install_end
+* Description  : Puts back the clocks from r_bsp_config.h and the RSPI bit
+*                rate from R_RSPI_Init(). Call it before jumping to the User
+*                Application and while no flash operation or RSPI transfer is
+*                running. Does nothing if the install clocks are not set.
+* Arguments    : none
+* Return value : none
+******************************************************************************/
+void fl_clock_install_end(void)
+{
+    if(g_fl_clock_install == false)
+    {
+        return;
+    }
+
+    /* Slow the RSPI first so it is never above the memory's limit */
+    fl_mem_set_speed(BSP_PCLKB_HZ, 0);
+
+#if FL_CLOCK_SCKCR_CHANGES == 1
+    fl_clock_sckcr_set(g_fl_clock_sckcr);
+#endif
+
+#if FL_CFG_INSTALL_FCK_DIV != BSP_CFG_FCK_DIV
+    R_FlashClockChanged(BSP_FCLK_HZ);
+#endif
+
+    g_fl_clock_install = false;
+}
+/******************************************************************************
+End of function fl_clock_install_end
+******************************************************************************/
+
+#if FL_CLOCK_SCKCR_CHANGES == 1
+/******************************************************************************
+* Function Name: fl_clock_sckcr_set
+* Description  : Writes SCKCR.
+* Arguments    : sckcr - 
+*                    Value to write
+* Return value : none
+******************************************************************************/
+static void fl_clock_sckcr_set(uint32_t sckcr)
+{
+    /* Protect off */
+    SYSTEM.PRCR.WORD = 0xA501;
+
+    SYSTEM.SCKCR.LONG = sckcr;
+
+    /* Read back so the write is done before going on */
+    sckcr = SYSTEM.SCKCR.LONG;
+
+    /* Protect on */
+    SYSTEM.PRCR.WORD = 0xA500;
+}
+/******************************************************************************
+End of function fl_clock_sckcr_set
+******************************************************************************/
+#endif
+
+#endif /* FL_CFG_INSTALL_CLOCK_ENABLE */
@@ -0,0 +1,475 @@
+/*******************************************************************************
+* DISCLAIMER
+* This software is supplied by Renesas Electronics Corporation and is only 
+* intended for use with Renesas products. No other uses are authorized. This 
+* software is owned by Renesas Electronics Corporation and is protected under
+* all applicable laws, including copyright laws.
+* THIS SOFTWARE IS PROVIDED "AS IS" AND RENESAS MAKES NO WARRANTIES REGARDING
+* THIS SOFTWARE, WHETHER EXPRESS, IMPLIED OR STATUTORY, INCLUDING BUT NOT
+* LIMITED TO WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE 
+* AND NON-INFRINGEMENT. ALL SUCH WARRANTIES ARE EXPRESSLY DISCLAIMED.
+* TO THE MAXIMUM EXTENT PERMITTED NOT PROHIBITED BY LAW, NEITHER RENESAS 
+* ELECTRONICS CORPORATION NOR ANY OF ITS AFFILIATED COMPANIES SHALL BE LIABLE 
+* FOR ANY DIRECT, INDIRECT, SPECIAL, INCIDENTAL OR CONSEQUENTIAL DAMAGES FOR
+* ANY REASON RELATED TO THIS SOFTWARE, EVEN IF RENESAS OR ITS AFFILIATES HAVE
+* BEEN ADVISED OF THE POSSIBILITY OF SUCH DAMAGES.
+* Renesas reserves the right, without notice, to make changes to this software
+* and to discontinue the availability of this software. By using this software,
+* you agree to the additional terms and conditions found by accessing the 
+* following link:
+* http://www.renesas.com/disclaimer *
+* Copyright (C) 2013 Renesas Electronics Corporation. All rights reserved.    
+*******************************************************************************/
+/*******************************************************************************
+* File Name    : r_fl_delta.c
+* Version      : 3.10
+* Description  : Applies delta images made by r_fl_mot_converter.py ('-b' 
+*                option) against the image currently in MCU flash. A delta 
+*                only holds the MCU flash erase blocks that changed, in 
+*                ascending address order. Each block is rebuilt from 
+*                operations that copy from the old image, insert new data or
+*                fill with a repeated byte.
+*
+*                Blocks are rebuilt in place one at a time, so a block may 
+*                only copy from old data that is still there when the block
+*                is rebuilt: the block itself and anything above it, or 
+*                blocks that do not change. This is checked as operations 
+*                are read. The block itself is erased before it is 
+*                programmed so its old contents are first copied to a scratch
+*                area in memory (see fl_delta_set_scratch()). Because of this
+*                rule the output is the same whether it is produced before 
+*                anything is erased (to verify it) or while installing.
+******************************************************************************/  
+/******************************************************************************
+* History : DD.MM.YYYY Version Description
+*         : 19.10.2026 3.10    First Release
+******************************************************************************/
+
+/******************************************************************************
+Includes   <System Includes> , "Project Includes"
+******************************************************************************/
+/* Used for memcpy() and memset() */
+#include <string.h>
+/* Fixed width types support. */
+#include <stdint.h>
+/* Used for bool. */
+#include <stdbool.h>
+/* Flash Loader project includes. */
+#include "r_fl_includes.h"
+
+/******************************************************************************
+Macro definitions
+******************************************************************************/
+/* Number of bytes of MCU flash held in an image */
+#define FL_DELTA_IMAGE_BYTES        (0x100000)
+/* Read address of start of image in MCU flash */
+#define FL_DELTA_ROM_START          (0xFFF00000)
+
+/******************************************************************************
+Private global variables and functions
+******************************************************************************/
+static bool fl_delta_get_bytes(fl_delta_state_t * p_state, uint8_t * p_data, uint32_t bytes);
+static bool fl_delta_get_op(fl_delta_state_t * p_state);
+static void fl_delta_copy_old(fl_delta_state_t * p_state, uint8_t * p_out, uint32_t bytes);
+
+/******************************************************************************
+* Function Name: fl_delta_init
+* Description  : Starts applying a delta stored in memory
+* Arguments    : p_state - 
+*                    State to initialize
+*                address - 
+*                    Memory address of start of delta (fl_delta_header_t)
+*                bytes - 
+*                    Length of delta
+*                p_header - 
+*                    Where to place delta header
+* Return value : true - 
+*                    Delta header read
+*                false - 
+*                    Delta is too short
+******************************************************************************/
+bool fl_delta_init(fl_delta_state_t * p_state, uint32_t address, uint32_t bytes, fl_delta_header_t * p_header)
+{
+    p_state->in_address      = address;
+    p_state->in_left         = bytes;
+    p_state->in_pos          = 0;
+    p_state->in_len          = 0;
+    p_state->blocks_left     = 0;
+    p_state->block_offset    = 0;
+    p_state->block_length    = 0;
+    p_state->block_left      = 0;
+    p_state->op_left         = 0;
+    p_state->scratch_address = FL_DELTA_NO_SCRATCH;
+
+    memset(p_state->rebuilt_map, 0, sizeof(p_state->rebuilt_map));
+
+    if(fl_delta_get_bytes(p_state, (uint8_t *)p_header, sizeof(fl_delta_header_t)) == false)
+    {
+        return false;
+    }
+
+    p_state->blocks_left = p_header->num_blocks;
+
+    return true;
+}
+/******************************************************************************
+End of function fl_delta_init
+******************************************************************************/
+
+/******************************************************************************
+* Function Name: fl_delta_next_block
+* Description  : Moves on to the next changed block. The previous block must
+*                have been fully read. Blocks must be in ascending order.
+* Arguments    : p_state - 
+*                    Delta state
+*                p_block - 
+*                    Where to place block info
+* Return value : true - 
+*                    Next block is ready to be read
+*                false - 
+*                    No more blocks, or delta is corrupt
+******************************************************************************/
+bool fl_delta_next_block(fl_delta_state_t * p_state, fl_delta_block_t * p_block)
+{
+    uint32_t unit;
+
+    if((p_state->blocks_left == 0) || (p_state->block_left != 0))
+    {
+        return false;
+    }
+
+    /* Previous block is now rebuilt */
+    for(unit = p_state->block_offset / FL_DELTA_UNIT_BYTES; 
+        unit < ((p_state->block_offset + p_state->block_length) / FL_DELTA_UNIT_BYTES); 
+        unit++)
+    {
+        p_state->rebuilt_map[unit / 8] |= (uint8_t)(1 << (unit % 8));
+    }
+
+    if(fl_delta_get_bytes(p_state, (uint8_t *)p_block, sizeof(fl_delta_block_t)) == false)
+    {
+        return false;
+    }
+
+    /* Block must be above the last one and inside the image */
+    if( (p_block->length == 0) ||
+        ((p_block->offset % FL_DELTA_UNIT_BYTES) != 0) ||
+        ((p_block->length % FL_DELTA_UNIT_BYTES) != 0) ||
+        (p_block->offset < (p_state->block_offset + p_state->block_length)) ||
+        (p_block->offset > FL_DELTA_IMAGE_BYTES) ||
+        (p_block->length > (FL_DELTA_IMAGE_BYTES - p_block->offset)) )
+    {
+        return false;
+    }
+
+    p_state->blocks_left--;
+    p_state->block_offset    = p_block->offset;
+    p_state->block_length    = p_block->length;
+    p_state->block_left      = p_block->length;
+    p_state->op_left         = 0;
+    p_state->scratch_address = FL_DELTA_NO_SCRATCH;
+
+    return true;
+}
+/******************************************************************************
+End of function fl_delta_next_block
+******************************************************************************/
+
+/******************************************************************************
+* Function Name: fl_delta_set_scratch
+* Description  : Tells the delta code where the old contents of the current
+*                block were copied to. Call this after fl_delta_next_block()
+*                and before erasing the block.
+* Arguments    : p_state - 
+*                    Delta state
+*                address - 
+*                    Memory address holding old copy of block, or 
+*                    FL_DELTA_NO_SCRATCH
+* Return value : none
+******************************************************************************/
+void fl_delta_set_scratch(fl_delta_state_t * p_state, uint32_t address)
+{
+    p_state->scratch_address = address;
+}
+/******************************************************************************
+End of function fl_delta_set_scratch
+******************************************************************************/
+
+/******************************************************************************
+* Function Name: fl_delta_read
+* Description  : Outputs the next bytes of the current block
+* Arguments    : p_state - 
+*                    Delta state
+*                p_out - 
+*                    Where to place output
+*                bytes - 
+*                    How many bytes to output
+* Return value : Number of bytes output. This is less than 'bytes' if the 
+*                block ended or the delta is corrupt.
+******************************************************************************/
+uint32_t fl_delta_read(fl_delta_state_t * p_state, uint8_t * p_out, uint32_t bytes)
+{
+    uint32_t produced;
+    uint32_t count;
+
+    produced = 0;
+
+    while((produced < bytes) && (p_state->block_left > 0))
+    {
+        /* Start next operation */
+        if(p_state->op_left == 0)
+        {
+            if(fl_delta_get_op(p_state) == false)
+            {
+                break;
+            }
+        }
+
+        /* Output as much of this operation as possible */
+        count = p_state->op_left;
+
+        if(count > (bytes - produced))
+        {
+            count = bytes - produced;
+        }
+
+        if(p_state->op == FL_DELTA_OP_COPY)
+        {
+            fl_delta_copy_old(p_state, &p_out[produced], count);
+
+            p_state->src_offset += count;
+        }
+        else if(p_state->op == FL_DELTA_OP_INSERT)
+        {
+            if(fl_delta_get_bytes(p_state, &p_out[produced], count) == false)
+            {
+                break;
+            }
+        }
+        else
+        {
+            memset(&p_out[produced], p_state->fill_value, count);
+        }
+
+        p_state->op_left    -= count;
+        p_state->block_left -= count;
+        produced            += count;
+    }
+
+    return produced;
+}
+/******************************************************************************
+End of function fl_delta_read
+******************************************************************************/
+
+/******************************************************************************
+* Function Name: fl_delta_get_op
+* Description  : Reads the next operation for the current block and checks 
+*                that it stays inside the block and only copies old data 
+*                that is still available.
+* Arguments    : p_state - 
+*                    Delta state
+* Return value : true - 
+*                    Operation is ready
+*                false - 
+*                    Delta is corrupt
+******************************************************************************/
+static bool fl_delta_get_op(fl_delta_state_t * p_state)
+{
+    uint16_t insert_len;
+    uint32_t unit;
+    uint32_t end;
+
+    if(fl_delta_get_bytes(p_state, &p_state->op, sizeof(p_state->op)) == false)
+    {
+        return false;
+    }
+
+    if(p_state->op == FL_DELTA_OP_COPY)
+    {
+        if( (fl_delta_get_bytes(p_state, (uint8_t *)&p_state->src_offset, sizeof(p_state->src_offset)) == false) ||
+            (fl_delta_get_bytes(p_state, (uint8_t *)&p_state->op_left, sizeof(p_state->op_left)) == false) )
+        {
+            return false;
+        }
+
+        /* Source must be inside image */
+        if( (p_state->src_offset > FL_DELTA_IMAGE_BYTES) ||
+            (p_state->op_left > (FL_DELTA_IMAGE_BYTES - p_state->src_offset)) ||
+            (p_state->op_left == 0) )
+        {
+            return false;
+        }
+
+        /* Source must not be in a block that was already rebuilt. Those 
+           blocks no longer hold old data. */
+        end = p_state->src_offset + p_state->op_left;
+
+        for(unit = p_state->src_offset / FL_DELTA_UNIT_BYTES; unit <= ((end - 1) / FL_DELTA_UNIT_BYTES); unit++)
+        {
+            if((p_state->rebuilt_map[unit / 8] & (1 << (unit % 8))) != 0)
+            {
+                return false;
+            }
+        }
+    }
+    else if(p_state->op == FL_DELTA_OP_INSERT)
+    {
+        if(fl_delta_get_bytes(p_state, (uint8_t *)&insert_len, sizeof(insert_len)) == false)
+        {
+            return false;
+        }
+
+        p_state->op_left = insert_len;
+    }
+    else if(p_state->op == FL_DELTA_OP_FILL)
+    {
+        if( (fl_delta_get_bytes(p_state, (uint8_t *)&p_state->op_left, sizeof(p_state->op_left)) == false) ||
+            (fl_delta_get_bytes(p_state, &p_state->fill_value, sizeof(p_state->fill_value)) == false) )
+        {
+            return false;
+        }
+    }
+    else
+    {
+        /* Unknown operation */
+        return false;
+    }
+
+    /* Operation must not run past end of block */
+    if((p_state->op_left == 0) || (p_state->op_left > p_state->block_left))
+    {
+        return false;
+    }
+
+    return true;
+}
+/******************************************************************************
+End of function fl_delta_get_op
+******************************************************************************/
+
+/******************************************************************************
+* Function Name: fl_delta_copy_old
+* Description  : Copies old image data. Data inside the current block comes
+*                from the scratch copy when one is set. Everything else is 
+*                read straight from MCU flash.
+* Arguments    : p_state - 
+*                    Delta state
+*                p_out - 
+*                    Where to place data
+*                bytes - 
+*                    How many bytes to copy from p_state->src_offset
+* Return value : none
+******************************************************************************/
+static void fl_delta_copy_old(fl_delta_state_t * p_state, uint8_t * p_out, uint32_t bytes)
+{
+    uint32_t src;
+    uint32_t count;
+    uint32_t block_end;
+
+    src       = p_state->src_offset;
+    block_end = p_state->block_offset + p_state->block_length;
+
+    while(bytes > 0)
+    {
+        if( (p_state->scratch_address != FL_DELTA_NO_SCRATCH) &&
+            (src >= p_state->block_offset) && 
+            (src < block_end) )
+        {
+            /* Old copy of current block */
+            count = block_end - src;
+
+            if(count > bytes)
+            {
+                count = bytes;
+            }
+
+            fl_mem_read(p_state->scratch_address + (src - p_state->block_offset), p_out, count);
+        }
+        else
+        {
+            /* Stop at start of current block if a scratch copy is used */
+            count = bytes;
+
+            if( (p_state->scratch_address != FL_DELTA_NO_SCRATCH) &&
+                (src < p_state->block_offset) && 
+                ((p_state->block_offset - src) < count) )
+            {
+                count = p_state->block_offset - src;
+            }
+
+            memcpy(p_out, (uint8_t *)(FL_DELTA_ROM_START + src), count);
+        }
+
+        src   += count;
+        p_out += count;
+        bytes -= count;
+    }
+}
+/******************************************************************************
+End of function fl_delta_copy_old
+******************************************************************************/
+
+/******************************************************************************
+* Function Name: fl_delta_get_bytes
+* Description  : Reads the next bytes of the delta. Memory is read 
+*                FL_DELTA_IN_BUF_BYTES at a time.
+* Arguments    : p_state - 
+*                    Delta state
+*                p_data - 
+*                    Where to place bytes
+*                bytes - 
+*                    How many bytes to read
+* Return value : true - 
+*                    Bytes read
+*                false - 
+*                    End of delta
+******************************************************************************/
+static bool fl_delta_get_bytes(fl_delta_state_t * p_state, uint8_t * p_data, uint32_t bytes)
+{
+    uint32_t count;
+
+    while(bytes > 0)
+    {
+        /* Refill input buffer if needed */
+        if(p_state->in_pos >= p_state->in_len)
+        {
+            if(p_state->in_left == 0)
+            {
+                return false;
+            }
+
+            count = p_state->in_left;
+
+            if(count > FL_DELTA_IN_BUF_BYTES)
+            {
+                count = FL_DELTA_IN_BUF_BYTES;
+            }
+
+            fl_mem_read(p_state->in_address, p_state->in_buf, count);
+
+            p_state->in_address += count;
+            p_state->in_left    -= count;
+            p_state->in_pos      = 0;
+            p_state->in_len      = (uint16_t)count;
+        }
+
+        count = (uint32_t)(p_state->in_len - p_state->in_pos);
+
+        if(count > bytes)
+        {
+            count = bytes;
+        }
+
+        memcpy(p_data, &p_state->in_buf[p_state->in_pos], count);
+
+        p_state->in_pos += (uint16_t)count;
+        p_data          += count;
+        bytes           -= count;
+    }
+
+    return true;
+}
+/******************************************************************************
+End of function fl_delta_get_bytes
+******************************************************************************/
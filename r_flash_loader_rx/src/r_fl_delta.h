@@ -0,0 +1,115 @@
+/*******************************************************************************
+* DISCLAIMER
+* This software is supplied by Renesas Electronics Corporation and is only 
+* intended for use with Renesas products. No other uses are authorized. This 
+* software is owned by Renesas Electronics Corporation and is protected under
+* all applicable laws, including copyright laws.
+* THIS SOFTWARE IS PROVIDED "AS IS" AND RENESAS MAKES NO WARRANTIES REGARDING
+* THIS SOFTWARE, WHETHER EXPRESS, IMPLIED OR STATUTORY, INCLUDING BUT NOT
+* LIMITED TO WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE 
+* AND NON-INFRINGEMENT. ALL SUCH WARRANTIES ARE EXPRESSLY DISCLAIMED.
+* TO THE MAXIMUM EXTENT PERMITTED NOT PROHIBITED BY LAW, NEITHER RENESAS 
+* ELECTRONICS CORPORATION NOR ANY OF ITS AFFILIATED COMPANIES SHALL BE LIABLE 
+* FOR ANY DIRECT, INDIRECT, SPECIAL, INCIDENTAL OR CONSEQUENTIAL DAMAGES FOR
+* ANY REASON RELATED TO THIS SOFTWARE, EVEN IF RENESAS OR ITS AFFILIATES HAVE
+* BEEN ADVISED OF THE POSSIBILITY OF SUCH DAMAGES.
+* Renesas reserves the right, without notice, to make changes to this software
+* and to discontinue the availability of this software. By using this software,
+* you agree to the additional terms and conditions found by accessing the 
+* following link:
+* http://www.renesas.com/disclaimer *
+* Copyright (C) 2013 Renesas Electronics Corporation. All rights reserved.    
+*******************************************************************************/
+/*******************************************************************************
+* File Name    : r_fl_delta.h
+* Version      : 3.10
+* Description  : Applies delta images against the image in MCU flash.
+******************************************************************************/  
+/******************************************************************************
+* History : DD.MM.YYYY Version Description
+*         : 19.10.2026 3.10    First Release
+******************************************************************************/
+
+#ifndef FL_DELTA_H
+#define FL_DELTA_H
+
+/******************************************************************************
+Includes   <System Includes> , "Project Includes"
+******************************************************************************/
+/* Fixed width types support. */
+#include <stdint.h>
+/* Used for bool. */
+#include <stdbool.h>
+/* Flash Loader types. */
+#include "r_fl_types.h"
+
+/******************************************************************************
+Macro definitions
+******************************************************************************/
+/* Delta operations. Each starts with 1 byte holding the operation. */
+/* Copy from old image. Followed by 32-bit source offset and 32-bit length. */
+#define FL_DELTA_OP_COPY            (1)
+/* New data. Followed by 16-bit length and then the data. */
+#define FL_DELTA_OP_INSERT          (2)
+/* Repeated byte. Followed by 32-bit length and the byte value. */
+#define FL_DELTA_OP_FILL            (3)
+
+/* Number of delta bytes read from memory at a time */
+#define FL_DELTA_IN_BUF_BYTES       (64)
+
+/* Use for fl_delta_set_scratch() when old data is all still in MCU flash */
+#define FL_DELTA_NO_SCRATCH         (0xFFFFFFFF)
+
+/* Blocks must start and end on this boundary. Used for tracking which parts
+   of the image have been rebuilt. */
+#define FL_DELTA_UNIT_BYTES         (0x1000)
+
+/* Number of bytes needed to hold 1 bit for each unit of a 1MB image */
+#define FL_DELTA_MAP_BYTES          (0x100000 / FL_DELTA_UNIT_BYTES / 8)
+
+/******************************************************************************
+Typedef definitions
+******************************************************************************/
+/* State of a delta being applied */
+typedef struct
+{
+    /* Memory address of next delta byte to read in to in_buf */
+    uint32_t    in_address;
+    /* Delta bytes not yet read in to in_buf */
+    uint32_t    in_left;
+    /* Delta bytes read from memory */
+    uint8_t     in_buf[FL_DELTA_IN_BUF_BYTES];
+    /* Next byte to use in in_buf */
+    uint16_t    in_pos;
+    /* Number of valid bytes in in_buf */
+    uint16_t    in_len;
+    /* Changed blocks left to read */
+    uint16_t    blocks_left;
+    /* Block being rebuilt */
+    uint32_t    block_offset;
+    uint32_t    block_length;
+    /* Bytes of block not yet output */
+    uint32_t    block_left;
+    /* Operation in progress and bytes it has left to output */
+    uint8_t     op;
+    uint32_t    op_left;
+    /* Source offset for FL_DELTA_OP_COPY */
+    uint32_t    src_offset;
+    /* Value for FL_DELTA_OP_FILL */
+    uint8_t     fill_value;
+    /* Memory address holding old copy of current block, or 
+       FL_DELTA_NO_SCRATCH */
+    uint32_t    scratch_address;
+    /* 1 bit for each unit of the image that is in a block already rebuilt */
+    uint8_t     rebuilt_map[FL_DELTA_MAP_BYTES];
+} fl_delta_state_t;
+
+/******************************************************************************
+Exported global functions (to be accessed by other files)
+******************************************************************************/
+bool     fl_delta_init(fl_delta_state_t * p_state, uint32_t address, uint32_t bytes, fl_delta_header_t * p_header);
+bool     fl_delta_next_block(fl_delta_state_t * p_state, fl_delta_block_t * p_block);
+void     fl_delta_set_scratch(fl_delta_state_t * p_state, uint32_t address);
+uint32_t fl_delta_read(fl_delta_state_t * p_state, uint8_t * p_out, uint32_t bytes);
+
+#endif /* FL_DELTA_H */
@@ -0,0 +1,375 @@
+/*******************************************************************************
+* DISCLAIMER
+* This software is supplied by Renesas Electronics Corporation and is only 
+* intended for use with Renesas products. No other uses are authorized. This 
+* software is owned by Renesas Electronics Corporation and is protected under
+* all applicable laws, including copyright laws.
+* THIS SOFTWARE IS PROVIDED "AS IS" AND RENESAS MAKES NO WARRANTIES REGARDING
+* THIS SOFTWARE, WHETHER EXPRESS, IMPLIED OR STATUTORY, INCLUDING BUT NOT
+* LIMITED TO WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE 
+* AND NON-INFRINGEMENT. ALL SUCH WARRANTIES ARE EXPRESSLY DISCLAIMED.
+* TO THE MAXIMUM EXTENT PERMITTED NOT PROHIBITED BY LAW, NEITHER RENESAS 
+* ELECTRONICS CORPORATION NOR ANY OF ITS AFFILIATED COMPANIES SHALL BE LIABLE 
+* FOR ANY DIRECT, INDIRECT, SPECIAL, INCIDENTAL OR CONSEQUENTIAL DAMAGES FOR
+* ANY REASON RELATED TO THIS SOFTWARE, EVEN IF RENESAS OR ITS AFFILIATES HAVE
+* BEEN ADVISED OF THE POSSIBILITY OF SUCH DAMAGES.
+* Renesas reserves the right, without notice, to make changes to this software
+* and to discontinue the availability of this software. By using this software,
+* you agree to the additional terms and conditions found by accessing the 
+* following link:
+* http://www.renesas.com/disclaimer *
+* Copyright (C) 2013 Renesas Electronics Corporation. All rights reserved.    
+*******************************************************************************/
+/*******************************************************************************
+* File Name    : r_fl_directory.c
+* Version      : 3.10
+* Description  : Slot directory. A single page at FL_CFG_MEM_DIR_ADDR holds a
+*                copy of each slot's load image header along with the slot's
+*                size, CRC and lifecycle state. The Bootloader reads this page
+*                once at boot instead of reading and verifying every slot.
+*                States are encoded so that each change only clears bits. This
+*                means a state change is a single program and does not need
+*                an erase of the directory sector.
+*
+*                The User Application writes a slot's entry as it stores a 
+*                load image, through the Bootloader services table: 
+*                fl_dir_clear_slot(), FL_DIR_STATE_RECEIVING, the image data,
+*                fl_dir_set_image_info(), then FL_DIR_STATE_COMPLETE. The 
+*                Bootloader moves a COMPLETE slot to INSTALLED or BAD. 
+*                'image_size' and 'image_crc' describe the bytes stored in the
+*                slot so the User Application can check a slot against what 
+*                it downloaded. The Bootloader checks images with raw_crc.
+******************************************************************************/  
+/******************************************************************************
+* History : DD.MM.YYYY Version Description
+*         : 19.10.2026 3.10    First Release
+*         : 19.10.2026 3.20    fl_dir_set_state() does not program a state 
+*                              that is already set.
+******************************************************************************/
+
+/******************************************************************************
+Includes   <System Includes> , "Project Includes"
+******************************************************************************/
+/* Defines standard macros used in this file */
+#include <stddef.h>
+/* Used for memset() */
+#include <string.h>
+/* Fixed width types support. */
+#include <stdint.h>
+/* Used for bool. */
+#include <stdbool.h>
+/* Flash Loader project includes. */
+#include "r_fl_includes.h"
+
+/******************************************************************************
+Macro definitions
+******************************************************************************/
+#if (FL_CFG_MEM_DIR_ENABLE == 1) && (FL_CFG_MEM_NUM_LOAD_IMAGES > FL_DIR_MAX_SLOTS)
+    #error "Too many load images for one directory page. Lower FL_CFG_MEM_NUM_LOAD_IMAGES or disable FL_CFG_MEM_DIR_ENABLE."
+#endif
+
+/* Address in memory of an entry */
+#define FL_DIR_ENTRY_ADDR(slot)     (FL_CFG_MEM_DIR_ADDR + \
+                                     offsetof(fl_dir_t, entries) + \
+                                     ((uint32_t)(slot) * sizeof(fl_dir_entry_t)))
+
+/******************************************************************************
+Private global variables and functions
+******************************************************************************/
+/* RAM copy of directory page */
+static fl_dir_t g_fl_dir;
+/* Whether g_fl_dir holds a formatted directory */
+static bool     g_fl_dir_valid = false;
+
+static bool fl_dir_write_page(void);
+
+/******************************************************************************
+* Function Name: fl_dir_read
+* Description  : Reads the directory page from memory in to RAM. This is the
+*                only read needed to decide what to boot.
+* Arguments    : none
+* Return value : true - 
+*                    Directory is formatted and matches this configuration
+*                false - 
+*                    Directory is not present, caller should fall back to
+*                    reading slot headers
+******************************************************************************/
+bool fl_dir_read(void)
+{
+    /* One read of the whole page */
+    fl_mem_read(FL_CFG_MEM_DIR_ADDR, (uint8_t *)&g_fl_dir, sizeof(g_fl_dir));
+
+    /* Directory must be formatted for the same number of slots */
+    if( (g_fl_dir.magic == FL_DIR_MAGIC) &&
+        (g_fl_dir.num_slots == FL_CFG_MEM_NUM_LOAD_IMAGES) )
+    {
+        g_fl_dir_valid = true;
+    }
+    else
+    {
+        g_fl_dir_valid = false;
+    }
+
+    return g_fl_dir_valid;
+}
+/******************************************************************************
+End of function fl_dir_read
+******************************************************************************/
+
+/******************************************************************************
+* Function Name: fl_dir_format
+* Description  : Erases the directory sector and writes an empty directory.
+*                All slots are marked FL_DIR_STATE_EMPTY.
+* Arguments    : none
+* Return value : true - 
+*                    Directory formatted
+*                false - 
+*                    Error occurred
+******************************************************************************/
+bool fl_dir_format(void)
+{
+    /* Start from an all erased page */
+    memset(&g_fl_dir, 0xFF, sizeof(g_fl_dir));
+
+    g_fl_dir.magic     = FL_DIR_MAGIC;
+    g_fl_dir.num_slots = FL_CFG_MEM_NUM_LOAD_IMAGES;
+
+    g_fl_dir_valid = fl_dir_write_page();
+
+    return g_fl_dir_valid;
+}
+/******************************************************************************
+End of function fl_dir_format
+******************************************************************************/
+
+/******************************************************************************
+* Function Name: fl_dir_is_valid
+* Description  : Returns whether the RAM copy holds a formatted directory
+* Arguments    : none
+* Return value : true - 
+*                    Directory is valid
+*                false - 
+*                    Directory is not valid
+******************************************************************************/
+bool fl_dir_is_valid(void)
+{
+    return g_fl_dir_valid;
+}
+/******************************************************************************
+End of function fl_dir_is_valid
+******************************************************************************/
+
+/******************************************************************************
+* Function Name: fl_dir_get_state
+* Description  : Returns the lifecycle state of a slot
+* Arguments    : slot - 
+*                    Which load image slot
+* Return value : FL_DIR_STATE_xxx value. FL_DIR_STATE_EMPTY is returned if the
+*                directory or slot is not valid.
+******************************************************************************/
+uint8_t fl_dir_get_state(uint8_t slot)
+{
+    if((g_fl_dir_valid == false) || (slot >= FL_CFG_MEM_NUM_LOAD_IMAGES))
+    {
+        return FL_DIR_STATE_EMPTY;
+    }
+
+    return g_fl_dir.entries[slot].state;
+}
+/******************************************************************************
+End of function fl_dir_get_state
+******************************************************************************/
+
+/******************************************************************************
+* Function Name: fl_dir_get_entry
+* Description  : Copies out the directory entry for a slot
+* Arguments    : slot - 
+*                    Which load image slot
+*                p_entry - 
+*                    Where to place the entry
+* Return value : true - 
+*                    Entry copied
+*                false - 
+*                    Directory or slot is not valid
+******************************************************************************/
+bool fl_dir_get_entry(uint8_t slot, fl_dir_entry_t * p_entry)
+{
+    if((g_fl_dir_valid == false) || (slot >= FL_CFG_MEM_NUM_LOAD_IMAGES))
+    {
+        return false;
+    }
+
+    *p_entry = g_fl_dir.entries[slot];
+
+    return true;
+}
+/******************************************************************************
+End of function fl_dir_get_entry
+******************************************************************************/
+
+/******************************************************************************
+* Function Name: fl_dir_set_state
+* Description  : Changes the lifecycle state of a slot. Only changes that 
+*                clear bits are allowed (e.g. RECEIVING -> COMPLETE) so that
+*                no erase is needed. Use fl_dir_clear_slot() to go back to 
+*                FL_DIR_STATE_EMPTY.
+* Arguments    : slot - 
+*                    Which load image slot
+*                state - 
+*                    New FL_DIR_STATE_xxx value
+* Return value : true - 
+*                    State changed, or was already set
+*                false - 
+*                    Directory or slot is not valid, or change would need an
+*                    erase
+******************************************************************************/
+bool fl_dir_set_state(uint8_t slot, uint8_t state)
+{
+    if((g_fl_dir_valid == false) || (slot >= FL_CFG_MEM_NUM_LOAD_IMAGES))
+    {
+        return false;
+    }
+
+    /* Nothing to program */
+    if(g_fl_dir.entries[slot].state == state)
+    {
+        return true;
+    }
+
+    /* Bits can only be cleared by programming */
+    if((state & (uint8_t)(~g_fl_dir.entries[slot].state)) != 0)
+    {
+        return false;
+    }
+
+    g_fl_dir.entries[slot].state = state;
+
+    /* Program just the state byte */
+    fl_mem_write(FL_DIR_ENTRY_ADDR(slot) + offsetof(fl_dir_entry_t, state),
+                 &g_fl_dir.entries[slot].state,
+                 sizeof(g_fl_dir.entries[slot].state));
+
+    return true;
+}
+/******************************************************************************
+End of function fl_dir_set_state
+******************************************************************************/
+
+/******************************************************************************
+* Function Name: fl_dir_set_image_info
+* Description  : Records the header, size and CRC of the image in a slot. This
+*                can only be done once after the slot was cleared. Call
+*                fl_dir_set_state() with FL_DIR_STATE_COMPLETE afterwards.
+* Arguments    : slot - 
+*                    Which load image slot
+*                p_header - 
+*                    Load image header of stored image
+*                image_size - 
+*                    Number of bytes stored in slot
+*                image_crc - 
+*                    CRC of image as stored in slot
+* Return value : true - 
+*                    Info recorded
+*                false - 
+*                    Directory or slot is not valid, or info was already
+*                    recorded
+******************************************************************************/
+bool fl_dir_set_image_info(uint8_t slot, fl_image_header_t * p_header, uint32_t image_size, uint16_t image_crc)
+{
+    fl_dir_entry_t * p_entry;
+    uint8_t        * p_byte;
+    uint32_t         i;
+
+    if((g_fl_dir_valid == false) || (slot >= FL_CFG_MEM_NUM_LOAD_IMAGES))
+    {
+        return false;
+    }
+
+    p_entry = &g_fl_dir.entries[slot];
+
+    /* Everything after the state byte must still be erased */
+    p_byte = (uint8_t *)&p_entry->header;
+
+    for(i = 0; i < (sizeof(fl_dir_entry_t) - offsetof(fl_dir_entry_t, header)); i++)
+    {
+        if(p_byte[i] != 0xFF)
+        {
+            return false;
+        }
+    }
+
+    p_entry->header     = *p_header;
+    p_entry->image_size = image_size;
+    p_entry->image_crc  = image_crc;
+
+    /* Program everything after the state byte */
+    fl_mem_write(FL_DIR_ENTRY_ADDR(slot) + offsetof(fl_dir_entry_t, header),
+                 (uint8_t *)&p_entry->header,
+                 sizeof(fl_dir_entry_t) - offsetof(fl_dir_entry_t, header));
+
+    return true;
+}
+/******************************************************************************
+End of function fl_dir_set_image_info
+******************************************************************************/
+
+/******************************************************************************
+* Function Name: fl_dir_clear_slot
+* Description  : Returns a slot to FL_DIR_STATE_EMPTY so a new image can be 
+*                stored in it. This needs an erase of the directory sector so
+*                the whole page is rewritten from the RAM copy.
+* Arguments    : slot - 
+*                    Which load image slot
+* Return value : true - 
+*                    Slot cleared
+*                false - 
+*                    Directory or slot is not valid
+******************************************************************************/
+bool fl_dir_clear_slot(uint8_t slot)
+{
+    if((g_fl_dir_valid == false) || (slot >= FL_CFG_MEM_NUM_LOAD_IMAGES))
+    {
+        return false;
+    }
+
+    /* Nothing to do if slot is already empty */
+    if(g_fl_dir.entries[slot].state == FL_DIR_STATE_EMPTY)
+    {
+        return true;
+    }
+
+    memset(&g_fl_dir.entries[slot], 0xFF, sizeof(fl_dir_entry_t));
+
+    return fl_dir_write_page();
+}
+/******************************************************************************
+End of function fl_dir_clear_slot
+******************************************************************************/
+
+/******************************************************************************
+* Function Name: fl_dir_write_page
+* Description  : Erases the directory sector and writes the RAM copy back. If
+*                power is lost in between the directory reads as unformatted
+*                and the Bootloader falls back to reading slot headers.
+* Arguments    : none
+* Return value : true - 
+*                    Page written
+*                false - 
+*                    Erase failed
+******************************************************************************/
+static bool fl_dir_write_page(void)
+{
+    /* Erase directory sector */
+    if(fl_mem_erase(FL_CFG_MEM_DIR_ADDR, FL_MEM_ERASE_SECTOR) == false)
+    {
+        return false;
+    }
+
+    /* Write directory */
+    fl_mem_write(FL_CFG_MEM_DIR_ADDR, (uint8_t *)&g_fl_dir, sizeof(g_fl_dir));
+
+    return true;
+}
+/******************************************************************************
+End of function fl_dir_write_page
+******************************************************************************/
@@ -0,0 +1,87 @@
+/*******************************************************************************
+* DISCLAIMER
+* This software is supplied by Renesas Electronics Corporation and is only 
+* intended for use with Renesas products. No other uses are authorized. This 
+* software is owned by Renesas Electronics Corporation and is protected under
+* all applicable laws, including copyright laws.
+* THIS SOFTWARE IS PROVIDED "AS IS" AND RENESAS MAKES NO WARRANTIES REGARDING
+* THIS SOFTWARE, WHETHER EXPRESS, IMPLIED OR STATUTORY, INCLUDING BUT NOT
+* LIMITED TO WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE 
+* AND NON-INFRINGEMENT. ALL SUCH WARRANTIES ARE EXPRESSLY DISCLAIMED.
+* TO THE MAXIMUM EXTENT PERMITTED NOT PROHIBITED BY LAW, NEITHER RENESAS 
+* ELECTRONICS CORPORATION NOR ANY OF ITS AFFILIATED COMPANIES SHALL BE LIABLE 
+* FOR ANY DIRECT, INDIRECT, SPECIAL, INCIDENTAL OR CONSEQUENTIAL DAMAGES FOR
+* ANY REASON RELATED TO THIS SOFTWARE, EVEN IF RENESAS OR ITS AFFILIATES HAVE
+* BEEN ADVISED OF THE POSSIBILITY OF SUCH DAMAGES.
+* Renesas reserves the right, without notice, to make changes to this software
+* and to discontinue the availability of this software. By using this software,
+* you agree to the additional terms and conditions found by accessing the 
+* following link:
+* http://www.renesas.com/disclaimer *
+* Copyright (C) 2013 Renesas Electronics Corporation. All rights reserved.    
+*******************************************************************************/
+/*******************************************************************************
+* File Name    : r_fl_directory.h
+* Version      : 3.10
+* Description  : Slot directory. A single page in memory that holds the state
+*                of every load image slot so that the boot decision can be
+*                made with one read.
+******************************************************************************/  
+/******************************************************************************
+* History : DD.MM.YYYY Version Description
+*         : 19.10.2026 3.10    First Release
+******************************************************************************/
+
+#ifndef FL_DIRECTORY_H
+#define FL_DIRECTORY_H
+
+/******************************************************************************
+Includes   <System Includes> , "Project Includes"
+******************************************************************************/
+/* Fixed width types support. */
+#include <stdint.h>
+/* Used for bool. */
+#include <stdbool.h>
+/* Flash Loader types. */
+#include "r_fl_types.h"
+
+/******************************************************************************
+Macro definitions
+******************************************************************************/
+/* Marks a formatted directory page ("FDIR"). */
+#define FL_DIR_MAGIC                (0x52494446)
+
+/* Size of the directory page in bytes. */
+#define FL_DIR_PAGE_BYTES           (256)
+
+/* Number of slots that fit in one directory page. This is
+   (FL_DIR_PAGE_BYTES - 8 byte page header) / 18 byte entries. */
+#define FL_DIR_MAX_SLOTS            (13)
+
+/* Slot lifecycle states. Each state only clears bits of the one before it
+   so a state change is a single program operation without an erase. Any
+   state can move to FL_DIR_STATE_BAD. */
+/* Nothing stored in slot (erased). */
+#define FL_DIR_STATE_EMPTY          (0xFF)
+/* Image is being downloaded in to slot. */
+#define FL_DIR_STATE_RECEIVING      (0xFE)
+/* Image is fully stored and image info is valid. */
+#define FL_DIR_STATE_COMPLETE       (0xFC)
+/* Image has been programmed in to MCU flash. */
+#define FL_DIR_STATE_INSTALLED      (0xF8)
+/* Image failed verification and must not be used. */
+#define FL_DIR_STATE_BAD            (0x00)
+
+/******************************************************************************
+Exported global functions (to be accessed by other files)
+******************************************************************************/
+bool    fl_dir_read(void);
+bool    fl_dir_format(void);
+bool    fl_dir_is_valid(void);
+uint8_t fl_dir_get_state(uint8_t slot);
+bool    fl_dir_get_entry(uint8_t slot, fl_dir_entry_t * p_entry);
+bool    fl_dir_set_state(uint8_t slot, uint8_t state);
+bool    fl_dir_set_image_info(uint8_t slot, fl_image_header_t * p_header, uint32_t image_size, uint16_t image_crc);
+bool    fl_dir_clear_slot(uint8_t slot);
+
+#endif /* FL_DIRECTORY_H */
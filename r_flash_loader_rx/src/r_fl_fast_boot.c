@@ -0,0 +1,277 @@
+/*******************************************************************************
+* DISCLAIMER
+* This software is supplied by Renesas Electronics Corporation and is only 
+* intended for use with Renesas products. No other uses are authorized. This 
+* software is owned by Renesas Electronics Corporation and is protected under
+* all applicable laws, including copyright laws.
+* THIS SOFTWARE IS PROVIDED "AS IS" AND RENESAS MAKES NO WARRANTIES REGARDING
+* THIS SOFTWARE, WHETHER EXPRESS, IMPLIED OR STATUTORY, INCLUDING BUT NOT
+* LIMITED TO WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE 
+* AND NON-INFRINGEMENT. ALL SUCH WARRANTIES ARE EXPRESSLY DISCLAIMED.
+* TO THE MAXIMUM EXTENT PERMITTED NOT PROHIBITED BY LAW, NEITHER RENESAS 
+* ELECTRONICS CORPORATION NOR ANY OF ITS AFFILIATED COMPANIES SHALL BE LIABLE 
+* FOR ANY DIRECT, INDIRECT, SPECIAL, INCIDENTAL OR CONSEQUENTIAL DAMAGES FOR
+* ANY REASON RELATED TO THIS SOFTWARE, EVEN IF RENESAS OR ITS AFFILIATES HAVE
+* BEEN ADVISED OF THE POSSIBILITY OF SUCH DAMAGES.
+* Renesas reserves the right, without notice, to make changes to this software
+* and to discontinue the availability of this software. By using this software,
+* you agree to the additional terms and conditions found by accessing the 
+* following link:
+* http://www.renesas.com/disclaimer *
+* Copyright (C) 2013 Renesas Electronics Corporation. All rights reserved.    
+*******************************************************************************/
+/*******************************************************************************
+* File Name    : r_fl_fast_boot.c
+* Version      : 3.10
+* Description  : Lets the Bootloader start the User Application straight out 
+*                of reset. After a boot that found the image in MCU flash 
+*                good and nothing newer to install, fl_fast_boot_set() writes
+*                a record for that image to a data flash block of its own. 
+*                fl_fast_boot() is the BSP_CFG_FAST_BOOT_CALLBACK of the 
+*                Bootloader's BSP. It runs before the clocks, RAM, ports, CRC
+*                and memory are set up and jumps to the User Application 
+*                while the record matches the image in MCU flash. The User 
+*                Application's own start up code then sets up the MCU as it 
+*                does after a reset.
+*
+*                The User Application must call fl_fast_boot_clear() when it
+*                stores a new load image or finds its image bad, so the next
+*                boot does the full checks and install.
+******************************************************************************/  
+/******************************************************************************
+* History : DD.MM.YYYY Version Description
+*         : 19.10.2026 3.10    First Release
+*         : 19.10.2026 3.20    fl_fast_boot() sets the data flash read 
+*                              enable itself, as R_FlashDataAreaAccess() is
+*                              in RAM with FLASH_API_RX_CFG_ROM_BGO.
+*         : 19.10.2026 3.30    Headers with FL_LI_VALID_MASK_GEN are valid.
+******************************************************************************/
+
+/******************************************************************************
+Includes   <System Includes> , "Project Includes"
+******************************************************************************/
+/* Defines intrinsic functions of the MCU */
+#include <machine.h>
+/* Used for FLASH registers. */
+#include <platform.h>
+/* Fixed width types support. */
+#include <stdint.h>
+/* Used for bool. */
+#include <stdbool.h>
+/* Flash Loader project includes. */
+#include "r_fl_includes.h"
+/* Uses the Flash API for data flash. */
+#include "r_flash_api_rx_if.h"
+
+#if FL_CFG_FAST_BOOT_ENABLE == 1
+
+/******************************************************************************
+Macro definitions
+******************************************************************************/
+#if defined(FLASH_API_RX_CFG_DATA_FLASH_BGO)
+    #error "r_fl_fast_boot.c needs data flash operations to block. Disable FLASH_API_RX_CFG_DATA_FLASH_BGO."
+#endif
+
+#if FL_CFG_FAST_BOOT_DF_BLOCK >= DF_NUM_BLOCKS
+    #error "FL_CFG_FAST_BOOT_DF_BLOCK is past the end of data flash."
+#endif
+
+#if (FL_CFG_KV_ENABLE == 1) && \
+    (FL_CFG_FAST_BOOT_DF_BLOCK >= FL_CFG_KV_FIRST_DF_BLOCK) && \
+    (FL_CFG_FAST_BOOT_DF_BLOCK < (FL_CFG_KV_FIRST_DF_BLOCK + FL_CFG_KV_NUM_PAGES))
+    #error "FL_CFG_FAST_BOOT_DF_BLOCK overlaps the key-value store."
+#endif
+
+/* r_fl_stats.c keeps 2 copies of its totals */
+#if (FL_CFG_STATS_ENABLE == 1) && \
+    (FL_CFG_FAST_BOOT_DF_BLOCK >= FL_CFG_STATS_FIRST_DF_BLOCK) && \
+    (FL_CFG_FAST_BOOT_DF_BLOCK < (FL_CFG_STATS_FIRST_DF_BLOCK + 2))
+    #error "FL_CFG_FAST_BOOT_DF_BLOCK overlaps the flash timing copies."
+#endif
+
+/* Flash API block number of the record */
+#define FL_FAST_BOOT_BLOCK          (BLOCK_DB0 + FL_CFG_FAST_BOOT_DF_BLOCK)
+
+/* Address in data flash of the record */
+#define FL_FAST_BOOT_ADDR           (g_flash_BlockAddresses[FL_FAST_BOOT_BLOCK])
+
+/* Mask for fl_df_access() and R_FlashDataAreaAccess() covering the record */
+#define FL_FAST_BOOT_ACCESS_MASK    ((uint16_t)(1 << FL_CFG_FAST_BOOT_DF_BLOCK))
+
+/* Data flash read enable register, key and bit for the record's block. 
+   fl_fast_boot() writes these itself because with FLASH_API_RX_CFG_ROM_BGO
+   R_FlashDataAreaAccess() runs from RAM, which is not set up out of reset. */
+#if FL_CFG_FAST_BOOT_DF_BLOCK < 8
+    #define FL_FAST_BOOT_DFLRE          (FLASH.DFLRE0.WORD)
+    #define FL_FAST_BOOT_DFLRE_KEY      (0x2D00)
+    #define FL_FAST_BOOT_DFLRE_BIT      (1 << FL_CFG_FAST_BOOT_DF_BLOCK)
+#else
+    #define FL_FAST_BOOT_DFLRE          (FLASH.DFLRE1.WORD)
+    #define FL_FAST_BOOT_DFLRE_KEY      (0xD200)
+    #define FL_FAST_BOOT_DFLRE_BIT      (1 << (FL_CFG_FAST_BOOT_DF_BLOCK - 8))
+#endif
+
+/* Reset vector of the User Application */
+#define FL_FAST_BOOT_RESET_VECTOR   (0xFFFFFFFC)
+
+/******************************************************************************
+Private global variables and functions
+******************************************************************************/
+static bool fl_fast_boot_read(uint16_t * p_raw_crc);
+
+/******************************************************************************
+* Function Name: fl_fast_boot
+* Description  : Jumps to the User Application if the fast boot record is for
+*                the image in MCU flash, otherwise returns so the Bootloader
+*                starts up as normal. This is called out of reset before the
+*                RAM sections are set up, so it must not use global or static
+*                variables or any Flash API function that may run from RAM. 
+*                Data flash reads are allowed only while the record is read,
+*                leaving the User Application the MCU as it was out of reset.
+* Arguments    : none
+* Return value : none
+******************************************************************************/
+void fl_fast_boot(void)
+{
+    fl_image_header_t * p_header;
+    uint16_t            raw_crc;
+    bool                found;
+
+    p_header = (fl_image_header_t *)__sectop("APPHEADER_1");
+
+    if(FL_LI_IS_VALID(p_header->valid_mask) == false)
+    {
+        /* No image in MCU flash, or one that was cut short */
+        return;
+    }
+
+    if(fl_check_bootloader_bypass() == true)
+    {
+        /* User wants to wait for a new load image */
+        return;
+    }
+
+    FL_FAST_BOOT_DFLRE = (uint16_t)(FL_FAST_BOOT_DFLRE_KEY | FL_FAST_BOOT_DFLRE_BIT);
+    found = fl_fast_boot_read(&raw_crc);
+    /* Back to no access, as out of reset */
+    FL_FAST_BOOT_DFLRE = (uint16_t)FL_FAST_BOOT_DFLRE_KEY;
+
+    if( (found == true) && (raw_crc == p_header->raw_crc) )
+    {
+        /* The User Application's start up code sets up the stacks, clocks 
+           and everything else itself */
+        ((void (*)(void))*((uint32_t *)FL_FAST_BOOT_RESET_VECTOR))();
+    }
+}
+/******************************************************************************
+End of function fl_fast_boot
+******************************************************************************/
+
+/******************************************************************************
+* Function Name: fl_fast_boot_set
+* Description  : Lets the next boots go straight to the image in MCU flash.
+*                Call only once the image has been checked and there is 
+*                nothing newer to install. Nothing is written if the record 
+*                is already there, so data flash is only erased once for 
+*                each image.
+* Arguments    : raw_crc - 
+*                    raw_crc of the image in MCU flash
+* Return value : none
+******************************************************************************/
+void fl_fast_boot_set(uint16_t raw_crc)
+{
+    fl_fast_boot_record_t record;
+    uint16_t              saved_crc;
+
+    fl_df_access(FL_FAST_BOOT_ACCESS_MASK);
+
+    if( (fl_fast_boot_read(&saved_crc) == true) && (saved_crc == raw_crc) )
+    {
+        /* Already set */
+        return;
+    }
+
+    record.magic   = FL_FAST_BOOT_MAGIC;
+    record.raw_crc = raw_crc;
+    record.check   = (uint16_t)(~raw_crc);
+
+    /* The block may hold a record for another image or random data */
+    if(R_FlashErase(FL_FAST_BOOT_BLOCK) != FLASH_SUCCESS)
+    {
+        return;
+    }
+
+    /* A record that did not get written fails fl_fast_boot_read(), which 
+       only costs a full boot */
+    R_FlashWrite(FL_FAST_BOOT_ADDR, (uint32_t)&record, sizeof(record));
+}
+/******************************************************************************
+End of function fl_fast_boot_set
+******************************************************************************/
+
+/******************************************************************************
+* Function Name: fl_fast_boot_clear
+* Description  : Makes the next boot do the full checks and install. Nothing 
+*                is erased if there is no record.
+* Arguments    : none
+* Return value : true - 
+*                    No record is left
+*                false - 
+*                    Data flash could not be erased. The next boot may still
+*                    go straight to the image in MCU flash.
+******************************************************************************/
+bool fl_fast_boot_clear(void)
+{
+    uint16_t raw_crc;
+
+    fl_df_access(FL_FAST_BOOT_ACCESS_MASK);
+
+    if(fl_fast_boot_read(&raw_crc) == false)
+    {
+        return true;
+    }
+
+    if(R_FlashErase(FL_FAST_BOOT_BLOCK) != FLASH_SUCCESS)
+    {
+        return false;
+    }
+
+    return (bool)(fl_fast_boot_read(&raw_crc) == false);
+}
+/******************************************************************************
+End of function fl_fast_boot_clear
+******************************************************************************/
+
+/******************************************************************************
+* Function Name: fl_fast_boot_read
+* Description  : Reads the fast boot record. Reads of data flash must be 
+*                allowed. Erased data flash reads back as random data, which
+*                almost never holds the magic number and a matching check.
+* Arguments    : p_raw_crc - 
+*                    Where to place raw_crc of the image the record is for
+* Return value : true - 
+*                    Record found
+*                false - 
+*                    No record
+******************************************************************************/
+static bool fl_fast_boot_read(uint16_t * p_raw_crc)
+{
+    volatile fl_fast_boot_record_t * p_record;
+
+    p_record = (volatile fl_fast_boot_record_t *)FL_FAST_BOOT_ADDR;
+
+    if( (p_record->magic != FL_FAST_BOOT_MAGIC) ||
+        (p_record->check != (uint16_t)(~p_record->raw_crc)) )
+    {
+        return false;
+    }
+
+    *p_raw_crc = p_record->raw_crc;
+
+    return true;
+}
+/******************************************************************************
+End of function fl_fast_boot_read
+******************************************************************************/
+
+#endif /* FL_CFG_FAST_BOOT_ENABLE */
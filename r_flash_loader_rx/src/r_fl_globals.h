@@ -28,6 +28,7 @@
 /*****************************************************************************
 * History : DD.MM.YYYY Version  Description
 *         : 22.02.2012 3.00     First Release (introduced in v3.0)
+*         : 19.10.2026 3.10     g_fl_li_mem_info is filled in by fl_mem_init().
 ******************************************************************************/
 
 #ifndef FL_GLOBALS
@@ -48,6 +49,6 @@ Shared Global Variables
 ******************************************************************************/
 /* Data structure to hold load image headers */
 extern fl_image_header_t   g_fl_load_image_headers[FL_CFG_MEM_NUM_LOAD_IMAGES];
-extern const fl_li_storage_t g_fl_li_mem_info;
+extern fl_li_storage_t g_fl_li_mem_info;
 
 #endif /* FL_GLOBALS */
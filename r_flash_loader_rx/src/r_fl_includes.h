@@ -28,6 +28,22 @@
 /*****************************************************************************
 * History : DD.MM.YYYY Version  Description
 *         : 23.02.2012 3.00     First Release (introduced in v3.0)
+*         : 19.10.2026 3.10     Added FL_LI_GENERATION_NONE.
+*         : 19.10.2026 3.20     Added r_fl_directory.h.
+*         : 19.10.2026 3.30     Added r_fl_metadata.h.
+*         : 19.10.2026 3.40     Added container header macros and r_fl_lz.h.
+*         : 19.10.2026 3.50     Added FL_IMAGE_FORMAT_DELTA and r_fl_delta.h.
+*         : 19.10.2026 3.60     Added FL_IMAGE_FORMAT_SPARSE.
+*         : 19.10.2026 3.70     Added r_fl_rom_queue.h.
+*         : 19.10.2026 3.80     Added r_fl_kv.h.
+*         : 19.10.2026 3.90     Added r_fl_stats.h.
+*         : 19.10.2026 4.00     Added r_fl_journal.h.
+*         : 19.10.2026 4.10     Added r_fl_check.h.
+*         : 19.10.2026 4.20     Added r_fl_profile.h.
+*         : 19.10.2026 4.30     Added r_fl_fast_boot.h.
+*         : 19.10.2026 4.40     Added r_fl_clock.h.
+*         : 19.10.2026 4.50     Added FL_LI_VALID_MASK_GEN and FL_LI_IS_VALID().
+*         : 19.10.2026 4.60     Removed r_fl_metadata.h.
 ******************************************************************************/
 
 #ifndef FL_INCLUDES
@@ -36,14 +52,45 @@
 /* Valid Mask for Load Image Header */
 #define FL_LI_VALID_MASK                (0xAA)
 
+/* Valid Mask for Load Image Header that has the 'generation' field. Headers
+   with FL_LI_VALID_MASK are the older 7 byte header, so whatever follows 
+   raw_crc is not a generation and they are treated as the oldest. */
+#define FL_LI_VALID_MASK_GEN            (0xAC)
+
+/* Whether a valid_mask marks a valid Load Image Header of either layout */
+#define FL_LI_IS_VALID(mask)            (((mask) == FL_LI_VALID_MASK) || \
+                                         ((mask) == FL_LI_VALID_MASK_GEN))
+
 /* Value of 'successfully_stored' value before image has been
    successfully downloaded.  If this is the value, then the
    image did not download correctly. */
 #define FL_LI_NOT_SUCCESSFULLY_STORED   (0xFFFFFFFF)
 
+/* Value of 'generation' when it was not set (erased memory). Images with
+   this value are treated as older than any other image. */
+#define FL_LI_GENERATION_NONE           (0xFFFFFFFF)
+
 /* Valid Mask for Block Header */
 #define FL_BH_VALID_MASK                (0xBB)
 
+/* Marks a slot that starts with a fl_container_header_t ("FLIM") */
+#define FL_CONTAINER_MAGIC              (0x4D494C46)
+
+/* Image formats used in fl_container_header_t. Raw images have no 
+   container header. */
+/* Raw copy of MCU flash */
+#define FL_IMAGE_FORMAT_RAW             (0)
+/* LZ compressed copy of MCU flash (see r_fl_lz.c) */
+#define FL_IMAGE_FORMAT_LZ              (1)
+/* Changes against the image currently in MCU flash (see r_fl_delta.c) */
+#define FL_IMAGE_FORMAT_DELTA           (2)
+/* Only the used address ranges of MCU flash (see fl_sparse_next()) */
+#define FL_IMAGE_FORMAT_SPARSE          (3)
+
+/* Segments of sparse images must start and end on this boundary so they can
+   be programmed as they are. This is ROM_PROGRAM_SIZE of the Flash API. */
+#define FL_SPARSE_ALIGN_BYTES           (128)
+
 /******************************************************************************
 Includes   <System Includes> , "Project Includes"
 ******************************************************************************/
@@ -57,6 +104,28 @@ Includes   <System Includes> , "Project Includes"
 #include "r_fl_memory.h"
 /* Function prototypes for storing and accessing load images */
 #include "r_fl_store_manager.h"
+/* Function prototypes for the slot directory */
+#include "r_fl_directory.h"
+/* Function prototypes for LZ decompression */
+#include "r_fl_lz.h"
+/* Function prototypes for applying delta images */
+#include "r_fl_delta.h"
+/* Function prototypes for the MCU flash job queue */
+#include "r_fl_rom_queue.h"
+/* Function prototypes for the data flash key-value store */
+#include "r_fl_kv.h"
+/* Function prototypes for flash operation timing */
+#include "r_fl_stats.h"
+/* Function prototypes for the install journal */
+#include "r_fl_journal.h"
+/* Function prototypes for checking images a few bytes at a time */
+#include "r_fl_check.h"
+/* Function prototypes for the PC sampling profiler */
+#include "r_fl_profile.h"
+/* Function prototypes for starting the User Application out of reset */
+#include "r_fl_fast_boot.h"
+/* Function prototypes for the install clock profile */
+#include "r_fl_clock.h"
 /* Function prototypes for utility fuctions (CRC & Reset) */
 #include "r_fl_utilities.h"
 /* Flash Loader interface file. */
@@ -0,0 +1,251 @@
+/*******************************************************************************
+* DISCLAIMER
+* This software is supplied by Renesas Electronics Corporation and is only 
+* intended for use with Renesas products. No other uses are authorized. This 
+* software is owned by Renesas Electronics Corporation and is protected under
+* all applicable laws, including copyright laws.
+* THIS SOFTWARE IS PROVIDED "AS IS" AND RENESAS MAKES NO WARRANTIES REGARDING
+* THIS SOFTWARE, WHETHER EXPRESS, IMPLIED OR STATUTORY, INCLUDING BUT NOT
+* LIMITED TO WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE 
+* AND NON-INFRINGEMENT. ALL SUCH WARRANTIES ARE EXPRESSLY DISCLAIMED.
+* TO THE MAXIMUM EXTENT PERMITTED NOT PROHIBITED BY LAW, NEITHER RENESAS 
+* ELECTRONICS CORPORATION NOR ANY OF ITS AFFILIATED COMPANIES SHALL BE LIABLE 
+* FOR ANY DIRECT, INDIRECT, SPECIAL, INCIDENTAL OR CONSEQUENTIAL DAMAGES FOR
+* ANY REASON RELATED TO THIS SOFTWARE, EVEN IF RENESAS OR ITS AFFILIATES HAVE
+* BEEN ADVISED OF THE POSSIBILITY OF SUCH DAMAGES.
+* Renesas reserves the right, without notice, to make changes to this software
+* and to discontinue the availability of this software. By using this software,
+* you agree to the additional terms and conditions found by accessing the 
+* following link:
+* http://www.renesas.com/disclaimer *
+* Copyright (C) 2013 Renesas Electronics Corporation. All rights reserved.    
+*******************************************************************************/
+/*******************************************************************************
+* File Name    : r_fl_journal.c
+* Version      : 3.10
+* Description  : Records how far an install of a load image in to MCU flash 
+*                has got, so an install cut short by power loss or a reset 
+*                goes on from where it stopped on the next boot instead of 
+*                starting again.
+*
+*                Installs program MCU flash from the lowest address up. 
+*                Progress is the offset from the start of the image below 
+*                which every block is erased and programmed. It is kept in 
+*                1 key-value store record (FL_KV_KEY_INSTALL) along with the
+*                load image slot and raw CRC, so the record is only used for
+*                the same image and is replaced in a single write. Blocks at
+*                and above the offset may be part programmed and are erased
+*                again when the install goes on.
+*
+*                Delta installs rebuild MCU flash blocks in place, so a block
+*                cut short cannot just be erased again: the delta needs its
+*                old contents. Before such a block is erased its offset is 
+*                kept in a second record (FL_KV_KEY_DELTA_BLOCK) with the same
+*                layout, which says the old contents are in the delta scratch
+*                area. The record only counts while it is at or above the 
+*                progress, so it lapses once the block is finished.
+******************************************************************************/  
+/******************************************************************************
+* History : DD.MM.YYYY Version Description
+*         : 19.10.2026 3.10    First Release
+*         : 19.10.2026 3.20    Records which delta block has its old 
+*                              contents in the scratch area.
+******************************************************************************/
+
+/******************************************************************************
+Includes   <System Includes> , "Project Includes"
+******************************************************************************/
+/* Fixed width types support. */
+#include <stdint.h>
+/* Used for bool. */
+#include <stdbool.h>
+/* Flash Loader project includes. */
+#include "r_fl_includes.h"
+
+#if FL_CFG_INSTALL_JOURNAL_ENABLE == 1
+
+/******************************************************************************
+Macro definitions
+******************************************************************************/
+#if FL_CFG_KV_ENABLE != 1
+    #error "FL_CFG_INSTALL_JOURNAL_ENABLE needs the key-value store. Please enable FL_CFG_KV_ENABLE."
+#endif
+
+#if FL_CFG_MEM_NUM_LOAD_IMAGES > 128
+    #error "r_fl_journal.c keeps the load image slot in 7 bits."
+#endif
+
+/* Layout of the FL_KV_KEY_INSTALL and FL_KV_KEY_DELTA_BLOCK values: raw CRC in bits 31-16, slot in 
+   bits 15-9 and progress in FL_JOURNAL_UNIT_BYTES units in bits 8-0. A 1MB
+   image is at most 256 units so the value is never FL_JOURNAL_NONE. */
+#define FL_JOURNAL_ID(crc, index)   ((((uint32_t)(crc)) << 16) | ((((uint32_t)(index)) & 0x7F) << 9))
+#define FL_JOURNAL_ID_MASK          (0xFFFFFE00)
+#define FL_JOURNAL_UNITS_MASK       (0x000001FF)
+
+/* Value when no install is under way */
+#define FL_JOURNAL_NONE             (0xFFFFFFFF)
+
+/******************************************************************************
+Private global variables and functions
+******************************************************************************/
+/* Slot and raw CRC bits of the install under way */
+static uint32_t g_fl_journal_id;
+/* Progress of the install under way in FL_JOURNAL_UNIT_BYTES units */
+static uint32_t g_fl_journal_units;
+/* Offset of delta block whose old contents are in the scratch area, or 
+   FL_JOURNAL_NO_BLOCK */
+static uint32_t g_fl_journal_block;
+
+/******************************************************************************
+* Function Name: fl_journal_start
+* Description  : Starts recording an install. If the last install of the 
+*                same image did not finish, returns how far it got. Nothing
+*                is written, so this may also be called before verifying.
+*                fl_kv_init() must have been called first.
+* Arguments    : image_index - 
+*                    Load image slot being installed
+*                raw_crc - 
+*                    raw_crc of the load image
+* Return value : Offset from the start of the image to go on from. 0 to 
+*                install all of it.
+******************************************************************************/
+uint32_t fl_journal_start(uint8_t image_index, uint16_t raw_crc)
+{
+    uint32_t value;
+
+    g_fl_journal_id    = FL_JOURNAL_ID(raw_crc, image_index);
+    g_fl_journal_units = 0;
+    g_fl_journal_block = FL_JOURNAL_NO_BLOCK;
+
+    if( (fl_kv_get(FL_KV_KEY_INSTALL, &value) == true) &&
+        (value != FL_JOURNAL_NONE) &&
+        ((value & FL_JOURNAL_ID_MASK) == g_fl_journal_id) )
+    {
+        /* Same image as the unfinished install */
+        g_fl_journal_units = value & FL_JOURNAL_UNITS_MASK;
+    }
+
+    /* A delta block below the progress was finished */
+    if( (fl_kv_get(FL_KV_KEY_DELTA_BLOCK, &value) == true) &&
+        (value != FL_JOURNAL_NONE) &&
+        ((value & FL_JOURNAL_ID_MASK) == g_fl_journal_id) &&
+        ((value & FL_JOURNAL_UNITS_MASK) >= g_fl_journal_units) )
+    {
+        g_fl_journal_block = (value & FL_JOURNAL_UNITS_MASK) * FL_JOURNAL_UNIT_BYTES;
+    }
+
+    /* A record of a different image is replaced by the first progress */
+    return g_fl_journal_units * FL_JOURNAL_UNIT_BYTES;
+}
+/******************************************************************************
+End of function fl_journal_start
+******************************************************************************/
+
+/******************************************************************************
+* Function Name: fl_journal_progress
+* Description  : Records that every block below an offset is erased and 
+*                programmed. All jobs for those blocks must have finished.
+*                Nothing is written unless the offset has moved up by at 
+*                least 1 unit.
+* Arguments    : offset - 
+*                    Offset from the start of the image. Rounded down to 
+*                    FL_JOURNAL_UNIT_BYTES.
+* Return value : none
+******************************************************************************/
+void fl_journal_progress(uint32_t offset)
+{
+    uint32_t units;
+
+    units = offset / FL_JOURNAL_UNIT_BYTES;
+
+    if(units <= g_fl_journal_units)
+    {
+        return;
+    }
+
+    g_fl_journal_units = units;
+
+    /* If this fails the install just goes on from an earlier point */
+    fl_kv_put(FL_KV_KEY_INSTALL, g_fl_journal_id | (units & FL_JOURNAL_UNITS_MASK));
+}
+/******************************************************************************
+End of function fl_journal_progress
+******************************************************************************/
+
+/******************************************************************************
+* Function Name: fl_journal_save_block
+* Description  : Records that the old contents of a delta block are in the 
+*                scratch area and the block is about to be erased. Blocks 
+*                below it must be finished. The block must not be erased if
+*                this fails.
+* Arguments    : offset - 
+*                    Offset of block from the start of the image. A multiple
+*                    of FL_JOURNAL_UNIT_BYTES.
+* Return value : true - 
+*                    Recorded
+*                false - 
+*                    Could not write the record
+******************************************************************************/
+bool fl_journal_save_block(uint32_t offset)
+{
+    uint32_t units;
+
+    units = offset / FL_JOURNAL_UNIT_BYTES;
+
+    g_fl_journal_block = units * FL_JOURNAL_UNIT_BYTES;
+
+    return fl_kv_put(FL_KV_KEY_DELTA_BLOCK, g_fl_journal_id | (units & FL_JOURNAL_UNITS_MASK));
+}
+/******************************************************************************
+End of function fl_journal_save_block
+******************************************************************************/
+
+/******************************************************************************
+* Function Name: fl_journal_saved_block
+* Description  : Says which delta block of the image given to 
+*                fl_journal_start() has its old contents in the scratch area
+*                and may be part rebuilt.
+* Arguments    : none
+* Return value : Offset of block from the start of the image, or 
+*                FL_JOURNAL_NO_BLOCK
+******************************************************************************/
+uint32_t fl_journal_saved_block(void)
+{
+    return g_fl_journal_block;
+}
+/******************************************************************************
+End of function fl_journal_saved_block
+******************************************************************************/
+
+/******************************************************************************
+* Function Name: fl_journal_finish
+* Description  : Records that no install is under way. Called once the image
+*                is fully programmed, so the next install of it, for example
+*                after MCU flash failed its CRC check, starts from the 
+*                beginning.
+* Arguments    : none
+* Return value : none
+******************************************************************************/
+void fl_journal_finish(void)
+{
+    uint32_t value;
+
+    /* Nothing to clear if no progress was ever recorded */
+    if(fl_kv_get(FL_KV_KEY_INSTALL, &value) == true)
+    {
+        fl_kv_put(FL_KV_KEY_INSTALL, FL_JOURNAL_NONE);
+    }
+
+    /* With the progress back at 0 a saved block would count again */
+    if(fl_kv_get(FL_KV_KEY_DELTA_BLOCK, &value) == true)
+    {
+        fl_kv_put(FL_KV_KEY_DELTA_BLOCK, FL_JOURNAL_NONE);
+    }
+
+    g_fl_journal_block = FL_JOURNAL_NO_BLOCK;
+}
+/******************************************************************************
+End of function fl_journal_finish
+******************************************************************************/
+
+#endif /* FL_CFG_INSTALL_JOURNAL_ENABLE */
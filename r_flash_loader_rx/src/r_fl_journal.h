@@ -0,0 +1,65 @@
+/*******************************************************************************
+* DISCLAIMER
+* This software is supplied by Renesas Electronics Corporation and is only 
+* intended for use with Renesas products. No other uses are authorized. This 
+* software is owned by Renesas Electronics Corporation and is protected under
+* all applicable laws, including copyright laws.
+* THIS SOFTWARE IS PROVIDED "AS IS" AND RENESAS MAKES NO WARRANTIES REGARDING
+* THIS SOFTWARE, WHETHER EXPRESS, IMPLIED OR STATUTORY, INCLUDING BUT NOT
+* LIMITED TO WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE 
+* AND NON-INFRINGEMENT. ALL SUCH WARRANTIES ARE EXPRESSLY DISCLAIMED.
+* TO THE MAXIMUM EXTENT PERMITTED NOT PROHIBITED BY LAW, NEITHER RENESAS 
+* ELECTRONICS CORPORATION NOR ANY OF ITS AFFILIATED COMPANIES SHALL BE LIABLE 
+* FOR ANY DIRECT, INDIRECT, SPECIAL, INCIDENTAL OR CONSEQUENTIAL DAMAGES FOR
+* ANY REASON RELATED TO THIS SOFTWARE, EVEN IF RENESAS OR ITS AFFILIATES HAVE
+* BEEN ADVISED OF THE POSSIBILITY OF SUCH DAMAGES.
+* Renesas reserves the right, without notice, to make changes to this software
+* and to discontinue the availability of this software. By using this software,
+* you agree to the additional terms and conditions found by accessing the 
+* following link:
+* http://www.renesas.com/disclaimer *
+* Copyright (C) 2013 Renesas Electronics Corporation. All rights reserved.    
+*******************************************************************************/
+/*******************************************************************************
+* File Name    : r_fl_journal.h
+* Version      : 3.10
+* Description  : Install progress kept in the key-value store.
+******************************************************************************/  
+/******************************************************************************
+* History : DD.MM.YYYY Version Description
+*         : 19.10.2026 3.10    First Release
+*         : 19.10.2026 3.20    Added fl_journal_save_block() and 
+*                              fl_journal_saved_block() for delta installs.
+******************************************************************************/
+
+#ifndef FL_JOURNAL_H
+#define FL_JOURNAL_H
+
+/******************************************************************************
+Includes   <System Includes> , "Project Includes"
+******************************************************************************/
+/* Fixed width types support. */
+#include <stdint.h>
+/* Used for bool. */
+#include <stdbool.h>
+
+/******************************************************************************
+Macro definitions
+******************************************************************************/
+/* Progress is kept in units of this many bytes. This is the smallest MCU 
+   flash erase block, so every block starts on a unit. */
+#define FL_JOURNAL_UNIT_BYTES       (4096)
+
+/* Returned by fl_journal_saved_block() when no delta block is part rebuilt */
+#define FL_JOURNAL_NO_BLOCK         (0xFFFFFFFF)
+
+/******************************************************************************
+Exported global functions (to be accessed by other files)
+******************************************************************************/
+uint32_t fl_journal_start(uint8_t image_index, uint16_t raw_crc);
+void     fl_journal_progress(uint32_t offset);
+bool     fl_journal_save_block(uint32_t offset);
+uint32_t fl_journal_saved_block(void);
+void     fl_journal_finish(void);
+
+#endif /* FL_JOURNAL_H */
@@ -0,0 +1,487 @@
+/*******************************************************************************
+* DISCLAIMER
+* This software is supplied by Renesas Electronics Corporation and is only 
+* intended for use with Renesas products. No other uses are authorized. This 
+* software is owned by Renesas Electronics Corporation and is protected under
+* all applicable laws, including copyright laws.
+* THIS SOFTWARE IS PROVIDED "AS IS" AND RENESAS MAKES NO WARRANTIES REGARDING
+* THIS SOFTWARE, WHETHER EXPRESS, IMPLIED OR STATUTORY, INCLUDING BUT NOT
+* LIMITED TO WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE 
+* AND NON-INFRINGEMENT. ALL SUCH WARRANTIES ARE EXPRESSLY DISCLAIMED.
+* TO THE MAXIMUM EXTENT PERMITTED NOT PROHIBITED BY LAW, NEITHER RENESAS 
+* ELECTRONICS CORPORATION NOR ANY OF ITS AFFILIATED COMPANIES SHALL BE LIABLE 
+* FOR ANY DIRECT, INDIRECT, SPECIAL, INCIDENTAL OR CONSEQUENTIAL DAMAGES FOR
+* ANY REASON RELATED TO THIS SOFTWARE, EVEN IF RENESAS OR ITS AFFILIATES HAVE
+* BEEN ADVISED OF THE POSSIBILITY OF SUCH DAMAGES.
+* Renesas reserves the right, without notice, to make changes to this software
+* and to discontinue the availability of this software. By using this software,
+* you agree to the additional terms and conditions found by accessing the 
+* following link:
+* http://www.renesas.com/disclaimer *
+* Copyright (C) 2013 Renesas Electronics Corporation. All rights reserved.    
+*******************************************************************************/
+/*******************************************************************************
+* File Name    : r_fl_kv.c
+* Version      : 3.10
+* Description  : Small key-value store kept in data flash. Values are 32 bits
+*                and keys are small numbers so a RAM table indexed by key 
+*                holds the current value of every key. Gets never access 
+*                data flash and puts append one record.
+*
+*                Each page is 1 data flash block. Slot 0 of a page is a 
+*                header holding the page sequence number and the rest are 
+*                records. Only the newest page with a good header is in use.
+*                When it fills up, the next page is erased, the current 
+*                value of every key is copied to it and its header is 
+*                written last. Power loss while a page is being filled 
+*                leaves it without a header, so the old page stays in use.
+*
+*                Erased data flash on the RX63N does not read back as a 
+*                fixed value, so free slots are found with 
+*                R_FlashDataAreaBlankCheck() instead of by reading them.
+******************************************************************************/  
+/******************************************************************************
+* History : DD.MM.YYYY Version Description
+*         : 19.10.2026 3.10    First Release
+*         : 19.10.2026 3.20    Data flash access is allowed with fl_df_access()
+*                              so blocks used by others stay allowed.
+******************************************************************************/
+
+/******************************************************************************
+Includes   <System Includes> , "Project Includes"
+******************************************************************************/
+/* Defines standard macros used in this file */
+#include <stddef.h>
+/* Used for memcmp() */
+#include <string.h>
+/* Fixed width types support. */
+#include <stdint.h>
+/* Used for bool. */
+#include <stdbool.h>
+/* Flash Loader project includes. */
+#include "r_fl_includes.h"
+/* Uses r_crc_rx package for CRC calculations. */
+#include "r_crc_rx_if.h"
+/* Uses the Flash API for data flash. */
+#include "r_flash_api_rx_if.h"
+
+#if FL_CFG_KV_ENABLE == 1
+
+/******************************************************************************
+Macro definitions
+******************************************************************************/
+#if FL_CFG_KV_NUM_PAGES < 2
+    #error "FL_CFG_KV_NUM_PAGES must be at least 2. Please fix in r_flash_loader_rx_config.h"
+#endif
+
+#if (FL_CFG_KV_FIRST_DF_BLOCK + FL_CFG_KV_NUM_PAGES) > DF_NUM_BLOCKS
+    #error "FL_CFG_KV_FIRST_DF_BLOCK and FL_CFG_KV_NUM_PAGES go past the end of data flash."
+#endif
+
+#if defined(FLASH_API_RX_CFG_DATA_FLASH_BGO)
+    #error "r_fl_kv.c needs data flash operations to block. Disable FLASH_API_RX_CFG_DATA_FLASH_BGO."
+#endif
+
+/* Key of a page header record */
+#define FL_KV_KEY_PAGE              (0xFFFE)
+
+/* Number of slots in each page, including the header */
+#define FL_KV_SLOTS_PER_PAGE        (DF_BLOCK_SIZE_LARGE / sizeof(fl_kv_record_t))
+
+/* sizeof() cannot be used here. Records are 8 bytes. */
+#if FL_CFG_KV_NUM_KEYS >= (DF_BLOCK_SIZE_LARGE / 8)
+    #error "FL_CFG_KV_NUM_KEYS is too large for 1 data flash block."
+#endif
+
+/* Number of times a put is tried before giving up */
+#define FL_KV_PUT_TRIES             (2)
+
+/* Flash API block number of a page */
+#define FL_KV_BLOCK(page)           (BLOCK_DB0 + FL_CFG_KV_FIRST_DF_BLOCK + (page))
+
+/* Address in data flash of a slot */
+#define FL_KV_SLOT_ADDR(page, slot) (g_flash_BlockAddresses[FL_KV_BLOCK(page)] + \
+                                     ((slot) * sizeof(fl_kv_record_t)))
+
+/* Mask for fl_df_access() covering all pages */
+#define FL_KV_ACCESS_MASK           ((uint16_t)(((1 << FL_CFG_KV_NUM_PAGES) - 1) << FL_CFG_KV_FIRST_DF_BLOCK))
+
+/******************************************************************************
+Private global variables and functions
+******************************************************************************/
+/* Current value of each key */
+static uint32_t g_fl_kv_values[FL_CFG_KV_NUM_KEYS];
+/* Whether each key has a value */
+static bool     g_fl_kv_valid[FL_CFG_KV_NUM_KEYS];
+/* Whether a page is in use. False until the first put to an empty store. */
+static bool     g_fl_kv_in_use = false;
+/* Page in use and its sequence number */
+static uint32_t g_fl_kv_page;
+static uint32_t g_fl_kv_sequence;
+/* Next free slot in page in use */
+static uint32_t g_fl_kv_slot;
+
+static bool     fl_kv_slot_blank(uint32_t page, uint32_t slot);
+static bool     fl_kv_read(uint32_t page, uint32_t slot, fl_kv_record_t * p_record);
+static bool     fl_kv_write(uint32_t page, uint32_t slot, uint32_t key, uint32_t value);
+static bool     fl_kv_new_page(void);
+static uint16_t fl_kv_calc_crc(fl_kv_record_t * p_record);
+
+/******************************************************************************
+* Function Name: fl_kv_init
+* Description  : Finds the page in use and loads the latest value of every 
+*                key in to RAM. R_CRC_Init() must have been called first, and
+*                the Flash API code must be in RAM.
+* Arguments    : none
+* Return value : none
+******************************************************************************/
+void fl_kv_init(void)
+{
+    fl_kv_record_t record;
+    uint32_t       page;
+    uint32_t       key;
+
+    for(key = 0; key < FL_CFG_KV_NUM_KEYS; key++)
+    {
+        g_fl_kv_valid[key] = false;
+    }
+
+    g_fl_kv_in_use = false;
+
+    /* Allow reading and programming of the pages */
+    fl_df_access(FL_KV_ACCESS_MASK);
+
+    /* Page in use is the one whose header has the highest sequence */
+    for(page = 0; page < FL_CFG_KV_NUM_PAGES; page++)
+    {
+        if( (fl_kv_read(page, 0, &record) == true) &&
+            (record.key == FL_KV_KEY_PAGE) &&
+            ((g_fl_kv_in_use == false) || (record.value > g_fl_kv_sequence)) )
+        {
+            g_fl_kv_page     = page;
+            g_fl_kv_sequence = record.value;
+            g_fl_kv_in_use   = true;
+        }
+    }
+
+    if(g_fl_kv_in_use == false)
+    {
+        /* Empty store. First put starts a page. */
+        return;
+    }
+
+    /* Replay records in order until the first blank slot */
+    for(g_fl_kv_slot = 1; g_fl_kv_slot < FL_KV_SLOTS_PER_PAGE; g_fl_kv_slot++)
+    {
+        if(fl_kv_slot_blank(g_fl_kv_page, g_fl_kv_slot) == true)
+        {
+            break;
+        }
+
+        /* A record that was being written when power was lost fails its 
+           CRC and is skipped. */
+        if( (fl_kv_read(g_fl_kv_page, g_fl_kv_slot, &record) == true) &&
+            (record.key < FL_CFG_KV_NUM_KEYS) )
+        {
+            g_fl_kv_values[record.key] = record.value;
+            g_fl_kv_valid[record.key]  = true;
+        }
+    }
+}
+/******************************************************************************
+End of function fl_kv_init
+******************************************************************************/
+
+/******************************************************************************
+* Function Name: fl_kv_get
+* Description  : Returns the value of a key. This does not access data flash.
+* Arguments    : key - 
+*                    Key to read
+*                p_value - 
+*                    Where to place the value
+* Return value : true - 
+*                    Value returned
+*                false - 
+*                    Key has no value or is out of range
+******************************************************************************/
+bool fl_kv_get(uint32_t key, uint32_t * p_value)
+{
+    if( (key >= FL_CFG_KV_NUM_KEYS) || (g_fl_kv_valid[key] == false) )
+    {
+        return false;
+    }
+
+    *p_value = g_fl_kv_values[key];
+
+    return true;
+}
+/******************************************************************************
+End of function fl_kv_get
+******************************************************************************/
+
+/******************************************************************************
+* Function Name: fl_kv_put
+* Description  : Sets the value of a key. Nothing is written if the value is
+*                unchanged. Otherwise a record is appended to the page in
+*                use, moving to a new page first if it is full.
+* Arguments    : key - 
+*                    Key to write
+*                value - 
+*                    Value to store
+* Return value : true - 
+*                    Value stored
+*                false - 
+*                    Key is out of range or data flash could not be written
+******************************************************************************/
+bool fl_kv_put(uint32_t key, uint32_t value)
+{
+    uint32_t tries;
+
+    if(key >= FL_CFG_KV_NUM_KEYS)
+    {
+        return false;
+    }
+
+    if( (g_fl_kv_valid[key] == true) && (g_fl_kv_values[key] == value) )
+    {
+        /* Already stored */
+        return true;
+    }
+
+    for(tries = 0; tries < FL_KV_PUT_TRIES; tries++)
+    {
+        /* New page holds the current values of all other keys */
+        if( (g_fl_kv_in_use == false) || (g_fl_kv_slot >= FL_KV_SLOTS_PER_PAGE) )
+        {
+            if(fl_kv_new_page() == false)
+            {
+                return false;
+            }
+        }
+
+        /* Slot is used even if the write failed */
+        g_fl_kv_slot++;
+
+        if(fl_kv_write(g_fl_kv_page, g_fl_kv_slot - 1, key, value) == true)
+        {
+            g_fl_kv_values[key] = value;
+            g_fl_kv_valid[key]  = true;
+
+            return true;
+        }
+    }
+
+    return false;
+}
+/******************************************************************************
+End of function fl_kv_put
+******************************************************************************/
+
+/******************************************************************************
+* Function Name: fl_kv_add
+* Description  : Adds to the value of a key. A key with no value counts from
+*                0. Used for counters.
+* Arguments    : key - 
+*                    Key to change
+*                amount - 
+*                    Amount to add
+* Return value : true - 
+*                    Value stored
+*                false - 
+*                    Key is out of range or data flash could not be written
+******************************************************************************/
+bool fl_kv_add(uint32_t key, uint32_t amount)
+{
+    uint32_t value;
+
+    if(fl_kv_get(key, &value) == false)
+    {
+        value = 0;
+    }
+
+    return fl_kv_put(key, value + amount);
+}
+/******************************************************************************
+End of function fl_kv_add
+******************************************************************************/
+
+/******************************************************************************
+* Function Name: fl_kv_new_page
+* Description  : Erases the next page, copies the current value of every key
+*                to it and then writes its header so it becomes the page in
+*                use.
+* Arguments    : none
+* Return value : true - 
+*                    New page in use
+*                false - 
+*                    Data flash could not be erased or written
+******************************************************************************/
+static bool fl_kv_new_page(void)
+{
+    uint32_t page;
+    uint32_t sequence;
+    uint32_t slot;
+    uint32_t key;
+
+    /* Pages are used in turn. An empty store starts at page 0. */
+    if(g_fl_kv_in_use == true)
+    {
+        page     = (g_fl_kv_page + 1) % FL_CFG_KV_NUM_PAGES;
+        sequence = g_fl_kv_sequence + 1;
+    }
+    else
+    {
+        page     = 0;
+        sequence = 0;
+    }
+
+    if(R_FlashErase(FL_KV_BLOCK(page)) != FLASH_SUCCESS)
+    {
+        return false;
+    }
+
+    slot = 1;
+
+    for(key = 0; key < FL_CFG_KV_NUM_KEYS; key++)
+    {
+        if(g_fl_kv_valid[key] == true)
+        {
+            if(fl_kv_write(page, slot, key, g_fl_kv_values[key]) == false)
+            {
+                return false;
+            }
+
+            slot++;
+        }
+    }
+
+    /* Header last so the page is only used once it holds every value */
+    if(fl_kv_write(page, 0, FL_KV_KEY_PAGE, sequence) == false)
+    {
+        return false;
+    }
+
+    g_fl_kv_page     = page;
+    g_fl_kv_sequence = sequence;
+    g_fl_kv_slot     = slot;
+    g_fl_kv_in_use   = true;
+
+    return true;
+}
+/******************************************************************************
+End of function fl_kv_new_page
+******************************************************************************/
+
+/******************************************************************************
+* Function Name: fl_kv_slot_blank
+* Description  : Checks whether a slot has never been written. Only the first
+*                2 bytes are checked because the key is written first.
+* Arguments    : page - 
+*                    Which page
+*                slot - 
+*                    Which slot in page
+* Return value : true - 
+*                    Slot is blank
+*                false - 
+*                    Slot has been written
+******************************************************************************/
+static bool fl_kv_slot_blank(uint32_t page, uint32_t slot)
+{
+    return (bool)(R_FlashDataAreaBlankCheck(FL_KV_SLOT_ADDR(page, slot), BLANK_CHECK_2_BYTE) == FLASH_BLANK);
+}
+/******************************************************************************
+End of function fl_kv_slot_blank
+******************************************************************************/
+
+/******************************************************************************
+* Function Name: fl_kv_read
+* Description  : Reads a slot and checks its CRC. Blank slots are not read.
+* Arguments    : page - 
+*                    Which page
+*                slot - 
+*                    Which slot in page
+*                p_record - 
+*                    Where to place the record
+* Return value : true - 
+*                    Record is good
+*                false - 
+*                    Slot is blank or record is corrupt
+******************************************************************************/
+static bool fl_kv_read(uint32_t page, uint32_t slot, fl_kv_record_t * p_record)
+{
+    if(fl_kv_slot_blank(page, slot) == true)
+    {
+        return false;
+    }
+
+    memcpy(p_record, (void *)FL_KV_SLOT_ADDR(page, slot), sizeof(fl_kv_record_t));
+
+    return (bool)(fl_kv_calc_crc(p_record) == p_record->crc);
+}
+/******************************************************************************
+End of function fl_kv_read
+******************************************************************************/
+
+/******************************************************************************
+* Function Name: fl_kv_write
+* Description  : Writes a record to a slot and reads it back
+* Arguments    : page - 
+*                    Which page
+*                slot - 
+*                    Which slot in page
+*                key - 
+*                    Key of record
+*                value - 
+*                    Value of record
+* Return value : true - 
+*                    Record written
+*                false - 
+*                    Error occurred
+******************************************************************************/
+static bool fl_kv_write(uint32_t page, uint32_t slot, uint32_t key, uint32_t value)
+{
+    fl_kv_record_t record;
+
+    record.key   = (uint16_t)key;
+    record.value = value;
+    record.crc   = fl_kv_calc_crc(&record);
+
+    if(R_FlashWrite(FL_KV_SLOT_ADDR(page, slot), (uint32_t)&record, sizeof(record)) != FLASH_SUCCESS)
+    {
+        return false;
+    }
+
+    return (bool)(memcmp((void *)FL_KV_SLOT_ADDR(page, slot), &record, sizeof(record)) == 0);
+}
+/******************************************************************************
+End of function fl_kv_write
+******************************************************************************/
+
+/******************************************************************************
+* Function Name: fl_kv_calc_crc
+* Description  : Calculates the CRC of a record's key and value
+* Arguments    : p_record - 
+*                    Record to use
+* Return value : CRC-16 CCITT of record
+******************************************************************************/
+static uint16_t fl_kv_calc_crc(fl_kv_record_t * p_record)
+{
+    uint16_t crc;
+
+    R_CRC_Compute( FL_CRC_SEED,
+                   (uint8_t *)&p_record->key,
+                   sizeof(p_record->key),
+                   &crc);
+
+    R_CRC_Compute( crc,
+                   (uint8_t *)&p_record->value,
+                   sizeof(p_record->value),
+                   &crc);
+
+    return crc;
+}
+/******************************************************************************
+End of function fl_kv_calc_crc
+******************************************************************************/
+
+#endif /* FL_CFG_KV_ENABLE */
@@ -0,0 +1,75 @@
+/*******************************************************************************
+* DISCLAIMER
+* This software is supplied by Renesas Electronics Corporation and is only 
+* intended for use with Renesas products. No other uses are authorized. This 
+* software is owned by Renesas Electronics Corporation and is protected under
+* all applicable laws, including copyright laws.
+* THIS SOFTWARE IS PROVIDED "AS IS" AND RENESAS MAKES NO WARRANTIES REGARDING
+* THIS SOFTWARE, WHETHER EXPRESS, IMPLIED OR STATUTORY, INCLUDING BUT NOT
+* LIMITED TO WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE 
+* AND NON-INFRINGEMENT. ALL SUCH WARRANTIES ARE EXPRESSLY DISCLAIMED.
+* TO THE MAXIMUM EXTENT PERMITTED NOT PROHIBITED BY LAW, NEITHER RENESAS 
+* ELECTRONICS CORPORATION NOR ANY OF ITS AFFILIATED COMPANIES SHALL BE LIABLE 
+* FOR ANY DIRECT, INDIRECT, SPECIAL, INCIDENTAL OR CONSEQUENTIAL DAMAGES FOR
+* ANY REASON RELATED TO THIS SOFTWARE, EVEN IF RENESAS OR ITS AFFILIATES HAVE
+* BEEN ADVISED OF THE POSSIBILITY OF SUCH DAMAGES.
+* Renesas reserves the right, without notice, to make changes to this software
+* and to discontinue the availability of this software. By using this software,
+* you agree to the additional terms and conditions found by accessing the 
+* following link:
+* http://www.renesas.com/disclaimer *
+* Copyright (C) 2013 Renesas Electronics Corporation. All rights reserved.    
+*******************************************************************************/
+/*******************************************************************************
+* File Name    : r_fl_kv.h
+* Version      : 3.10
+* Description  : Key-value store kept in data flash.
+******************************************************************************/  
+/******************************************************************************
+* History : DD.MM.YYYY Version Description
+*         : 19.10.2026 3.10    First Release
+*         : 19.10.2026 3.20    Added FL_KV_KEY_FLASH_AGING.
+*         : 19.10.2026 3.30    Added FL_KV_KEY_INSTALL.
+*         : 19.10.2026 3.40    Added FL_KV_KEY_APP_CHECK.
+*         : 19.10.2026 3.50    Added FL_KV_KEY_DELTA_BLOCK.
+******************************************************************************/
+
+#ifndef FL_KV_H
+#define FL_KV_H
+
+/******************************************************************************
+Includes   <System Includes> , "Project Includes"
+******************************************************************************/
+/* Fixed width types support. */
+#include <stdint.h>
+/* Used for bool. */
+#include <stdbool.h>
+
+/******************************************************************************
+Macro definitions
+******************************************************************************/
+/* Keys used by the Bootloader */
+/* Number of times the Bootloader has started */
+#define FL_KV_KEY_BOOT_COUNT        (0)
+/* Number of load images installed */
+#define FL_KV_KEY_INSTALL_COUNT     (1)
+/* Set to 1 once flash timing shows the part is aging (see r_fl_stats.c) */
+#define FL_KV_KEY_FLASH_AGING       (2)
+/* Progress of an unfinished install (see r_fl_journal.c) */
+#define FL_KV_KEY_INSTALL           (3)
+/* Result of the last check of the image in MCU flash (see r_fl_check.c) */
+#define FL_KV_KEY_APP_CHECK         (4)
+/* Delta block whose old contents are in the scratch area (see r_fl_journal.c) */
+#define FL_KV_KEY_DELTA_BLOCK       (5)
+/* First key free for other use */
+#define FL_KV_KEY_USER              (6)
+
+/******************************************************************************
+Exported global functions (to be accessed by other files)
+******************************************************************************/
+void fl_kv_init(void);
+bool fl_kv_get(uint32_t key, uint32_t * p_value);
+bool fl_kv_put(uint32_t key, uint32_t value);
+bool fl_kv_add(uint32_t key, uint32_t amount);
+
+#endif /* FL_KV_H */
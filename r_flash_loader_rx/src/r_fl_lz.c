@@ -0,0 +1,265 @@
+/*******************************************************************************
+* DISCLAIMER
+* This software is supplied by Renesas Electronics Corporation and is only 
+* intended for use with Renesas products. No other uses are authorized. This 
+* software is owned by Renesas Electronics Corporation and is protected under
+* all applicable laws, including copyright laws.
+* THIS SOFTWARE IS PROVIDED "AS IS" AND RENESAS MAKES NO WARRANTIES REGARDING
+* THIS SOFTWARE, WHETHER EXPRESS, IMPLIED OR STATUTORY, INCLUDING BUT NOT
+* LIMITED TO WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE 
+* AND NON-INFRINGEMENT. ALL SUCH WARRANTIES ARE EXPRESSLY DISCLAIMED.
+* TO THE MAXIMUM EXTENT PERMITTED NOT PROHIBITED BY LAW, NEITHER RENESAS 
+* ELECTRONICS CORPORATION NOR ANY OF ITS AFFILIATED COMPANIES SHALL BE LIABLE 
+* FOR ANY DIRECT, INDIRECT, SPECIAL, INCIDENTAL OR CONSEQUENTIAL DAMAGES FOR
+* ANY REASON RELATED TO THIS SOFTWARE, EVEN IF RENESAS OR ITS AFFILIATES HAVE
+* BEEN ADVISED OF THE POSSIBILITY OF SUCH DAMAGES.
+* Renesas reserves the right, without notice, to make changes to this software
+* and to discontinue the availability of this software. By using this software,
+* you agree to the additional terms and conditions found by accessing the 
+* following link:
+* http://www.renesas.com/disclaimer *
+* Copyright (C) 2013 Renesas Electronics Corporation. All rights reserved.    
+*******************************************************************************/
+/*******************************************************************************
+* File Name    : r_fl_lz.c
+* Version      : 3.10
+* Description  : Streaming decompressor for LZ compressed load images. Images
+*                are compressed by r_fl_mot_converter.py ('-c' option).
+*
+*                The stream is a series of groups. Each group starts with a
+*                flag byte that describes the next 8 items, bit 0 first:
+*                  1 - Literal. 1 byte follows which is output as is.
+*                  0 - Match. 2 bytes follow (little endian). Bits 0-11 hold
+*                      distance - 1 (1 to 4096 bytes back). Bits 12-15 hold 
+*                      length - 3. If this is 15 then extra length bytes 
+*                      follow which are added to the length; this continues
+*                      while the extra byte is 255.
+*                The stream ends when the expected number of bytes is output.
+*
+*                The output buffer is used as the history window. It must be
+*                FL_LZ_WINDOW_BYTES long and the same buffer must be passed
+*                on every call. Output is written at (bytes output so far) 
+*                modulo FL_LZ_WINDOW_BYTES, so reading FL_LZ_WINDOW_BYTES at
+*                a time fills the buffer from the start each time. Only the 
+*                few bytes in fl_lz_state_t are needed on top of the buffer.
+******************************************************************************/  
+/******************************************************************************
+* History : DD.MM.YYYY Version Description
+*         : 19.10.2026 3.10    First Release
+******************************************************************************/
+
+/******************************************************************************
+Includes   <System Includes> , "Project Includes"
+******************************************************************************/
+/* Fixed width types support. */
+#include <stdint.h>
+/* Used for bool. */
+#include <stdbool.h>
+/* Flash Loader project includes. */
+#include "r_fl_includes.h"
+
+/******************************************************************************
+Macro definitions
+******************************************************************************/
+/* Mask used to wrap window positions */
+#define FL_LZ_WINDOW_MASK           (FL_LZ_WINDOW_BYTES - 1)
+/* Minimum length of a match */
+#define FL_LZ_MIN_MATCH             (3)
+/* Length code that means extra length bytes follow */
+#define FL_LZ_LEN_EXTENDED          (15)
+
+/******************************************************************************
+Private global variables and functions
+******************************************************************************/
+static bool fl_lz_get_byte(fl_lz_state_t * p_state, uint8_t * p_byte);
+
+/******************************************************************************
+* Function Name: fl_lz_init
+* Description  : Starts decompression of a compressed stream in memory
+* Arguments    : p_state - 
+*                    State to initialize
+*                address - 
+*                    Memory address of start of compressed stream
+*                bytes - 
+*                    Length of compressed stream
+* Return value : none
+******************************************************************************/
+void fl_lz_init(fl_lz_state_t * p_state, uint32_t address, uint32_t bytes)
+{
+    p_state->in_address = address;
+    p_state->in_left    = bytes;
+    p_state->in_pos     = 0;
+    p_state->in_len     = 0;
+    p_state->flags      = 0;
+    p_state->flag_bits  = 0;
+    p_state->match_dist = 0;
+    p_state->match_len  = 0;
+    p_state->out_pos    = 0;
+}
+/******************************************************************************
+End of function fl_lz_init
+******************************************************************************/
+
+/******************************************************************************
+* Function Name: fl_lz_read
+* Description  : Outputs the next bytes of the decompressed image
+* Arguments    : p_state - 
+*                    Decompression state
+*                p_window - 
+*                    Output buffer and history window, FL_LZ_WINDOW_BYTES 
+*                    long
+*                bytes - 
+*                    How many bytes to output
+* Return value : Number of bytes output. This is less than 'bytes' if the 
+*                stream ended early or is corrupt.
+******************************************************************************/
+uint32_t fl_lz_read(fl_lz_state_t * p_state, uint8_t * p_window, uint32_t bytes)
+{
+    uint32_t produced;
+    uint8_t  byte;
+    uint8_t  low;
+    uint16_t token;
+
+    produced = 0;
+
+    while(produced < bytes)
+    {
+        /* Finish any match in progress first. Distance may be less than the
+           length, in which case bytes output by this match are repeated. */
+        if(p_state->match_len > 0)
+        {
+            p_window[p_state->out_pos & FL_LZ_WINDOW_MASK] = 
+                p_window[(p_state->out_pos - p_state->match_dist) & FL_LZ_WINDOW_MASK];
+
+            p_state->out_pos++;
+            p_state->match_len--;
+            produced++;
+
+            continue;
+        }
+
+        /* Get flags for next group */
+        if(p_state->flag_bits == 0)
+        {
+            if(fl_lz_get_byte(p_state, &p_state->flags) == false)
+            {
+                break;
+            }
+
+            p_state->flag_bits = 8;
+        }
+
+        p_state->flag_bits--;
+
+        if((p_state->flags & 0x01) != 0)
+        {
+            p_state->flags >>= 1;
+
+            /* Literal */
+            if(fl_lz_get_byte(p_state, &byte) == false)
+            {
+                break;
+            }
+
+            p_window[p_state->out_pos & FL_LZ_WINDOW_MASK] = byte;
+
+            p_state->out_pos++;
+            produced++;
+        }
+        else
+        {
+            p_state->flags >>= 1;
+
+            /* Match */
+            if( (fl_lz_get_byte(p_state, &low) == false) ||
+                (fl_lz_get_byte(p_state, &byte) == false) )
+            {
+                break;
+            }
+
+            token = (uint16_t)(((uint16_t)byte << 8) | low);
+
+            p_state->match_dist = (uint16_t)((token & FL_LZ_WINDOW_MASK) + 1);
+            p_state->match_len  = (uint32_t)(token >> 12);
+
+            if(p_state->match_len == FL_LZ_LEN_EXTENDED)
+            {
+                /* Add extra length bytes */
+                do
+                {
+                    if(fl_lz_get_byte(p_state, &byte) == false)
+                    {
+                        return produced;
+                    }
+
+                    p_state->match_len += byte;
+
+                } while(byte == 0xFF);
+            }
+
+            p_state->match_len += FL_LZ_MIN_MATCH;
+
+            /* Cannot reference data before start of image */
+            if(p_state->match_dist > p_state->out_pos)
+            {
+                p_state->match_len = 0;
+                break;
+            }
+        }
+    }
+
+    return produced;
+}
+/******************************************************************************
+End of function fl_lz_read
+******************************************************************************/
+
+/******************************************************************************
+* Function Name: fl_lz_get_byte
+* Description  : Returns next byte of compressed stream. Memory is read 
+*                FL_LZ_IN_BUF_BYTES at a time.
+* Arguments    : p_state - 
+*                    Decompression state
+*                p_byte - 
+*                    Where to place byte
+* Return value : true - 
+*                    Byte returned
+*                false - 
+*                    End of compressed stream
+******************************************************************************/
+static bool fl_lz_get_byte(fl_lz_state_t * p_state, uint8_t * p_byte)
+{
+    uint32_t read_bytes;
+
+    /* Refill input buffer if needed */
+    if(p_state->in_pos >= p_state->in_len)
+    {
+        if(p_state->in_left == 0)
+        {
+            return false;
+        }
+
+        read_bytes = p_state->in_left;
+
+        if(read_bytes > FL_LZ_IN_BUF_BYTES)
+        {
+            read_bytes = FL_LZ_IN_BUF_BYTES;
+        }
+
+        fl_mem_read(p_state->in_address, p_state->in_buf, read_bytes);
+
+        p_state->in_address += read_bytes;
+        p_state->in_left    -= read_bytes;
+        p_state->in_pos      = 0;
+        p_state->in_len      = (uint16_t)read_bytes;
+    }
+
+    *p_byte = p_state->in_buf[p_state->in_pos];
+
+    p_state->in_pos++;
+
+    return true;
+}
+/******************************************************************************
+End of function fl_lz_get_byte
+******************************************************************************/
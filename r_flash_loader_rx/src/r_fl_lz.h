@@ -0,0 +1,88 @@
+/*******************************************************************************
+* DISCLAIMER
+* This software is supplied by Renesas Electronics Corporation and is only 
+* intended for use with Renesas products. No other uses are authorized. This 
+* software is owned by Renesas Electronics Corporation and is protected under
+* all applicable laws, including copyright laws.
+* THIS SOFTWARE IS PROVIDED "AS IS" AND RENESAS MAKES NO WARRANTIES REGARDING
+* THIS SOFTWARE, WHETHER EXPRESS, IMPLIED OR STATUTORY, INCLUDING BUT NOT
+* LIMITED TO WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE 
+* AND NON-INFRINGEMENT. ALL SUCH WARRANTIES ARE EXPRESSLY DISCLAIMED.
+* TO THE MAXIMUM EXTENT PERMITTED NOT PROHIBITED BY LAW, NEITHER RENESAS 
+* ELECTRONICS CORPORATION NOR ANY OF ITS AFFILIATED COMPANIES SHALL BE LIABLE 
+* FOR ANY DIRECT, INDIRECT, SPECIAL, INCIDENTAL OR CONSEQUENTIAL DAMAGES FOR
+* ANY REASON RELATED TO THIS SOFTWARE, EVEN IF RENESAS OR ITS AFFILIATES HAVE
+* BEEN ADVISED OF THE POSSIBILITY OF SUCH DAMAGES.
+* Renesas reserves the right, without notice, to make changes to this software
+* and to discontinue the availability of this software. By using this software,
+* you agree to the additional terms and conditions found by accessing the 
+* following link:
+* http://www.renesas.com/disclaimer *
+* Copyright (C) 2013 Renesas Electronics Corporation. All rights reserved.    
+*******************************************************************************/
+/*******************************************************************************
+* File Name    : r_fl_lz.h
+* Version      : 3.10
+* Description  : Streaming decompressor for LZ compressed load images.
+******************************************************************************/  
+/******************************************************************************
+* History : DD.MM.YYYY Version Description
+*         : 19.10.2026 3.10    First Release
+******************************************************************************/
+
+#ifndef FL_LZ_H
+#define FL_LZ_H
+
+/******************************************************************************
+Includes   <System Includes> , "Project Includes"
+******************************************************************************/
+/* Fixed width types support. */
+#include <stdint.h>
+/* Used for bool. */
+#include <stdbool.h>
+
+/******************************************************************************
+Macro definitions
+******************************************************************************/
+/* Size of the history window. The output buffer passed to fl_lz_read() is
+   used as the window so it must be this size (same as fl_app_buffer). */
+#define FL_LZ_WINDOW_BYTES          (4096)
+
+/* Number of compressed bytes read from memory at a time */
+#define FL_LZ_IN_BUF_BYTES          (64)
+
+/******************************************************************************
+Typedef definitions
+******************************************************************************/
+/* State of a decompression in progress */
+typedef struct
+{
+    /* Memory address of next compressed byte to read in to in_buf */
+    uint32_t    in_address;
+    /* Compressed bytes not yet read in to in_buf */
+    uint32_t    in_left;
+    /* Compressed bytes read from memory */
+    uint8_t     in_buf[FL_LZ_IN_BUF_BYTES];
+    /* Next byte to use in in_buf */
+    uint16_t    in_pos;
+    /* Number of valid bytes in in_buf */
+    uint16_t    in_len;
+    /* Flags for the current group of 8 items. Bit 0 is next. */
+    uint8_t     flags;
+    /* Number of items left in current group */
+    uint8_t     flag_bits;
+    /* Distance back to copy from for match in progress */
+    uint16_t    match_dist;
+    /* Bytes left to copy for match in progress */
+    uint32_t    match_len;
+    /* Total number of bytes output so far */
+    uint32_t    out_pos;
+} fl_lz_state_t;
+
+/******************************************************************************
+Exported global functions (to be accessed by other files)
+******************************************************************************/
+void     fl_lz_init(fl_lz_state_t * p_state, uint32_t address, uint32_t bytes);
+uint32_t fl_lz_read(fl_lz_state_t * p_state, uint8_t * p_window, uint32_t bytes);
+
+#endif /* FL_LZ_H */
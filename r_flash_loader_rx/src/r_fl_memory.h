@@ -33,6 +33,9 @@
 *                              now found in the 'g_fl_li_mem_info' structure.
 *                              The 'FL_CFG_MEM_NUM_LOAD_IMAGES' was moved to  
 *                              r_flash_loader_rx_config.h.
+*         : 19.10.2026 3.10    Added page cache functions.
+*         : 19.10.2026 3.20    Added fl_mem_map().
+*         : 19.10.2026 3.30    Added fl_mem_set_speed().
 ******************************************************************************/
 
 #ifndef FL_MEMORY_H
@@ -45,6 +48,8 @@ Includes   <System Includes> , "Project Includes"
 #include <stdint.h>
 /* Used for bool. */
 #include <stdbool.h>
+/* Flash Loader types. */
+#include "r_fl_types.h"
 
 /******************************************************************************
 Macro definitions
@@ -59,8 +64,12 @@ Exported global functions (to be accessed by other files)
 ******************************************************************************/
 void fl_mem_init(void);
 void fl_mem_read(uint32_t rx_address, uint8_t *rx_buffer, uint32_t rx_bytes);
+uint8_t * fl_mem_map(uint32_t rx_address, uint8_t * rx_buffer, uint32_t rx_bytes);
 void fl_mem_write(uint32_t tx_address, uint8_t *tx_buffer, uint32_t tx_bytes);
 bool fl_mem_erase(const uint32_t address, const uint8_t size);
 bool fl_mem_get_busy(void);
+void fl_mem_cache_invalidate(void);
+void fl_mem_cache_get_stats(fl_mem_cache_stats_t * p_stats);
+void fl_mem_set_speed(uint32_t pclk_hz, uint32_t max_hz);
 
 #endif /* FL_MEMORY_H */
\ No newline at end of file
@@ -0,0 +1,316 @@
+/*******************************************************************************
+* DISCLAIMER
+* This software is supplied by Renesas Electronics Corporation and is only 
+* intended for use with Renesas products. No other uses are authorized. This 
+* software is owned by Renesas Electronics Corporation and is protected under
+* all applicable laws, including copyright laws.
+* THIS SOFTWARE IS PROVIDED "AS IS" AND RENESAS MAKES NO WARRANTIES REGARDING
+* THIS SOFTWARE, WHETHER EXPRESS, IMPLIED OR STATUTORY, INCLUDING BUT NOT
+* LIMITED TO WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE 
+* AND NON-INFRINGEMENT. ALL SUCH WARRANTIES ARE EXPRESSLY DISCLAIMED.
+* TO THE MAXIMUM EXTENT PERMITTED NOT PROHIBITED BY LAW, NEITHER RENESAS 
+* ELECTRONICS CORPORATION NOR ANY OF ITS AFFILIATED COMPANIES SHALL BE LIABLE 
+* FOR ANY DIRECT, INDIRECT, SPECIAL, INCIDENTAL OR CONSEQUENTIAL DAMAGES FOR
+* ANY REASON RELATED TO THIS SOFTWARE, EVEN IF RENESAS OR ITS AFFILIATES HAVE
+* BEEN ADVISED OF THE POSSIBILITY OF SUCH DAMAGES.
+* Renesas reserves the right, without notice, to make changes to this software
+* and to discontinue the availability of this software. By using this software,
+* you agree to the additional terms and conditions found by accessing the 
+* following link:
+* http://www.renesas.com/disclaimer *
+* Copyright (C) 2013 Renesas Electronics Corporation. All rights reserved.    
+*******************************************************************************/
+/*******************************************************************************
+* File Name    : r_fl_profile.c
+* Version      : 3.10
+* Description  : Samples the PC from a periodic CMT interrupt into a histogram
+*                in RAM to show where the Bootloader spends its time. The
+*                histogram is saved to memory with fl_profile_save() and
+*                utilities\python\r_fl_profile.py turns it into a list of
+*                functions using the linker map file.
+*
+*                The interrupt has to be taken while ROM is in P/E mode, as
+*                that is where R_FlashWrite() and R_FlashErase() spend their
+*                time. So the handler is in the FRAM section with the Flash
+*                API, and while profiling the CPU uses a copy of the vector
+*                table in RAM that points the CMT channel at it.
+*
+*                The Bootloader runs on the user stack (PSW.U is set in
+*                resetprg.c) and its interrupts do not nest, so the PC and
+*                PSW of the interrupted code are always the first things
+*                pushed on the interrupt stack. The handler reads the PC
+*                from the top of the SI section and does not depend on how
+*                the compiler lays out its own stack frame.
+*
+*                fl_profile_add() takes the PC as an argument so the same
+*                histogram and save code can be fed made up samples.
+******************************************************************************/  
+/******************************************************************************
+* History : DD.MM.YYYY Version Description
+*         : 19.10.2026 3.10    First Release
+******************************************************************************/
+
+/******************************************************************************
+Includes   <System Includes> , "Project Includes"
+******************************************************************************/
+/* Defines intrinsic functions of the MCU */
+#include <machine.h>
+/* Info on which board is being used. */
+#include <platform.h>
+/* Used for memset() and memcpy() */
+#include <string.h>
+/* Fixed width types support. */
+#include <stdint.h>
+/* Used for bool. */
+#include <stdbool.h>
+/* Flash Loader project includes. */
+#include "r_fl_includes.h"
+/* Uses a CMT channel for the sampling interrupt. */
+#include "r_cmt_rx_if.h"
+/* Uses R_FlashCodeCopy() to put the handler in RAM. */
+#include "r_flash_api_rx_if.h"
+
+#if FL_CFG_PROFILE_ENABLE == 1
+
+/******************************************************************************
+Macro definitions
+******************************************************************************/
+/* Number of histogram buckets */
+#define FL_PROFILE_NUM_BUCKETS      (FL_CFG_PROFILE_BYTES >> FL_CFG_PROFILE_BUCKET_SHIFT)
+
+/* Bytes saved to memory */
+#define FL_PROFILE_SAVE_BYTES       (sizeof(fl_profile_header_t) + (FL_PROFILE_NUM_BUCKETS * sizeof(uint32_t)))
+
+/* Entries in the vector table */
+#define FL_PROFILE_NUM_VECTORS      (256)
+
+/* Address of the PC of the interrupted code. The CPU pushes the PSW and then
+   the PC on the interrupt stack, which is empty when the interrupt is
+   taken. */
+#define FL_PROFILE_PC_ADDR          (((uint32_t)__secend("SI")) - 8)
+
+#if (FL_CFG_PROFILE_BYTES & ((1 << FL_CFG_PROFILE_BUCKET_SHIFT) - 1)) != 0
+    #error "FL_CFG_PROFILE_BYTES must be a multiple of the bucket size."
+#endif
+
+/******************************************************************************
+Private global variables and functions
+******************************************************************************/
+/* Sample counts. Bucket n covers the code at 
+   FL_CFG_PROFILE_START + (n << FL_CFG_PROFILE_BUCKET_SHIFT). */
+static uint32_t g_fl_profile_buckets[FL_PROFILE_NUM_BUCKETS];
+/* All samples, and samples outside the buckets */
+static uint32_t g_fl_profile_samples;
+static uint32_t g_fl_profile_outside;
+
+/* Copy of the vector table used while profiling. INTB must be a multiple of
+   4. */
+static uint32_t g_fl_profile_vectors[FL_PROFILE_NUM_VECTORS];
+/* Vector table in use before fl_profile_start() */
+static uint32_t g_fl_profile_saved_intb;
+
+/* CMT channel used for sampling */
+static uint32_t g_fl_profile_channel;
+/* Whether sampling is running */
+static bool     g_fl_profile_running = false;
+
+static void fl_profile_isr(void);
+
+/******************************************************************************
+* Function Name: fl_profile_start
+* Description  : Clears the histogram and starts sampling. Other interrupts
+*                go through the same handlers as before.
+* Arguments    : none
+* Return value : true -
+*                    Sampling has started.
+*                false -
+*                    Already sampling or no CMT channel is free.
+******************************************************************************/
+bool fl_profile_start(void)
+{
+    uint32_t vector;
+
+    if(g_fl_profile_running == true)
+    {
+        return false;
+    }
+
+    memset(g_fl_profile_buckets, 0, sizeof(g_fl_profile_buckets));
+    g_fl_profile_samples = 0;
+    g_fl_profile_outside = 0;
+
+#if defined(FLASH_API_RX_CFG_ENABLE_ROM_PROGRAMMING) && defined(FLASH_API_RX_CFG_COPY_CODE_BY_API)
+    /* The handler is in the FRAM section. The Flash API skips its own copy
+       later on as the code is already there. */
+    R_FlashCodeCopy();
+#endif
+
+    /* Move to a copy of the vector table in RAM, as the vector is read from
+       the table each time the interrupt is taken */
+    g_fl_profile_saved_intb = (uint32_t)get_intb();
+    memcpy(g_fl_profile_vectors, (void *)g_fl_profile_saved_intb, sizeof(g_fl_profile_vectors));
+#if __RENESAS_VERSION__ >= 0x01010000
+    set_intb((void *)g_fl_profile_vectors);
+#else
+    set_intb((unsigned long)g_fl_profile_vectors);
+#endif
+
+    /* The channel is set up with no callback as the handler below takes the
+       interrupt in place of the CMT driver's handler */
+    if(R_CMT_CreatePeriodic(FL_CFG_PROFILE_HZ, FIT_NO_FUNC, &g_fl_profile_channel) == false)
+    {
+#if __RENESAS_VERSION__ >= 0x01010000
+        set_intb((void *)g_fl_profile_saved_intb);
+#else
+        set_intb((unsigned long)g_fl_profile_saved_intb);
+#endif
+        return false;
+    }
+
+    /* CMI0 to CMI3 are next to each other in the vector table. The first 
+       interrupt comes a whole period after the channel starts so there is 
+       time to set the vector. */
+    vector = VECT(CMT0, CMI0) + g_fl_profile_channel;
+    g_fl_profile_vectors[vector] = (uint32_t)fl_profile_isr;
+
+    g_fl_profile_running = true;
+
+    return true;
+}
+/******************************************************************************
+End of function fl_profile_start
+******************************************************************************/
+
+/******************************************************************************
+* Function Name: fl_profile_stop
+* Description  : Stops sampling and goes back to the vector table in use 
+*                before fl_profile_start(). The histogram is kept.
+* Arguments    : none
+* Return value : none
+******************************************************************************/
+void fl_profile_stop(void)
+{
+    if(g_fl_profile_running == false)
+    {
+        return;
+    }
+
+    R_CMT_Stop(g_fl_profile_channel);
+
+#if __RENESAS_VERSION__ >= 0x01010000
+    set_intb((void *)g_fl_profile_saved_intb);
+#else
+    set_intb((unsigned long)g_fl_profile_saved_intb);
+#endif
+
+    g_fl_profile_running = false;
+}
+/******************************************************************************
+End of function fl_profile_stop
+******************************************************************************/
+
+/******************************************************************************
+* Function Name: fl_profile_save
+* Description  : Saves the histogram to memory at FL_CFG_PROFILE_MEM_ADDR as
+*                a fl_profile_header_t followed by the counts. The header is
+*                written last so a save cut short by a reset is not read.
+* Arguments    : none
+* Return value : none
+******************************************************************************/
+void fl_profile_save(void)
+{
+    fl_profile_header_t header;
+    uint32_t            address;
+
+    /* Erase every sector the profile touches */
+    for(address = FL_CFG_PROFILE_MEM_ADDR; 
+        address < (FL_CFG_PROFILE_MEM_ADDR + FL_PROFILE_SAVE_BYTES);
+        address += g_fl_li_mem_info.erase_size)
+    {
+        fl_mem_erase(address, FL_MEM_ERASE_SECTOR);
+    }
+
+    fl_mem_write(FL_CFG_PROFILE_MEM_ADDR + sizeof(fl_profile_header_t),
+                 (uint8_t *)g_fl_profile_buckets,
+                 sizeof(g_fl_profile_buckets));
+
+    header.magic        = FL_PROFILE_MAGIC;
+    header.version      = FL_PROFILE_VERSION;
+    header.bucket_shift = FL_CFG_PROFILE_BUCKET_SHIFT;
+    header.sample_hz    = FL_CFG_PROFILE_HZ;
+    header.start        = FL_CFG_PROFILE_START;
+    header.num_buckets  = FL_PROFILE_NUM_BUCKETS;
+    header.samples      = g_fl_profile_samples;
+    header.outside      = g_fl_profile_outside;
+    header.reserved     = 0xFFFFFFFF;
+
+    fl_mem_write(FL_CFG_PROFILE_MEM_ADDR, (uint8_t *)&header, sizeof(header));
+
+    /* Wait for the last write so the profile is there if the next thing the
+       Bootloader does is jump to the User Application */
+    while(fl_mem_get_busy() == true)
+    {
+        /* Wait */
+    }
+}
+/******************************************************************************
+End of function fl_profile_save
+******************************************************************************/
+
+#ifdef FLASH_API_RX_CFG_ENABLE_ROM_PROGRAMMING
+/* The handler and the code it calls run while ROM is in P/E mode */
+#pragma section FRAM
+#endif
+
+/******************************************************************************
+* Function Name: fl_profile_add
+* Description  : Counts a sample. Called from the sampling interrupt, or 
+*                with made up PCs to try out the histogram and save code.
+* Arguments    : pc -
+*                    Address of the code that was running.
+* Return value : none
+******************************************************************************/
+void fl_profile_add(uint32_t pc)
+{
+    uint32_t offset;
+
+    g_fl_profile_samples++;
+
+    /* Addresses below the start wrap round to large offsets */
+    offset = pc - FL_CFG_PROFILE_START;
+
+    if(offset < FL_CFG_PROFILE_BYTES)
+    {
+        g_fl_profile_buckets[offset >> FL_CFG_PROFILE_BUCKET_SHIFT]++;
+    }
+    else
+    {
+        g_fl_profile_outside++;
+    }
+}
+/******************************************************************************
+End of function fl_profile_add
+******************************************************************************/
+
+/******************************************************************************
+* Function Name: fl_profile_isr
+* Description  : Sampling interrupt. The CMT compare match flag clears itself
+*                when the interrupt is taken so there is nothing else to do.
+* Arguments    : none
+* Return value : none
+******************************************************************************/
+#pragma interrupt fl_profile_isr
+static void fl_profile_isr(void)
+{
+    fl_profile_add(*(volatile uint32_t *)FL_PROFILE_PC_ADDR);
+}
+/******************************************************************************
+End of function fl_profile_isr
+******************************************************************************/
+
+#ifdef FLASH_API_RX_CFG_ENABLE_ROM_PROGRAMMING
+#pragma section
+#endif
+
+#endif /* FL_CFG_PROFILE_ENABLE */
+
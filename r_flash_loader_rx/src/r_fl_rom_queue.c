@@ -0,0 +1,686 @@
+/*******************************************************************************
+* DISCLAIMER
+* This software is supplied by Renesas Electronics Corporation and is only 
+* intended for use with Renesas products. No other uses are authorized. This 
+* software is owned by Renesas Electronics Corporation and is protected under
+* all applicable laws, including copyright laws.
+* THIS SOFTWARE IS PROVIDED "AS IS" AND RENESAS MAKES NO WARRANTIES REGARDING
+* THIS SOFTWARE, WHETHER EXPRESS, IMPLIED OR STATUTORY, INCLUDING BUT NOT
+* LIMITED TO WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE 
+* AND NON-INFRINGEMENT. ALL SUCH WARRANTIES ARE EXPRESSLY DISCLAIMED.
+* TO THE MAXIMUM EXTENT PERMITTED NOT PROHIBITED BY LAW, NEITHER RENESAS 
+* ELECTRONICS CORPORATION NOR ANY OF ITS AFFILIATED COMPANIES SHALL BE LIABLE 
+* FOR ANY DIRECT, INDIRECT, SPECIAL, INCIDENTAL OR CONSEQUENTIAL DAMAGES FOR
+* ANY REASON RELATED TO THIS SOFTWARE, EVEN IF RENESAS OR ITS AFFILIATES HAVE
+* BEEN ADVISED OF THE POSSIBILITY OF SUCH DAMAGES.
+* Renesas reserves the right, without notice, to make changes to this software
+* and to discontinue the availability of this software. By using this software,
+* you agree to the additional terms and conditions found by accessing the 
+* following link:
+* http://www.renesas.com/disclaimer *
+* Copyright (C) 2013 Renesas Electronics Corporation. All rights reserved.    
+*******************************************************************************/
+/*******************************************************************************
+* File Name    : r_fl_rom_queue.c
+* Version      : 3.10
+* Description  : Queue of MCU flash erase, program and blank check jobs. 
+*
+*                When FLASH_API_RX_CFG_ROM_BGO is enabled in 
+*                r_flash_api_rx_config.h each job is started from the flash
+*                ready interrupt as soon as the one before it finishes (see
+*                FlashEraseDone() and FlashWriteDone() below). The caller 
+*                keeps reading and expanding the next data while the FCU is
+*                busy, so there are no gaps between FCU operations. Data 
+*                passed to fl_rom_queue_write() must stay in place until the
+*                job has finished; fl_rom_queue_wait() is used for this.
+*                MCU flash cannot be read while it is being erased or 
+*                programmed, so with ROM BGO this file is placed in the FRAM
+*                section (copied to RAM with the Flash API) and code that 
+*                runs while jobs are queued must not be in the ROM area being
+*                changed.
+*
+*                Without ROM BGO each job runs as soon as it is queued, so 
+*                the same calling code works either way.
+******************************************************************************/  
+/******************************************************************************
+* History : DD.MM.YYYY Version Description
+*         : 19.10.2026 3.10    First Release
+*         : 19.10.2026 3.20    Added fl_rom_queue_erase_used() which skips
+*                              blocks that are already erased.
+*         : 19.10.2026 3.30    Added fl_rom_queue_erase_range() which erases
+*                              by address and never erases the Bootloader.
+*                              Erase times are measured per block.
+*         : 19.10.2026 3.40    Erases are timed with the free running CMT 
+*                              channel from fl_free_timer_get().
+******************************************************************************/
+
+/******************************************************************************
+Includes   <System Includes> , "Project Includes"
+******************************************************************************/
+/* Info on which board is being used. */
+#include <platform.h>
+/* Fixed width types support. */
+#include <stdint.h>
+/* Used for bool. */
+#include <stdbool.h>
+/* Flash Loader project includes. */
+#include "r_fl_includes.h"
+/* Uses the Flash API for erasing and programming. */
+#include "r_flash_api_rx_if.h"
+#if FL_CFG_ROM_ERASE_TIMING_ENABLE == 1
+/* Uses a free running CMT channel to time erases. */
+#include "r_cmt_rx_if.h"
+#endif
+
+/******************************************************************************
+Macro definitions
+******************************************************************************/
+#ifdef FLASH_API_RX_CFG_ROM_BGO
+/* Jobs are finished from the flash ready interrupt. Mask it while the queue
+   is changed. */
+#define FL_ROM_QUEUE_LOCK()         (IEN(FCU, FRDYI) = 0)
+#define FL_ROM_QUEUE_UNLOCK()       (IEN(FCU, FRDYI) = 1)
+#else
+/* Jobs are finished by the caller */
+#define FL_ROM_QUEUE_LOCK()
+#define FL_ROM_QUEUE_UNLOCK()
+#endif
+
+/* MCU flash read address is the program/erase address with the MSB set */
+#define FL_ROM_READ_ADDR(x)         ((x) | 0xFF000000)
+/* Program/erase address just past the top of MCU flash. This is where 
+   block 0 ends. */
+#define FL_ROM_PE_END               (0x01000000)
+
+/******************************************************************************
+Private global variables and functions
+******************************************************************************/
+/* Queued jobs. The job at g_fl_rom_head is running or is next to run. */
+static fl_rom_job_t      g_fl_rom_jobs[FL_CFG_ROM_QUEUE_LENGTH];
+/* Index of oldest job */
+static volatile uint32_t g_fl_rom_head;
+/* Number of jobs queued, including the one running */
+static volatile uint32_t g_fl_rom_count;
+/* Whether the FCU is busy with the job at g_fl_rom_head */
+static volatile bool     g_fl_rom_running;
+/* Set when a job fails. No more jobs are started until fl_rom_queue_init(). */
+static volatile bool     g_fl_rom_error;
+
+#if FL_CFG_ROM_ERASE_TIMING_ENABLE == 1
+/* CMT channel counting PCLK/CMT_RX_FREE_RUNNING_DIVIDER. Shared with 
+   r_fl_stats.c. */
+static uint32_t          g_fl_rom_cmt_channel;
+/* Whether g_fl_rom_cmt_channel has been created */
+static bool              g_fl_rom_cmt_created = false;
+/* Counter value when the running erase was started */
+static uint16_t          g_fl_rom_erase_start;
+/* Counts taken by the last erase of each block. 0 if not erased. */
+static uint16_t          g_fl_rom_erase_counts[ROM_NUM_BLOCKS];
+#endif
+
+static bool fl_rom_queue_add(fl_rom_job_t * p_job);
+static void fl_rom_queue_start(void);
+static void fl_rom_queue_job_done(bool success);
+static bool fl_rom_is_blank(uint32_t flash_addr, uint32_t bytes);
+static bool fl_rom_block_is_blank(uint32_t block);
+static uint32_t fl_rom_block_end(uint32_t block);
+#if FL_CFG_ROM_ERASE_TIMING_ENABLE == 1
+static uint16_t fl_rom_get_count(void);
+#endif
+
+#ifdef FLASH_API_RX_CFG_ROM_BGO
+/* Code here runs from the flash ready interrupt while MCU flash is not 
+   readable, so it must run from RAM like the Flash API. */
+#pragma section FRAM
+#endif
+
+/******************************************************************************
+* Function Name: fl_rom_queue_init
+* Description  : Empties the queue and clears any error. Must not be called 
+*                while a job is running.
+* Arguments    : none
+* Return value : none
+******************************************************************************/
+void fl_rom_queue_init(void)
+{
+#if FL_CFG_ROM_ERASE_TIMING_ENABLE == 1
+    uint32_t i;
+
+    if(g_fl_rom_cmt_created == false)
+    {
+        /* Erases are not timed if no channel is free */
+        g_fl_rom_cmt_created = fl_free_timer_get(&g_fl_rom_cmt_channel);
+    }
+
+    for(i = 0; i < ROM_NUM_BLOCKS; i++)
+    {
+        g_fl_rom_erase_counts[i] = 0;
+    }
+#endif
+
+    FL_ROM_QUEUE_LOCK();
+
+    g_fl_rom_head    = 0;
+    g_fl_rom_count   = 0;
+    g_fl_rom_running = false;
+    g_fl_rom_error   = false;
+
+    FL_ROM_QUEUE_UNLOCK();
+}
+/******************************************************************************
+End of function fl_rom_queue_init
+******************************************************************************/
+
+/******************************************************************************
+* Function Name: fl_rom_queue_erase
+* Description  : Queues erasing of a MCU flash block
+* Arguments    : block - 
+*                    Block number (BLOCK_xxx in Flash API)
+* Return value : true - 
+*                    Job queued
+*                false - 
+*                    A job has failed
+******************************************************************************/
+bool fl_rom_queue_erase(uint32_t block)
+{
+    fl_rom_job_t job;
+
+    job.type       = FL_ROM_JOB_ERASE;
+    job.flash_addr = block;
+
+    return fl_rom_queue_add(&job);
+}
+/******************************************************************************
+End of function fl_rom_queue_erase
+******************************************************************************/
+
+/******************************************************************************
+* Function Name: fl_rom_queue_erase_used
+* Description  : Queues erasing of a MCU flash block. When the job is reached
+*                the block is read and the erase is skipped if the block is
+*                already erased. Reading a block is much quicker than 
+*                erasing it.
+* Arguments    : block - 
+*                    Block number (BLOCK_xxx in Flash API)
+* Return value : true - 
+*                    Job queued
+*                false - 
+*                    A job has failed
+******************************************************************************/
+bool fl_rom_queue_erase_used(uint32_t block)
+{
+    fl_rom_job_t job;
+
+    job.type       = FL_ROM_JOB_ERASE_USED;
+    job.flash_addr = block;
+
+    return fl_rom_queue_add(&job);
+}
+/******************************************************************************
+End of function fl_rom_queue_erase_used
+******************************************************************************/
+
+/******************************************************************************
+* Function Name: fl_rom_queue_erase_range
+* Description  : Queues erasing of the MCU flash blocks that make up an 
+*                address range. Blocks that are already erased are skipped 
+*                as in fl_rom_queue_erase_used(). Blocks that overlap 
+*                FL_CFG_BOOTLOADER_ROM_ADDR and FL_CFG_BOOTLOADER_ROM_BYTES
+*                are never erased.
+* Arguments    : start_addr - 
+*                    Start of range. Must be on an erase block boundary.
+*                bytes - 
+*                    Bytes in range. Must end on an erase block boundary.
+* Return value : true - 
+*                    Jobs queued
+*                false - 
+*                    Range is not made of whole blocks or a job has failed
+******************************************************************************/
+bool fl_rom_queue_erase_range(uint32_t start_addr, uint32_t bytes)
+{
+    uint32_t block;
+    uint32_t num_blocks;
+
+    if(R_FlashGetRomBlocks(start_addr, bytes, &block, &num_blocks) != FLASH_SUCCESS)
+    {
+        return false;
+    }
+
+    for( ; num_blocks > 0; num_blocks--, block++)
+    {
+#if FL_CFG_BOOTLOADER_ROM_BYTES > 0
+        /* Do not erase the Bootloader */
+        if( (g_flash_BlockAddresses[block] < 
+             ((FL_CFG_BOOTLOADER_ROM_ADDR & 0x00FFFFFF) + FL_CFG_BOOTLOADER_ROM_BYTES)) &&
+            ((FL_CFG_BOOTLOADER_ROM_ADDR & 0x00FFFFFF) < fl_rom_block_end(block)) )
+        {
+            continue;
+        }
+#endif
+
+        if(fl_rom_queue_erase_used(block) == false)
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+/******************************************************************************
+End of function fl_rom_queue_erase_range
+******************************************************************************/
+
+/******************************************************************************
+* Function Name: fl_rom_queue_write
+* Description  : Queues programming of MCU flash
+* Arguments    : flash_addr - 
+*                    Program/erase address to start at
+*                buffer_addr - 
+*                    RAM address of data. Must not change until the job has
+*                    finished.
+*                bytes - 
+*                    Number of bytes, a multiple of ROM_PROGRAM_SIZE
+* Return value : true - 
+*                    Job queued
+*                false - 
+*                    A job has failed
+******************************************************************************/
+bool fl_rom_queue_write(uint32_t flash_addr, uint32_t buffer_addr, uint16_t bytes)
+{
+    fl_rom_job_t job;
+
+    job.type        = FL_ROM_JOB_WRITE;
+    job.flash_addr  = flash_addr;
+    job.buffer_addr = buffer_addr;
+    job.bytes       = bytes;
+
+    return fl_rom_queue_add(&job);
+}
+/******************************************************************************
+End of function fl_rom_queue_write
+******************************************************************************/
+
+/******************************************************************************
+* Function Name: fl_rom_queue_blank_check
+* Description  : Queues a check of whether part of MCU flash is erased. The 
+*                check runs when the jobs before it have finished.
+* Arguments    : flash_addr - 
+*                    Program/erase address to start at, 4 byte aligned
+*                bytes - 
+*                    Number of bytes, a multiple of 4
+*                p_blank - 
+*                    Where to place result. Valid after fl_rom_queue_wait().
+* Return value : true - 
+*                    Job queued
+*                false - 
+*                    A job has failed
+******************************************************************************/
+bool fl_rom_queue_blank_check(uint32_t flash_addr, uint16_t bytes, bool * p_blank)
+{
+    fl_rom_job_t job;
+
+    job.type       = FL_ROM_JOB_BLANK_CHECK;
+    job.flash_addr = flash_addr;
+    job.bytes      = bytes;
+    job.p_blank    = p_blank;
+
+    return fl_rom_queue_add(&job);
+}
+/******************************************************************************
+End of function fl_rom_queue_blank_check
+******************************************************************************/
+
+/******************************************************************************
+* Function Name: fl_rom_queue_wait
+* Description  : Waits until no more than 'jobs' jobs are left in the queue.
+*                Use 0 to wait for all jobs to finish.
+* Arguments    : jobs - 
+*                    Number of jobs that may still be queued
+* Return value : true - 
+*                    All other jobs finished successfully
+*                false - 
+*                    A job has failed
+******************************************************************************/
+bool fl_rom_queue_wait(uint32_t jobs)
+{
+    while((g_fl_rom_count > jobs) && (g_fl_rom_error == false))
+    {
+        /* Jobs are finished from flash ready interrupt */
+    }
+
+    return (bool)(g_fl_rom_error == false);
+}
+/******************************************************************************
+End of function fl_rom_queue_wait
+******************************************************************************/
+
+/******************************************************************************
+* Function Name: fl_rom_queue_pending
+* Description  : Returns the number of jobs that have not finished
+* Arguments    : none
+* Return value : Number of jobs queued or running
+******************************************************************************/
+uint32_t fl_rom_queue_pending(void)
+{
+    return g_fl_rom_count;
+}
+/******************************************************************************
+End of function fl_rom_queue_pending
+******************************************************************************/
+
+/******************************************************************************
+* Function Name: fl_rom_queue_erase_time
+* Description  : Returns how long the last erase of a block took
+* Arguments    : block - 
+*                    Block number (BLOCK_xxx in Flash API)
+* Return value : Erase time in microseconds. 0 if the block has not been 
+*                erased since fl_rom_queue_init(), the erase was skipped or
+*                FL_CFG_ROM_ERASE_TIMING_ENABLE is 0.
+******************************************************************************/
+uint32_t fl_rom_queue_erase_time(uint32_t block)
+{
+#if FL_CFG_ROM_ERASE_TIMING_ENABLE == 1
+    if(block < ROM_NUM_BLOCKS)
+    {
+        return ((uint32_t)g_fl_rom_erase_counts[block] * CMT_RX_FREE_RUNNING_DIVIDER) / 
+               (BSP_PCLKB_HZ / 1000000);
+    }
+#endif
+
+    return 0;
+}
+/******************************************************************************
+End of function fl_rom_queue_erase_time
+******************************************************************************/
+
+/******************************************************************************
+* Function Name: fl_rom_queue_add
+* Description  : Adds a job to the queue, waiting for space if it is full. 
+*                The job is started if the FCU is idle.
+* Arguments    : p_job - 
+*                    Job to add
+* Return value : true - 
+*                    Job queued
+*                false - 
+*                    A job has failed
+******************************************************************************/
+static bool fl_rom_queue_add(fl_rom_job_t * p_job)
+{
+    /* Wait for space */
+    if(fl_rom_queue_wait(FL_CFG_ROM_QUEUE_LENGTH - 1) == false)
+    {
+        return false;
+    }
+
+    FL_ROM_QUEUE_LOCK();
+
+    g_fl_rom_jobs[(g_fl_rom_head + g_fl_rom_count) % FL_CFG_ROM_QUEUE_LENGTH] = *p_job;
+    g_fl_rom_count++;
+
+    if(g_fl_rom_running == false)
+    {
+        fl_rom_queue_start();
+    }
+
+    FL_ROM_QUEUE_UNLOCK();
+
+    return (bool)(g_fl_rom_error == false);
+}
+/******************************************************************************
+End of function fl_rom_queue_add
+******************************************************************************/
+
+/******************************************************************************
+* Function Name: fl_rom_queue_start
+* Description  : Starts jobs until one is left running on the FCU or the 
+*                queue is empty. Blank checks do not use the FCU and are done
+*                here.
+* Arguments    : none
+* Return value : none
+******************************************************************************/
+static void fl_rom_queue_start(void)
+{
+    fl_rom_job_t * p_job;
+    uint8_t        ret;
+
+    while((g_fl_rom_count > 0) && (g_fl_rom_running == false) && (g_fl_rom_error == false))
+    {
+        p_job = &g_fl_rom_jobs[g_fl_rom_head];
+
+        if(p_job->type == FL_ROM_JOB_BLANK_CHECK)
+        {
+            *p_job->p_blank = fl_rom_is_blank(p_job->flash_addr, p_job->bytes);
+
+            fl_rom_queue_job_done(true);
+
+            continue;
+        }
+
+        if( (p_job->type == FL_ROM_JOB_ERASE_USED) &&
+            (fl_rom_block_is_blank(p_job->flash_addr) == true) )
+        {
+            /* Nothing to erase */
+            fl_rom_queue_job_done(true);
+
+            continue;
+        }
+
+        g_fl_rom_running = true;
+
+        if(p_job->type != FL_ROM_JOB_WRITE)
+        {
+#if FL_CFG_ROM_ERASE_TIMING_ENABLE == 1
+            g_fl_rom_erase_start = fl_rom_get_count();
+#endif
+            ret = R_FlashErase(p_job->flash_addr);
+        }
+        else
+        {
+            ret = R_FlashWrite(p_job->flash_addr, p_job->buffer_addr, p_job->bytes);
+        }
+
+#ifdef FLASH_API_RX_CFG_ROM_BGO
+        /* Job finishes in flash ready interrupt unless it did not start */
+        if(ret != FLASH_SUCCESS)
+        {
+            fl_rom_queue_job_done(false);
+        }
+#else
+        fl_rom_queue_job_done((bool)(ret == FLASH_SUCCESS));
+#endif
+    }
+}
+/******************************************************************************
+End of function fl_rom_queue_start
+******************************************************************************/
+
+/******************************************************************************
+* Function Name: fl_rom_queue_job_done
+* Description  : Removes the oldest job from the queue
+* Arguments    : success - 
+*                    Whether the job finished successfully
+* Return value : none
+******************************************************************************/
+static void fl_rom_queue_job_done(bool success)
+{
+    if(success == false)
+    {
+        g_fl_rom_running = false;
+        g_fl_rom_error   = true;
+        return;
+    }
+
+#if FL_CFG_ROM_ERASE_TIMING_ENABLE == 1
+    /* Only erases that ran on the FCU are timed */
+    if( (g_fl_rom_running == true) &&
+        (g_fl_rom_jobs[g_fl_rom_head].type != FL_ROM_JOB_WRITE) )
+    {
+        g_fl_rom_erase_counts[g_fl_rom_jobs[g_fl_rom_head].flash_addr] = 
+            (uint16_t)(fl_rom_get_count() - g_fl_rom_erase_start);
+    }
+#endif
+
+    g_fl_rom_running = false;
+
+    g_fl_rom_head = (g_fl_rom_head + 1) % FL_CFG_ROM_QUEUE_LENGTH;
+    g_fl_rom_count--;
+}
+/******************************************************************************
+End of function fl_rom_queue_job_done
+******************************************************************************/
+
+/******************************************************************************
+* Function Name: fl_rom_is_blank
+* Description  : Checks whether part of MCU flash is erased. Reads 32 bits at
+*                a time.
+* Arguments    : flash_addr - 
+*                    Program/erase address to start at, 4 byte aligned
+*                bytes - 
+*                    Number of bytes, a multiple of 4
+* Return value : true - 
+*                    All bytes are erased
+*                false - 
+*                    Some bytes are programmed
+******************************************************************************/
+static bool fl_rom_is_blank(uint32_t flash_addr, uint32_t bytes)
+{
+    volatile uint32_t * p_word;
+    uint32_t            i;
+
+    p_word = (volatile uint32_t *)FL_ROM_READ_ADDR(flash_addr);
+
+    for(i = 0; i < (bytes / sizeof(uint32_t)); i++)
+    {
+        if(p_word[i] != 0xFFFFFFFF)
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+/******************************************************************************
+End of function fl_rom_is_blank
+******************************************************************************/
+
+/******************************************************************************
+* Function Name: fl_rom_block_is_blank
+* Description  : Checks whether a MCU flash erase block is erased. The RX63N 
+*                FCU only has a blank check command for data flash, so the
+*                block is read.
+* Arguments    : block - 
+*                    Block number (BLOCK_xxx in Flash API)
+* Return value : true - 
+*                    Block is erased
+*                false - 
+*                    Block is programmed
+******************************************************************************/
+static bool fl_rom_block_is_blank(uint32_t block)
+{
+    return fl_rom_is_blank(g_flash_BlockAddresses[block], 
+                           fl_rom_block_end(block) - g_flash_BlockAddresses[block]);
+}
+/******************************************************************************
+End of function fl_rom_block_is_blank
+******************************************************************************/
+
+/******************************************************************************
+* Function Name: fl_rom_block_end
+* Description  : Returns the program/erase address just past a MCU flash 
+*                erase block
+* Arguments    : block - 
+*                    Block number (BLOCK_xxx in Flash API)
+* Return value : End address of block
+******************************************************************************/
+static uint32_t fl_rom_block_end(uint32_t block)
+{
+    /* Blocks are in descending address order */
+    if(block == 0)
+    {
+        return FL_ROM_PE_END;
+    }
+
+    return g_flash_BlockAddresses[block - 1];
+}
+/******************************************************************************
+End of function fl_rom_block_end
+******************************************************************************/
+
+#if FL_CFG_ROM_ERASE_TIMING_ENABLE == 1
+/******************************************************************************
+* Function Name: fl_rom_get_count
+* Description  : Reads the free running CMT counter. This is only called 
+*                while the FCU is idle because R_CMT_Control() runs from 
+*                MCU flash.
+* Arguments    : none
+* Return value : Counter value. 0 if there is no channel.
+******************************************************************************/
+static uint16_t fl_rom_get_count(void)
+{
+    uint16_t count = 0;
+
+    if(g_fl_rom_cmt_created == true)
+    {
+        R_CMT_Control(g_fl_rom_cmt_channel, CMT_RX_CMD_GET_COUNT, &count);
+    }
+
+    return count;
+}
+/******************************************************************************
+End of function fl_rom_get_count
+******************************************************************************/
+#endif
+
+#ifdef FLASH_API_RX_CFG_ROM_BGO
+/******************************************************************************
+* Function Name: FlashEraseDone
+* Description  : Flash API callback from flash ready interrupt. Finishes the
+*                running job and starts the next one.
+* Arguments    : none
+* Return value : none
+******************************************************************************/
+void FlashEraseDone(void)
+{
+    fl_rom_queue_job_done(true);
+    fl_rom_queue_start();
+}
+/******************************************************************************
+End of function FlashEraseDone
+******************************************************************************/
+
+/******************************************************************************
+* Function Name: FlashWriteDone
+* Description  : Flash API callback from flash ready interrupt. Finishes the
+*                running job and starts the next one.
+* Arguments    : none
+* Return value : none
+******************************************************************************/
+void FlashWriteDone(void)
+{
+    fl_rom_queue_job_done(true);
+    fl_rom_queue_start();
+}
+/******************************************************************************
+End of function FlashWriteDone
+******************************************************************************/
+
+/******************************************************************************
+* Function Name: FlashError
+* Description  : Flash API callback from flash ready interrupt when a job 
+*                failed. No more jobs are started.
+* Arguments    : none
+* Return value : none
+******************************************************************************/
+void FlashError(void)
+{
+    fl_rom_queue_job_done(false);
+}
+/******************************************************************************
+End of function FlashError
+******************************************************************************/
+#endif /* FLASH_API_RX_CFG_ROM_BGO */
+
+#ifdef FLASH_API_RX_CFG_ROM_BGO
+/* Back to default code section */
+#pragma section
+#endif
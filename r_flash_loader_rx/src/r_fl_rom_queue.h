@@ -0,0 +1,92 @@
+/*******************************************************************************
+* DISCLAIMER
+* This software is supplied by Renesas Electronics Corporation and is only 
+* intended for use with Renesas products. No other uses are authorized. This 
+* software is owned by Renesas Electronics Corporation and is protected under
+* all applicable laws, including copyright laws.
+* THIS SOFTWARE IS PROVIDED "AS IS" AND RENESAS MAKES NO WARRANTIES REGARDING
+* THIS SOFTWARE, WHETHER EXPRESS, IMPLIED OR STATUTORY, INCLUDING BUT NOT
+* LIMITED TO WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE 
+* AND NON-INFRINGEMENT. ALL SUCH WARRANTIES ARE EXPRESSLY DISCLAIMED.
+* TO THE MAXIMUM EXTENT PERMITTED NOT PROHIBITED BY LAW, NEITHER RENESAS 
+* ELECTRONICS CORPORATION NOR ANY OF ITS AFFILIATED COMPANIES SHALL BE LIABLE 
+* FOR ANY DIRECT, INDIRECT, SPECIAL, INCIDENTAL OR CONSEQUENTIAL DAMAGES FOR
+* ANY REASON RELATED TO THIS SOFTWARE, EVEN IF RENESAS OR ITS AFFILIATES HAVE
+* BEEN ADVISED OF THE POSSIBILITY OF SUCH DAMAGES.
+* Renesas reserves the right, without notice, to make changes to this software
+* and to discontinue the availability of this software. By using this software,
+* you agree to the additional terms and conditions found by accessing the 
+* following link:
+* http://www.renesas.com/disclaimer *
+* Copyright (C) 2013 Renesas Electronics Corporation. All rights reserved.    
+*******************************************************************************/
+/*******************************************************************************
+* File Name    : r_fl_rom_queue.h
+* Version      : 3.10
+* Description  : Queue of MCU flash erase, program and blank check jobs.
+******************************************************************************/  
+/******************************************************************************
+* History : DD.MM.YYYY Version Description
+*         : 19.10.2026 3.10    First Release
+*         : 19.10.2026 3.20    Added FL_ROM_JOB_ERASE_USED.
+*         : 19.10.2026 3.30    Added fl_rom_queue_erase_range() and 
+*                              fl_rom_queue_erase_time().
+******************************************************************************/
+
+#ifndef FL_ROM_QUEUE_H
+#define FL_ROM_QUEUE_H
+
+/******************************************************************************
+Includes   <System Includes> , "Project Includes"
+******************************************************************************/
+/* Fixed width types support. */
+#include <stdint.h>
+/* Used for bool. */
+#include <stdbool.h>
+
+/******************************************************************************
+Macro definitions
+******************************************************************************/
+/* Job types */
+/* Erase 1 MCU flash block */
+#define FL_ROM_JOB_ERASE            (0)
+/* Program a range of MCU flash */
+#define FL_ROM_JOB_WRITE            (1)
+/* Check whether a range of MCU flash is erased */
+#define FL_ROM_JOB_BLANK_CHECK      (2)
+/* Erase 1 MCU flash block unless it is already erased */
+#define FL_ROM_JOB_ERASE_USED       (3)
+
+/******************************************************************************
+Typedef definitions
+******************************************************************************/
+/* Queued MCU flash job */
+typedef struct
+{
+    /* FL_ROM_JOB_xxx */
+    uint8_t     type;
+    /* Block number for FL_ROM_JOB_ERASE and FL_ROM_JOB_ERASE_USED. 
+       Program/erase address otherwise. */
+    uint32_t    flash_addr;
+    /* RAM address of data for FL_ROM_JOB_WRITE */
+    uint32_t    buffer_addr;
+    /* Number of bytes to program or check */
+    uint16_t    bytes;
+    /* Where to place result of FL_ROM_JOB_BLANK_CHECK */
+    bool      * p_blank;
+} fl_rom_job_t;
+
+/******************************************************************************
+Exported global functions (to be accessed by other files)
+******************************************************************************/
+void     fl_rom_queue_init(void);
+bool     fl_rom_queue_erase(uint32_t block);
+bool     fl_rom_queue_erase_used(uint32_t block);
+bool     fl_rom_queue_erase_range(uint32_t start_addr, uint32_t bytes);
+bool     fl_rom_queue_write(uint32_t flash_addr, uint32_t buffer_addr, uint16_t bytes);
+bool     fl_rom_queue_blank_check(uint32_t flash_addr, uint16_t bytes, bool * p_blank);
+bool     fl_rom_queue_wait(uint32_t jobs);
+uint32_t fl_rom_queue_pending(void);
+uint32_t fl_rom_queue_erase_time(uint32_t block);
+
+#endif /* FL_ROM_QUEUE_H */
@@ -0,0 +1,188 @@
+/*******************************************************************************
+* DISCLAIMER
+* This software is supplied by Renesas Electronics Corporation and is only
+* intended for use with Renesas products. No other uses are authorized. This
+* software is owned by Renesas Electronics Corporation and is protected under
+* all applicable laws, including copyright laws.
+* THIS SOFTWARE IS PROVIDED "AS IS" AND RENESAS MAKES NO WARRANTIES REGARDING
+* THIS SOFTWARE, WHETHER EXPRESS, IMPLIED OR STATUTORY, INCLUDING BUT NOT
+* LIMITED TO WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE
+* AND NON-INFRINGEMENT. ALL SUCH WARRANTIES ARE EXPRESSLY DISCLAIMED.
+* TO THE MAXIMUM EXTENT PERMITTED NOT PROHIBITED BY LAW, NEITHER RENESAS
+* ELECTRONICS CORPORATION NOR ANY OF ITS AFFILIATED COMPANIES SHALL BE LIABLE
+* FOR ANY DIRECT, INDIRECT, SPECIAL, INCIDENTAL OR CONSEQUENTIAL DAMAGES FOR
+* ANY REASON RELATED TO THIS SOFTWARE, EVEN IF RENESAS OR ITS AFFILIATES HAVE
+* BEEN ADVISED OF THE POSSIBILITY OF SUCH DAMAGES.
+* Renesas reserves the right, without notice, to make changes to this software
+* and to discontinue the availability of this software. By using this software,
+* you agree to the additional terms and conditions found by accessing the
+* following link:
+* http://www.renesas.com/disclaimer *
+* Copyright (C) 2013 Renesas Electronics Corporation. All rights reserved.
+*******************************************************************************/
+/*******************************************************************************
+* File Name    : r_fl_services.c
+* Version      : 3.10
+* Description  : Table of Bootloader services for the User Application. The
+*                table (fl_services_t in r_flash_loader_rx_if.h) is placed
+*                at FL_CFG_SERVICES_ADDR so a User Application can find it
+*                with R_FL_GetServices() without being linked against this
+*                build of the Bootloader. It gives the memory driver, CRC,
+*                Flash API and load image check used by the Bootloader so
+*                the User Application does not need its own copies to
+*                receive and check new load images.
+*
+*                The services run on the caller's stack but keep their state
+*                in the Bootloader's RAM sections, which the 'init' entry
+*                sets up. The User Application must leave that RAM alone.
+*                With FLASH_API_RX_CFG_ROM_BGO the flash ready interrupt goes
+*                through the User Application's vector table, so operations
+*                must be finished by polling the 'flash_get_status' entry.
+******************************************************************************/
+/******************************************************************************
+* History : DD.MM.YYYY Version Description
+*         : 19.10.2026 3.10    First Release
+*         : 19.10.2026 3.20    Added 'fast_boot_clear'.
+*         : 19.10.2026 3.30    Added the slot directory entries. 'init' reads
+*                              the directory.
+*         : 19.10.2026 3.40    The metadata log was removed.
+******************************************************************************/
+
+/******************************************************************************
+Includes   <System Includes> , "Project Includes"
+******************************************************************************/
+/* Fixed width types support. */
+#include <stdint.h>
+/* Used for bool. */
+#include <stdbool.h>
+/* Flash Loader project includes. */
+#include "r_fl_includes.h"
+/* Used for CRC functions. */
+#include "r_crc_rx_if.h"
+/* Used for Flash API functions. */
+#include "r_flash_api_rx_if.h"
+
+#if FL_CFG_SERVICES_ENABLE == 1
+
+/******************************************************************************
+External function Prototypes
+******************************************************************************/
+/* Sets up RAM sections from the Bootloader's section tables (see dbsct.c) */
+extern void _INITSCT(void);
+
+/******************************************************************************
+Private global variables and functions
+******************************************************************************/
+static void fl_services_init(void);
+#if FL_CFG_FAST_BOOT_ENABLE != 1
+static bool fl_services_no_fast_boot(void);
+#endif
+#if FL_CFG_MEM_DIR_ENABLE != 1
+static bool fl_services_no_dir_format(void);
+#endif
+
+/* The table must stay at FL_CFG_SERVICES_ADDR */
+#pragma section C FLSERVICES
+
+const fl_services_t g_fl_services =
+{
+    FL_SERVICES_MAGIC,
+    FL_SERVICES_VERSION_MAJOR,
+    FL_SERVICES_VERSION_MINOR,
+    sizeof(fl_services_t),
+    fl_services_init,
+    fl_mem_read,
+    fl_mem_write,
+    fl_mem_erase,
+    fl_mem_get_busy,
+    R_CRC_Compute,
+    R_FlashErase,
+    R_FlashWrite,
+    R_FlashGetStatus,
+    R_FlashDataAreaAccess,
+    fl_verify_load_image,
+#if FL_CFG_FAST_BOOT_ENABLE == 1
+    fl_fast_boot_clear,
+#else
+    fl_services_no_fast_boot,
+#endif
+#if FL_CFG_MEM_DIR_ENABLE == 1
+    fl_dir_format,
+#else
+    fl_services_no_dir_format,
+#endif
+    /* These fail while no directory has been read or formatted */
+    fl_dir_get_entry,
+    fl_dir_clear_slot,
+    fl_dir_set_state,
+    fl_dir_set_image_info
+};
+
+#pragma section
+
+/******************************************************************************
+* Function Name: fl_services_init
+* Description  : Sets up the Bootloader for use by the User Application. The
+*                Bootloader's RAM sections are set up again because the
+*                User Application's start up code only sets up its own. The
+*                Flash API copies its RAM code again on first use.
+* Arguments    : none
+* Return value : none
+******************************************************************************/
+static void fl_services_init(void)
+{
+    /* Clear B sections and copy D sections to R sections */
+    _INITSCT();
+
+    R_CRC_Init();
+
+    /* Fills in g_fl_li_mem_info */
+    fl_mem_init();
+
+#if FL_CFG_MEM_DIR_ENABLE == 1
+    /* RAM copy of the directory used by the 'dir_xxx' entries */
+    fl_dir_read();
+#endif
+}
+/******************************************************************************
+End of function fl_services_init
+******************************************************************************/
+
+#if FL_CFG_FAST_BOOT_ENABLE != 1
+/******************************************************************************
+* Function Name: fl_services_no_fast_boot
+* Description  : Stands in for fl_fast_boot_clear() when this Bootloader never
+*                goes straight to the User Application.
+* Arguments    : none
+* Return value : true - 
+*                    Every boot does the full checks
+******************************************************************************/
+static bool fl_services_no_fast_boot(void)
+{
+    return true;
+}
+/******************************************************************************
+End of function fl_services_no_fast_boot
+******************************************************************************/
+#endif
+
+#if FL_CFG_MEM_DIR_ENABLE != 1
+/******************************************************************************
+* Function Name: fl_services_no_dir_format
+* Description  : Stands in for fl_dir_format() when this Bootloader does not
+*                use the slot directory, so none is written.
+* Arguments    : none
+* Return value : false - 
+*                    There is no directory
+******************************************************************************/
+static bool fl_services_no_dir_format(void)
+{
+    return false;
+}
+/******************************************************************************
+End of function fl_services_no_dir_format
+******************************************************************************/
+#endif
+
+#endif /* FL_CFG_SERVICES_ENABLE */
+
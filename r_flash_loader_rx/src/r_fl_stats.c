@@ -0,0 +1,464 @@
+/*******************************************************************************
+* DISCLAIMER
+* This software is supplied by Renesas Electronics Corporation and is only 
+* intended for use with Renesas products. No other uses are authorized. This 
+* software is owned by Renesas Electronics Corporation and is protected under
+* all applicable laws, including copyright laws.
+* THIS SOFTWARE IS PROVIDED "AS IS" AND RENESAS MAKES NO WARRANTIES REGARDING
+* THIS SOFTWARE, WHETHER EXPRESS, IMPLIED OR STATUTORY, INCLUDING BUT NOT
+* LIMITED TO WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE 
+* AND NON-INFRINGEMENT. ALL SUCH WARRANTIES ARE EXPRESSLY DISCLAIMED.
+* TO THE MAXIMUM EXTENT PERMITTED NOT PROHIBITED BY LAW, NEITHER RENESAS 
+* ELECTRONICS CORPORATION NOR ANY OF ITS AFFILIATED COMPANIES SHALL BE LIABLE 
+* FOR ANY DIRECT, INDIRECT, SPECIAL, INCIDENTAL OR CONSEQUENTIAL DAMAGES FOR
+* ANY REASON RELATED TO THIS SOFTWARE, EVEN IF RENESAS OR ITS AFFILIATES HAVE
+* BEEN ADVISED OF THE POSSIBILITY OF SUCH DAMAGES.
+* Renesas reserves the right, without notice, to make changes to this software
+* and to discontinue the availability of this software. By using this software,
+* you agree to the additional terms and conditions found by accessing the 
+* following link:
+* http://www.renesas.com/disclaimer *
+* Copyright (C) 2013 Renesas Electronics Corporation. All rights reserved.    
+*******************************************************************************/
+/*******************************************************************************
+* File Name    : r_fl_stats.c
+* Version      : 3.10
+* Description  : Keeps the timing collected by the Flash API in data flash so
+*                it builds up over the life of the part. Each erase of each
+*                block is counted and the longest erase of each block is 
+*                kept, along with a histogram of how long each kind of flash
+*                operation took. Erases take longer as flash wears, so a part
+*                whose erases are getting close to the Flash API timeout can
+*                be flagged before an update fails in the field.
+*
+*                Timing uses the shared free running CMT channel (see 
+*                fl_free_timer_get()), which the Flash API reads directly 
+*                (see R_FlashStatsInit()). The totals are 
+*                kept in 2 data flash blocks that are written in turn, each
+*                with a sequence number and CRC, so power loss while saving
+*                leaves the older copy in use.
+******************************************************************************/  
+/******************************************************************************
+* History : DD.MM.YYYY Version Description
+*         : 19.10.2026 3.10    First Release
+*         : 19.10.2026 3.20    Data flash access is allowed with fl_df_access()
+*                              so blocks used by others stay allowed.
+*         : 19.10.2026 3.30    Uses the free running CMT channel from 
+*                              fl_free_timer_get().
+******************************************************************************/
+
+/******************************************************************************
+Includes   <System Includes> , "Project Includes"
+******************************************************************************/
+/* Info on which board is being used. */
+#include <platform.h>
+/* Used for memcmp() and memset() */
+#include <string.h>
+/* Fixed width types support. */
+#include <stdint.h>
+/* Used for bool. */
+#include <stdbool.h>
+/* Flash Loader project includes. */
+#include "r_fl_includes.h"
+/* Uses r_crc_rx package for CRC calculations. */
+#include "r_crc_rx_if.h"
+/* Uses the Flash API for timing and for data flash. */
+#include "r_flash_api_rx_if.h"
+/* Uses a free running CMT channel for timing. */
+#include "r_cmt_rx_if.h"
+
+#if FL_CFG_STATS_ENABLE == 1
+
+/******************************************************************************
+Macro definitions
+******************************************************************************/
+#if !defined(FLASH_API_RX_CFG_COLLECT_STATS)
+    #error "r_fl_stats.c needs FLASH_API_RX_CFG_COLLECT_STATS. Please enable it in r_flash_api_rx_config.h"
+#endif
+
+#if defined(FLASH_API_RX_CFG_DATA_FLASH_BGO)
+    #error "r_fl_stats.c needs data flash operations to block. Disable FLASH_API_RX_CFG_DATA_FLASH_BGO."
+#endif
+
+/* Number of data flash blocks holding copies of the totals */
+#define FL_STATS_NUM_COPIES         (2)
+
+#if (FL_CFG_STATS_FIRST_DF_BLOCK + FL_STATS_NUM_COPIES) > DF_NUM_BLOCKS
+    #error "FL_CFG_STATS_FIRST_DF_BLOCK goes past the end of data flash."
+#endif
+
+#if (FL_CFG_KV_ENABLE == 1) && \
+    (FL_CFG_STATS_FIRST_DF_BLOCK < (FL_CFG_KV_FIRST_DF_BLOCK + FL_CFG_KV_NUM_PAGES)) && \
+    ((FL_CFG_STATS_FIRST_DF_BLOCK + FL_STATS_NUM_COPIES) > FL_CFG_KV_FIRST_DF_BLOCK)
+    #error "FL_CFG_STATS_FIRST_DF_BLOCK overlaps the key-value store."
+#endif
+
+/* Flash API block number of a copy */
+#define FL_STATS_BLOCK(copy)        (BLOCK_DB0 + FL_CFG_STATS_FIRST_DF_BLOCK + (copy))
+
+/* Address in data flash of a copy */
+#define FL_STATS_ADDR(copy)         (g_flash_BlockAddresses[FL_STATS_BLOCK(copy)])
+
+/* Mask for fl_df_access() covering all copies */
+#define FL_STATS_ACCESS_MASK        ((uint16_t)(((1 << FL_STATS_NUM_COPIES) - 1) << FL_CFG_STATS_FIRST_DF_BLOCK))
+
+/* Converts ticks of the CMT channel to microseconds */
+#define FL_STATS_TICKS_TO_US(ticks) (((ticks) * CMT_RX_FREE_RUNNING_DIVIDER) / (BSP_PCLKB_HZ / 1000000))
+
+/******************************************************************************
+Typedef definitions
+******************************************************************************/
+/* Copy of the totals as kept in data flash. The size is a multiple of 
+   DF_PROGRAM_SIZE_SMALL and fits in 1 data flash block. */
+typedef struct
+{
+    /* Incremented each save. The good copy with the highest is used. */
+    uint32_t      sequence;
+    /* CRC-16 CCITT of 'sequence' and 'stats' */
+    uint16_t      crc;
+    /* Keeps 'stats' 4 byte aligned */
+    uint16_t      reserved;
+    /* Totals over all saves */
+    flash_stats_t stats;
+} fl_stats_record_t;
+
+/******************************************************************************
+Private global variables and functions
+******************************************************************************/
+/* Totals as of the last save */
+static fl_stats_record_t g_fl_stats_saved;
+/* Whether a copy in data flash holds g_fl_stats_saved, and which one */
+static bool              g_fl_stats_have_copy = false;
+static uint32_t          g_fl_stats_copy;
+
+static bool     fl_stats_copy_good(uint32_t copy);
+static void     fl_stats_merge(flash_stats_t * p_total, const flash_stats_t * p_new);
+static bool     fl_stats_check_aging(const flash_stats_t * p_stats);
+static uint16_t fl_stats_calc_crc(const fl_stats_record_t * p_record);
+
+/******************************************************************************
+* Function Name: fl_stats_init
+* Description  : Loads the saved totals and starts timing flash operations.
+*                R_CRC_Init() must have been called first, and the Flash API
+*                code must be in RAM. If no CMT channel is free the saved 
+*                totals can still be read but nothing new is timed.
+* Arguments    : none
+* Return value : none
+******************************************************************************/
+void fl_stats_init(void)
+{
+    uint32_t copy;
+    uint32_t channel;
+    uint32_t counter_addr;
+
+    g_fl_stats_have_copy = false;
+
+    /* Allow reading and programming of the copies */
+    fl_df_access(FL_STATS_ACCESS_MASK);
+
+    /* Use the good copy with the highest sequence */
+    for(copy = 0; copy < FL_STATS_NUM_COPIES; copy++)
+    {
+        if( (fl_stats_copy_good(copy) == true) &&
+            ( (g_fl_stats_have_copy == false) ||
+              (((fl_stats_record_t *)FL_STATS_ADDR(copy))->sequence > g_fl_stats_saved.sequence) ) )
+        {
+            memcpy(&g_fl_stats_saved, (void *)FL_STATS_ADDR(copy), sizeof(g_fl_stats_saved));
+
+            g_fl_stats_copy      = copy;
+            g_fl_stats_have_copy = true;
+        }
+    }
+
+    if(g_fl_stats_have_copy == false)
+    {
+        /* Nothing saved yet */
+        memset(&g_fl_stats_saved, 0, sizeof(g_fl_stats_saved));
+    }
+
+    /* The Flash API reads the counter register itself because ROM, and so
+       R_CMT_Control(), cannot be read during MCU flash operations. */
+    if( (fl_free_timer_get(&channel) == true) &&
+        (R_CMT_Control(channel, CMT_RX_CMD_GET_COUNT_ADDRESS, &counter_addr) == true) )
+    {
+        R_FlashStatsInit(counter_addr);
+    }
+}
+/******************************************************************************
+End of function fl_stats_init
+******************************************************************************/
+
+/******************************************************************************
+* Function Name: fl_stats_save
+* Description  : Adds what the Flash API has timed since the last save to the
+*                totals and writes them to the copy not in use. Nothing is 
+*                written if no flash operation has been timed.
+* Arguments    : none
+* Return value : true - 
+*                    Totals saved or nothing to save
+*                false - 
+*                    Data flash could not be erased or written. The totals
+*                    are kept in RAM and written by the next save.
+******************************************************************************/
+bool fl_stats_save(void)
+{
+    uint32_t copy;
+
+    /* Every erase and program enters P/E mode first */
+    if(R_FlashStatsGet()->op[FLASH_STATS_OP_ENTER_PE].count == 0)
+    {
+        return true;
+    }
+
+    fl_stats_merge(&g_fl_stats_saved.stats, R_FlashStatsGet());
+
+    /* Operations done while saving are counted in the next save */
+    R_FlashStatsClear();
+
+    /* Copies are written in turn */
+    if(g_fl_stats_have_copy == true)
+    {
+        copy = (g_fl_stats_copy + 1) % FL_STATS_NUM_COPIES;
+        g_fl_stats_saved.sequence++;
+    }
+    else
+    {
+        copy = 0;
+        g_fl_stats_saved.sequence = 0;
+    }
+
+    g_fl_stats_saved.crc = fl_stats_calc_crc(&g_fl_stats_saved);
+
+    if(R_FlashErase(FL_STATS_BLOCK(copy)) != FLASH_SUCCESS)
+    {
+        return false;
+    }
+
+    if(R_FlashWrite(FL_STATS_ADDR(copy), 
+                    (uint32_t)&g_fl_stats_saved, 
+                    sizeof(g_fl_stats_saved)) != FLASH_SUCCESS)
+    {
+        return false;
+    }
+
+    if(memcmp((void *)FL_STATS_ADDR(copy), &g_fl_stats_saved, sizeof(g_fl_stats_saved)) != 0)
+    {
+        return false;
+    }
+
+    g_fl_stats_copy      = copy;
+    g_fl_stats_have_copy = true;
+
+    return true;
+}
+/******************************************************************************
+End of function fl_stats_save
+******************************************************************************/
+
+/******************************************************************************
+* Function Name: fl_stats_is_aging
+* Description  : Checks whether the MCU flash is wearing out. This is the case
+*                when any flash operation has timed out or an erase of any
+*                MCU flash block has taken longer than 
+*                FL_CFG_STATS_AGING_ERASE_US.
+* Arguments    : none
+* Return value : true - 
+*                    Flash is aging
+*                false - 
+*                    No sign of aging
+******************************************************************************/
+bool fl_stats_is_aging(void)
+{
+    return (bool)( (fl_stats_check_aging(&g_fl_stats_saved.stats) == true) ||
+                   (fl_stats_check_aging(R_FlashStatsGet()) == true) );
+}
+/******************************************************************************
+End of function fl_stats_is_aging
+******************************************************************************/
+
+/******************************************************************************
+* Function Name: fl_stats_erase_count
+* Description  : Returns how many times a block has been erased since the
+*                totals were first saved.
+* Arguments    : block - 
+*                    Flash API block number (BLOCK_0, BLOCK_DB0, etc...)
+* Return value : Number of erases
+******************************************************************************/
+uint32_t fl_stats_erase_count(uint32_t block)
+{
+    if(block >= FLASH_STATS_NUM_BLOCKS)
+    {
+        return 0;
+    }
+
+    return g_fl_stats_saved.stats.block_erases[block] + R_FlashStatsGet()->block_erases[block];
+}
+/******************************************************************************
+End of function fl_stats_erase_count
+******************************************************************************/
+
+/******************************************************************************
+* Function Name: fl_stats_erase_max_us
+* Description  : Returns the longest erase of a block.
+* Arguments    : block - 
+*                    Flash API block number (BLOCK_0, BLOCK_DB0, etc...)
+* Return value : Longest erase in microseconds
+******************************************************************************/
+uint32_t fl_stats_erase_max_us(uint32_t block)
+{
+    uint32_t ticks;
+
+    if(block >= FLASH_STATS_NUM_BLOCKS)
+    {
+        return 0;
+    }
+
+    ticks = g_fl_stats_saved.stats.block_erase_max_ticks[block];
+
+    if(R_FlashStatsGet()->block_erase_max_ticks[block] > ticks)
+    {
+        ticks = R_FlashStatsGet()->block_erase_max_ticks[block];
+    }
+
+    return FL_STATS_TICKS_TO_US(ticks);
+}
+/******************************************************************************
+End of function fl_stats_erase_max_us
+******************************************************************************/
+
+/******************************************************************************
+* Function Name: fl_stats_copy_good
+* Description  : Checks the CRC of a copy in data flash. A blank copy is not 
+*                read because erased data flash has no fixed value.
+* Arguments    : copy - 
+*                    Which copy
+* Return value : true - 
+*                    Copy is good
+*                false - 
+*                    Copy is blank or corrupt
+******************************************************************************/
+static bool fl_stats_copy_good(uint32_t copy)
+{
+    const fl_stats_record_t * p_record;
+
+    if(R_FlashDataAreaBlankCheck(FL_STATS_ADDR(copy), BLANK_CHECK_2_BYTE) == FLASH_BLANK)
+    {
+        return false;
+    }
+
+    p_record = (const fl_stats_record_t *)FL_STATS_ADDR(copy);
+
+    return (bool)(fl_stats_calc_crc(p_record) == p_record->crc);
+}
+/******************************************************************************
+End of function fl_stats_copy_good
+******************************************************************************/
+
+/******************************************************************************
+* Function Name: fl_stats_merge
+* Description  : Adds newly collected statistics to a total
+* Arguments    : p_total - 
+*                    Total to add to
+*                p_new - 
+*                    Statistics to add
+* Return value : none
+******************************************************************************/
+static void fl_stats_merge(flash_stats_t * p_total, const flash_stats_t * p_new)
+{
+    uint32_t op;
+    uint32_t i;
+
+    for(op = 0; op < FLASH_STATS_NUM_OPS; op++)
+    {
+        p_total->op[op].count    += p_new->op[op].count;
+        p_total->op[op].timeouts += p_new->op[op].timeouts;
+
+        if(p_new->op[op].max_ticks > p_total->op[op].max_ticks)
+        {
+            p_total->op[op].max_ticks = p_new->op[op].max_ticks;
+        }
+
+        for(i = 0; i < FLASH_STATS_NUM_BUCKETS; i++)
+        {
+            p_total->op[op].histogram[i] += p_new->op[op].histogram[i];
+        }
+    }
+
+    for(i = 0; i < FLASH_STATS_NUM_BLOCKS; i++)
+    {
+        p_total->block_erases[i] += p_new->block_erases[i];
+
+        if(p_new->block_erase_max_ticks[i] > p_total->block_erase_max_ticks[i])
+        {
+            p_total->block_erase_max_ticks[i] = p_new->block_erase_max_ticks[i];
+        }
+    }
+}
+/******************************************************************************
+End of function fl_stats_merge
+******************************************************************************/
+
+/******************************************************************************
+* Function Name: fl_stats_check_aging
+* Description  : Checks one set of statistics for signs of aging
+* Arguments    : p_stats - 
+*                    Statistics to check
+* Return value : true - 
+*                    A timeout or slow MCU flash erase was found
+*                false - 
+*                    No sign of aging
+******************************************************************************/
+static bool fl_stats_check_aging(const flash_stats_t * p_stats)
+{
+    uint32_t i;
+
+    for(i = 0; i < FLASH_STATS_NUM_OPS; i++)
+    {
+        if(p_stats->op[i].timeouts != 0)
+        {
+            return true;
+        }
+    }
+
+    for(i = 0; i < ROM_NUM_BLOCKS; i++)
+    {
+        if(FL_STATS_TICKS_TO_US(p_stats->block_erase_max_ticks[i]) > FL_CFG_STATS_AGING_ERASE_US)
+        {
+            return true;
+        }
+    }
+
+    return false;
+}
+/******************************************************************************
+End of function fl_stats_check_aging
+******************************************************************************/
+
+/******************************************************************************
+* Function Name: fl_stats_calc_crc
+* Description  : Calculates the CRC of a copy's sequence and totals
+* Arguments    : p_record - 
+*                    Copy to use, in RAM or data flash
+* Return value : CRC-16 CCITT of copy
+******************************************************************************/
+static uint16_t fl_stats_calc_crc(const fl_stats_record_t * p_record)
+{
+    uint16_t crc;
+
+    R_CRC_Compute( FL_CRC_SEED,
+                   (uint8_t *)&p_record->sequence,
+                   sizeof(p_record->sequence),
+                   &crc);
+
+    R_CRC_Compute( crc,
+                   (uint8_t *)&p_record->stats,
+                   sizeof(p_record->stats),
+                   &crc);
+
+    return crc;
+}
+/******************************************************************************
+End of function fl_stats_calc_crc
+******************************************************************************/
+
+#endif /* FL_CFG_STATS_ENABLE */
@@ -33,6 +33,32 @@
 *         : 23.02.2012 3.00    Made compliant with CS v4.0. Fixed bug in 
 *                              fl_store_block_init() function when data member
 *                              spanned programming pages.
+*         : 19.10.2026 3.10    fl_get_latest_image() now returns the valid 
+*                              image with the highest generation number.
+*                              fl_verify_load_image() now reads the requested
+*                              load image instead of always using the first.
+*         : 19.10.2026 3.20    fl_get_load_image_headers() uses the slot
+*                              directory when it is available.
+*         : 19.10.2026 3.30    Added support for LZ compressed load images.
+*         : 19.10.2026 3.40    Added support for delta load images.
+*         : 19.10.2026 3.50    Added support for sparse load images. The CRC
+*                              of erased parts is calculated without reading
+*                              them.
+*         : 19.10.2026 3.60    Image data is read with fl_mem_map() so it is
+*                              not copied when the memory allows it.
+*         : 19.10.2026 3.70    Locals of fl_get_load_image_headers() are 
+*                              declared at the top of the function.
+*         : 19.10.2026 3.80    Only headers with FL_LI_VALID_MASK_GEN have a
+*                              generation. Older headers count as the oldest.
+*         : 19.10.2026 3.90    A delta install cut short by power loss is
+*                              verified from where it stopped.
+*         : 19.10.2026 4.00    Added build time checks that the memory areas
+*                              after the load images are sector aligned and
+*                              do not overlap. Delta blocks larger than the
+*                              scratch area are rejected.
+*         : 19.10.2026 4.10    Image data is mapped 1 cache page at a time 
+*                              when the memory cache is enabled so it is read
+*                              in place from the cache.
 ******************************************************************************/
 
 /******************************************************************************
@@ -54,9 +80,104 @@ Includes   <System Includes> , "Project Includes"
 
 #define CRC_ADDRESS (((uint32_t)__sectop("APPHEADER_1"))-0xFFF00000)
 
+/* Number of bytes of MCU flash held in a load image */
+#define FL_RAW_IMAGE_BYTES  (0x100000)
+/* Read address of start of raw image in MCU flash */
+#define FL_RAW_IMAGE_ROM_START  (0xFFF00000)
+
+/* Bytes of image data mapped at a time. With the memory cache each piece is 
+   1 page on a page boundary so fl_mem_map() can point in to the cache instead
+   of copying it. */
+#if FL_CFG_MEM_CACHE_ENABLE == 1
+#define FL_MAP_BYTES        (FL_CFG_MEM_CACHE_PAGE_BYTES)
+#else
+#define FL_MAP_BYTES        (sizeof(fl_app_buffer))
+#endif
+
+/* End of the last load image slot */
+#define FL_LI_AREA_END      (FL_CFG_MEM_BASE_ADDR + (FL_CFG_MEM_NUM_LOAD_IMAGES * FL_CFG_MEM_MAX_LI_SIZE_BYTES))
+/* Whether two memory areas share any bytes */
+#define FL_AREAS_OVERLAP(a, a_bytes, b, b_bytes)    (((a) < ((b) + (b_bytes))) && ((b) < ((a) + (a_bytes))))
+/* Bytes erased for a saved profile. The header is 32 bytes followed by one 
+   32-bit count per bucket (see r_fl_profile.c). */
+#define FL_PROFILE_AREA_BYTES   ((((32 + ((FL_CFG_PROFILE_BYTES >> FL_CFG_PROFILE_BUCKET_SHIFT) * 4)) + \
+                                   FL_CFG_MEM_SECTOR_BYTES) - 1) / FL_CFG_MEM_SECTOR_BYTES * FL_CFG_MEM_SECTOR_BYTES)
+
+/* The slot directory, delta scratch area and saved profile are erased by 
+   sector. They must be sector aligned and must not overlap the load images or
+   each other, otherwise formatting one would erase another. */
+#if ((FL_CFG_DELTA_SCRATCH_ADDR % FL_CFG_MEM_SECTOR_BYTES) != 0) || \
+    ((FL_CFG_DELTA_SCRATCH_BYTES % FL_CFG_MEM_SECTOR_BYTES) != 0)
+    #error "FL_CFG_DELTA_SCRATCH_ADDR and FL_CFG_DELTA_SCRATCH_BYTES must be multiples of FL_CFG_MEM_SECTOR_BYTES."
+#endif
+#if FL_AREAS_OVERLAP(FL_CFG_DELTA_SCRATCH_ADDR, FL_CFG_DELTA_SCRATCH_BYTES, \
+                     FL_CFG_MEM_BASE_ADDR, (FL_LI_AREA_END - FL_CFG_MEM_BASE_ADDR))
+    #error "The delta scratch area overlaps a load image slot."
+#endif
+
+#if FL_CFG_MEM_DIR_ENABLE == 1
+#if (FL_CFG_MEM_DIR_ADDR % FL_CFG_MEM_SECTOR_BYTES) != 0
+    #error "FL_CFG_MEM_DIR_ADDR must be a multiple of FL_CFG_MEM_SECTOR_BYTES."
+#endif
+#if FL_AREAS_OVERLAP(FL_CFG_MEM_DIR_ADDR, FL_CFG_MEM_SECTOR_BYTES, \
+                     FL_CFG_MEM_BASE_ADDR, (FL_LI_AREA_END - FL_CFG_MEM_BASE_ADDR))
+    #error "The slot directory overlaps a load image slot."
+#endif
+#if FL_AREAS_OVERLAP(FL_CFG_MEM_DIR_ADDR, FL_CFG_MEM_SECTOR_BYTES, \
+                     FL_CFG_DELTA_SCRATCH_ADDR, FL_CFG_DELTA_SCRATCH_BYTES)
+    #error "The slot directory overlaps the delta scratch area."
+#endif
+#endif
+
+#if FL_CFG_PROFILE_ENABLE == 1
+#if (FL_CFG_PROFILE_MEM_ADDR % FL_CFG_MEM_SECTOR_BYTES) != 0
+    #error "FL_CFG_PROFILE_MEM_ADDR must be a multiple of FL_CFG_MEM_SECTOR_BYTES."
+#endif
+#if FL_AREAS_OVERLAP(FL_CFG_PROFILE_MEM_ADDR, FL_PROFILE_AREA_BYTES, \
+                     FL_CFG_MEM_BASE_ADDR, (FL_LI_AREA_END - FL_CFG_MEM_BASE_ADDR))
+    #error "The saved profile overlaps a load image slot."
+#endif
+#if FL_AREAS_OVERLAP(FL_CFG_PROFILE_MEM_ADDR, FL_PROFILE_AREA_BYTES, \
+                     FL_CFG_DELTA_SCRATCH_ADDR, FL_CFG_DELTA_SCRATCH_BYTES)
+    #error "The saved profile overlaps the delta scratch area."
+#endif
+#if (FL_CFG_MEM_DIR_ENABLE == 1) && \
+    FL_AREAS_OVERLAP(FL_CFG_PROFILE_MEM_ADDR, FL_PROFILE_AREA_BYTES, FL_CFG_MEM_DIR_ADDR, FL_CFG_MEM_SECTOR_BYTES)
+    #error "The saved profile overlaps the slot directory."
+#endif
+#endif
+
+/******************************************************************************
+Typedef definitions
+******************************************************************************/
+/* Effect of CRC'ing a fixed run of bytes. The new CRC is the XOR of 
+   'constant' and linear[i] for each bit i set in the old CRC. */
+typedef struct
+{
+    uint16_t linear[16];
+    uint16_t constant;
+} fl_crc_map_t;
+
 /******************************************************************************
 Private global variables and functions
 ******************************************************************************/
+static uint16_t fl_verify_lz_image(uint32_t image_index, fl_container_header_t * p_container);
+static uint16_t fl_verify_delta_image(uint32_t image_index, fl_container_header_t * p_container);
+static uint16_t fl_verify_sparse_image(uint32_t image_index, fl_container_header_t * p_container);
+static bool     fl_container_fits(uint32_t image_index, fl_container_header_t * p_container);
+static uint32_t fl_map_bytes(uint32_t address, uint32_t bytes);
+static void     fl_crc_mem(uint16_t * p_crc, uint32_t address, uint32_t bytes);
+static void     fl_crc_raw_image(uint16_t * p_crc, uint8_t * p_data, uint32_t offset, uint32_t bytes);
+static void     fl_crc_add(uint16_t * p_crc, uint8_t * p_data, uint32_t bytes);
+static uint16_t fl_crc_erased(uint16_t crc, uint32_t bytes);
+static uint16_t fl_crc_map_apply(fl_crc_map_t * p_map, uint16_t crc);
+
+/* Decompression state used when verifying */
+static fl_lz_state_t g_fl_verify_lz;
+/* Delta state used when verifying */
+static fl_delta_state_t g_fl_verify_delta;
+/* Segment state used when verifying */
+static fl_sparse_state_t g_fl_verify_sparse;
 
 
 extern volatile    uint16_t calc_crc;
@@ -64,7 +185,11 @@ extern volatile    uint16_t calc_crc;
 
 /******************************************************************************
 * Function Name: fl_get_latest_image
-* Description  : Returns index for the last downloaded load image
+* Description  : Returns index for the newest valid load image. This is the 
+*                valid image with the highest generation number. If more than
+*                one image has the same generation then the highest index is
+*                used. Headers without a generation (FL_LI_VALID_MASK) count 
+*                as generation 0.
 * Arguments    : none
 * Return value : -1 -
 *                    No load image found
@@ -75,15 +200,32 @@ int32_t fl_get_latest_image(void)
 {
     uint32_t i;
     int32_t  image_to_load;
+    uint32_t generation;
+    uint32_t newest_generation;
 
     /* Initialize values. */
     image_to_load = -1;
+    newest_generation = 0;
 
     for(i = 0; i < FL_CFG_MEM_NUM_LOAD_IMAGES; i++)
     {
-        if(g_fl_load_image_headers[i].valid_mask == FL_LI_VALID_MASK)
+        if(FL_LI_IS_VALID(g_fl_load_image_headers[i].valid_mask) == true)
         {
-                image_to_load = i;
+            generation = g_fl_load_image_headers[i].generation;
+
+            /* Images that never had a generation set are the oldest. The 
+               bytes after an older header are not a generation. */
+            if( (g_fl_load_image_headers[i].valid_mask != FL_LI_VALID_MASK_GEN) ||
+                (generation == FL_LI_GENERATION_NONE) )
+            {
+                generation = 0;
+            }
+
+            if((image_to_load == -1) || (generation >= newest_generation))
+            {
+                image_to_load = (int32_t)i;
+                newest_generation = generation;
+            }
         }
     }
 
@@ -95,18 +237,58 @@ End of function fl_get_latest_image
 
 /******************************************************************************
 * Function Name: fl_get_load_image_headers
-* Description  : Obtains Load Image Header if available from external memory
+* Description  : Obtains Load Image Header if available from external memory.
+*                If the slot directory is present the headers are taken from
+*                it with a single read. Only slots that are complete or 
+*                installed get a valid header, so slots that are still being
+*                received or that failed are never selected.
 * Arguments    : none
 * Return value : none
 ******************************************************************************/
 void fl_get_load_image_headers(void)
 {
     uint32_t i;
+    fl_container_header_t container;
+
+#if FL_CFG_MEM_DIR_ENABLE == 1
+    fl_dir_entry_t entry;
+
+    /* Try to use directory first */
+    if(fl_dir_read() == true)
+    {
+        for(i = 0; i < FL_CFG_MEM_NUM_LOAD_IMAGES; i++)
+        {
+            fl_dir_get_entry((uint8_t)i, &entry);
+
+            if( (entry.state == FL_DIR_STATE_COMPLETE) ||
+                (entry.state == FL_DIR_STATE_INSTALLED) )
+            {
+                g_fl_load_image_headers[i] = entry.header;
+            }
+            else
+            {
+                /* Slot must not be used */
+                g_fl_load_image_headers[i].valid_mask = (uint8_t)~FL_LI_VALID_MASK;
+            }
+        }
+
+        return;
+    }
+#endif
 
     /* Get load image headers from external memory */
     for(i = 0; i < FL_CFG_MEM_NUM_LOAD_IMAGES; i++)
     {
-        fl_mem_read(g_fl_li_mem_info.addresses[i]+CRC_ADDRESS, (uint8_t *)&g_fl_load_image_headers[i], sizeof(fl_image_header_t));
+        if(fl_get_image_container(i, &container) == true)
+        {
+            /* Header is kept in container */
+            g_fl_load_image_headers[i] = container.header;
+        }
+        else
+        {
+            /* Raw image, header is where the linker put it */
+            fl_mem_read(g_fl_li_mem_info.addresses[i]+CRC_ADDRESS, (uint8_t *)&g_fl_load_image_headers[i], sizeof(fl_image_header_t));
+        }
     }
 }
 /******************************************************************************
@@ -129,48 +311,51 @@ uint8_t fl_app_buffer[4096];
 uint16_t fl_verify_load_image(uint32_t image_index)
 {
 	 uint16_t calc_crc;
-	 uint32_t sizeapp;
 	 uint32_t start_address;
+	 uint32_t base_address;
+	 fl_container_header_t container;
+
+    /* Images that are not raw are verified by expanding them */
+    if(fl_get_image_container(image_index, &container) == true)
+    {
+        if(container.format == FL_IMAGE_FORMAT_LZ)
+        {
+            return fl_verify_lz_image(image_index, &container);
+        }
+
+        if(container.format == FL_IMAGE_FORMAT_DELTA)
+        {
+            return fl_verify_delta_image(image_index, &container);
+        }
+
+        if(container.format == FL_IMAGE_FORMAT_SPARSE)
+        {
+            return fl_verify_sparse_image(image_index, &container);
+        }
+
+        /* Unknown format, make sure CRC does not match */
+        return (uint16_t)(~container.header.raw_crc);
+    }
+
+    /* Where this load image starts in memory. Offsets below are relative to
+       this address. */
+    base_address = g_fl_li_mem_info.addresses[image_index];
+
+    /* Calculate CRC up to the location where the linker put the CRC value */
+    calc_crc = RX_LINKER_SEED;
+    fl_crc_mem(&calc_crc, 
+               base_address, 
+               CRC_ADDRESS + offsetof(fl_image_header_t, raw_crc));
 
-    /* Get lowest flash address. ROM_PE_ADDR is the lowest address with the
-       MSB set to 0x00. To get the read address just make the MSB 0xFF. */
-    start_address = 0;
-    sizeapp = sizeof(fl_app_buffer);
-	fl_mem_read(start_address,fl_app_buffer,sizeapp);
-	R_CRC_Compute( RX_LINKER_SEED,
-				   (uint8_t *) fl_app_buffer,
-				   sizeapp,
-				   &calc_crc);
-	start_address += sizeof(fl_app_buffer);
-    while(start_address < 0xFF000)
-    {
-		fl_mem_read(start_address,fl_app_buffer,sizeof(fl_app_buffer));
-		/* Calculate CRC up to the location where the linker put the CRC value */
-		R_CRC_Compute( calc_crc,
-					   (uint8_t *) fl_app_buffer,
-					   sizeof(fl_app_buffer),
-					   &calc_crc);
-		start_address += sizeof(fl_app_buffer);
-    }
-    sizeapp = CRC_ADDRESS-start_address + \
-            offsetof(fl_image_header_t, raw_crc);
-	fl_mem_read(start_address,fl_app_buffer,sizeapp);
-
-	R_CRC_Compute( calc_crc,
-				   (uint8_t *) fl_app_buffer,
-				   sizeapp,
-				   &calc_crc);
     /* Move start_address to right after 'raw_crc' */
     start_address = CRC_ADDRESS + \
                     offsetof(fl_image_header_t, raw_crc) + \
                     sizeof(((fl_image_header_t *) 0)->raw_crc);
-    sizeapp = (0x000FFFFF - start_address) + 1;
-	fl_mem_read(start_address,fl_app_buffer,sizeapp);
+
     /* Calculate the rest of flash after the CRC in memory */
-    R_CRC_Compute( calc_crc,
-                   (uint8_t *) fl_app_buffer,
-				   sizeapp,
-                   &calc_crc);
+    fl_crc_mem(&calc_crc, 
+               base_address + start_address, 
+               FL_RAW_IMAGE_BYTES - start_address);
 
     /* The RX linker does a bitwise NOT on the data after the
        CRC has finished */
@@ -182,5 +367,636 @@ uint16_t fl_verify_load_image(uint32_t image_index)
 End of function fl_verify_load_image
 ******************************************************************************/
 
+/******************************************************************************
+* Function Name: fl_get_image_container
+* Description  : Reads the container header at the start of a load image slot
+* Arguments    : image_index - 
+*                    Which load image slot
+*                p_container - 
+*                    Where to place container header
+* Return value : true - 
+*                    Slot holds a container (image is not raw)
+*                false - 
+*                    Slot holds a raw image
+******************************************************************************/
+bool fl_get_image_container(uint32_t image_index, fl_container_header_t * p_container)
+{
+    fl_mem_read(g_fl_li_mem_info.addresses[image_index], (uint8_t *)p_container, sizeof(fl_container_header_t));
+
+    return (bool)(p_container->magic == FL_CONTAINER_MAGIC);
+}
+/******************************************************************************
+End of function fl_get_image_container
+******************************************************************************/
+
+/******************************************************************************
+* Function Name: fl_verify_lz_image
+* Description  : Verifies a LZ compressed load image by expanding it and 
+*                calculating the same CRC the linker does. This makes sure
+*                the decompressed image is correct before MCU flash is erased.
+* Arguments    : image_index - 
+*                    Which load image slot
+*                p_container - 
+*                    Container header of slot
+* Return value : CRC16-CCITT value of expanded image
+******************************************************************************/
+static uint16_t fl_verify_lz_image(uint32_t image_index, fl_container_header_t * p_container)
+{
+    uint16_t calc_crc;
+    uint32_t offset;
+
+    /* Compressed data must fit in slot and expand to a whole image */
+    if(fl_container_fits(image_index, p_container) == false)
+    {
+        return (uint16_t)(~p_container->header.raw_crc);
+    }
+
+    fl_lz_init(&g_fl_verify_lz, 
+               g_fl_li_mem_info.addresses[image_index] + sizeof(fl_container_header_t), 
+               p_container->stored_size);
+
+    calc_crc = RX_LINKER_SEED;
+
+    for(offset = 0; offset < FL_RAW_IMAGE_BYTES; offset += sizeof(fl_app_buffer))
+    {
+        /* Expand next part of image */
+        if(fl_lz_read(&g_fl_verify_lz, fl_app_buffer, sizeof(fl_app_buffer)) != sizeof(fl_app_buffer))
+        {
+            /* Stream is short or corrupt */
+            return (uint16_t)(~p_container->header.raw_crc);
+        }
+
+        fl_crc_raw_image(&calc_crc, fl_app_buffer, offset, sizeof(fl_app_buffer));
+    }
+
+    /* The RX linker does a bitwise NOT on the data after the
+       CRC has finished */
+    return (uint16_t)(~calc_crc);
+}
+/******************************************************************************
+End of function fl_verify_lz_image
+******************************************************************************/
+
+/******************************************************************************
+* Function Name: fl_verify_delta_image
+* Description  : Verifies a delta load image by applying it without writing
+*                anything. Unchanged parts come straight from MCU flash. The
+*                delta rules (see r_fl_delta.c) make sure this gives the same
+*                output as installing it, so the CRC is checked before MCU 
+*                flash is erased. With FL_CFG_INSTALL_JOURNAL_ENABLE an 
+*                install of this image that was cut short is checked as it 
+*                will be finished: blocks it rebuilt come from MCU flash and
+*                the block it was rebuilding uses its old contents from the
+*                scratch area.
+* Arguments    : image_index - 
+*                    Which load image slot
+*                p_container - 
+*                    Container header of slot
+* Return value : CRC16-CCITT value of image after applying delta
+******************************************************************************/
+static uint16_t fl_verify_delta_image(uint32_t image_index, fl_container_header_t * p_container)
+{
+    uint16_t           calc_crc;
+    uint32_t           offset;
+    uint32_t           done;
+    uint32_t           bytes;
+    uint32_t           resume_done;
+    uint32_t           resume_block;
+    fl_delta_header_t  delta;
+    fl_delta_block_t   block;
+    fl_image_header_t * p_cur_header;
+
+    if(fl_container_fits(image_index, p_container) == false)
+    {
+        return (uint16_t)(~p_container->header.raw_crc);
+    }
+
+    if(fl_delta_init(&g_fl_verify_delta, 
+                     g_fl_li_mem_info.addresses[image_index] + sizeof(fl_container_header_t), 
+                     p_container->stored_size,
+                     &delta) == false)
+    {
+        return (uint16_t)(~p_container->header.raw_crc);
+    }
+
+#if FL_CFG_INSTALL_JOURNAL_ENABLE == 1
+    /* Where an unfinished install of this image stopped */
+    resume_done  = fl_journal_start((uint8_t)image_index, g_fl_load_image_headers[image_index].raw_crc);
+    resume_block = fl_journal_saved_block();
+#else
+    resume_done  = 0;
+    resume_block = FL_JOURNAL_NO_BLOCK;
+#endif
+
+    /* Delta must have been made against the image in MCU flash. Once the
+       install has started the header may already be rebuilt or erased, and
+       the base was checked before it started. */
+    p_cur_header = (fl_image_header_t *)__sectop("APPHEADER_1");
+
+    if( (resume_done == 0) && 
+        (resume_block == FL_JOURNAL_NO_BLOCK) &&
+        ((FL_LI_IS_VALID(p_cur_header->valid_mask) == false) ||
+         (p_cur_header->raw_crc != delta.base_crc)) )
+    {
+        return (uint16_t)(~p_container->header.raw_crc);
+    }
+
+    calc_crc = RX_LINKER_SEED;
+    offset   = 0;
+
+    while(fl_delta_next_block(&g_fl_verify_delta, &block) == true)
+    {
+        /* Unchanged data before this block */
+        fl_crc_raw_image(&calc_crc, 
+                         (uint8_t *)(FL_RAW_IMAGE_ROM_START + offset), 
+                         offset, 
+                         block.offset - offset);
+
+        /* Old contents of block must fit in the scratch area */
+        if(block.length > FL_CFG_DELTA_SCRATCH_BYTES)
+        {
+            return (uint16_t)(~p_container->header.raw_crc);
+        }
+
+        /* Old contents of a part rebuilt block were saved */
+        if(block.offset == resume_block)
+        {
+            fl_delta_set_scratch(&g_fl_verify_delta, FL_CFG_DELTA_SCRATCH_ADDR);
+        }
+
+        /* Rebuilt block */
+        for(done = 0; done < block.length; done += bytes)
+        {
+            bytes = block.length - done;
+
+            if(bytes > sizeof(fl_app_buffer))
+            {
+                bytes = sizeof(fl_app_buffer);
+            }
+
+            if(fl_delta_read(&g_fl_verify_delta, fl_app_buffer, bytes) != bytes)
+            {
+                return (uint16_t)(~p_container->header.raw_crc);
+            }
+
+            if((block.offset + block.length) <= resume_done)
+            {
+                /* Already in MCU flash. The delta is still read to get past
+                   the block. */
+                fl_crc_raw_image(&calc_crc, 
+                                 (uint8_t *)(FL_RAW_IMAGE_ROM_START + block.offset + done), 
+                                 block.offset + done, 
+                                 bytes);
+            }
+            else
+            {
+                fl_crc_raw_image(&calc_crc, fl_app_buffer, block.offset + done, bytes);
+            }
+        }
+
+        offset = block.offset + block.length;
+    }
+
+    /* All blocks must have been read */
+    if(g_fl_verify_delta.blocks_left != 0)
+    {
+        return (uint16_t)(~p_container->header.raw_crc);
+    }
+
+    /* Unchanged data after last block */
+    fl_crc_raw_image(&calc_crc, 
+                     (uint8_t *)(FL_RAW_IMAGE_ROM_START + offset), 
+                     offset, 
+                     FL_RAW_IMAGE_BYTES - offset);
+
+    /* The RX linker does a bitwise NOT on the data after the
+       CRC has finished */
+    return (uint16_t)(~calc_crc);
+}
+/******************************************************************************
+End of function fl_verify_delta_image
+******************************************************************************/
+
+/******************************************************************************
+* Function Name: fl_verify_sparse_image
+* Description  : Verifies a sparse load image. Only the segments are read, 
+*                the CRC of the erased parts between them is calculated.
+* Arguments    : image_index - 
+*                    Which load image slot
+*                p_container - 
+*                    Container header of slot
+* Return value : CRC16-CCITT value of image as it will be in MCU flash
+******************************************************************************/
+static uint16_t fl_verify_sparse_image(uint32_t image_index, fl_container_header_t * p_container)
+{
+    uint16_t     calc_crc;
+    uint16_t     segment_crc;
+    uint32_t     offset;
+    uint32_t     done;
+    uint32_t     bytes;
+    uint32_t     data_address;
+    uint8_t *    p_data;
+    fl_segment_t segment;
+
+    if(fl_sparse_init(&g_fl_verify_sparse, image_index, p_container) == false)
+    {
+        return (uint16_t)(~p_container->header.raw_crc);
+    }
+
+    calc_crc = RX_LINKER_SEED;
+    offset   = 0;
+
+    while(g_fl_verify_sparse.segments_left > 0)
+    {
+        if(fl_sparse_next(&g_fl_verify_sparse, &segment, &data_address) == false)
+        {
+            return (uint16_t)(~p_container->header.raw_crc);
+        }
+
+        /* Erased gap before this segment */
+        fl_crc_raw_image(&calc_crc, NULL, offset, segment.offset - offset);
+
+        /* Segment data */
+        segment_crc = FL_CRC_SEED;
+
+        for(done = 0; done < segment.length; done += bytes)
+        {
+            bytes = fl_map_bytes(data_address + done, segment.length - done);
+
+            p_data = fl_mem_map(data_address + done, fl_app_buffer, bytes);
+
+            R_CRC_Compute(segment_crc, p_data, bytes, &segment_crc);
+
+            fl_crc_raw_image(&calc_crc, p_data, segment.offset + done, bytes);
+        }
+
+        if(segment_crc != segment.crc)
+        {
+            return (uint16_t)(~p_container->header.raw_crc);
+        }
+
+        offset = segment.offset + segment.length;
+    }
+
+    /* Erased space after last segment */
+    fl_crc_raw_image(&calc_crc, NULL, offset, FL_RAW_IMAGE_BYTES - offset);
+
+    /* The RX linker does a bitwise NOT on the data after the
+       CRC has finished */
+    return (uint16_t)(~calc_crc);
+}
+/******************************************************************************
+End of function fl_verify_sparse_image
+******************************************************************************/
+
+/******************************************************************************
+* Function Name: fl_sparse_init
+* Description  : Starts reading the segments of a sparse load image
+* Arguments    : p_state - 
+*                    Segment state to initialize
+*                image_index - 
+*                    Which load image slot
+*                p_container - 
+*                    Container header of slot
+* Return value : true - 
+*                    Segment table is ready to be read
+*                false - 
+*                    Image is corrupt
+******************************************************************************/
+bool fl_sparse_init(fl_sparse_state_t * p_state, uint32_t image_index, fl_container_header_t * p_container)
+{
+    fl_sparse_header_t sparse;
+    uint32_t           table_bytes;
+
+    if( (fl_container_fits(image_index, p_container) == false) ||
+        (p_container->stored_size < sizeof(fl_sparse_header_t)) )
+    {
+        return false;
+    }
+
+    p_state->table_address = g_fl_li_mem_info.addresses[image_index] + sizeof(fl_container_header_t);
+    p_state->end_address   = p_state->table_address + p_container->stored_size;
+
+    fl_mem_read(p_state->table_address, (uint8_t *)&sparse, sizeof(fl_sparse_header_t));
+
+    /* Segment table must fit in image data */
+    table_bytes = sizeof(fl_sparse_header_t) + ((uint32_t)sparse.num_segments * sizeof(fl_segment_t));
+
+    if(table_bytes > p_container->stored_size)
+    {
+        return false;
+    }
+
+    p_state->table_address += sizeof(fl_sparse_header_t);
+    p_state->data_address   = p_state->table_address + ((uint32_t)sparse.num_segments * sizeof(fl_segment_t));
+    p_state->segments_left  = sparse.num_segments;
+    p_state->next_offset    = 0;
+
+    return true;
+}
+/******************************************************************************
+End of function fl_sparse_init
+******************************************************************************/
+
+/******************************************************************************
+* Function Name: fl_sparse_next
+* Description  : Reads the next segment of a sparse load image. Segments must
+*                be in ascending order, must not overlap and must start and 
+*                end on a FL_SPARSE_ALIGN_BYTES boundary.
+* Arguments    : p_state - 
+*                    Segment state
+*                p_segment - 
+*                    Where to place segment
+*                p_data_address - 
+*                    Where to place memory address of segment data
+* Return value : true - 
+*                    Segment read
+*                false - 
+*                    No more segments, or image is corrupt
+******************************************************************************/
+bool fl_sparse_next(fl_sparse_state_t * p_state, fl_segment_t * p_segment, uint32_t * p_data_address)
+{
+    if(p_state->segments_left == 0)
+    {
+        return false;
+    }
+
+    fl_mem_read(p_state->table_address, (uint8_t *)p_segment, sizeof(fl_segment_t));
+
+    if( (p_segment->length == 0) ||
+        ((p_segment->offset % FL_SPARSE_ALIGN_BYTES) != 0) ||
+        ((p_segment->length % FL_SPARSE_ALIGN_BYTES) != 0) ||
+        (p_segment->offset < p_state->next_offset) ||
+        (p_segment->offset > FL_RAW_IMAGE_BYTES) ||
+        (p_segment->length > (FL_RAW_IMAGE_BYTES - p_segment->offset)) ||
+        (p_segment->length > (p_state->end_address - p_state->data_address)) )
+    {
+        return false;
+    }
+
+    *p_data_address = p_state->data_address;
+
+    p_state->table_address += sizeof(fl_segment_t);
+    p_state->data_address  += p_segment->length;
+    p_state->next_offset    = p_segment->offset + p_segment->length;
+    p_state->segments_left--;
+
+    return true;
+}
+/******************************************************************************
+End of function fl_sparse_next
+******************************************************************************/
+
+/******************************************************************************
+* Function Name: fl_container_fits
+* Description  : Checks that the image data of a container fits in its slot
+*                and describes a whole image
+* Arguments    : image_index - 
+*                    Which load image slot
+*                p_container - 
+*                    Container header of slot
+* Return value : true - 
+*                    Container is usable
+*                false - 
+*                    Container is corrupt
+******************************************************************************/
+static bool fl_container_fits(uint32_t image_index, fl_container_header_t * p_container)
+{
+    if( (p_container->raw_size != FL_RAW_IMAGE_BYTES) ||
+        (p_container->stored_size > ((g_fl_li_mem_info.addresses[image_index+1] - 
+                                      g_fl_li_mem_info.addresses[image_index]) - 
+                                     sizeof(fl_container_header_t))) )
+    {
+        return false;
+    }
+
+    return true;
+}
+/******************************************************************************
+End of function fl_container_fits
+******************************************************************************/
+
+/******************************************************************************
+* Function Name: fl_map_bytes
+* Description  : Returns how many bytes to map with fl_mem_map() at once. A
+*                piece never crosses a FL_MAP_BYTES boundary.
+* Arguments    : address - 
+*                    Where the piece starts in memory
+*                bytes - 
+*                    Bytes left to read
+* Return value : Bytes in this piece
+******************************************************************************/
+static uint32_t fl_map_bytes(uint32_t address, uint32_t bytes)
+{
+    uint32_t chunk;
+
+    chunk = FL_MAP_BYTES - (address % FL_MAP_BYTES);
+
+    if(chunk > bytes)
+    {
+        chunk = bytes;
+    }
+
+    return chunk;
+}
+/******************************************************************************
+End of function fl_map_bytes
+******************************************************************************/
+
+/******************************************************************************
+* Function Name: fl_crc_mem
+* Description  : Adds a range of memory where load images are stored to a 
+*                CRC. The range is mapped in pieces from fl_map_bytes().
+* Arguments    : p_crc - 
+*                    CRC to update
+*                address - 
+*                    Where the range starts in memory
+*                bytes - 
+*                    Size of range
+* Return value : none
+******************************************************************************/
+static void fl_crc_mem(uint16_t * p_crc, uint32_t address, uint32_t bytes)
+{
+    uint32_t  chunk;
+    uint8_t * p_data;
+
+    while(bytes > 0)
+    {
+        chunk  = fl_map_bytes(address, bytes);
+        p_data = fl_mem_map(address, fl_app_buffer, chunk);
+
+        R_CRC_Compute(*p_crc, p_data, chunk, p_crc);
+
+        address += chunk;
+        bytes   -= chunk;
+    }
+}
+/******************************************************************************
+End of function fl_crc_mem
+******************************************************************************/
+
+/******************************************************************************
+* Function Name: fl_crc_raw_image
+* Description  : Adds part of a raw image to a running CRC. The 'raw_crc' 
+*                field of the load image header is skipped the same way the
+*                linker does.
+* Arguments    : p_crc - 
+*                    Running CRC, updated by this function
+*                p_data - 
+*                    Image data, or NULL if this part is erased (0xFF)
+*                offset - 
+*                    Offset of p_data in raw image
+*                bytes - 
+*                    Number of bytes of image data
+* Return value : none
+******************************************************************************/
+static void fl_crc_raw_image(uint16_t * p_crc, uint8_t * p_data, uint32_t offset, uint32_t bytes)
+{
+    uint32_t skip_start;
+    uint32_t skip_end;
 
+    /* Location of 'raw_crc' in raw image */
+    skip_start = CRC_ADDRESS + offsetof(fl_image_header_t, raw_crc);
+    skip_end   = skip_start + sizeof(((fl_image_header_t *) 0)->raw_crc);
 
+    if((offset >= skip_end) || ((offset + bytes) <= skip_start))
+    {
+        /* 'raw_crc' is not in this part */
+        fl_crc_add(p_crc, p_data, bytes);
+    }
+    else
+    {
+        /* CRC data before and after 'raw_crc' */
+        if(skip_start > offset)
+        {
+            fl_crc_add(p_crc, p_data, skip_start - offset);
+        }
+
+        if((offset + bytes) > skip_end)
+        {
+            fl_crc_add(p_crc, 
+                       (p_data == NULL) ? NULL : &p_data[skip_end - offset], 
+                       (offset + bytes) - skip_end);
+        }
+    }
+}
+/******************************************************************************
+End of function fl_crc_raw_image
+******************************************************************************/
+
+/******************************************************************************
+* Function Name: fl_crc_add
+* Description  : Adds data to a running CRC
+* Arguments    : p_crc - 
+*                    Running CRC, updated by this function
+*                p_data - 
+*                    Data, or NULL for erased (0xFF) bytes
+*                bytes - 
+*                    Number of bytes
+* Return value : none
+******************************************************************************/
+static void fl_crc_add(uint16_t * p_crc, uint8_t * p_data, uint32_t bytes)
+{
+    if(p_data == NULL)
+    {
+        *p_crc = fl_crc_erased(*p_crc, bytes);
+    }
+    else
+    {
+        R_CRC_Compute(*p_crc, p_data, bytes, p_crc);
+    }
+}
+/******************************************************************************
+End of function fl_crc_add
+******************************************************************************/
+
+/******************************************************************************
+* Function Name: fl_crc_erased
+* Description  : Adds a run of erased (0xFF) bytes to a running CRC without
+*                going through each byte. Adding 1 byte changes the CRC in a
+*                fixed linear way (plus a constant), so the change for 2^n 
+*                bytes is found by combining the change for 2^(n-1) bytes 
+*                with itself. Takes about 20 steps for a 1MB run.
+* Arguments    : crc - 
+*                    Running CRC
+*                bytes - 
+*                    Number of erased bytes
+* Return value : Updated CRC
+******************************************************************************/
+static uint16_t fl_crc_erased(uint16_t crc, uint32_t bytes)
+{
+    fl_crc_map_t step;
+    fl_crc_map_t twice;
+    uint8_t      value;
+    uint32_t     i;
+
+    /* Change caused by 1 erased byte. Uses the CRC unit so it always matches
+       R_CRC_Compute(). */
+    value = 0x00;
+
+    for(i = 0; i < 16; i++)
+    {
+        R_CRC_Compute((uint16_t)(1 << i), &value, 1, &step.linear[i]);
+    }
+
+    value = 0xFF;
+    R_CRC_Compute(0, &value, 1, &step.constant);
+
+    while(bytes > 0)
+    {
+        if((bytes & 1) != 0)
+        {
+            crc = fl_crc_map_apply(&step, crc);
+        }
+
+        bytes >>= 1;
+
+        if(bytes > 0)
+        {
+            /* Change for twice as many bytes */
+            for(i = 0; i < 16; i++)
+            {
+                twice.linear[i] = (uint16_t)(fl_crc_map_apply(&step, step.linear[i]) ^ step.constant);
+            }
+
+            twice.constant = fl_crc_map_apply(&step, step.constant);
+
+            step = twice;
+        }
+    }
+
+    return crc;
+}
+/******************************************************************************
+End of function fl_crc_erased
+******************************************************************************/
+
+/******************************************************************************
+* Function Name: fl_crc_map_apply
+* Description  : Applies a CRC change to a CRC value
+* Arguments    : p_map - 
+*                    Change to apply
+*                crc - 
+*                    CRC value
+* Return value : Changed CRC value
+******************************************************************************/
+static uint16_t fl_crc_map_apply(fl_crc_map_t * p_map, uint16_t crc)
+{
+    uint16_t result;
+    uint32_t i;
+
+    result = p_map->constant;
+
+    for(i = 0; i < 16; i++)
+    {
+        if((crc & (1 << i)) != 0)
+        {
+            result ^= p_map->linear[i];
+        }
+    }
+
+    return result;
+}
+/******************************************************************************
+End of function fl_crc_map_apply
+******************************************************************************/
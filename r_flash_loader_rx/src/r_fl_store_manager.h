@@ -34,6 +34,8 @@
 *                              this is defined in Flash API. Removed function
 *                              headers from prototypes because it was only
 *                              a duplication.
+*         : 19.10.2026 3.10    Added fl_get_image_container().
+*         : 19.10.2026 3.20    Added fl_sparse_init() and fl_sparse_next().
 ******************************************************************************/
 
 #ifndef FL_STORE_H
@@ -67,5 +69,8 @@ void    fl_get_load_image_headers(void);
 int32_t fl_find_matching_image(fl_image_header_t * ptr);
 uint16_t fl_verify_load_image(uint32_t image_index);
 int32_t fl_get_latest_image(void);
+bool    fl_get_image_container(uint32_t image_index, fl_container_header_t * p_container);
+bool    fl_sparse_init(fl_sparse_state_t * p_state, uint32_t image_index, fl_container_header_t * p_container);
+bool    fl_sparse_next(fl_sparse_state_t * p_state, fl_segment_t * p_segment, uint32_t * p_data_address);
 
 #endif /* FL_STORE_H */
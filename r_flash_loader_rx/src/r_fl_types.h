@@ -32,6 +32,19 @@
 *                               them easier to modify or add new ones. They 
 *                               were also slightly changed to match CS v4.0.
 *                               (introduced in v3.0)
+*         : 19.10.2026 3.10     Added fl_mem_cache_stats_t.
+*         : 19.10.2026 3.20     Added 'generation' to fl_image_header_t.
+*         : 19.10.2026 3.30     Added slot directory structures.
+*         : 19.10.2026 3.40     Added fl_meta_record_t.
+*         : 19.10.2026 3.50     Added fl_container_header_t.
+*         : 19.10.2026 3.60     Added delta image structures.
+*         : 19.10.2026 3.70     Added sparse image structures.
+*         : 19.10.2026 3.80     Added fl_kv_record_t.
+*         : 19.10.2026 3.90     Added fl_check_state_t.
+*         : 19.10.2026 4.00     Added fl_profile_header_t.
+*         : 19.10.2026 4.10     Added fl_fast_boot_record_t.
+*         : 19.10.2026 4.20     Removed fl_meta_record_t.
+*         : 19.10.2026 4.20     'generation' is only used with FL_LI_VALID_MASK_GEN.
 ******************************************************************************/
 
 #ifndef FL_TYPES
@@ -91,6 +104,12 @@ typedef struct
     uint8_t    version_comp;
     /* CRC-16 CCITT of image as in MCU flash */
     uint16_t    raw_crc;
+    /* Monotonic generation number. Must be higher for each new image. When
+       more than one valid image is stored the one with the highest 
+       generation is used. Erased value (FL_LI_GENERATION_NONE) is treated
+       as the oldest. Only used when valid_mask is FL_LI_VALID_MASK_GEN, as 
+       headers with FL_LI_VALID_MASK end after raw_crc. */
+    uint32_t    generation;
 } fl_image_header_t;
 
 /* Structure of FlashLoader Block Header */
@@ -111,6 +130,137 @@ typedef struct
     /* Then comes the actual data */
 } fl_block_header_t;
 
+/* Header placed at the start of a slot when the image is not stored as a 
+   raw copy of MCU flash (e.g. compressed). Raw images do not have this. */
+typedef struct
+{
+    /* FL_CONTAINER_MAGIC */
+    uint32_t            magic;
+    /* How image data is stored (FL_IMAGE_FORMAT_xxx) */
+    uint8_t             format;
+    /* Copy of the application's load image header */
+    fl_image_header_t   header;
+    /* Number of bytes of MCU flash the image expands to */
+    uint32_t            raw_size;
+    /* Number of bytes of image data following this header */
+    uint32_t            stored_size;
+    /* CRC-16 CCITT (FL_CRC_SEED) of image data following this header */
+    uint16_t            stored_crc;
+} fl_container_header_t;
+
+/* Start of the image data of a delta image (FL_IMAGE_FORMAT_DELTA). This is
+   followed by 'num_blocks' fl_delta_block_t records, each followed by the
+   operations that rebuild that block. */
+typedef struct
+{
+    /* raw_crc of the image the delta was made against */
+    uint16_t            base_crc;
+    /* Number of changed blocks in delta */
+    uint16_t            num_blocks;
+} fl_delta_header_t;
+
+/* Changed block in a delta image. Operations for the block follow and 
+   produce exactly 'length' bytes. */
+typedef struct
+{
+    /* Offset of block in raw image. This is a MCU flash erase block. */
+    uint32_t            offset;
+    /* Size of block in bytes */
+    uint32_t            length;
+} fl_delta_block_t;
+
+/* Start of the image data of a sparse image (FL_IMAGE_FORMAT_SPARSE). This 
+   is followed by 'num_segments' fl_segment_t records and then the data of 
+   each segment in the same order. Everything outside the segments is 
+   erased (0xFF). */
+typedef struct
+{
+    /* Number of segments in image */
+    uint16_t            num_segments;
+} fl_sparse_header_t;
+
+/* Segment of a sparse image */
+typedef struct
+{
+    /* Offset of segment in raw image */
+    uint32_t            offset;
+    /* Size of segment in bytes */
+    uint32_t            length;
+    /* CRC-16 CCITT (FL_CRC_SEED) of segment data */
+    uint16_t            crc;
+} fl_segment_t;
+
+/* Used for reading the segments of a sparse image in order */
+typedef struct
+{
+    /* Memory address of next fl_segment_t */
+    uint32_t            table_address;
+    /* Memory address of data of next segment */
+    uint32_t            data_address;
+    /* Memory address just past end of image data */
+    uint32_t            end_address;
+    /* Segments not yet read */
+    uint16_t            segments_left;
+    /* Lowest offset the next segment may start at */
+    uint32_t            next_offset;
+} fl_sparse_state_t;
+
+/* Used for checking a raw image a few bytes at a time (see r_fl_check.c) */
+typedef struct
+{
+    /* Read address of start of image, in MCU flash or in memory */
+    uint32_t            base_address;
+    /* Offset in image of next byte to add to the CRC */
+    uint32_t            offset;
+    /* CRC of bytes before 'offset' */
+    uint16_t            crc;
+    /* 'raw_crc' from the image's header */
+    uint16_t            raw_crc;
+    /* true if the image is in MCU flash, false if it is in memory */
+    bool                rom;
+} fl_check_state_t;
+
+/* Slot directory entry. One per load image slot. */
+typedef struct
+{
+    /* Lifecycle state of slot (FL_DIR_STATE_xxx) */
+    uint8_t             state;
+    /* Copy of load image header */
+    fl_image_header_t   header;
+    /* Number of bytes stored in slot */
+    uint32_t            image_size;
+    /* CRC-16 CCITT of image as stored in slot. For raw images this is the
+       same as header.raw_crc. */
+    uint16_t            image_crc;
+} fl_dir_entry_t;
+
+/* Slot directory page. */
+typedef struct
+{
+    /* FL_DIR_MAGIC when page is formatted */
+    uint32_t            magic;
+    /* FL_CFG_MEM_NUM_LOAD_IMAGES when page was formatted */
+    uint8_t             num_slots;
+    /* Keeps entries aligned the same way on every build */
+    uint8_t             reserved[3];
+    /* Entry for each slot */
+    fl_dir_entry_t      entries[FL_CFG_MEM_NUM_LOAD_IMAGES];
+} fl_dir_t;
+
+/* Data flash key-value store record. Each put appends a record to the 
+   active page. The size must be a multiple of DF_PROGRAM_SIZE_SMALL. The 
+   key is first so a record that was never started is blank at its first 
+   2 bytes. */
+typedef struct
+{
+    /* Key the record is for. FL_KV_KEY_PAGE for a page header. */
+    uint16_t    key;
+    /* CRC-16 CCITT of 'key' and 'value' */
+    uint16_t    crc;
+    /* Value stored. Page sequence number for a page header. */
+    uint32_t    value;
+} fl_kv_record_t;
+
 /* Turn off the pack option and put back to default. */
 #pragma packoption
 
@@ -126,4 +276,52 @@ typedef struct
     uint32_t    addresses[FL_CFG_MEM_NUM_LOAD_IMAGES+1];
 } fl_li_storage_t;
 
+/* Statistics for the memory page cache. */
+typedef struct
+{
+    /* Number of page lookups that were served from RAM. */
+    uint32_t    hits;
+    /* Number of page lookups that had to be read from memory. */
+    uint32_t    misses;
+} fl_mem_cache_stats_t;
+
+/* Start of a profile saved in memory by fl_profile_save(). It is followed by
+   'num_buckets' uint32_t sample counts. Bucket n counts samples whose PC was
+   in the 2^'bucket_shift' bytes from 'start' + (n << 'bucket_shift'). */
+typedef struct
+{
+    /* FL_PROFILE_MAGIC. Written last so a save cut short is not used. */
+    uint32_t    magic;
+    /* FL_PROFILE_VERSION */
+    uint16_t    version;
+    /* log2 of the bytes covered by each bucket */
+    uint16_t    bucket_shift;
+    /* Samples per second */
+    uint32_t    sample_hz;
+    /* Address of the first byte covered by bucket 0 */
+    uint32_t    start;
+    /* Number of buckets after this header */
+    uint32_t    num_buckets;
+    /* All samples taken */
+    uint32_t    samples;
+    /* Samples whose PC was outside the buckets */
+    uint32_t    outside;
+    /* Always 0xFFFFFFFF */
+    uint32_t    reserved;
+} fl_profile_header_t;
+
+/* Data flash record that lets the Bootloader start the User Application 
+   straight out of reset (see r_fl_fast_boot.c). Erased data flash does not
+   read back as a fixed value, so the record is only trusted when all 3 
+   fields agree. 'check' is last so a record cut short by power loss fails. */
+typedef struct
+{
+    /* FL_FAST_BOOT_MAGIC */
+    uint32_t    magic;
+    /* raw_crc of the image in MCU flash when the record was written */
+    uint16_t    raw_crc;
+    /* Bitwise NOT of 'raw_crc' */
+    uint16_t    check;
+} fl_fast_boot_record_t;
+
 #endif /* FL_TYPES */
@@ -37,6 +37,11 @@
 *                              state machine timer because it is now the users
 *                              responsibility to call the state machine. Added
 *                              R_FL_GetVersion() function to this file.
+*         : 19.10.2026 3.10    Added R_FL_GetServices().
+*         : 19.10.2026 3.20    Added fl_df_access().
+*         : 19.10.2026 3.30    Added fl_free_timer_get() and 
+*                              fl_free_timer_stop() so flash timing uses 1
+*                              CMT channel.
 ******************************************************************************/
 
 /******************************************************************************
@@ -50,6 +55,12 @@ Includes   <System Includes> , "Project Includes"
 #include "r_fl_includes.h"
 /* Used to get ROM_SIZE_BYTES which is in mcu_info.h and for LCD API. */
 #include "r_crc_rx_if.h"
+/* Used for R_FlashDataAreaAccess(). */
+#include "r_flash_api_rx_if.h"
+#if (FL_CFG_STATS_ENABLE == 1) || (FL_CFG_ROM_ERASE_TIMING_ENABLE == 1)
+/* Used for the shared free running CMT channel. */
+#include "r_cmt_rx_if.h"
+#endif
 
 /******************************************************************************
 Macro definitions
@@ -57,6 +68,19 @@ Macro definitions
 /*  Bottom of User Flash Area */
 #define ROM_START_ADDRESS     (0x100000000-BSP_ROM_SIZE_BYTES)
 volatile    uint16_t calc_crc;
+
+#if (FL_CFG_KV_ENABLE == 1) || (FL_CFG_STATS_ENABLE == 1) || (FL_CFG_FAST_BOOT_ENABLE == 1)
+/* Data flash blocks that reads and erase/program have been allowed for */
+static uint16_t g_fl_df_access = 0;
+#endif
+
+#if (FL_CFG_STATS_ENABLE == 1) || (FL_CFG_ROM_ERASE_TIMING_ENABLE == 1)
+/* Free running CMT channel shared by everything that times flash */
+static uint32_t g_fl_free_timer_channel;
+/* Whether g_fl_free_timer_channel has been created */
+static bool     g_fl_free_timer_created = false;
+#endif
+
 /******************************************************************************
 * Function Name: fl_check_application
 * Description  : Does a CRC on MCU flash to make sure current image is valid
@@ -187,6 +211,79 @@ bool fl_check_bootloader_bypass(void)
 End of function fl_check_bootloader_bypass
 ******************************************************************************/
 
+#if (FL_CFG_KV_ENABLE == 1) || (FL_CFG_STATS_ENABLE == 1) || (FL_CFG_FAST_BOOT_ENABLE == 1)
+/******************************************************************************
+* Function Name: fl_df_access
+* Description  : Allows reads and erase/program of more data flash blocks.
+*                R_FlashDataAreaAccess() sets the access of every block at 
+*                once, so each user of data flash asks through here to keep
+*                the blocks allowed for the others.
+* Arguments    : mask - 
+*                    Bit n set for each block DBn to allow
+* Return value : none
+******************************************************************************/
+void fl_df_access(uint16_t mask)
+{
+    g_fl_df_access |= mask;
+
+    R_FlashDataAreaAccess(g_fl_df_access, g_fl_df_access);
+}
+/******************************************************************************
+End of function fl_df_access
+******************************************************************************/
+#endif
+
+#if (FL_CFG_STATS_ENABLE == 1) || (FL_CFG_ROM_ERASE_TIMING_ENABLE == 1)
+/******************************************************************************
+* Function Name: fl_free_timer_get
+* Description  : Gets the free running CMT channel (PCLK / 
+*                CMT_RX_FREE_RUNNING_DIVIDER) used to time flash operations.
+*                The channel is created on first use and shared after that,
+*                so timing only takes 1 of the CMT channels.
+* Arguments    : p_channel - 
+*                    Where to place the channel number
+* Return value : true - 
+*                    Channel is counting
+*                false - 
+*                    No CMT channel is free
+******************************************************************************/
+bool fl_free_timer_get(uint32_t * p_channel)
+{
+    if(g_fl_free_timer_created == false)
+    {
+        g_fl_free_timer_created = R_CMT_CreateFreeRunning(&g_fl_free_timer_channel);
+    }
+
+    *p_channel = g_fl_free_timer_channel;
+
+    return g_fl_free_timer_created;
+}
+/******************************************************************************
+End of function fl_free_timer_get
+******************************************************************************/
+
+/******************************************************************************
+* Function Name: fl_free_timer_stop
+* Description  : Stops the free running CMT channel, if it was created, so 
+*                the User Application gets all of the CMT channels. Called 
+*                before jumping to the User Application.
+* Arguments    : none
+* Return value : none
+******************************************************************************/
+void fl_free_timer_stop(void)
+{
+    if(g_fl_free_timer_created == true)
+    {
+        R_CMT_Stop(g_fl_free_timer_channel);
+
+        g_fl_free_timer_created = false;
+    }
+}
+/******************************************************************************
+End of function fl_free_timer_stop
+******************************************************************************/
+#endif
+
 /******************************************************************************
 * Function Name: R_FL_GetVersion
 * Description  : Returns the current version of this module. The version number
@@ -206,4 +303,42 @@ uint32_t R_FL_GetVersion (void)
 End of function R_FL_GetVersion
 ******************************************************************************/
 
+/******************************************************************************
+* Function Name: R_FL_GetServices
+* Description  : Finds the Bootloader services table. This is called by the
+*                User Application.
+* Arguments    : none
+* Return Value : Pointer to the table, or NULL if the Bootloader has no table
+*                or its table is missing entries this code knows about.
+******************************************************************************/
+const fl_services_t * R_FL_GetServices (void)
+{
+    const fl_services_t * p_services;
+
+    p_services = (const fl_services_t *)FL_CFG_SERVICES_ADDR;
+
+    /* Erased flash or a Bootloader built without the table */
+    if(p_services->magic != FL_SERVICES_MAGIC)
+    {
+        return NULL;
+    }
+
+    /* Entries mean something else to this Bootloader */
+    if(p_services->version_major != FL_SERVICES_VERSION_MAJOR)
+    {
+        return NULL;
+    }
+
+    /* Older Bootloader without the newest entries */
+    if(p_services->bytes < sizeof(fl_services_t))
+    {
+        return NULL;
+    }
+
+    return p_services;
+}
+/******************************************************************************
+End of function R_FL_GetServices
+******************************************************************************/
+
 
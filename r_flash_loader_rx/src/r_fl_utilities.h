@@ -34,6 +34,9 @@
 *         : 23.02.2012 3.00    Removed 'LOWEST_ROM_ADDRESS' macro. Instead 
 *                              getting this info from Flash API. Made code
 *                              compliant with CS v4.0.
+*         : 19.10.2026 3.10    Added fl_df_access().
+*         : 19.10.2026 3.20    Added fl_free_timer_get() and 
+*                              fl_free_timer_stop().
 ******************************************************************************/
 
 #ifndef FL_UTIL_H
@@ -62,6 +65,9 @@ uint16_t fl_check_application(void);
 void     fl_reset(void);
 void     fl_signal(void);
 bool     fl_check_bootloader_bypass(void);
+void     fl_df_access(uint16_t mask);
+bool     fl_free_timer_get(uint32_t * p_channel);
+void     fl_free_timer_stop(void);
 
 #endif /* FL_UTIL_H */
 
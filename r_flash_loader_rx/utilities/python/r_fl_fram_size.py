@@ -0,0 +1,157 @@
+#!/usr/bin/env python
+'''
+/*******************************************************************************
+* DISCLAIMER
+* This software is supplied by Renesas Electronics Corporation and is only
+* intended for use with Renesas products. No other uses are authorized. This
+* software is owned by Renesas Electronics Corporation and is protected under
+* all applicable laws, including copyright laws.
+* THIS SOFTWARE IS PROVIDED "AS IS" AND RENESAS MAKES NO WARRANTIES REGARDING
+* THIS SOFTWARE, WHETHER EXPRESS, IMPLIED OR STATUTORY, INCLUDING BUT NOT
+* LIMITED TO WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE
+* AND NON-INFRINGEMENT. ALL SUCH WARRANTIES ARE EXPRESSLY DISCLAIMED.
+* TO THE MAXIMUM EXTENT PERMITTED NOT PROHIBITED BY LAW, NEITHER RENESAS
+* ELECTRONICS CORPORATION NOR ANY OF ITS AFFILIATED COMPANIES SHALL BE LIABLE
+* FOR ANY DIRECT, INDIRECT, SPECIAL, INCIDENTAL OR CONSEQUENTIAL DAMAGES FOR
+* ANY REASON RELATED TO THIS SOFTWARE, EVEN IF RENESAS OR ITS AFFILIATES HAVE
+* BEEN ADVISED OF THE POSSIBILITY OF SUCH DAMAGES.
+* Renesas reserves the right, without notice, to make changes to this software
+* and to discontinue the availability of this software. By using this software,
+* you agree to the additional terms and conditions found by accessing the
+* following link:
+* http://www.renesas.com/disclaimer *
+* Copyright (C) 2013 Renesas Electronics Corporation. All rights reserved.
+*******************************************************************************/
+/****************************************************************************
+* File Name		: r_fl_fram_size.py
+* Description   : Reports how much RAM the Flash API's FRAM section takes. The
+*                 FRAM section (PFRAM in ROM, RPFRAM in RAM) holds the Flash
+*                 API code that runs while ROM is in P/E mode and is copied
+*                 to RAM the first time ROM is programmed or erased. The sizes
+*                 are read from the map file made by the linker (the linker
+*                 '-list' and '-show=all' options). Run it as a post-build
+*                 step, optionally with '-l' to fail the build when the
+*                 section grows past a limit.
+******************************************************************************/
+/******************************************************************************
+* History 		: MM.DD.YYYY Version Information
+*               : 10.19.2026 Ver. 1.00 First Release
+******************************************************************************/
+'''
+#Used for getting input arguments and exiting
+import sys
+#Used for matching the section lines in the map file
+import re
+
+#This is the class that reads section sizes from a linker map file
+class FL_FRAM_Size:
+
+    #Section that holds the FRAM code in ROM
+    FL_FRAM_ROM_SECTION = 'PFRAM'
+    #Section that the FRAM code is copied to in RAM
+    FL_FRAM_RAM_SECTION = 'RPFRAM'
+    #Line after a section name in the map file: start, end and size in hex
+    FL_MAP_RANGE = re.compile(r'^\s*([0-9a-fA-F]{8})\s+([0-9a-fA-F]{8})\s+([0-9a-fA-F]+)\b')
+
+    def __init__(self, map_filename, limit, quiet):
+        self.map_filename = map_filename
+        self.limit = limit
+        self.quiet = quiet
+
+    #Returns {section name: (start, end, size)} for each section in the map file
+    def read_sections(self):
+        sections = {}
+        name = None
+
+        try:
+            map_file = open(self.map_filename, 'r')
+        except IOError:
+            print('Error opening map file ' + str(self.map_filename))
+            sys.exit(2)
+
+        for line in map_file:
+            stripped = line.strip()
+            #The section name is on a line of its own and the addresses and size on the next
+            if name is not None:
+                match = self.FL_MAP_RANGE.match(line)
+                if match:
+                    #A section can be listed once per object file, keep the first (whole section) entry
+                    if name not in sections:
+                        sections[name] = (int(match.group(1), 16), int(match.group(2), 16), int(match.group(3), 16))
+                    name = None
+                    continue
+            if stripped != '' and len(stripped.split()) == 1:
+                name = stripped
+            else:
+                name = None
+
+        map_file.close()
+        return sections
+
+    #Prints the size of the FRAM section. Returns the exit code for the build.
+    def execute(self):
+        sections = self.read_sections()
+
+        if self.FL_FRAM_ROM_SECTION not in sections:
+            #No ROM programming in this build, so nothing is copied to RAM
+            if self.quiet == False:
+                print('No ' + self.FL_FRAM_ROM_SECTION + ' section in ' + self.map_filename + ', 0 bytes copied to RAM')
+            return 0
+
+        (start, end, size) = sections[self.FL_FRAM_ROM_SECTION]
+
+        if self.quiet == False:
+            print(self.FL_FRAM_ROM_SECTION + ' (ROM) : 0x%08X - 0x%08X' % (start, end))
+            if self.FL_FRAM_RAM_SECTION in sections:
+                (ram_start, ram_end, ram_size) = sections[self.FL_FRAM_RAM_SECTION]
+                print(self.FL_FRAM_RAM_SECTION + ' (RAM) : 0x%08X - 0x%08X' % (ram_start, ram_end))
+            print('Flash API code copied to RAM on first ROM program/erase is ' + str(size) + ' bytes')
+
+        if (self.limit is not None) and (size > self.limit):
+            print('Error - ' + self.FL_FRAM_ROM_SECTION + ' is ' + str(size) + ' bytes, over the limit of ' + str(self.limit) + ' bytes')
+            return 1
+
+        return 0
+
+if __name__ == '__main__':
+    from optparse import OptionParser
+
+    parser = OptionParser(
+        description = "FlashLoader FRAM Size - Report the RAM used by the Flash API code that runs during ROM P/E"
+    )
+
+    parser.add_option("-f", "--file",
+        dest="filename",
+        action="store",
+        help="The linker map file to read.",
+        default = None,
+        metavar="FILE"
+    )
+
+    parser.add_option("-l", "--limit",
+        dest="limit",
+        action="store",
+        type= 'int',
+        help="Exit with an error if the FRAM section is bigger than this many bytes",
+        default = None,
+        metavar="BYTES"
+    )
+
+    parser.add_option("-q", "--quiet",
+        dest="quiet",
+        action="store_true",
+        help="If specified, only errors are printed.",
+        default=False
+    )
+
+    if len(sys.argv) == 1:
+        parser.print_help()
+        sys.exit()
+    else:
+        (options, args) = parser.parse_args()
+
+    #Initialize class
+    fs = FL_FRAM_Size(options.filename, options.limit, options.quiet)
+
+    #Report size
+    sys.exit(fs.execute())
@@ -49,6 +49,21 @@
 *                                      0xAA. If the read value does not match
 *                                      the expected value then an error 
 *                                      message is output.
+*               : 10.19.2026 Ver. 3.10 Added '-c' option to output a LZ
+*                                      compressed image of MCU flash for the
+*                                      Bootloader to expand while programming.
+*               : 10.19.2026 Ver. 3.20 Added '-b' option to output a delta
+*                                      image that only holds the MCU flash
+*                                      blocks that changed since the base
+*                                      image.
+*               : 10.19.2026 Ver. 3.30 Added '-s' option to output a sparse
+*                                      image that only holds the used address
+*                                      ranges of MCU flash.
+*               : 10.19.2026 Ver. 3.40 Application headers with the older 
+*                                      0xAA valid mask have no generation.
+*                                      Container headers made from them get
+*                                      an erased generation, not the bytes
+*                                      that follow the header.
 ******************************************************************************/
 '''
 #Used for getting input arguments and exiting
@@ -90,6 +105,53 @@ class FL_MOT_Converter:
 
     #Other defines for Load Image Headers and Data Block Headers
     FL_BH_VALID_MASK = "BB"
+
+    #Defines for compressed images ('-c' option). These must match r_fl_includes.h, r_fl_types.h and r_fl_lz.h
+    #Marks a slot that starts with a container header ("FLIM")
+    FL_CONTAINER_MAGIC = 0x4D494C46
+    #Container image format for LZ compressed images
+    FL_IMAGE_FORMAT_LZ = 1
+    #Container image format for delta images ('-b' option)
+    FL_IMAGE_FORMAT_DELTA = 2
+    #Container image format for sparse images ('-s' option)
+    FL_IMAGE_FORMAT_SPARSE = 3
+    #Segments of sparse images start and end on this boundary (FL_SPARSE_ALIGN_BYTES)
+    FL_SPARSE_ALIGN_BYTES = 128
+    #Format of application's load image header in MCU flash (valid_mask, 4 version bytes, raw_crc, generation)
+    FL_IMAGE_HEADER_FORMAT = '<BBBBBHL'
+    #Valid mask of headers that have the generation field (FL_LI_VALID_MASK_GEN). Headers with any other mask end
+    #after raw_crc.
+    FL_LI_VALID_MASK_GEN = 0xAC
+    #Generation the Bootloader treats as the oldest (FL_LI_GENERATION_NONE)
+    FL_LI_GENERATION_NONE = 0xFFFFFFFF
+    #Size of MCU flash that is held in a load image
+    FL_RAW_IMAGE_BYTES = 0x100000
+    #Lowest MCU flash address held in a load image
+    FL_RAW_IMAGE_START = 0x100000000 - FL_RAW_IMAGE_BYTES
+    #Seed used by RX linker for raw_crc
+    RX_LINKER_SEED = 0xFFFF
+    #LZ history window size, match lengths, and how many earlier positions to try for each match
+    LZ_WINDOW_BYTES = 4096
+    LZ_MIN_MATCH = 3
+    LZ_MAX_MATCH = 0xFFFF
+    LZ_LEN_EXTENDED = 15
+    LZ_MAX_TRIES = 32
+    #Delta operations. These must match r_fl_delta.h
+    FL_DELTA_OP_COPY = 1
+    FL_DELTA_OP_INSERT = 2
+    FL_DELTA_OP_FILL = 3
+    #Largest FL_DELTA_OP_INSERT
+    DELTA_MAX_INSERT = 0xFFFF
+    #Shortest copy and fill worth using instead of inserting the bytes
+    DELTA_MIN_COPY = 12
+    DELTA_MIN_FILL = 12
+    #Blocks in delta image must be MCU flash erase blocks (offset from start of image, block size). These match
+    #g_flash_BlockAddresses[] for a 1MB RX631/RX63N.
+    DELTA_BLOCK_MAP = [(0x00000, 0x8000), (0x80000, 0x4000), (0xF8000, 0x1000)]
+    #Unit used by the Bootloader to track which blocks have been rebuilt
+    DELTA_UNIT_BYTES = 0x1000
+    #How many earlier positions in the base image to remember for each 4 byte sequence
+    DELTA_MAX_TRIES = 8
         
     #Holds current sequence number for record
     sequence_number = 0
@@ -432,6 +494,363 @@ class FL_MOT_Converter:
         #Write raw CRC
         output_file.write(binascii.unhexlify(self.switch_endian(("%0" + str(self.FL_LI_FORMAT['raw_crc']*2) + "x") % my_header.raw_crc)))
 
+    #Reads the S-Record file into a copy of MCU flash. Bytes that are not in the file are left as 0xFF just like
+    #erased flash.
+    def ReadRawImage(self, mot_filename):
+        #Open input file
+        try:
+            mot_file = open(mot_filename, "r")
+        except:
+            print 'Error opening input file ' , mot_filename
+            sys.exit()
+
+        image = bytearray([0xFF] * self.FL_RAW_IMAGE_BYTES)
+
+        for line in mot_file:
+            #Test to see if each line starts with 'S'
+            if line.startswith('S') == False:
+                self.found_error()
+
+            #Get address size for this line. S3 means 4-byte address, S2 3-byte, and S1 2-byte.
+            if line.startswith('S3') == True:
+                address_size_bytes = 4
+            elif line.startswith('S2') == True:
+                address_size_bytes = 3
+            elif line.startswith('S1') == True:
+                address_size_bytes = 2
+            else:
+                continue
+
+            data_start_byte = 4 + (address_size_bytes*2)
+            address = int(line[4:data_start_byte],16)
+            num_data_bytes = int(line[2:4],16) - address_size_bytes - self.CHECKSUM_BYTES
+            data = bytearray(binascii.unhexlify(line[data_start_byte:data_start_byte+(num_data_bytes*2)]))
+
+            #Only MCU flash is held in a load image
+            if address < self.FL_RAW_IMAGE_START or (address + num_data_bytes) > 0x100000000:
+                print 'Warning - Data at ' + hex(address) + ' is outside of MCU flash and was skipped.'
+                continue
+
+            offset = address - self.FL_RAW_IMAGE_START
+            image[offset:offset+num_data_bytes] = data
+
+        mot_file.close()
+
+        return image
+
+    #Compresses data into the stream format expanded by r_fl_lz.c. Items are put in groups of 8 after a flag byte
+    #(bit 0 first, 1 = literal byte, 0 = match). A match is 2 bytes LSB first: bits 0-11 are distance-1 and bits 12-15
+    #are length-3. A length code of 15 is followed by extra length bytes which continue while they are 255.
+    def LZCompress(self, data):
+        out = bytearray()
+        #Earlier positions for each 3 byte sequence
+        table = {}
+        data_len = len(data)
+        pos = 0
+        flag_index = 0
+        flag_bit = 8
+
+        while pos < data_len:
+            #Start new group
+            if flag_bit == 8:
+                flag_index = len(out)
+                out.append(0)
+                flag_bit = 0
+
+            #Look for longest match in window
+            best_len = 0
+            best_dist = 0
+            key = -1
+            if pos + self.LZ_MIN_MATCH <= data_len:
+                key = (data[pos] << 16) | (data[pos+1] << 8) | data[pos+2]
+                limit = min(self.LZ_MAX_MATCH, data_len - pos)
+                for cand in reversed(table.get(key, [])[-self.LZ_MAX_TRIES:]):
+                    dist = pos - cand
+                    if dist > self.LZ_WINDOW_BYTES:
+                        break
+                    length = 0
+                    while length < limit and data[cand + length] == data[pos + length]:
+                        length += 1
+                    if length > best_len:
+                        best_len = length
+                        best_dist = dist
+                        if length == limit:
+                            break
+
+            if best_len >= self.LZ_MIN_MATCH:
+                #Output match, flag bit stays 0
+                code = best_len - self.LZ_MIN_MATCH
+                if code >= self.LZ_LEN_EXTENDED:
+                    token = ((best_dist - 1) | (self.LZ_LEN_EXTENDED << 12))
+                    out.append(token & 0xFF)
+                    out.append(token >> 8)
+                    remaining = code - self.LZ_LEN_EXTENDED
+                    while remaining >= 255:
+                        out.append(255)
+                        remaining -= 255
+                    out.append(remaining)
+                else:
+                    token = ((best_dist - 1) | (code << 12))
+                    out.append(token & 0xFF)
+                    out.append(token >> 8)
+                #Remember start of match. Only the first few positions inside a match are added so long runs stay fast.
+                for i in range(pos, min(pos + 16, pos + best_len, data_len - self.LZ_MIN_MATCH + 1)):
+                    self.LZAddPosition(table, data, i)
+                pos += best_len
+            else:
+                #Output literal
+                out[flag_index] |= (1 << flag_bit)
+                out.append(data[pos])
+                if key != -1:
+                    self.LZAddPosition(table, data, pos)
+                pos += 1
+
+            flag_bit += 1
+
+        return out
+
+    #Remembers a position in the LZ match table
+    def LZAddPosition(self, table, data, pos):
+        key = (data[pos] << 16) | (data[pos+1] << 8) | data[pos+2]
+        positions = table.setdefault(key, [])
+        positions.append(pos)
+        #Older positions are out of the window anyway, keep list short
+        if len(positions) > (self.LZ_MAX_TRIES * 4):
+            del positions[:len(positions) - self.LZ_MAX_TRIES]
+
+    #Gets the application's load image header out of a copy of MCU flash. Returns the header bytes and the unpacked
+    #header.
+    def GetImageHeader(self, image):
+        #Get application's load image header
+        header_offset = self.header_location - self.FL_RAW_IMAGE_START
+        header_size = calcsize(self.FL_IMAGE_HEADER_FORMAT)
+        header_bytes = image[header_offset:header_offset+header_size]
+        header = unpack(self.FL_IMAGE_HEADER_FORMAT, bytes(header_bytes))
+
+        #Check Valid Mask to make sure this is actually a valid header
+        if header[0] != self.input_valid_mask:
+            print 'Error - Valid mask in Application Header did not match the value it was supposed to be.'
+            print 'Expected Value = ' + hex(self.input_valid_mask) + " Actual Value = " + hex(header[0])
+            sys.exit()
+
+        #Check raw_crc the same way the Bootloader will. The raw_crc field itself is skipped.
+        raw_crc_offset = header_offset + 5
+        linker_crc = crcmod.mkCrcFun(self.g16, self.RX_LINKER_SEED, 0)
+        calc_crc = linker_crc(bytes(image[:raw_crc_offset]))
+        calc_crc = crcmod.mkCrcFun(self.g16, calc_crc, 0)(bytes(image[raw_crc_offset+2:]))
+        calc_crc = (~calc_crc) & 0xFFFF
+        if calc_crc != header[5]:
+            print 'Warning - raw_crc in Application Header (' + hex(header[5]) + ') does not match the image (' + hex(calc_crc) + ').'
+            print 'Make sure the linker is set to output the CRC. The Bootloader will not install this image.'
+
+        #Older headers have no generation, so what follows them in MCU flash must not be passed on as one
+        if header[0] != self.FL_LI_VALID_MASK_GEN:
+            header_bytes = header_bytes[:header_size-4] + bytearray(pack('<L', self.FL_LI_GENERATION_NONE))
+            header = header[:6] + (self.FL_LI_GENERATION_NONE,)
+
+        return header_bytes, header
+
+    #Writes a container header followed by the image data. This is written to a load image slot as is.
+    def WriteContainer(self, image_format, header_bytes, data):
+        #Open a new file for output
+        try:
+            out_file = open(self.out_filename, "wb")
+        except:
+            print 'Error opening output file ' , self.out_filename
+            sys.exit()
+
+        out_file.write(pack('<LB', self.FL_CONTAINER_MAGIC, image_format))
+        out_file.write(bytes(header_bytes))
+        out_file.write(pack('<LLH', self.FL_RAW_IMAGE_BYTES, len(data), self.crc(bytes(data))))
+        out_file.write(bytes(data))
+        out_file.close()
+
+    #Converts the S-Record file into a LZ compressed copy of MCU flash. The output file is a container header followed
+    #by the compressed data. This is written to a load image slot as is.
+    def ProcessCompressed(self):
+        image = self.ReadRawImage(self.mot_filename)
+
+        header_bytes, header = self.GetImageHeader(image)
+
+        compressed = self.LZCompress(image)
+
+        #Write container header then compressed data
+        self.WriteContainer(self.FL_IMAGE_FORMAT_LZ, header_bytes, compressed)
+
+        print "S-Record file converted and compressed successfully."
+        print "Output file is " + self.out_filename
+        print "Compressed " + str(self.FL_RAW_IMAGE_BYTES) + " bytes to " + str(len(compressed)) + " bytes"
+
+    #Returns a list of (offset, size) for each MCU flash erase block in the image
+    def DeltaBlocks(self):
+        blocks = []
+        offset = 0
+        while offset < self.FL_RAW_IMAGE_BYTES:
+            for (start, size) in self.DELTA_BLOCK_MAP:
+                if offset >= start:
+                    block_size = size
+            blocks.append((offset, block_size))
+            offset += block_size
+        return blocks
+
+    #Makes the delta operations that rebuild one block of the new image. Blocks are rebuilt in ascending order by the
+    #Bootloader so copies may only come from the block itself and above, or from blocks that do not change.
+    def DeltaEncodeBlock(self, base, image, index, changed_units, block_offset, block_size):
+        out = bytearray()
+        literal = bytearray()
+        block_end = block_offset + block_size
+        pos = block_offset
+        next_src = -1
+
+        while pos < block_end:
+            #Length of run of the same byte
+            run = 1
+            while pos + run < block_end and image[pos + run] == image[pos]:
+                run += 1
+
+            #Look for longest copy. Try carrying on from the last copy first, this finds code that moved.
+            best_len = 0
+            best_src = 0
+            candidates = []
+            if next_src >= 0:
+                candidates.append(next_src)
+            if pos + 4 <= block_end:
+                candidates.extend(index.get(bytes(image[pos:pos+4]), []))
+            for src in candidates:
+                limit = min(block_end - pos, self.DeltaCopyLimit(changed_units, block_offset, src))
+                length = 0
+                while length + 64 <= limit and image[pos+length:pos+length+64] == base[src+length:src+length+64]:
+                    length += 64
+                while length < limit and image[pos + length] == base[src + length]:
+                    length += 1
+                if length > best_len:
+                    best_len = length
+                    best_src = src
+
+            if run >= self.DELTA_MIN_FILL and run >= best_len:
+                out += self.DeltaFlushInsert(literal)
+                out += pack('<BLB', self.FL_DELTA_OP_FILL, run, image[pos])
+                pos += run
+                next_src = -1
+            elif best_len >= self.DELTA_MIN_COPY:
+                out += self.DeltaFlushInsert(literal)
+                out += pack('<BLL', self.FL_DELTA_OP_COPY, best_src, best_len)
+                pos += best_len
+                next_src = best_src + best_len
+            else:
+                literal.append(image[pos])
+                pos += 1
+                if next_src >= 0:
+                    next_src += 1
+                if len(literal) == self.DELTA_MAX_INSERT:
+                    out += self.DeltaFlushInsert(literal)
+
+            #Source must stay inside the image
+            if next_src >= self.FL_RAW_IMAGE_BYTES:
+                next_src = -1
+
+        out += self.DeltaFlushInsert(literal)
+
+        return out
+
+    #Returns how many bytes can be copied from 'src' before reaching old data that was already rebuilt
+    def DeltaCopyLimit(self, changed_units, block_offset, src):
+        end = src
+        while end < self.FL_RAW_IMAGE_BYTES:
+            unit = end / self.DELTA_UNIT_BYTES
+            if end < block_offset and unit in changed_units:
+                break
+            end = (unit + 1) * self.DELTA_UNIT_BYTES
+        return end - src
+
+    #Outputs pending new bytes as an insert operation and empties the list
+    def DeltaFlushInsert(self, literal):
+        out = bytearray()
+        if len(literal) > 0:
+            out += pack('<BH', self.FL_DELTA_OP_INSERT, len(literal))
+            out += literal
+            del literal[:]
+        return out
+
+    #Converts the S-Record file into a delta against the base S-Record file (the image currently in MCU flash). The
+    #output file is a container header followed by the delta. This is written to a load image slot as is.
+    def ProcessDelta(self, base_filename):
+        image = self.ReadRawImage(self.mot_filename)
+        base = self.ReadRawImage(base_filename)
+
+        header_bytes, header = self.GetImageHeader(image)
+        base_header_bytes, base_header = self.GetImageHeader(base)
+
+        #Find which blocks changed
+        changed = []
+        changed_units = set()
+        for (offset, size) in self.DeltaBlocks():
+            if image[offset:offset+size] != base[offset:offset+size]:
+                changed.append((offset, size))
+                for unit in range(offset / self.DELTA_UNIT_BYTES, (offset + size) / self.DELTA_UNIT_BYTES):
+                    changed_units.add(unit)
+
+        #Remember where each 4 byte sequence is in the base image. Runs of the same sequence are skipped, fills
+        #handle those.
+        index = {}
+        last_key = None
+        for pos in range(0, self.FL_RAW_IMAGE_BYTES - 3):
+            key = bytes(base[pos:pos+4])
+            if key != last_key:
+                positions = index.setdefault(key, [])
+                if len(positions) < self.DELTA_MAX_TRIES:
+                    positions.append(pos)
+            last_key = key
+
+        #Delta header is the raw_crc of the base image then each changed block
+        delta = bytearray(pack('<HH', base_header[5], len(changed)))
+        for (offset, size) in changed:
+            delta += pack('<LL', offset, size)
+            delta += self.DeltaEncodeBlock(base, image, index, changed_units, offset, size)
+
+        #Write container header then delta
+        self.WriteContainer(self.FL_IMAGE_FORMAT_DELTA, header_bytes, delta)
+
+        print "S-Record file converted to delta image successfully."
+        print "Output file is " + self.out_filename
+        print str(len(changed)) + " blocks changed, delta is " + str(len(delta)) + " bytes"
+
+    #Converts the S-Record file into a sparse image. Only the used address ranges (segments) of MCU flash are held,
+    #everything else is erased. Used ranges closer than the fill space are joined. The output file is a container
+    #header, the segment table and then the data of each segment. This is written to a load image slot as is.
+    def ProcessSparse(self):
+        image = self.ReadRawImage(self.mot_filename)
+
+        header_bytes, header = self.GetImageHeader(image)
+
+        #Find used ranges, looking at one programming unit at a time
+        segments = []
+        blank = bytearray([0xFF] * self.FL_SPARSE_ALIGN_BYTES)
+        for offset in range(0, self.FL_RAW_IMAGE_BYTES, self.FL_SPARSE_ALIGN_BYTES):
+            if image[offset:offset+self.FL_SPARSE_ALIGN_BYTES] == blank:
+                continue
+            if len(segments) > 0 and (offset - (segments[-1][0] + segments[-1][1])) <= self.max_fill_space:
+                #Join with last segment
+                segments[-1][1] = (offset + self.FL_SPARSE_ALIGN_BYTES) - segments[-1][0]
+            else:
+                segments.append([offset, self.FL_SPARSE_ALIGN_BYTES])
+
+        #Segment table then data
+        sparse = bytearray(pack('<H', len(segments)))
+        data = bytearray()
+        for (offset, length) in segments:
+            segment_data = image[offset:offset+length]
+            sparse += pack('<LLH', offset, length, self.crc(bytes(segment_data)))
+            data += segment_data
+        sparse += data
+
+        #Write container header then segments
+        self.WriteContainer(self.FL_IMAGE_FORMAT_SPARSE, header_bytes, sparse)
+
+        print "S-Record file converted to sparse image successfully."
+        print "Output file is " + self.out_filename
+        print str(len(segments)) + " segments, image is " + str(len(sparse)) + " bytes"
+
 if __name__ == '__main__':
     from optparse import OptionParser
     
@@ -498,6 +917,28 @@ if __name__ == '__main__':
         metavar="VALIDMASK"
     )
 
+    parser.add_option("-c", "--compress",
+        dest="want_compress",
+        action="store_true",
+        help="Output a LZ compressed copy of MCU flash to be stored in a load image slot, instead of Data Blocks.",
+        default=False
+    )
+
+    parser.add_option("-b", "--base",
+        dest="base_filename",
+        action="store",
+        help="Output a delta against this S-Record file, which must be the image currently in MCU flash.",
+        default = "",
+        metavar="BASE"
+    )
+
+    parser.add_option("-s", "--sparse",
+        dest="want_sparse",
+        action="store_true",
+        help="Output only the used address ranges of MCU flash to be stored in a load image slot, instead of Data Blocks. Ranges closer than FILLSPACE are joined.",
+        default=False
+    )
+
     if len(sys.argv) == 1:
         parser.print_help()
         sys.exit()
@@ -548,6 +989,13 @@ if __name__ == '__main__':
         
     fl_m = FL_MOT_Converter(options.mot_filename, options.out_filename, options.max_block_size, options.max_fill_space, options.header_location, options.input_valid_mask)
     
-    fl_m.Process()
+    if len(options.base_filename) != 0:
+        fl_m.ProcessDelta(options.base_filename)
+    elif options.want_compress == True:
+        fl_m.ProcessCompressed()
+    elif options.want_sparse == True:
+        fl_m.ProcessSparse()
+    else:
+        fl_m.Process()
         
         
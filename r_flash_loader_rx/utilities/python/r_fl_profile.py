@@ -0,0 +1,375 @@
+#!/usr/bin/env python
+'''
+/*******************************************************************************
+* DISCLAIMER
+* This software is supplied by Renesas Electronics Corporation and is only
+* intended for use with Renesas products. No other uses are authorized. This
+* software is owned by Renesas Electronics Corporation and is protected under
+* all applicable laws, including copyright laws.
+* THIS SOFTWARE IS PROVIDED "AS IS" AND RENESAS MAKES NO WARRANTIES REGARDING
+* THIS SOFTWARE, WHETHER EXPRESS, IMPLIED OR STATUTORY, INCLUDING BUT NOT
+* LIMITED TO WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE
+* AND NON-INFRINGEMENT. ALL SUCH WARRANTIES ARE EXPRESSLY DISCLAIMED.
+* TO THE MAXIMUM EXTENT PERMITTED NOT PROHIBITED BY LAW, NEITHER RENESAS
+* ELECTRONICS CORPORATION NOR ANY OF ITS AFFILIATED COMPANIES SHALL BE LIABLE
+* FOR ANY DIRECT, INDIRECT, SPECIAL, INCIDENTAL OR CONSEQUENTIAL DAMAGES FOR
+* ANY REASON RELATED TO THIS SOFTWARE, EVEN IF RENESAS OR ITS AFFILIATES HAVE
+* BEEN ADVISED OF THE POSSIBILITY OF SUCH DAMAGES.
+* Renesas reserves the right, without notice, to make changes to this software
+* and to discontinue the availability of this software. By using this software,
+* you agree to the additional terms and conditions found by accessing the
+* following link:
+* http://www.renesas.com/disclaimer *
+* Copyright (C) 2013 Renesas Electronics Corporation. All rights reserved.
+*******************************************************************************/
+/****************************************************************************
+* File Name		: r_fl_profile.py
+* Description   : Turns a profile saved by the Bootloader's PC sampling 
+*                 profiler (r_fl_profile.c) into a list of the functions 
+*                 that took the most time. The profile is a copy of the 
+*                 memory at FL_CFG_PROFILE_MEM_ADDR, read out over whatever
+*                 path the board has to that memory. Function addresses are
+*                 read from the symbol list in the map file made by the 
+*                 linker (the linker '-list' and '-show=symbol' options).
+*                 A bucket that straddles 2 functions is counted against the
+*                 function its first byte is in.
+*
+*                 With '-s' a profile is made up from known samples spread 
+*                 over the functions in the map file, packed the way the 
+*                 Bootloader saves it, read back and resolved. The result is
+*                 checked against what went in so the tool can be tested 
+*                 without a board.
+******************************************************************************/
+/******************************************************************************
+* History 		: MM.DD.YYYY Version Information
+*               : 10.19.2026 Ver. 1.00 First Release
+******************************************************************************/
+'''
+#Used for getting input arguments and exiting
+import sys
+#Used for matching the symbol lines in the map file
+import re
+#Used for reading and writing the saved profile (like C style struct)
+import struct
+#Used for making up samples
+import random
+
+#This is the class that reads a saved profile and resolves it against a map file
+class FL_Profile:
+
+    #Marks a saved profile ("FLPF"), FL_PROFILE_MAGIC in r_fl_profile.h
+    FL_PROFILE_MAGIC = 0x46504C46
+    #FL_PROFILE_VERSION in r_fl_profile.h
+    FL_PROFILE_VERSION = 1
+    #fl_profile_header_t in r_fl_types.h: magic, version, bucket_shift, sample_hz, start, num_buckets, samples,
+    #outside, reserved. The RX is little endian.
+    FL_PROFILE_HEADER = struct.Struct('<IHHIIIIII')
+    #Each bucket count after the header
+    FL_PROFILE_COUNT = struct.Struct('<I')
+    #Line after a symbol name in the map file: address, size and type
+    FL_MAP_SYMBOL = re.compile(r'^\s*([0-9a-fA-F]{8})\s+([0-9a-fA-F]+)\s+(\w+)\s*,')
+    #Defaults of the r_flash_loader_rx_config.h profile options, used for made up profiles
+    FL_CFG_PROFILE_HZ = 997
+    FL_CFG_PROFILE_START = 0xFF7FC000
+    FL_CFG_PROFILE_BYTES = 0x4000
+    FL_CFG_PROFILE_BUCKET_SHIFT = 4
+    #Functions used for a made up profile when no map file is given: name, address, size
+    FL_EXAMPLE_SYMBOLS = [('_main', 0xFF7FC000, 0x400),
+                          ('_R_RSPI_Read', 0xFF7FC400, 0x180),
+                          ('_R_CRC_Compute', 0xFF7FC580, 0x60),
+                          ('_R_FlashWrite', 0xFF7FC5E0, 0x220),
+                          ('_fl_lz_decode', 0xFF7FC800, 0x300)]
+
+    def __init__(self, profile_filename, map_filename, top, quiet):
+        self.profile_filename = profile_filename
+        self.map_filename = map_filename
+        self.top = top
+        self.quiet = quiet
+
+    #Returns a list of (address, size, name) for each function in the map file, sorted by address
+    def read_symbols(self):
+        symbols = []
+        name = None
+
+        try:
+            map_file = open(self.map_filename, 'r')
+        except IOError:
+            print('Error opening map file ' + str(self.map_filename))
+            sys.exit(2)
+
+        for line in map_file:
+            stripped = line.strip()
+            #The symbol name is on a line of its own and the address, size and type on the next
+            if name is not None:
+                match = self.FL_MAP_SYMBOL.match(line)
+                if match:
+                    if match.group(3) == 'func':
+                        symbols.append((int(match.group(1), 16), int(match.group(2), 16), name))
+                    name = None
+                    continue
+            if stripped != '' and len(stripped.split()) == 1 and '=' not in stripped:
+                name = stripped
+            else:
+                name = None
+
+        map_file.close()
+        symbols.sort()
+        return symbols
+
+    #Returns (header, counts) from a saved profile
+    def unpack(self, data):
+        if len(data) < self.FL_PROFILE_HEADER.size:
+            print('Error - profile is too short')
+            sys.exit(2)
+
+        fields = self.FL_PROFILE_HEADER.unpack_from(data, 0)
+        header = {'magic' : fields[0], 'version' : fields[1], 'bucket_shift' : fields[2], 'sample_hz' : fields[3],
+                  'start' : fields[4], 'num_buckets' : fields[5], 'samples' : fields[6], 'outside' : fields[7]}
+
+        if header['magic'] != self.FL_PROFILE_MAGIC:
+            print('Error - no profile found (magic is 0x%08X). The save may have been cut short.' % header['magic'])
+            sys.exit(2)
+
+        if header['version'] != self.FL_PROFILE_VERSION:
+            print('Error - profile version ' + str(header['version']) + ' is not supported')
+            sys.exit(2)
+
+        if len(data) < (self.FL_PROFILE_HEADER.size + (header['num_buckets'] * self.FL_PROFILE_COUNT.size)):
+            print('Error - profile is too short for ' + str(header['num_buckets']) + ' buckets')
+            sys.exit(2)
+
+        counts = []
+        for i in range(header['num_buckets']):
+            counts.append(self.FL_PROFILE_COUNT.unpack_from(data, self.FL_PROFILE_HEADER.size + (i * self.FL_PROFILE_COUNT.size))[0])
+
+        return (header, counts)
+
+    #Packs a profile the way fl_profile_save() does
+    def pack(self, header, counts):
+        data = self.FL_PROFILE_HEADER.pack(self.FL_PROFILE_MAGIC, self.FL_PROFILE_VERSION, header['bucket_shift'],
+                                           header['sample_hz'], header['start'], len(counts), header['samples'],
+                                           header['outside'], 0xFFFFFFFF)
+        for count in counts:
+            data += self.FL_PROFILE_COUNT.pack(count)
+        return data
+
+    #Returns the function holding an address, or None
+    def find_symbol(self, symbols, address):
+        for (sym_address, sym_size, sym_name) in symbols:
+            if (address >= sym_address) and (address < (sym_address + sym_size)):
+                return sym_name
+        return None
+
+    #Returns {function name: samples} for a profile. Buckets with no function are listed by address.
+    def resolve(self, header, counts, symbols):
+        totals = {}
+
+        for i in range(len(counts)):
+            if counts[i] == 0:
+                continue
+            address = header['start'] + (i << header['bucket_shift'])
+            name = self.find_symbol(symbols, address)
+            if name is None:
+                name = '<0x%08X>' % address
+            totals[name] = totals.get(name, 0) + counts[i]
+
+        return totals
+
+    #Prints the functions with the most samples
+    def report(self, header, totals, symbols):
+        addresses = {}
+        for (sym_address, sym_size, sym_name) in symbols:
+            addresses[sym_name] = sym_address
+
+        samples = header['samples']
+        if samples == 0:
+            print('No samples')
+            return
+
+        print('%d samples at %d Hz (%.2f s), %d (%.1f%%) outside 0x%08X - 0x%08X' % 
+              (samples, header['sample_hz'], float(samples) / header['sample_hz'], header['outside'],
+               (100.0 * header['outside']) / samples, header['start'],
+               header['start'] + (header['num_buckets'] << header['bucket_shift']) - 1))
+        print('')
+        print('  Samples       %  Address     Function')
+
+        ranked = sorted(totals.items(), key=lambda item: (-item[1], item[0]))
+        for (name, count) in ranked[:self.top]:
+            if name in addresses:
+                address = '0x%08X' % addresses[name]
+            else:
+                address = '          '
+            print('%9d  %5.1f%%  %s  %s' % (count, (100.0 * count) / samples, address, name))
+
+    #Reads a saved profile and prints where the time went. Returns the exit code.
+    def execute(self):
+        try:
+            profile_file = open(self.profile_filename, 'rb')
+        except IOError:
+            print('Error opening profile file ' + str(self.profile_filename))
+            sys.exit(2)
+
+        data = profile_file.read()
+        profile_file.close()
+
+        symbols = []
+        if self.map_filename is not None:
+            symbols = self.read_symbols()
+
+        (header, counts) = self.unpack(data)
+        self.report(header, self.resolve(header, counts, symbols), symbols)
+
+        return 0
+
+    #Makes up a profile from known samples, resolves it and checks the result. Returns the exit code.
+    def synthetic(self, num_samples, output_filename):
+        if self.map_filename is not None:
+            symbols = self.read_symbols()
+        else:
+            symbols = sorted([(a, s, n) for (n, a, s) in self.FL_EXAMPLE_SYMBOLS])
+
+        header = {'bucket_shift' : self.FL_CFG_PROFILE_BUCKET_SHIFT, 'sample_hz' : self.FL_CFG_PROFILE_HZ,
+                  'start' : self.FL_CFG_PROFILE_START, 'samples' : 0, 'outside' : 0}
+        bucket_bytes = 1 << header['bucket_shift']
+        counts = [0] * (self.FL_CFG_PROFILE_BYTES >> header['bucket_shift'])
+        end = self.FL_CFG_PROFILE_START + self.FL_CFG_PROFILE_BYTES
+
+        #Only buckets that lie wholly inside one function are used, so the answer is known
+        candidates = []
+        for (sym_address, sym_size, sym_name) in symbols:
+            first = (sym_address + bucket_bytes - 1) & ~(bucket_bytes - 1)
+            last = (sym_address + sym_size) & ~(bucket_bytes - 1)
+            if (first >= self.FL_CFG_PROFILE_START) and (last <= end) and (first < last):
+                candidates.append((first, last, sym_name))
+
+        if len(candidates) == 0:
+            print('Error - no functions inside 0x%08X - 0x%08X' % (self.FL_CFG_PROFILE_START, end - 1))
+            return 2
+
+        #Same seed each run so a failure can be repeated
+        rng = random.Random(1)
+        weights = [rng.randint(1, 100) for c in candidates]
+        expected = {}
+
+        for i in range(num_samples):
+            #Mostly the functions, some outside the buckets as for interrupts taken in the User Application
+            if rng.randint(0, 19) == 0:
+                pc = end + rng.randint(0, 0xFFFF)
+            else:
+                (first, last, name) = candidates[self.pick(rng, weights)]
+                pc = rng.randint(first, last - 1)
+                expected[name] = expected.get(name, 0) + 1
+
+            #Same as fl_profile_add()
+            header['samples'] += 1
+            offset = (pc - header['start']) & 0xFFFFFFFF
+            if offset < self.FL_CFG_PROFILE_BYTES:
+                counts[offset >> header['bucket_shift']] += 1
+            else:
+                header['outside'] += 1
+
+        data = self.pack(header, counts)
+
+        if output_filename is not None:
+            output_file = open(output_filename, 'wb')
+            output_file.write(data)
+            output_file.close()
+
+        (header, counts) = self.unpack(data)
+        totals = self.resolve(header, counts, symbols)
+
+        if self.quiet == False:
+            self.report(header, totals, symbols)
+
+        if (totals != expected) or ((sum(expected.values()) + header['outside']) != num_samples):
+            print('Error - resolved profile does not match the samples made up')
+            return 1
+
+        if self.quiet == False:
+            print('')
+            print('Resolved profile matches the ' + str(num_samples) + ' samples made up')
+        return 0
+
+    #Returns an index picked at random with the given weights
+    def pick(self, rng, weights):
+        point = rng.randint(1, sum(weights))
+        for i in range(len(weights)):
+            point -= weights[i]
+            if point <= 0:
+                return i
+        return len(weights) - 1
+
+if __name__ == '__main__':
+    from optparse import OptionParser
+
+    parser = OptionParser(
+        description = "FlashLoader Profile - List the functions the Bootloader spent its time in"
+    )
+
+    parser.add_option("-f", "--file",
+        dest="filename",
+        action="store",
+        help="Copy of the memory at FL_CFG_PROFILE_MEM_ADDR.",
+        default = None,
+        metavar="FILE"
+    )
+
+    parser.add_option("-m", "--map",
+        dest="map_filename",
+        action="store",
+        help="The linker map file of the Bootloader, with the symbol list.",
+        default = None,
+        metavar="FILE"
+    )
+
+    parser.add_option("-n", "--top",
+        dest="top",
+        action="store",
+        type= 'int',
+        help="Number of functions to list. Default is 20.",
+        default = 20,
+        metavar="COUNT"
+    )
+
+    parser.add_option("-s", "--synthetic",
+        dest="synthetic",
+        action="store",
+        type= 'int',
+        help="Make up a profile from this many samples over the functions in the map file (or example functions), resolve it and check the result.",
+        default = None,
+        metavar="SAMPLES"
+    )
+
+    parser.add_option("-o", "--output",
+        dest="output",
+        action="store",
+        help="With -s, also write the made up profile to this file.",
+        default = None,
+        metavar="FILE"
+    )
+
+    parser.add_option("-q", "--quiet",
+        dest="quiet",
+        action="store_true",
+        help="If specified, only errors are printed.",
+        default=False
+    )
+
+    if len(sys.argv) == 1:
+        parser.print_help()
+        sys.exit()
+    else:
+        (options, args) = parser.parse_args()
+
+    #Initialize class
+    fp = FL_Profile(options.filename, options.map_filename, options.top, options.quiet)
+
+    if options.synthetic is not None:
+        sys.exit(fp.synthetic(options.synthetic, options.output))
+
+    if options.filename is None:
+        print('Error - give a profile with -f or use -s')
+        sys.exit(2)
+
+    #Print profile
+    sys.exit(fp.execute())